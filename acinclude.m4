@@ -19,6 +19,12 @@ AC_DEFUN([AX_LIBFSNTFS_CHECK_LOCAL],
 
   dnl Check for internationalization functions in libfsntfs/libfsntfs_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Headers included in libfsntfs/libfsntfs_memory_map.c
+  AC_CHECK_HEADERS([errno.h fcntl.h sys/mman.h sys/stat.h unistd.h])
+
+  dnl Functions used in libfsntfs/libfsntfs_memory_map.c
+  AC_CHECK_FUNCS([close lseek mmap munmap open])
 ])
 
 dnl Function to detect if fsntfstools dependencies are available
@@ -0,0 +1,173 @@
+/*
+ * The metadata cache file definition
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _FSNTFS_METADATA_CACHE_H )
+#define _FSNTFS_METADATA_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct fsntfs_metadata_cache_header fsntfs_metadata_cache_header_t;
+
+struct fsntfs_metadata_cache_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: "fsntfsmc"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The number of MFT ranges
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_mft_ranges[ 4 ];
+
+	/* The volume serial number
+	 * Consists of 8 bytes
+	 */
+	uint8_t volume_serial_number[ 8 ];
+
+	/* The journal sequence number of the $MFT MFT entry
+	 * Consists of 8 bytes
+	 */
+	uint8_t mft_journal_sequence_number[ 8 ];
+
+	/* The MFT size
+	 * Consists of 8 bytes
+	 */
+	uint8_t mft_size[ 8 ];
+
+	/* The cluster block size
+	 * Consists of 4 bytes
+	 */
+	uint8_t cluster_block_size[ 4 ];
+
+	/* The MFT entry size
+	 * Consists of 4 bytes
+	 */
+	uint8_t mft_entry_size[ 4 ];
+
+	/* The number of attribute list mappings
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_attribute_list_mappings[ 4 ];
+
+	/* The number of security descriptor mappings
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_security_descriptor_mappings[ 4 ];
+
+	/* The number of path hints
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_path_hints[ 4 ];
+
+	/* The path data size
+	 * Consists of 4 bytes
+	 */
+	uint8_t path_data_size[ 4 ];
+};
+
+typedef struct fsntfs_metadata_cache_mft_range fsntfs_metadata_cache_mft_range_t;
+
+struct fsntfs_metadata_cache_mft_range
+{
+	/* The offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+
+	/* The size
+	 * Consists of 8 bytes
+	 */
+	uint8_t size[ 8 ];
+};
+
+typedef struct fsntfs_metadata_cache_attribute_list_mapping fsntfs_metadata_cache_attribute_list_mapping_t;
+
+struct fsntfs_metadata_cache_attribute_list_mapping
+{
+	/* The base record file reference
+	 * Consists of 8 bytes
+	 */
+	uint8_t base_record_file_reference[ 8 ];
+
+	/* The (attribute list data MFT entry) file reference
+	 * Consists of 8 bytes
+	 */
+	uint8_t file_reference[ 8 ];
+};
+
+typedef struct fsntfs_metadata_cache_security_descriptor_mapping fsntfs_metadata_cache_security_descriptor_mapping_t;
+
+struct fsntfs_metadata_cache_security_descriptor_mapping
+{
+	/* The security descriptor identifier
+	 * Consists of 4 bytes
+	 */
+	uint8_t identifier[ 4 ];
+
+	/* The $SDS data size
+	 * Consists of 4 bytes
+	 */
+	uint8_t data_size[ 4 ];
+
+	/* The $SDS data offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_offset[ 8 ];
+};
+
+typedef struct fsntfs_metadata_cache_path_hint fsntfs_metadata_cache_path_hint_t;
+
+struct fsntfs_metadata_cache_path_hint
+{
+	/* The file reference
+	 * Consists of 8 bytes
+	 */
+	uint8_t file_reference[ 8 ];
+
+	/* The path offset, relative to the start of the path data
+	 * Consists of 4 bytes
+	 */
+	uint8_t path_offset[ 4 ];
+
+	/* The path size, including the end-of-string character
+	 * Consists of 4 bytes
+	 */
+	uint8_t path_size[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _FSNTFS_METADATA_CACHE_H ) */
+
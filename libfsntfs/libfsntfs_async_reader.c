@@ -0,0 +1,1094 @@
+/*
+ * Asynchronous reader functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_async_reader.h"
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+
+/* Creates an asynchronous reader
+ * Make sure the value async_reader is referencing, is set to NULL
+ * The threads are started on the first read
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_async_reader_initialize(
+     libfsntfs_async_reader_t **async_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_async_reader_initialize";
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid asynchronous reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*async_reader = memory_allocate_structure(
+	                 libfsntfs_async_reader_t );
+
+	if( *async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create asynchronous reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *async_reader,
+	     0,
+	     sizeof( libfsntfs_async_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear asynchronous reader.",
+		 function );
+
+		memory_free(
+		 *async_reader );
+
+		*async_reader = NULL;
+
+		return( -1 );
+	}
+	( *async_reader )->number_of_threads = LIBFSNTFS_DEFAULT_NUMBER_OF_ASYNC_READ_THREADS;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *async_reader )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *async_reader != NULL )
+	{
+		memory_free(
+		 *async_reader );
+
+		*async_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an asynchronous reader
+ * Reads that are still queued are completed before the threads are joined
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_async_reader_free(
+     libfsntfs_async_reader_t **async_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_async_reader_free";
+	int result            = 1;
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_reader != NULL )
+	{
+		if( libfsntfs_async_reader_stop(
+		     *async_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop asynchronous reader.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *async_reader )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *async_reader );
+
+		*async_reader = NULL;
+	}
+	return( result );
+}
+
+/* Sets the number of threads
+ * The number of threads is only read when the thread pool is started, running
+ * threads are stopped after the outstanding reads have completed and
+ * the new number of threads is started on the next read
+ * Since stopping joins the thread pool this function cannot be called from a read callback
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_async_reader_set_number_of_threads(
+     libfsntfs_async_reader_t *async_reader,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_async_reader_set_number_of_threads";
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > LIBFSNTFS_MAXIMUM_NUMBER_OF_ASYNC_READ_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	async_reader->number_of_threads = number_of_threads;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     async_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The threads that were started with the previous number of threads
+	 * are stopped, the thread pool is restarted on the next read
+	 */
+	if( libfsntfs_async_reader_stop(
+	     async_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+/* Starts the threads
+ * Every thread reads using its own clone of the file IO handle
+ * This function must be called with the mutex grabbed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_async_reader_start(
+     libfsntfs_async_reader_t *async_reader,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_async_reader_start";
+	int handle_index      = 0;
+	int result            = 0;
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_reader->thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid asynchronous reader - thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The number of threads can change while the thread pool is running
+	 */
+	async_reader->number_of_started_threads = async_reader->number_of_threads;
+
+	async_reader->file_io_handles = (libbfio_handle_t **) memory_allocate(
+	                                                       sizeof( libbfio_handle_t * ) * async_reader->number_of_started_threads );
+
+	if( async_reader->file_io_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     async_reader->file_io_handles,
+	     0,
+	     sizeof( libbfio_handle_t * ) * async_reader->number_of_started_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handles.",
+		 function );
+
+		memory_free(
+		 async_reader->file_io_handles );
+
+		async_reader->file_io_handles = NULL;
+
+		goto on_error;
+	}
+	if( libcthreads_queue_initialize(
+	     &( async_reader->file_io_handles_queue ),
+	     async_reader->number_of_started_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handles queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( handle_index = 0;
+	     handle_index < async_reader->number_of_started_threads;
+	     handle_index++ )
+	{
+		if( libbfio_handle_clone(
+		     &( async_reader->file_io_handles[ handle_index ] ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		result = libbfio_handle_is_open(
+		          async_reader->file_io_handles[ handle_index ],
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle: %d is open.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libbfio_handle_open(
+			     async_reader->file_io_handles[ handle_index ],
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open file IO handle: %d.",
+				 function,
+				 handle_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_queue_push(
+		     async_reader->file_io_handles_queue,
+		     (intptr_t *) async_reader->file_io_handles[ handle_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push file IO handle: %d onto queue.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+	}
+	async_reader->file_io_handle         = file_io_handle;
+	async_reader->number_of_queued_reads = 0;
+
+	if( libcthreads_thread_pool_create(
+	     &( async_reader->thread_pool ),
+	     NULL,
+	     async_reader->number_of_started_threads,
+	     LIBFSNTFS_MAXIMUM_NUMBER_OF_QUEUED_ASYNC_READS,
+	     (int (*)(intptr_t *, void *)) &libfsntfs_async_reader_process_read,
+	     (void *) async_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libfsntfs_async_reader_free_file_io_handles(
+	 async_reader,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Frees the file IO handles
+ * This function must be called with the mutex grabbed and without running threads
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_async_reader_free_file_io_handles(
+     libfsntfs_async_reader_t *async_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_async_reader_free_file_io_handles";
+	int handle_index      = 0;
+	int result            = 1;
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_reader->file_io_handles_queue != NULL )
+	{
+		/* The file IO handles in the queue are freed below
+		 */
+		if( libcthreads_queue_free(
+		     &( async_reader->file_io_handles_queue ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handles queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( async_reader->file_io_handles != NULL )
+	{
+		for( handle_index = 0;
+		     handle_index < async_reader->number_of_started_threads;
+		     handle_index++ )
+		{
+			if( async_reader->file_io_handles[ handle_index ] == NULL )
+			{
+				continue;
+			}
+			if( libbfio_handle_close(
+			     async_reader->file_io_handles[ handle_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle: %d.",
+				 function,
+				 handle_index );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( async_reader->file_io_handles[ handle_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle: %d.",
+				 function,
+				 handle_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 async_reader->file_io_handles );
+
+		async_reader->file_io_handles = NULL;
+	}
+	async_reader->file_io_handle = NULL;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+/* Stops the threads
+ * Reads that are still queued are completed before the threads are joined,
+ * reads submitted while the threads are being stopped fail
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_async_reader_stop(
+     libfsntfs_async_reader_t *async_reader,
+     libcerror_error_t **error )
+{
+	static char *function                  = "libfsntfs_async_reader_stop";
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	int result                             = 1;
+#endif
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_reader->is_stopping != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid asynchronous reader - already stopping.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		thread_pool = async_reader->thread_pool;
+
+		if( thread_pool != NULL )
+		{
+			async_reader->is_stopping = 1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     async_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_pool == NULL )
+	{
+		return( result );
+	}
+	/* The mutex is not held while the threads are joined since the callback
+	 * functions of the queued reads can submit reads
+	 */
+	if( libcthreads_thread_pool_join(
+	     &thread_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread pool.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_grab(
+	     async_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_async_reader_free_file_io_handles(
+	     async_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handles.",
+		 function );
+
+		result = -1;
+	}
+	async_reader->thread_pool            = NULL;
+	async_reader->number_of_queued_reads = 0;
+	async_reader->is_stopping            = 0;
+
+	if( libcthreads_mutex_release(
+	     async_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+#else
+	return( 1 );
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+}
+
+/* Completes an asynchronous read
+ * Reads the data using a specific file IO handle and calls the callback function
+ * with the result, after which the asynchronous read is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_async_reader_complete_read(
+     libfsntfs_async_read_t *async_read,
+     libbfio_handle_t *file_io_handle )
+{
+	libcerror_error_t *error = NULL;
+	ssize_t read_count       = 0;
+	int result               = 1;
+
+	if( async_read == NULL )
+	{
+		return( -1 );
+	}
+	read_count = async_read->read_function(
+	              async_read->object,
+	              file_io_handle,
+	              async_read->buffer,
+	              async_read->buffer_size,
+	              async_read->offset,
+	              &error );
+
+	if( read_count < 0 )
+	{
+		read_count = -1;
+		result     = -1;
+	}
+	async_read->callback_function(
+	 async_read->object,
+	 async_read->buffer,
+	 read_count,
+	 async_read->offset,
+	 error,
+	 async_read->user_data );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	memory_free(
+	 async_read );
+
+	return( result );
+}
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+/* Processes an asynchronous read
+ * This function is called by the threads of the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_async_reader_process_read(
+     libfsntfs_async_read_t *async_read,
+     libfsntfs_async_reader_t *async_reader )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	int result                       = 1;
+
+	if( async_read == NULL )
+	{
+		return( -1 );
+	}
+	if( async_reader == NULL )
+	{
+		return( libfsntfs_async_reader_complete_read(
+		         async_read,
+		         async_read->file_io_handle ) );
+	}
+	if( libcthreads_mutex_grab(
+	     async_reader->mutex,
+	     NULL ) == 1 )
+	{
+		async_reader->number_of_queued_reads -= 1;
+
+		libcthreads_mutex_release(
+		 async_reader->mutex,
+		 NULL );
+	}
+	/* The clones of the file IO handle can only be used for objects that read
+	 * from the file IO handle the threads were started with
+	 */
+	if( async_read->file_io_handle != async_reader->file_io_handle )
+	{
+		return( libfsntfs_async_reader_complete_read(
+		         async_read,
+		         async_read->file_io_handle ) );
+	}
+	if( libcthreads_queue_pop(
+	     async_reader->file_io_handles_queue,
+	     (intptr_t **) &file_io_handle,
+	     NULL ) != 1 )
+	{
+		file_io_handle = NULL;
+	}
+	result = libfsntfs_async_reader_complete_read(
+	          async_read,
+	          ( file_io_handle != NULL ) ? file_io_handle : async_read->file_io_handle );
+
+	if( file_io_handle != NULL )
+	{
+		if( libcthreads_queue_push(
+		     async_reader->file_io_handles_queue,
+		     (intptr_t *) file_io_handle,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+/* Submits an asynchronous read
+ * The read function is called by one of the threads, with a clone of the
+ * file IO handle, after which the callback function is called on that thread
+ * When the maximum number of queued reads was reached or without multi-thread
+ * support the read is completed directly by the calling thread
+ * The object and buffer must remain valid until the callback function was called
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_async_reader_submit_read(
+     libfsntfs_async_reader_t *async_reader,
+     intptr_t *object,
+     libbfio_handle_t *file_io_handle,
+     ssize_t (*read_function)(
+                intptr_t *object,
+                libbfio_handle_t *file_io_handle,
+                uint8_t *buffer,
+                size_t buffer_size,
+                off64_t offset,
+                libcerror_error_t **error ),
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+             intptr_t *object,
+             uint8_t *buffer,
+             ssize_t read_count,
+             off64_t offset,
+             libcerror_error_t *error,
+             void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_async_read_t *async_read = NULL;
+	static char *function              = "libfsntfs_async_reader_submit_read";
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	int result                         = 1;
+	int use_thread_pool                = 0;
+#endif
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read function.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	async_read = memory_allocate_structure(
+	              libfsntfs_async_read_t );
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	async_read->object            = object;
+	async_read->file_io_handle    = file_io_handle;
+	async_read->read_function     = read_function;
+	async_read->buffer            = buffer;
+	async_read->buffer_size       = buffer_size;
+	async_read->offset            = offset;
+	async_read->callback_function = callback_function;
+	async_read->user_data         = user_data;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( async_reader->is_stopping != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid asynchronous reader - threads are being stopped.",
+		 function );
+
+		result = -1;
+	}
+	else if( async_reader->thread_pool == NULL )
+	{
+		if( libfsntfs_async_reader_start(
+		     async_reader,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start asynchronous reader.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The thread pool is only used while it has room for the read, a full
+	 * thread pool would otherwise block callback functions that submit reads
+	 */
+	if( ( result == 1 )
+	 && ( async_reader->number_of_queued_reads < LIBFSNTFS_MAXIMUM_NUMBER_OF_QUEUED_ASYNC_READS ) )
+	{
+		if( libcthreads_thread_pool_push(
+		     async_reader->thread_pool,
+		     (intptr_t *) async_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push asynchronous read onto thread pool.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			async_reader->number_of_queued_reads += 1;
+
+			use_thread_pool = 1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     async_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		/* The asynchronous read is owned by the thread pool once pushed
+		 */
+		if( use_thread_pool != 0 )
+		{
+			return( -1 );
+		}
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( use_thread_pool != 0 )
+	{
+		return( 1 );
+	}
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+	/* The callback function reports the result of the read
+	 */
+	libfsntfs_async_reader_complete_read(
+	 async_read,
+	 file_io_handle );
+
+	return( 1 );
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+on_error:
+	memory_free(
+	 async_read );
+
+	return( -1 );
+#endif
+}
+
@@ -0,0 +1,199 @@
+/*
+ * Asynchronous reader functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_ASYNC_READER_H )
+#define _LIBFSNTFS_ASYNC_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_async_reader libfsntfs_async_reader_t;
+
+typedef struct libfsntfs_async_read libfsntfs_async_read_t;
+
+struct libfsntfs_async_read
+{
+	/* The object, a file entry or data stream
+	 */
+	intptr_t *object;
+
+	/* The file IO handle of the object
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The read function
+	 */
+	ssize_t (*read_function)(
+	           intptr_t *object,
+	           libbfio_handle_t *file_io_handle,
+	           uint8_t *buffer,
+	           size_t buffer_size,
+	           off64_t offset,
+	           libcerror_error_t **error );
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The callback function
+	 */
+	void (*callback_function)(
+	        intptr_t *object,
+	        uint8_t *buffer,
+	        ssize_t read_count,
+	        off64_t offset,
+	        libcerror_error_t *error,
+	        void *user_data );
+
+	/* The user data
+	 */
+	void *user_data;
+};
+
+struct libfsntfs_async_reader
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	/* The file IO handle the file IO handles were cloned from
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The file IO handles, clones of the file IO handle, one per thread
+	 */
+	libbfio_handle_t **file_io_handles;
+
+	/* The queue of file IO handles that are not in use
+	 */
+	libcthreads_queue_t *file_io_handles_queue;
+
+	/* The thread pool, started on the first read
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The number of threads the thread pool was started with
+	 */
+	int number_of_started_threads;
+
+	/* The number of reads pushed onto the thread pool that were not yet processed
+	 */
+	int number_of_queued_reads;
+
+	/* Value to indicate the thread pool is being stopped
+	 */
+	uint8_t is_stopping;
+
+	/* The mutex that protects starting and stopping the thread pool
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libfsntfs_async_reader_initialize(
+     libfsntfs_async_reader_t **async_reader,
+     libcerror_error_t **error );
+
+int libfsntfs_async_reader_free(
+     libfsntfs_async_reader_t **async_reader,
+     libcerror_error_t **error );
+
+int libfsntfs_async_reader_set_number_of_threads(
+     libfsntfs_async_reader_t *async_reader,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+int libfsntfs_async_reader_start(
+     libfsntfs_async_reader_t *async_reader,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsntfs_async_reader_free_file_io_handles(
+     libfsntfs_async_reader_t *async_reader,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+int libfsntfs_async_reader_stop(
+     libfsntfs_async_reader_t *async_reader,
+     libcerror_error_t **error );
+
+int libfsntfs_async_reader_complete_read(
+     libfsntfs_async_read_t *async_read,
+     libbfio_handle_t *file_io_handle );
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+int libfsntfs_async_reader_process_read(
+     libfsntfs_async_read_t *async_read,
+     libfsntfs_async_reader_t *async_reader );
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+int libfsntfs_async_reader_submit_read(
+     libfsntfs_async_reader_t *async_reader,
+     intptr_t *object,
+     libbfio_handle_t *file_io_handle,
+     ssize_t (*read_function)(
+                intptr_t *object,
+                libbfio_handle_t *file_io_handle,
+                uint8_t *buffer,
+                size_t buffer_size,
+                off64_t offset,
+                libcerror_error_t **error ),
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+             intptr_t *object,
+             uint8_t *buffer,
+             ssize_t read_count,
+             off64_t offset,
+             libcerror_error_t *error,
+             void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_ASYNC_READER_H ) */
+
@@ -0,0 +1,657 @@
+/*
+ * Children index functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libfsntfs_children_index.h"
+#include "libfsntfs_libcerror.h"
+
+/* Creates a children index
+ * Make sure the value children_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_children_index_initialize(
+     libfsntfs_children_index_t **children_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_children_index_initialize";
+
+	if( children_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid children index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *children_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid children index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*children_index = memory_allocate_structure(
+	                   libfsntfs_children_index_t );
+
+	if( *children_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create children index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *children_index,
+	     0,
+	     sizeof( libfsntfs_children_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear children index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *children_index != NULL )
+	{
+		memory_free(
+		 *children_index );
+
+		*children_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a children index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_children_index_free(
+     libfsntfs_children_index_t **children_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_children_index_free";
+
+	if( children_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid children index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *children_index != NULL )
+	{
+		if( ( *children_index )->children != NULL )
+		{
+			memory_free(
+			 ( *children_index )->children );
+		}
+		if( ( *children_index )->child_offsets != NULL )
+		{
+			memory_free(
+			 ( *children_index )->child_offsets );
+		}
+		memory_free(
+		 *children_index );
+
+		*children_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the children index from parent to child links
+ * The children are grouped by parent MFT entry index using a counting sort,
+ * after which the children of a parent are sorted by the parent sequence number
+ * Links of which the parent MFT entry index is out of bounds or equals
+ * the child MFT entry index are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_children_index_set_links(
+     libfsntfs_children_index_t *children_index,
+     uint64_t number_of_entries,
+     const uint64_t *parent_file_references,
+     const uint64_t *child_mft_entry_indexes,
+     uint64_t number_of_links,
+     libcerror_error_t **error )
+{
+	uint64_t *safe_child_offsets    = NULL;
+	uint64_t *safe_children         = NULL;
+	static char *function           = "libfsntfs_children_index_set_links";
+	size_t child_offsets_size       = 0;
+	size_t children_size            = 0;
+	uint64_t child_offset           = 0;
+	uint64_t link_index             = 0;
+	uint64_t mft_entry_index        = 0;
+	uint64_t number_of_children     = 0;
+	uint64_t parent_mft_entry_index = 0;
+
+	if( children_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid children index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries >= ( (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_links > ( (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of links value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_links > 0 )
+	{
+		if( parent_file_references == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid parent file references.",
+			 function );
+
+			return( -1 );
+		}
+		if( child_mft_entry_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid child MFT entry indexes.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	child_offsets_size = sizeof( uint64_t ) * (size_t) ( number_of_entries + 1 );
+
+	safe_child_offsets = (uint64_t *) memory_allocate(
+	                                   child_offsets_size );
+
+	if( safe_child_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create child offsets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_child_offsets,
+	     0,
+	     child_offsets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear child offsets.",
+		 function );
+
+		goto on_error;
+	}
+	/* Count the number of children per parent, the count of the MFT entry
+	 * with index N is stored in child offset N + 1
+	 */
+	for( link_index = 0;
+	     link_index < number_of_links;
+	     link_index++ )
+	{
+		parent_mft_entry_index = parent_file_references[ link_index ] & 0xffffffffffffUL;
+
+		if( ( parent_mft_entry_index >= number_of_entries )
+		 || ( parent_mft_entry_index == child_mft_entry_indexes[ link_index ] ) )
+		{
+			continue;
+		}
+		if( child_mft_entry_indexes[ link_index ] > 0xffffffffffffUL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid child MFT entry index: %" PRIu64 " value out of bounds.",
+			 function,
+			 child_mft_entry_indexes[ link_index ] );
+
+			goto on_error;
+		}
+		safe_child_offsets[ parent_mft_entry_index + 1 ] += 1;
+
+		number_of_children++;
+	}
+	for( mft_entry_index = 1;
+	     mft_entry_index <= number_of_entries;
+	     mft_entry_index++ )
+	{
+		safe_child_offsets[ mft_entry_index ] += safe_child_offsets[ mft_entry_index - 1 ];
+	}
+	if( number_of_children > 0 )
+	{
+		children_size = sizeof( uint64_t ) * (size_t) number_of_children;
+
+		safe_children = (uint64_t *) memory_allocate(
+		                              children_size );
+
+		if( safe_children == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create children.",
+			 function );
+
+			goto on_error;
+		}
+		/* Fill the children per parent, child offset N is used as the fill
+		 * position of the MFT entry with index N, afterwards it contains the
+		 * start of the children of the MFT entry with index N + 1, hence the
+		 * child offsets are moved back into place
+		 */
+		for( link_index = 0;
+		     link_index < number_of_links;
+		     link_index++ )
+		{
+			parent_mft_entry_index = parent_file_references[ link_index ] & 0xffffffffffffUL;
+
+			if( ( parent_mft_entry_index >= number_of_entries )
+			 || ( parent_mft_entry_index == child_mft_entry_indexes[ link_index ] ) )
+			{
+				continue;
+			}
+			child_offset = safe_child_offsets[ parent_mft_entry_index ];
+
+			safe_children[ child_offset ] = ( parent_file_references[ link_index ] & 0xffff000000000000UL )
+			                              | child_mft_entry_indexes[ link_index ];
+
+			safe_child_offsets[ parent_mft_entry_index ] += 1;
+		}
+		for( mft_entry_index = number_of_entries;
+		     mft_entry_index > 0;
+		     mft_entry_index-- )
+		{
+			safe_child_offsets[ mft_entry_index ] = safe_child_offsets[ mft_entry_index - 1 ];
+		}
+		safe_child_offsets[ 0 ] = 0;
+
+		/* Sort the children of a parent by parent sequence number
+		 */
+		for( mft_entry_index = 0;
+		     mft_entry_index < number_of_entries;
+		     mft_entry_index++ )
+		{
+			child_offset = safe_child_offsets[ mft_entry_index ];
+
+			if( ( safe_child_offsets[ mft_entry_index + 1 ] - child_offset ) > 1 )
+			{
+				qsort(
+				 &( safe_children[ child_offset ] ),
+				 (size_t) ( safe_child_offsets[ mft_entry_index + 1 ] - child_offset ),
+				 sizeof( uint64_t ),
+				 &libfsntfs_children_index_compare_children );
+			}
+		}
+	}
+	if( children_index->children != NULL )
+	{
+		memory_free(
+		 children_index->children );
+	}
+	if( children_index->child_offsets != NULL )
+	{
+		memory_free(
+		 children_index->child_offsets );
+	}
+	children_index->number_of_entries  = number_of_entries;
+	children_index->child_offsets      = safe_child_offsets;
+	children_index->children           = safe_children;
+	children_index->number_of_children = number_of_children;
+
+	return( 1 );
+
+on_error:
+	if( safe_children != NULL )
+	{
+		memory_free(
+		 safe_children );
+	}
+	if( safe_child_offsets != NULL )
+	{
+		memory_free(
+		 safe_child_offsets );
+	}
+	return( -1 );
+}
+
+/* Compares two children
+ * Callback for qsort
+ * Returns -1 if the first child is less than the second, 0 if equal or 1 if greater
+ */
+int libfsntfs_children_index_compare_children(
+     const void *first_child,
+     const void *second_child )
+{
+	uint64_t first_value  = *( (const uint64_t *) first_child );
+	uint64_t second_value = *( (const uint64_t *) second_child );
+
+	if( first_value < second_value )
+	{
+		return( -1 );
+	}
+	else if( first_value > second_value )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the range of the children of a specific parent file reference
+ * Only the children that refer to the parent with the same sequence number are included,
+ * unless the parent is not allocated. The sequence number is updated when the MFT entry
+ * is deleted, hence the children of an unallocated parent that refer to the previous
+ * sequence number are included as well
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_children_index_get_children_range(
+     libfsntfs_children_index_t *children_index,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     uint64_t *first_child_offset,
+     uint64_t *number_of_children,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfsntfs_children_index_get_children_range";
+	uint64_t first_offset           = 0;
+	uint64_t last_offset            = 0;
+	uint64_t lower_offset           = 0;
+	uint64_t middle_offset          = 0;
+	uint64_t parent_mft_entry_index = 0;
+	uint64_t lower_sequence_number  = 0;
+	uint64_t sequence_number        = 0;
+	uint64_t upper_offset           = 0;
+
+	if( children_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid children index.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_child_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first child offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_children == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of children.",
+		 function );
+
+		return( -1 );
+	}
+	parent_mft_entry_index = parent_file_reference & 0xffffffffffffUL;
+	sequence_number        = parent_file_reference & 0xffff000000000000UL;
+	lower_sequence_number  = sequence_number;
+
+	/* The children are sorted by sequence number, hence the children that refer
+	 * to the previous sequence number directly precede those of the current one
+	 */
+	if( ( parent_is_allocated == 0 )
+	 && ( sequence_number != 0 ) )
+	{
+		lower_sequence_number -= 0x0001000000000000UL;
+	}
+
+	if( parent_mft_entry_index >= children_index->number_of_entries )
+	{
+		*first_child_offset = 0;
+		*number_of_children = 0;
+
+		return( 1 );
+	}
+	first_offset = children_index->child_offsets[ parent_mft_entry_index ];
+	last_offset  = children_index->child_offsets[ parent_mft_entry_index + 1 ];
+
+	/* Determine the first child with a sequence number that is not less
+	 */
+	lower_offset = first_offset;
+	upper_offset = last_offset;
+
+	while( lower_offset < upper_offset )
+	{
+		middle_offset = lower_offset + ( ( upper_offset - lower_offset ) / 2 );
+
+		if( ( children_index->children[ middle_offset ] & 0xffff000000000000UL ) < lower_sequence_number )
+		{
+			lower_offset = middle_offset + 1;
+		}
+		else
+		{
+			upper_offset = middle_offset;
+		}
+	}
+	first_offset = lower_offset;
+
+	/* Determine the first child with a sequence number that is greater
+	 */
+	upper_offset = last_offset;
+
+	while( lower_offset < upper_offset )
+	{
+		middle_offset = lower_offset + ( ( upper_offset - lower_offset ) / 2 );
+
+		if( ( children_index->children[ middle_offset ] & 0xffff000000000000UL ) <= sequence_number )
+		{
+			lower_offset = middle_offset + 1;
+		}
+		else
+		{
+			upper_offset = middle_offset;
+		}
+	}
+	*first_child_offset = first_offset;
+	*number_of_children = lower_offset - first_offset;
+
+	return( 1 );
+}
+
+/* Retrieves the number of children of a specific parent file reference
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_children_index_get_number_of_children(
+     libfsntfs_children_index_t *children_index,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     int *number_of_children,
+     libcerror_error_t **error )
+{
+	static char *function            = "libfsntfs_children_index_get_number_of_children";
+	uint64_t first_child_offset      = 0;
+	uint64_t safe_number_of_children = 0;
+
+	if( number_of_children == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of children.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_children_index_get_children_range(
+	     children_index,
+	     parent_file_reference,
+	     parent_is_allocated,
+	     &first_child_offset,
+	     &safe_number_of_children,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve children range.",
+		 function );
+
+		return( -1 );
+	}
+	if( safe_number_of_children > (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of children value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_children = (int) safe_number_of_children;
+
+	return( 1 );
+}
+
+/* Retrieves a specific child MFT entry index of a specific parent file reference
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_children_index_get_child_by_index(
+     libfsntfs_children_index_t *children_index,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     int child_index,
+     uint64_t *child_mft_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfsntfs_children_index_get_child_by_index";
+	uint64_t first_child_offset = 0;
+	uint64_t number_of_children = 0;
+
+	if( child_mft_entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid child MFT entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_children_index_get_children_range(
+	     children_index,
+	     parent_file_reference,
+	     parent_is_allocated,
+	     &first_child_offset,
+	     &number_of_children,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve children range.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( child_index < 0 )
+	 || ( (uint64_t) child_index >= number_of_children ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid child index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*child_mft_entry_index = children_index->children[ first_child_offset + (uint64_t) child_index ] & 0xffffffffffffUL;
+
+	return( 1 );
+}
+
@@ -0,0 +1,109 @@
+/*
+ * Children index functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_CHILDREN_INDEX_H )
+#define _LIBFSNTFS_CHILDREN_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_children_index libfsntfs_children_index_t;
+
+struct libfsntfs_children_index
+{
+	/* The number of entries
+	 */
+	uint64_t number_of_entries;
+
+	/* The child offsets
+	 * Contains the number of entries + 1 values, the children of the MFT entry
+	 * with index N are stored from child offset N up to child offset N + 1
+	 */
+	uint64_t *child_offsets;
+
+	/* The children
+	 * Every child contains the sequence number of the parent file reference
+	 * in the upper 16 bits and the child MFT entry index in the lower 48 bits
+	 * The children of a parent are sorted so that the children per parent
+	 * sequence number are stored consecutively
+	 */
+	uint64_t *children;
+
+	/* The number of children
+	 */
+	uint64_t number_of_children;
+};
+
+int libfsntfs_children_index_initialize(
+     libfsntfs_children_index_t **children_index,
+     libcerror_error_t **error );
+
+int libfsntfs_children_index_free(
+     libfsntfs_children_index_t **children_index,
+     libcerror_error_t **error );
+
+int libfsntfs_children_index_set_links(
+     libfsntfs_children_index_t *children_index,
+     uint64_t number_of_entries,
+     const uint64_t *parent_file_references,
+     const uint64_t *child_mft_entry_indexes,
+     uint64_t number_of_links,
+     libcerror_error_t **error );
+
+int libfsntfs_children_index_compare_children(
+     const void *first_child,
+     const void *second_child );
+
+int libfsntfs_children_index_get_children_range(
+     libfsntfs_children_index_t *children_index,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     uint64_t *first_child_offset,
+     uint64_t *number_of_children,
+     libcerror_error_t **error );
+
+int libfsntfs_children_index_get_number_of_children(
+     libfsntfs_children_index_t *children_index,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     int *number_of_children,
+     libcerror_error_t **error );
+
+int libfsntfs_children_index_get_child_by_index(
+     libfsntfs_children_index_t *children_index,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     int child_index,
+     uint64_t *child_mft_entry_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_CHILDREN_INDEX_H ) */
+
@@ -0,0 +1,618 @@
+/*
+ * Cluster allocation map functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_cluster_allocation_map.h"
+#include "libfsntfs_libcerror.h"
+
+/* Determines the number of trailing zero bits of a non-zero 64-bit value
+ * Returns the number of trailing zero bits
+ */
+uint8_t libfsntfs_cluster_allocation_map_get_number_of_trailing_zero_bits(
+         uint64_t value_64bit )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+	return( (uint8_t) __builtin_ctzll( value_64bit ) );
+#else
+	uint8_t number_of_bits = 0;
+
+	if( ( value_64bit & 0x00000000ffffffffULL ) == 0 )
+	{
+		number_of_bits += 32;
+		value_64bit   >>= 32;
+	}
+	if( ( value_64bit & 0x000000000000ffffULL ) == 0 )
+	{
+		number_of_bits += 16;
+		value_64bit   >>= 16;
+	}
+	if( ( value_64bit & 0x00000000000000ffULL ) == 0 )
+	{
+		number_of_bits += 8;
+		value_64bit   >>= 8;
+	}
+	if( ( value_64bit & 0x000000000000000fULL ) == 0 )
+	{
+		number_of_bits += 4;
+		value_64bit   >>= 4;
+	}
+	if( ( value_64bit & 0x0000000000000003ULL ) == 0 )
+	{
+		number_of_bits += 2;
+		value_64bit   >>= 2;
+	}
+	if( ( value_64bit & 0x0000000000000001ULL ) == 0 )
+	{
+		number_of_bits += 1;
+	}
+	return( number_of_bits );
+#endif
+}
+
+/* Creates a cluster allocation map
+ * Make sure the value cluster_allocation_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_allocation_map_initialize(
+     libfsntfs_cluster_allocation_map_t **cluster_allocation_map,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_cluster_allocation_map_initialize";
+
+	if( cluster_allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cluster_allocation_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid cluster allocation map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*cluster_allocation_map = memory_allocate_structure(
+	                           libfsntfs_cluster_allocation_map_t );
+
+	if( *cluster_allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cluster allocation map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *cluster_allocation_map,
+	     0,
+	     sizeof( libfsntfs_cluster_allocation_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear cluster allocation map.",
+		 function );
+
+		goto on_error;
+	}
+	( *cluster_allocation_map )->number_of_clusters = number_of_clusters;
+
+	return( 1 );
+
+on_error:
+	if( *cluster_allocation_map != NULL )
+	{
+		memory_free(
+		 *cluster_allocation_map );
+
+		*cluster_allocation_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a cluster allocation map
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_allocation_map_free(
+     libfsntfs_cluster_allocation_map_t **cluster_allocation_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_cluster_allocation_map_free";
+
+	if( cluster_allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cluster_allocation_map != NULL )
+	{
+		if( ( *cluster_allocation_map )->unallocated_ranges != NULL )
+		{
+			memory_free(
+			 ( *cluster_allocation_map )->unallocated_ranges );
+		}
+		memory_free(
+		 *cluster_allocation_map );
+
+		*cluster_allocation_map = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends an unallocated range
+ * The range must not precede the last unallocated range, adjacent ranges are merged
+ * Parts of the range beyond the number of clusters of the map are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_allocation_map_append_unallocated_range(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     uint64_t first_cluster_number,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_range_t *last_range = NULL;
+	libfsntfs_cluster_range_t *ranges     = NULL;
+	static char *function                 = "libfsntfs_cluster_allocation_map_append_unallocated_range";
+	size_t ranges_size                    = 0;
+	int maximum_number_of_ranges          = 0;
+
+	if( cluster_allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_clusters == 0 )
+	 || ( first_cluster_number >= cluster_allocation_map->number_of_clusters ) )
+	{
+		return( 1 );
+	}
+	if( number_of_clusters > ( cluster_allocation_map->number_of_clusters - first_cluster_number ) )
+	{
+		number_of_clusters = cluster_allocation_map->number_of_clusters - first_cluster_number;
+	}
+	if( cluster_allocation_map->number_of_unallocated_ranges > 0 )
+	{
+		last_range = &( cluster_allocation_map->unallocated_ranges[ cluster_allocation_map->number_of_unallocated_ranges - 1 ] );
+
+		if( first_cluster_number < ( last_range->first_cluster_number + last_range->number_of_clusters ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid first cluster number value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( first_cluster_number == ( last_range->first_cluster_number + last_range->number_of_clusters ) )
+		{
+			last_range->number_of_clusters += number_of_clusters;
+
+			return( 1 );
+		}
+	}
+	if( cluster_allocation_map->number_of_unallocated_ranges >= cluster_allocation_map->maximum_number_of_unallocated_ranges )
+	{
+		if( cluster_allocation_map->maximum_number_of_unallocated_ranges == 0 )
+		{
+			maximum_number_of_ranges = 256;
+		}
+		else if( cluster_allocation_map->maximum_number_of_unallocated_ranges <= ( INT_MAX / 2 ) )
+		{
+			maximum_number_of_ranges = cluster_allocation_map->maximum_number_of_unallocated_ranges * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of unallocated ranges value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		ranges_size = sizeof( libfsntfs_cluster_range_t ) * (size_t) maximum_number_of_ranges;
+
+		if( ranges_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid unallocated ranges size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		ranges = (libfsntfs_cluster_range_t *) memory_reallocate(
+		                                        cluster_allocation_map->unallocated_ranges,
+		                                        ranges_size );
+
+		if( ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize unallocated ranges.",
+			 function );
+
+			return( -1 );
+		}
+		cluster_allocation_map->unallocated_ranges                   = ranges;
+		cluster_allocation_map->maximum_number_of_unallocated_ranges = maximum_number_of_ranges;
+	}
+	last_range = &( cluster_allocation_map->unallocated_ranges[ cluster_allocation_map->number_of_unallocated_ranges ] );
+
+	last_range->first_cluster_number = first_cluster_number;
+	last_range->number_of_clusters   = number_of_clusters;
+
+	cluster_allocation_map->number_of_unallocated_ranges += 1;
+
+	return( 1 );
+}
+
+/* Reads $Bitmap data into the cluster allocation map
+ * The data is scanned 64 bits at a time, ranges that continue from the data
+ * of a preceding call are merged
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_allocation_map_read_data(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t first_cluster_number,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfsntfs_cluster_allocation_map_read_data";
+	size_t data_offset          = 0;
+	uint64_t cluster_number     = 0;
+	uint64_t unallocated_bits   = 0;
+	uint64_t value_64bit        = 0;
+	uint8_t bit_index           = 0;
+	uint8_t byte_value          = 0;
+	uint8_t first_bit_index     = 0;
+	uint8_t number_of_bits      = 0;
+
+	if( cluster_allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	cluster_number = first_cluster_number;
+
+	while( ( ( data_offset + 8 ) <= data_size )
+	    && ( cluster_number < cluster_allocation_map->number_of_clusters ) )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( data[ data_offset ] ),
+		 value_64bit );
+
+		data_offset += 8;
+
+		/* Fully allocated words are the common case and need no further processing
+		 */
+		if( value_64bit != 0xffffffffffffffffULL )
+		{
+			unallocated_bits = ~value_64bit;
+
+			while( unallocated_bits != 0 )
+			{
+				first_bit_index = libfsntfs_cluster_allocation_map_get_number_of_trailing_zero_bits(
+				                   unallocated_bits );
+
+				if( ( value_64bit >> first_bit_index ) == 0 )
+				{
+					number_of_bits = 64 - first_bit_index;
+				}
+				else
+				{
+					number_of_bits = libfsntfs_cluster_allocation_map_get_number_of_trailing_zero_bits(
+					                  value_64bit >> first_bit_index );
+				}
+				if( libfsntfs_cluster_allocation_map_append_unallocated_range(
+				     cluster_allocation_map,
+				     cluster_number + first_bit_index,
+				     (uint64_t) number_of_bits,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append unallocated range.",
+					 function );
+
+					return( -1 );
+				}
+				if( ( first_bit_index + number_of_bits ) >= 64 )
+				{
+					break;
+				}
+				unallocated_bits &= ~( ( (uint64_t) 1 << ( first_bit_index + number_of_bits ) ) - 1 );
+			}
+		}
+		cluster_number += 64;
+	}
+	while( ( data_offset < data_size )
+	    && ( cluster_number < cluster_allocation_map->number_of_clusters ) )
+	{
+		byte_value = data[ data_offset ];
+
+		data_offset++;
+
+		for( bit_index = 0;
+		     bit_index < 8;
+		     bit_index++ )
+		{
+			if( ( byte_value & 0x01 ) == 0 )
+			{
+				if( libfsntfs_cluster_allocation_map_append_unallocated_range(
+				     cluster_allocation_map,
+				     cluster_number,
+				     1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append unallocated range.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			byte_value >>= 1;
+
+			cluster_number++;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of unallocated ranges
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     int *number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges";
+
+	if( cluster_allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of ranges.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_ranges = cluster_allocation_map->number_of_unallocated_ranges;
+
+	return( 1 );
+}
+
+/* Retrieves a specific unallocated range
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     int range_index,
+     uint64_t *first_cluster_number,
+     uint64_t *number_of_clusters,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_cluster_allocation_map_get_unallocated_range_by_index";
+
+	if( cluster_allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index < 0 )
+	 || ( range_index >= cluster_allocation_map->number_of_unallocated_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_cluster_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first cluster number.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_clusters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of clusters.",
+		 function );
+
+		return( -1 );
+	}
+	*first_cluster_number = cluster_allocation_map->unallocated_ranges[ range_index ].first_cluster_number;
+	*number_of_clusters   = cluster_allocation_map->unallocated_ranges[ range_index ].number_of_clusters;
+
+	return( 1 );
+}
+
+/* Determines if a specific cluster is allocated
+ * The unallocated ranges are searched using a binary search
+ * Returns 1 if allocated, 0 if not or -1 on error
+ */
+int libfsntfs_cluster_allocation_map_is_cluster_allocated(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     uint64_t cluster_number,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_range_t *range = NULL;
+	static char *function            = "libfsntfs_cluster_allocation_map_is_cluster_allocated";
+	int first_range_index            = 0;
+	int last_range_index             = 0;
+	int range_index                  = 0;
+
+	if( cluster_allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( cluster_number >= cluster_allocation_map->number_of_clusters )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid cluster number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	last_range_index = cluster_allocation_map->number_of_unallocated_ranges;
+
+	/* Determine the first range that starts after the cluster number
+	 */
+	while( first_range_index < last_range_index )
+	{
+		range_index = first_range_index + ( ( last_range_index - first_range_index ) / 2 );
+
+		if( cluster_allocation_map->unallocated_ranges[ range_index ].first_cluster_number <= cluster_number )
+		{
+			first_range_index = range_index + 1;
+		}
+		else
+		{
+			last_range_index = range_index;
+		}
+	}
+	if( first_range_index > 0 )
+	{
+		range = &( cluster_allocation_map->unallocated_ranges[ first_range_index - 1 ] );
+
+		if( ( cluster_number - range->first_cluster_number ) < range->number_of_clusters )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,115 @@
+/*
+ * Cluster allocation map functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_CLUSTER_ALLOCATION_MAP_H )
+#define _LIBFSNTFS_CLUSTER_ALLOCATION_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_cluster_range libfsntfs_cluster_range_t;
+
+struct libfsntfs_cluster_range
+{
+	/* The first cluster number
+	 */
+	uint64_t first_cluster_number;
+
+	/* The number of clusters
+	 */
+	uint64_t number_of_clusters;
+};
+
+typedef struct libfsntfs_cluster_allocation_map libfsntfs_cluster_allocation_map_t;
+
+struct libfsntfs_cluster_allocation_map
+{
+	/* The number of clusters covered by the map
+	 */
+	uint64_t number_of_clusters;
+
+	/* The unallocated ranges, sorted by first cluster number
+	 */
+	libfsntfs_cluster_range_t *unallocated_ranges;
+
+	/* The number of unallocated ranges
+	 */
+	int number_of_unallocated_ranges;
+
+	/* The number of allocated unallocated range entries
+	 */
+	int maximum_number_of_unallocated_ranges;
+};
+
+uint8_t libfsntfs_cluster_allocation_map_get_number_of_trailing_zero_bits(
+         uint64_t value_64bit );
+
+int libfsntfs_cluster_allocation_map_initialize(
+     libfsntfs_cluster_allocation_map_t **cluster_allocation_map,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_allocation_map_free(
+     libfsntfs_cluster_allocation_map_t **cluster_allocation_map,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_allocation_map_append_unallocated_range(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     uint64_t first_cluster_number,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_allocation_map_read_data(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t first_cluster_number,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     int *number_of_ranges,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     int range_index,
+     uint64_t *first_cluster_number,
+     uint64_t *number_of_clusters,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_allocation_map_is_cluster_allocated(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map,
+     uint64_t cluster_number,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_CLUSTER_ALLOCATION_MAP_H ) */
+
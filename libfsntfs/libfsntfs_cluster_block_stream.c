@@ -30,6 +30,7 @@
 #include "libfsntfs_compressed_data_handle.h"
 #include "libfsntfs_definitions.h"
 #include "libfsntfs_io_handle.h"
+#include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
@@ -955,3 +956,115 @@ on_error:
 	return( -1 );
 }
 
+/* Reads multiple ranges of data from a cluster block stream
+ * The ranges are read in the order they are provided, afterwards the current offset
+ * of the cluster block stream is restored. The number of bytes read per range is
+ * stored in range_read_counts
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_block_stream_read_ranges(
+     libfdata_stream_t *cluster_block_stream,
+     libbfio_handle_t *file_io_handle,
+     const off64_t *range_offsets,
+     const size_t *range_sizes,
+     uint8_t **range_buffers,
+     ssize_t *range_read_counts,
+     int number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function  = "libfsntfs_cluster_block_stream_read_ranges";
+	off64_t current_offset = 0;
+	ssize_t read_count     = 0;
+	int range_index        = 0;
+	int result             = 1;
+
+	if( number_of_ranges < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == 0 )
+	{
+		return( 1 );
+	}
+	if( ( range_offsets == NULL )
+	 || ( range_sizes == NULL )
+	 || ( range_buffers == NULL )
+	 || ( range_read_counts == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_stream_get_offset(
+	     cluster_block_stream,
+	     &current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current offset.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		read_count = libfdata_stream_read_buffer_at_offset(
+		              cluster_block_stream,
+		              (intptr_t *) file_io_handle,
+		              range_buffers[ range_index ],
+		              range_sizes[ range_index ],
+		              range_offsets[ range_index ],
+		              0,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read range: %d.",
+			 function,
+			 range_index );
+
+			result = -1;
+
+			break;
+		}
+		range_read_counts[ range_index ] = read_count;
+	}
+	if( libfdata_stream_seek_offset(
+	     cluster_block_stream,
+	     current_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to restore current offset.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
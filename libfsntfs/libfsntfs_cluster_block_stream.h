@@ -71,6 +71,16 @@ int libfsntfs_cluster_block_stream_initialize(
      uint32_t compression_method,
      libcerror_error_t **error );
 
+int libfsntfs_cluster_block_stream_read_ranges(
+     libfdata_stream_t *cluster_block_stream,
+     libbfio_handle_t *file_io_handle,
+     const off64_t *range_offsets,
+     const size_t *range_sizes,
+     uint8_t **range_buffers,
+     ssize_t *range_read_counts,
+     int number_of_ranges,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
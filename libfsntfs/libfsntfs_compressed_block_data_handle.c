@@ -45,7 +45,9 @@ int libfsntfs_compressed_block_data_handle_initialize(
      libfsntfs_mft_attribute_t *mft_attribute,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_compressed_block_data_handle_initialize";
+	static char *function               = "libfsntfs_compressed_block_data_handle_initialize";
+	size_t compression_unit_size        = 0;
+	int maximum_number_of_cache_entries = 0;
 
 	if( data_handle == NULL )
 	{
@@ -142,9 +144,39 @@ int libfsntfs_compressed_block_data_handle_initialize(
 
 		goto on_error;
 	}
+	if( libfsntfs_mft_attribute_get_compression_unit_size(
+	     mft_attribute,
+	     &compression_unit_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression unit size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+	     io_handle,
+	     LIBFSNTFS_CACHE_TYPE_COMPRESSED_BLOCKS,
+	     compression_unit_size,
+	     &maximum_number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum number of compressed block cache entries.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfcache_cache_initialize(
 	     &( ( *data_handle )->compressed_block_cache ),
-	     LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_COMPRESSED_BLOCKS,
+	     maximum_number_of_cache_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -0,0 +1,372 @@
+/*
+ * Data read-ahead functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_data_readahead.h"
+#include "libfsntfs_data_segment_table.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcnotify.h"
+
+/* Creates data read-ahead
+ * Make sure the value data_readahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_data_readahead_initialize(
+     libfsntfs_data_readahead_t **data_readahead,
+     size_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_data_readahead_initialize";
+
+	if( data_readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_readahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*data_readahead = memory_allocate_structure(
+	                   libfsntfs_data_readahead_t );
+
+	if( *data_readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *data_readahead,
+	     0,
+	     sizeof( libfsntfs_data_readahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	( *data_readahead )->maximum_size = maximum_size;
+	( *data_readahead )->next_offset  = -1;
+
+	return( 1 );
+
+on_error:
+	if( *data_readahead != NULL )
+	{
+		memory_free(
+		 *data_readahead );
+
+		*data_readahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees data read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_data_readahead_free(
+     libfsntfs_data_readahead_t **data_readahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_data_readahead_free";
+
+	if( data_readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_readahead != NULL )
+	{
+		if( ( *data_readahead )->data != NULL )
+		{
+			memory_free(
+			 ( *data_readahead )->data );
+		}
+		memory_free(
+		 *data_readahead );
+
+		*data_readahead = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads data at a specific offset using read-ahead
+ * A read that starts directly after the previous read is considered sequential.
+ * Sequential reads are served from a read-ahead window that starts at twice the
+ * size of the read and is doubled every time it is refilled, up to the maximum
+ * size. A read that is not sequential resets the window and is read directly
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_data_readahead_read_buffer_at_offset(
+         libfsntfs_data_readahead_t *data_readahead,
+         libfsntfs_data_segment_table_t *data_segment_table,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	uint8_t *reallocation = NULL;
+	static char *function = "libfsntfs_data_readahead_read_buffer_at_offset";
+	size_t buffer_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t read_offset   = 0;
+
+	if( data_readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset != data_readahead->next_offset )
+	 || ( data_readahead->maximum_size == 0 ) )
+	{
+		data_readahead->window_size = 0;
+	}
+	else if( data_readahead->window_size == 0 )
+	{
+		if( buffer_size < ( data_readahead->maximum_size / 2 ) )
+		{
+			data_readahead->window_size = buffer_size * 2;
+		}
+		else
+		{
+			data_readahead->window_size = data_readahead->maximum_size;
+		}
+	}
+	while( buffer_offset < buffer_size )
+	{
+		read_offset = offset + (off64_t) buffer_offset;
+		read_size   = buffer_size - buffer_offset;
+
+		if( ( data_readahead->size > 0 )
+		 && ( read_offset >= data_readahead->data_offset )
+		 && ( (size64_t) ( read_offset - data_readahead->data_offset ) < (size64_t) data_readahead->size ) )
+		{
+			if( read_size > ( data_readahead->size - (size_t) ( read_offset - data_readahead->data_offset ) ) )
+			{
+				read_size = data_readahead->size - (size_t) ( read_offset - data_readahead->data_offset );
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( data_readahead->data[ read_offset - data_readahead->data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy read-ahead data.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_offset += read_size;
+
+			continue;
+		}
+		if( read_size >= data_readahead->window_size )
+		{
+			/* Reads that are not sequential or do not fit in the window are read directly
+			 */
+			read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+			              data_segment_table,
+			              file_io_handle,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              read_offset,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 read_offset,
+				 read_offset );
+
+				return( -1 );
+			}
+			buffer_offset += (size_t) read_count;
+
+			break;
+		}
+		if( data_readahead->window_size > data_readahead->data_size )
+		{
+			reallocation = (uint8_t *) memory_reallocate(
+			                            data_readahead->data,
+			                            data_readahead->window_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize read-ahead data.",
+				 function );
+
+				return( -1 );
+			}
+			data_readahead->data      = reallocation;
+			data_readahead->data_size = data_readahead->window_size;
+		}
+		data_readahead->size = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading ahead %" PRIzd " bytes of data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 data_readahead->window_size,
+			 read_offset,
+			 read_offset );
+		}
+#endif
+		read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+		              data_segment_table,
+		              file_io_handle,
+		              data_readahead->data,
+		              data_readahead->window_size,
+		              read_offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ahead data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset,
+			 read_offset );
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		data_readahead->data_offset = read_offset;
+		data_readahead->size        = (size_t) read_count;
+
+		if( data_readahead->window_size < ( data_readahead->maximum_size / 2 ) )
+		{
+			data_readahead->window_size *= 2;
+		}
+		else
+		{
+			data_readahead->window_size = data_readahead->maximum_size;
+		}
+	}
+	data_readahead->next_offset = offset + (off64_t) buffer_offset;
+
+	return( (ssize_t) buffer_offset );
+}
+
@@ -0,0 +1,93 @@
+/*
+ * Data read-ahead functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_DATA_READAHEAD_H )
+#define _LIBFSNTFS_DATA_READAHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_data_segment_table.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_data_readahead libfsntfs_data_readahead_t;
+
+struct libfsntfs_data_readahead
+{
+	/* The maximum read-ahead size
+	 */
+	size_t maximum_size;
+
+	/* The read-ahead data
+	 */
+	uint8_t *data;
+
+	/* The read-ahead data size
+	 */
+	size_t data_size;
+
+	/* The offset of the read-ahead data in the data
+	 */
+	off64_t data_offset;
+
+	/* The read-ahead size, the number of bytes in the read-ahead data
+	 * that are in use
+	 */
+	size_t size;
+
+	/* The read-ahead window size, 0 if the reads are not sequential
+	 */
+	size_t window_size;
+
+	/* The offset directly after the previous read or -1 if not set
+	 */
+	off64_t next_offset;
+};
+
+int libfsntfs_data_readahead_initialize(
+     libfsntfs_data_readahead_t **data_readahead,
+     size_t maximum_size,
+     libcerror_error_t **error );
+
+int libfsntfs_data_readahead_free(
+     libfsntfs_data_readahead_t **data_readahead,
+     libcerror_error_t **error );
+
+ssize_t libfsntfs_data_readahead_read_buffer_at_offset(
+         libfsntfs_data_readahead_t *data_readahead,
+         libfsntfs_data_segment_table_t *data_segment_table,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_DATA_READAHEAD_H ) */
+
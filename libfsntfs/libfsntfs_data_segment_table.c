@@ -0,0 +1,1434 @@
+/*
+ * Data segment table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libfsntfs_data_run.h"
+#include "libfsntfs_data_segment_table.h"
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libfdata.h"
+#include "libfsntfs_mft_attribute.h"
+
+/* Creates a data segment table
+ * Make sure the value data_segment_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_data_segment_table_initialize(
+     libfsntfs_data_segment_table_t **data_segment_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_data_segment_table_initialize";
+
+	if( data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_segment_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data segment table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*data_segment_table = memory_allocate_structure(
+	                       libfsntfs_data_segment_table_t );
+
+	if( *data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data segment table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *data_segment_table,
+	     0,
+	     sizeof( libfsntfs_data_segment_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data segment table.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *data_segment_table != NULL )
+	{
+		memory_free(
+		 *data_segment_table );
+
+		*data_segment_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a data segment table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_data_segment_table_free(
+     libfsntfs_data_segment_table_t **data_segment_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_data_segment_table_free";
+
+	if( data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_segment_table != NULL )
+	{
+		/* The resident_data is referenced and freed elsewhere
+		 */
+		if( ( *data_segment_table )->segments != NULL )
+		{
+			memory_free(
+			 ( *data_segment_table )->segments );
+		}
+		memory_free(
+		 *data_segment_table );
+
+		*data_segment_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a segment
+ * The segment is stored directly after the previous segment in the data
+ * If the segment is stored directly after the previous segment in the volume,
+ * or both are sparse, the previous segment is extended instead, so that reads
+ * of consecutive data runs result in a single read
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_data_segment_table_append_segment(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     off64_t start_offset,
+     size64_t size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	libfsntfs_data_segment_t *segment  = NULL;
+	libfsntfs_data_segment_t *segments = NULL;
+	static char *function              = "libfsntfs_data_segment_table_append_segment";
+	off64_t data_offset                = 0;
+	size_t segments_size               = 0;
+	int number_of_allocated_segments   = 0;
+
+	if( data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid start offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_segment_table->number_of_segments > 0 )
+	{
+		segment = &( data_segment_table->segments[ data_segment_table->number_of_segments - 1 ] );
+
+		data_offset = segment->data_offset + (off64_t) segment->size;
+	}
+	if( (size64_t) data_offset > ( (size64_t) INT64_MAX - size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment != NULL )
+	 && ( segment->range_flags == range_flags ) )
+	{
+		if( ( ( range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+		 || ( ( segment->start_offset + (off64_t) segment->size ) == start_offset ) )
+		{
+			segment->size += size;
+
+			return( 1 );
+		}
+	}
+	if( data_segment_table->number_of_segments >= data_segment_table->number_of_allocated_segments )
+	{
+		if( data_segment_table->number_of_allocated_segments == 0 )
+		{
+			number_of_allocated_segments = 16;
+		}
+		else if( data_segment_table->number_of_allocated_segments < ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_segments = data_segment_table->number_of_allocated_segments * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of segments value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		segments_size = sizeof( libfsntfs_data_segment_t ) * (size_t) number_of_allocated_segments;
+
+		if( segments_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid segments size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		segments = (libfsntfs_data_segment_t *) memory_reallocate(
+		                                         data_segment_table->segments,
+		                                         segments_size );
+
+		if( segments == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segments.",
+			 function );
+
+			return( -1 );
+		}
+		data_segment_table->segments                     = segments;
+		data_segment_table->number_of_allocated_segments = number_of_allocated_segments;
+	}
+	segment = &( data_segment_table->segments[ data_segment_table->number_of_segments ] );
+
+	segment->data_offset  = data_offset;
+	segment->start_offset = start_offset;
+	segment->size         = size;
+	segment->range_flags  = range_flags;
+
+	data_segment_table->number_of_segments += 1;
+
+	return( 1 );
+}
+
+/* Reads the data segment table from a data attribute
+ * The segments correspond to those of the cluster block stream, hence
+ * the data beyond the valid data size is stored as a sparse segment
+ * Returns 1 if successful, 0 if the attribute data is not supported or -1 on error
+ */
+int libfsntfs_data_segment_table_read_data_attribute(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     libfsntfs_mft_attribute_t *data_attribute,
+     libcerror_error_t **error )
+{
+	libfsntfs_data_run_t *data_run = NULL;
+	uint8_t *resident_data         = NULL;
+	static char *function          = "libfsntfs_data_segment_table_read_data_attribute";
+	size64_t data_segment_size     = 0;
+	size64_t data_size             = 0;
+	size64_t valid_data_size       = 0;
+	size_t resident_data_size      = 0;
+	off64_t data_segment_offset    = 0;
+	uint16_t attribute_data_flags  = 0;
+	int attribute_index            = 0;
+	int data_run_index             = 0;
+	int number_of_data_runs        = 0;
+	int result                     = 0;
+
+	if( data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_segment_table->number_of_segments != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data segment table - segments already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_attribute_get_data_size(
+	     data_attribute,
+	     &data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_mft_attribute_data_is_resident(
+	          data_attribute,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if attribute data is resident.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_mft_attribute_get_resident_data(
+		     data_attribute,
+		     &resident_data,
+		     &resident_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve resident data from attribute.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( resident_data != NULL )
+	 || ( data_size == 0 ) )
+	{
+		if( data_size != (size64_t) resident_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: unuspported data size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		data_segment_table->resident_data = resident_data;
+		data_segment_table->data_size     = data_size;
+
+		return( 1 );
+	}
+	if( libfsntfs_mft_attribute_get_data_flags(
+	     data_attribute,
+	     &attribute_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attribute data flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( attribute_data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_mft_attribute_get_valid_data_size(
+	     data_attribute,
+	     &valid_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve valid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( valid_data_size > 0 )
+	{
+		while( data_attribute != NULL )
+		{
+			if( libfsntfs_mft_attribute_get_number_of_data_runs(
+			     data_attribute,
+			     &number_of_data_runs,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute: %d number of data runs.",
+				 function,
+				 attribute_index );
+
+				return( -1 );
+			}
+			for( data_run_index = 0;
+			     data_run_index < number_of_data_runs;
+			     data_run_index++ )
+			{
+				if( libfsntfs_mft_attribute_get_data_run_by_index(
+				     data_attribute,
+				     data_run_index,
+				     &data_run,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve attribute: %d data run: %d.",
+					 function,
+					 attribute_index,
+					 data_run_index );
+
+					return( -1 );
+				}
+				if( data_run == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing attribute: %d data run: %d.",
+					 function,
+					 attribute_index,
+					 data_run_index );
+
+					return( -1 );
+				}
+				if( data_run->size > ( valid_data_size - data_segment_offset ) )
+				{
+					data_segment_size = valid_data_size - data_segment_offset;
+				}
+				else
+				{
+					data_segment_size = data_run->size;
+				}
+				if( libfsntfs_data_segment_table_append_segment(
+				     data_segment_table,
+				     data_run->start_offset,
+				     data_segment_size,
+				     data_run->range_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append attribute: %d data run: %d segment.",
+					 function,
+					 attribute_index,
+					 data_run_index );
+
+					return( -1 );
+				}
+				data_segment_offset += data_segment_size;
+
+				if( (size64_t) data_segment_offset >= valid_data_size )
+				{
+					break;
+				}
+			}
+			attribute_index++;
+
+			if( libfsntfs_mft_attribute_get_next_attribute(
+			     data_attribute,
+			     &data_attribute,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next MFT attribute: %d.",
+				 function,
+				 attribute_index );
+
+				return( -1 );
+			}
+		}
+	}
+	if( (size64_t) data_segment_offset < data_size )
+	{
+		if( libfsntfs_data_segment_table_append_segment(
+		     data_segment_table,
+		     0,
+		     data_size - data_segment_offset,
+		     LIBFDATA_RANGE_FLAG_IS_SPARSE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append sparse segment.",
+			 function );
+
+			return( -1 );
+		}
+		data_segment_offset = (off64_t) data_size;
+	}
+	data_segment_table->data_size = (size64_t) data_segment_offset;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the segment that contains a specific offset
+ * Returns 1 if successful, 0 if no such segment or -1 on error
+ */
+int libfsntfs_data_segment_table_get_segment_index_at_offset(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     off64_t offset,
+     int *segment_index,
+     libcerror_error_t **error )
+{
+	libfsntfs_data_segment_t *segment = NULL;
+	static char *function             = "libfsntfs_data_segment_table_get_segment_index_at_offset";
+	int lower_segment_index           = 0;
+	int middle_segment_index          = 0;
+	int upper_segment_index           = 0;
+
+	if( data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		return( 0 );
+	}
+	upper_segment_index = data_segment_table->number_of_segments;
+
+	while( lower_segment_index < upper_segment_index )
+	{
+		middle_segment_index = lower_segment_index + ( ( upper_segment_index - lower_segment_index ) / 2 );
+
+		segment = &( data_segment_table->segments[ middle_segment_index ] );
+
+		if( offset < segment->data_offset )
+		{
+			upper_segment_index = middle_segment_index;
+		}
+		else if( ( offset - segment->data_offset ) >= (off64_t) segment->size )
+		{
+			lower_segment_index = middle_segment_index + 1;
+		}
+		else
+		{
+			*segment_index = middle_segment_index;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the next range of data at or after a specific offset
+ * Sparse segments are skipped and consecutive non-sparse segments are merged
+ * into a single range, so that callers can skip holes in the data
+ * Returns 1 if successful, 0 if there is no data at or after the offset or -1 on error
+ */
+int libfsntfs_data_segment_table_get_next_data_range(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_data_segment_t *segment = NULL;
+	static char *function             = "libfsntfs_data_segment_table_get_next_data_range";
+	off64_t safe_range_offset         = 0;
+	off64_t range_end_offset          = 0;
+	int result                        = 0;
+	int segment_index                 = 0;
+
+	if( data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= data_segment_table->data_size )
+	{
+		return( 0 );
+	}
+	if( data_segment_table->resident_data != NULL )
+	{
+		*range_offset = offset;
+		*range_size   = data_segment_table->data_size - (size64_t) offset;
+
+		return( 1 );
+	}
+	result = libfsntfs_data_segment_table_get_segment_index_at_offset(
+	          data_segment_table,
+	          offset,
+	          &segment_index,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	while( segment_index < data_segment_table->number_of_segments )
+	{
+		segment = &( data_segment_table->segments[ segment_index ] );
+
+		if( ( segment->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) == 0 )
+		{
+			break;
+		}
+		segment_index++;
+	}
+	if( segment_index >= data_segment_table->number_of_segments )
+	{
+		return( 0 );
+	}
+	safe_range_offset = segment->data_offset;
+
+	if( safe_range_offset < offset )
+	{
+		safe_range_offset = offset;
+	}
+	while( segment_index < data_segment_table->number_of_segments )
+	{
+		segment = &( data_segment_table->segments[ segment_index ] );
+
+		if( ( segment->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			break;
+		}
+		range_end_offset = segment->data_offset + (off64_t) segment->size;
+
+		segment_index++;
+	}
+	*range_offset = safe_range_offset;
+	*range_size   = (size64_t) ( range_end_offset - safe_range_offset );
+
+	return( 1 );
+}
+
+/* Reads data at a specific offset
+ * This function does not maintain a current offset and only reads the table,
+ * hence it can be called concurrently as long as the file IO handle supports
+ * concurrent reads at an offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_data_segment_table_read_buffer_at_offset(
+         libfsntfs_data_segment_table_t *data_segment_table,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfsntfs_data_segment_t *segment = NULL;
+	static char *function             = "libfsntfs_data_segment_table_read_buffer_at_offset";
+	size64_t segment_relative_offset  = 0;
+	size_t buffer_offset              = 0;
+	size_t read_size                  = 0;
+	ssize_t read_count                = 0;
+	int result                        = 0;
+	int segment_index                 = 0;
+
+	if( data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= data_segment_table->data_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) buffer_size > ( data_segment_table->data_size - offset ) )
+	{
+		buffer_size = (size_t) ( data_segment_table->data_size - offset );
+	}
+	if( data_segment_table->resident_data != NULL )
+	{
+		if( memory_copy(
+		     buffer,
+		     &( data_segment_table->resident_data[ offset ] ),
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy resident data.",
+			 function );
+
+			return( -1 );
+		}
+		return( (ssize_t) buffer_size );
+	}
+	result = libfsntfs_data_segment_table_get_segment_index_at_offset(
+	          data_segment_table,
+	          offset,
+	          &segment_index,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	segment_relative_offset = (size64_t) ( offset - data_segment_table->segments[ segment_index ].data_offset );
+
+	while( buffer_offset < buffer_size )
+	{
+		if( segment_index >= data_segment_table->number_of_segments )
+		{
+			break;
+		}
+		segment = &( data_segment_table->segments[ segment_index ] );
+
+		read_size = buffer_size - buffer_offset;
+
+		if( (size64_t) read_size > ( segment->size - segment_relative_offset ) )
+		{
+			read_size = (size_t) ( segment->size - segment_relative_offset );
+		}
+		if( ( segment->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			if( memory_set(
+			     &( buffer[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              segment->start_offset + (off64_t) segment_relative_offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 segment_index,
+				 segment->start_offset + (off64_t) segment_relative_offset,
+				 segment->start_offset + (off64_t) segment_relative_offset );
+
+				return( -1 );
+			}
+		}
+		buffer_offset          += read_size;
+		segment_relative_offset = 0;
+
+		segment_index++;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Compares two data segment ranges by their start offset
+ * Callback for qsort
+ * Returns -1 if the first range starts before the second, 1 if after or 0 if equal
+ */
+int libfsntfs_data_segment_range_compare_by_start_offset(
+     const void *first_data_segment_range,
+     const void *second_data_segment_range )
+{
+	off64_t first_start_offset  = ( (const libfsntfs_data_segment_range_t *) first_data_segment_range )->start_offset;
+	off64_t second_start_offset = ( (const libfsntfs_data_segment_range_t *) second_data_segment_range )->start_offset;
+
+	if( first_start_offset < second_start_offset )
+	{
+		return( -1 );
+	}
+	else if( first_start_offset > second_start_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads multiple ranges of data
+ * The ranges are mapped onto the volume and read in the order they are stored
+ * in the volume. Neighbouring or overlapping ranges are read using a single read
+ * up to LIBFSNTFS_MAXIMUM_READ_RANGES_MERGE_SIZE. Sparse and resident data is
+ * copied without reading. The number of bytes read per range is stored in
+ * range_read_counts, which is less than the requested size at the end of the data
+ * This function does not maintain a current offset and only reads the table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_data_segment_table_read_ranges(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     libbfio_handle_t *file_io_handle,
+     const off64_t *range_offsets,
+     const size_t *range_sizes,
+     uint8_t **range_buffers,
+     ssize_t *range_read_counts,
+     int number_of_ranges,
+     libcerror_error_t **error )
+{
+	libfsntfs_data_segment_range_t *data_segment_range  = NULL;
+	libfsntfs_data_segment_range_t *data_segment_ranges = NULL;
+	libfsntfs_data_segment_t *segment                   = NULL;
+	uint8_t *merge_buffer                               = NULL;
+	void *reallocation                                  = NULL;
+	static char *function                               = "libfsntfs_data_segment_table_read_ranges";
+	size64_t segment_relative_offset                    = 0;
+	size_t buffer_offset                                = 0;
+	size_t merge_buffer_size                            = 0;
+	size_t merge_size                                   = 0;
+	size_t range_size                                   = 0;
+	size_t read_size                                    = 0;
+	ssize_t read_count                                  = 0;
+	off64_t merge_end_offset                            = 0;
+	off64_t merge_start_offset                          = 0;
+	off64_t range_end_offset                            = 0;
+	off64_t range_offset                                = 0;
+	int data_segment_range_index                        = 0;
+	int first_data_segment_range_index                  = 0;
+	int number_of_allocated_data_segment_ranges         = 0;
+	int number_of_data_segment_ranges                   = 0;
+	int range_index                                     = 0;
+	int segment_index                                   = 0;
+
+	if( data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == 0 )
+	{
+		return( 1 );
+	}
+	if( range_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range read counts.",
+		 function );
+
+		return( -1 );
+	}
+	/* Map the ranges onto the volume, sparse and resident data is copied directly
+	 */
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		range_offset = range_offsets[ range_index ];
+		range_size   = range_sizes[ range_index ];
+
+		if( range_buffers[ range_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid range: %d buffer.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		if( range_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid range: %d size value exceeds maximum.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		if( range_offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range: %d offset value out of bounds.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		if( (size64_t) range_offset >= data_segment_table->data_size )
+		{
+			range_size = 0;
+		}
+		else if( (size64_t) range_size > ( data_segment_table->data_size - range_offset ) )
+		{
+			range_size = (size_t) ( data_segment_table->data_size - range_offset );
+		}
+		range_read_counts[ range_index ] = (ssize_t) range_size;
+
+		if( range_size == 0 )
+		{
+			continue;
+		}
+		if( data_segment_table->resident_data != NULL )
+		{
+			if( memory_copy(
+			     range_buffers[ range_index ],
+			     &( data_segment_table->resident_data[ range_offset ] ),
+			     range_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy resident data.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( libfsntfs_data_segment_table_get_segment_index_at_offset(
+		     data_segment_table,
+		     range_offset,
+		     &segment_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 range_offset,
+			 range_offset );
+
+			goto on_error;
+		}
+		segment_relative_offset = (size64_t) ( range_offset - data_segment_table->segments[ segment_index ].data_offset );
+		buffer_offset           = 0;
+
+		while( ( buffer_offset < range_size )
+		    && ( segment_index < data_segment_table->number_of_segments ) )
+		{
+			segment = &( data_segment_table->segments[ segment_index ] );
+
+			read_size = range_size - buffer_offset;
+
+			if( (size64_t) read_size > ( segment->size - segment_relative_offset ) )
+			{
+				read_size = (size_t) ( segment->size - segment_relative_offset );
+			}
+			if( ( segment->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+			{
+				if( memory_set(
+				     &( ( range_buffers[ range_index ] )[ buffer_offset ] ),
+				     0,
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear range: %d buffer.",
+					 function,
+					 range_index );
+
+					goto on_error;
+				}
+			}
+			else if( read_size > 0 )
+			{
+				if( number_of_data_segment_ranges >= number_of_allocated_data_segment_ranges )
+				{
+					if( number_of_allocated_data_segment_ranges == 0 )
+					{
+						number_of_allocated_data_segment_ranges = number_of_ranges;
+					}
+					else if( number_of_allocated_data_segment_ranges < ( INT_MAX / 2 ) )
+					{
+						number_of_allocated_data_segment_ranges *= 2;
+					}
+					else
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+						 "%s: invalid number of data segment ranges value out of bounds.",
+						 function );
+
+						goto on_error;
+					}
+					if( (size_t) number_of_allocated_data_segment_ranges > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsntfs_data_segment_range_t ) ) )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+						 "%s: invalid number of data segment ranges value exceeds maximum.",
+						 function );
+
+						goto on_error;
+					}
+					reallocation = memory_reallocate(
+					                data_segment_ranges,
+					                sizeof( libfsntfs_data_segment_range_t ) * (size_t) number_of_allocated_data_segment_ranges );
+
+					if( reallocation == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to resize data segment ranges.",
+						 function );
+
+						goto on_error;
+					}
+					data_segment_ranges = (libfsntfs_data_segment_range_t *) reallocation;
+				}
+				data_segment_range = &( data_segment_ranges[ number_of_data_segment_ranges++ ] );
+
+				data_segment_range->start_offset = segment->start_offset + (off64_t) segment_relative_offset;
+				data_segment_range->size         = read_size;
+				data_segment_range->buffer       = &( ( range_buffers[ range_index ] )[ buffer_offset ] );
+			}
+			buffer_offset          += read_size;
+			segment_relative_offset = 0;
+
+			segment_index++;
+		}
+	}
+	if( number_of_data_segment_ranges > 1 )
+	{
+		qsort(
+		 data_segment_ranges,
+		 (size_t) number_of_data_segment_ranges,
+		 sizeof( libfsntfs_data_segment_range_t ),
+		 &libfsntfs_data_segment_range_compare_by_start_offset );
+	}
+	/* Read neighbouring or overlapping ranges using a single read
+	 */
+	data_segment_range_index = 0;
+
+	while( data_segment_range_index < number_of_data_segment_ranges )
+	{
+		first_data_segment_range_index = data_segment_range_index;
+
+		data_segment_range = &( data_segment_ranges[ data_segment_range_index++ ] );
+
+		merge_start_offset = data_segment_range->start_offset;
+		merge_end_offset   = merge_start_offset + (off64_t) data_segment_range->size;
+
+		while( data_segment_range_index < number_of_data_segment_ranges )
+		{
+			data_segment_range = &( data_segment_ranges[ data_segment_range_index ] );
+
+			if( data_segment_range->start_offset > merge_end_offset )
+			{
+				break;
+			}
+			range_end_offset = data_segment_range->start_offset + (off64_t) data_segment_range->size;
+
+			if( range_end_offset < merge_end_offset )
+			{
+				range_end_offset = merge_end_offset;
+			}
+			if( (size64_t) ( range_end_offset - merge_start_offset ) > (size64_t) LIBFSNTFS_MAXIMUM_READ_RANGES_MERGE_SIZE )
+			{
+				break;
+			}
+			merge_end_offset = range_end_offset;
+
+			data_segment_range_index++;
+		}
+		merge_size = (size_t) ( merge_end_offset - merge_start_offset );
+
+		if( ( data_segment_range_index - first_data_segment_range_index ) == 1 )
+		{
+			data_segment_range = &( data_segment_ranges[ first_data_segment_range_index ] );
+
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              data_segment_range->buffer,
+			              data_segment_range->size,
+			              data_segment_range->start_offset,
+			              error );
+
+			if( read_count != (ssize_t) data_segment_range->size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 data_segment_range->start_offset,
+				 data_segment_range->start_offset );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( merge_size > merge_buffer_size )
+		{
+			reallocation = memory_reallocate(
+			                merge_buffer,
+			                sizeof( uint8_t ) * merge_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize merge buffer.",
+				 function );
+
+				goto on_error;
+			}
+			merge_buffer      = (uint8_t *) reallocation;
+			merge_buffer_size = merge_size;
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              merge_buffer,
+		              merge_size,
+		              merge_start_offset,
+		              error );
+
+		if( read_count != (ssize_t) merge_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read merged ranges at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 merge_start_offset,
+			 merge_start_offset );
+
+			goto on_error;
+		}
+		while( first_data_segment_range_index < data_segment_range_index )
+		{
+			data_segment_range = &( data_segment_ranges[ first_data_segment_range_index++ ] );
+
+			if( memory_copy(
+			     data_segment_range->buffer,
+			     &( merge_buffer[ data_segment_range->start_offset - merge_start_offset ] ),
+			     data_segment_range->size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy merged range data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( merge_buffer != NULL )
+	{
+		memory_free(
+		 merge_buffer );
+	}
+	if( data_segment_ranges != NULL )
+	{
+		memory_free(
+		 data_segment_ranges );
+	}
+	return( 1 );
+
+on_error:
+	if( merge_buffer != NULL )
+	{
+		memory_free(
+		 merge_buffer );
+	}
+	if( data_segment_ranges != NULL )
+	{
+		memory_free(
+		 data_segment_ranges );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,160 @@
+/*
+ * Data segment table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_DATA_SEGMENT_TABLE_H )
+#define _LIBFSNTFS_DATA_SEGMENT_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_mft_attribute.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_data_segment libfsntfs_data_segment_t;
+
+struct libfsntfs_data_segment
+{
+	/* The offset of the segment in the data
+	 */
+	off64_t data_offset;
+
+	/* The start offset of the segment in the volume
+	 */
+	off64_t start_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The range flags
+	 */
+	uint32_t range_flags;
+};
+
+typedef struct libfsntfs_data_segment_range libfsntfs_data_segment_range_t;
+
+struct libfsntfs_data_segment_range
+{
+	/* The start offset of the range in the volume
+	 */
+	off64_t start_offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The buffer the range is read into
+	 */
+	uint8_t *buffer;
+};
+
+typedef struct libfsntfs_data_segment_table libfsntfs_data_segment_table_t;
+
+struct libfsntfs_data_segment_table
+{
+	/* The data size
+	 */
+	size64_t data_size;
+
+	/* The resident data
+	 * Refers to the data of the MFT attribute and is not owned by the table
+	 */
+	const uint8_t *resident_data;
+
+	/* The segments
+	 */
+	libfsntfs_data_segment_t *segments;
+
+	/* The number of segments
+	 */
+	int number_of_segments;
+
+	/* The number of allocated segments
+	 */
+	int number_of_allocated_segments;
+};
+
+int libfsntfs_data_segment_table_initialize(
+     libfsntfs_data_segment_table_t **data_segment_table,
+     libcerror_error_t **error );
+
+int libfsntfs_data_segment_table_free(
+     libfsntfs_data_segment_table_t **data_segment_table,
+     libcerror_error_t **error );
+
+int libfsntfs_data_segment_table_append_segment(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     off64_t start_offset,
+     size64_t size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libfsntfs_data_segment_table_read_data_attribute(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     libfsntfs_mft_attribute_t *data_attribute,
+     libcerror_error_t **error );
+
+int libfsntfs_data_segment_table_get_segment_index_at_offset(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     off64_t offset,
+     int *segment_index,
+     libcerror_error_t **error );
+
+int libfsntfs_data_segment_table_get_next_data_range(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+ssize_t libfsntfs_data_segment_table_read_buffer_at_offset(
+         libfsntfs_data_segment_table_t *data_segment_table,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libfsntfs_data_segment_range_compare_by_start_offset(
+     const void *first_data_segment_range,
+     const void *second_data_segment_range );
+
+int libfsntfs_data_segment_table_read_ranges(
+     libfsntfs_data_segment_table_t *data_segment_table,
+     libbfio_handle_t *file_io_handle,
+     const off64_t *range_offsets,
+     const size_t *range_sizes,
+     uint8_t **range_buffers,
+     ssize_t *range_read_counts,
+     int number_of_ranges,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_DATA_SEGMENT_TABLE_H ) */
+
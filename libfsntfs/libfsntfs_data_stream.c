@@ -24,8 +24,11 @@
 #include <types.h>
 
 #include "libfsntfs_attribute.h"
+#include "libfsntfs_async_reader.h"
 #include "libfsntfs_cluster_block_stream.h"
 #include "libfsntfs_data_extent.h"
+#include "libfsntfs_data_readahead.h"
+#include "libfsntfs_data_segment_table.h"
 #include "libfsntfs_data_stream.h"
 #include "libfsntfs_definitions.h"
 #include "libfsntfs_io_handle.h"
@@ -50,6 +53,7 @@ int libfsntfs_data_stream_initialize(
 {
 	libfsntfs_internal_data_stream_t *internal_data_stream = NULL;
 	static char *function                                  = "libfsntfs_data_stream_initialize";
+	int result                                             = 0;
 
 	if( data_stream == NULL )
 	{
@@ -147,6 +151,70 @@ int libfsntfs_data_stream_initialize(
 
 		goto on_error;
 	}
+	if( libfsntfs_data_segment_table_initialize(
+	     &( internal_data_stream->data_segment_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data segment table.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsntfs_data_segment_table_read_data_attribute(
+	          internal_data_stream->data_segment_table,
+	          data_attribute,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data segment table.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		/* Compressed data is read using the data cluster block stream
+		 */
+		if( libfsntfs_data_segment_table_free(
+		     &( internal_data_stream->data_segment_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data segment table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( io_handle->data_readahead_size > 0 )
+	{
+		if( libfsntfs_data_readahead_initialize(
+		     &( internal_data_stream->data_readahead ),
+		     io_handle->data_readahead_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data read-ahead.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
 	     &( internal_data_stream->read_write_lock ),
@@ -163,6 +231,7 @@ int libfsntfs_data_stream_initialize(
 	}
 #endif
 	internal_data_stream->file_io_handle = file_io_handle;
+	internal_data_stream->async_reader   = io_handle->async_reader;
 	internal_data_stream->data_attribute = data_attribute;
 
 	*data_stream = (libfsntfs_data_stream_t *) internal_data_stream;
@@ -178,6 +247,18 @@ on_error:
 			 &( internal_data_stream->data_cluster_block_stream ),
 			 NULL );
 		}
+		if( internal_data_stream->data_readahead != NULL )
+		{
+			libfsntfs_data_readahead_free(
+			 &( internal_data_stream->data_readahead ),
+			 NULL );
+		}
+		if( internal_data_stream->data_segment_table != NULL )
+		{
+			libfsntfs_data_segment_table_free(
+			 &( internal_data_stream->data_segment_table ),
+			 NULL );
+		}
 		if( internal_data_stream->extents_array != NULL )
 		{
 			libcdata_array_free(
@@ -251,6 +332,38 @@ int libfsntfs_data_stream_free(
 				result = -1;
 			}
 		}
+		if( internal_data_stream->data_segment_table != NULL )
+		{
+			if( libfsntfs_data_segment_table_free(
+			     &( internal_data_stream->data_segment_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data segment table.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_data_stream->data_readahead != NULL )
+		{
+			if( libfsntfs_data_readahead_free(
+			     &( internal_data_stream->data_readahead ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data read-ahead.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libcdata_array_free(
 		     &( internal_data_stream->extents_array ),
 		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_data_extent_free,
@@ -567,6 +680,108 @@ int libfsntfs_data_stream_get_utf16_name(
 	return( result );
 }
 
+/* Reads data at a specific offset and sets the current offset to the end of the data read
+ * Uncompressed data is read using the data segment table, where sequential reads
+ * are read ahead
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_internal_data_stream_read_buffer_at_offset(
+         libfsntfs_internal_data_stream_t *internal_data_stream,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_internal_data_stream_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( internal_data_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_stream->data_segment_table == NULL )
+	{
+		read_count = libfdata_stream_read_buffer_at_offset(
+		              internal_data_stream->data_cluster_block_stream,
+		              (intptr_t *) internal_data_stream->file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              0,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from data cluster block stream.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	if( internal_data_stream->data_readahead != NULL )
+	{
+		read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+		              internal_data_stream->data_readahead,
+		              internal_data_stream->data_segment_table,
+		              internal_data_stream->file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+	}
+	else
+	{
+		read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+		              internal_data_stream->data_segment_table,
+		              internal_data_stream->file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+	}
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data cluster block stream maintains the current offset
+	 */
+	if( libfdata_stream_seek_offset(
+	     internal_data_stream->data_cluster_block_stream,
+	     offset + (off64_t) read_count,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in data cluster block stream.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
 /* Reads data at the current offset
  * Returns the number of bytes read or -1 on error
  */
@@ -578,6 +793,7 @@ ssize_t libfsntfs_data_stream_read_buffer(
 {
 	libfsntfs_internal_data_stream_t *internal_data_stream = NULL;
 	static char *function                                  = "libfsntfs_data_stream_read_buffer";
+	off64_t current_offset                                 = 0;
 	ssize_t read_count                                     = 0;
 
 	if( data_stream == NULL )
@@ -608,25 +824,41 @@ ssize_t libfsntfs_data_stream_read_buffer(
 		return( -1 );
 	}
 #endif
-	read_count = libfdata_stream_read_buffer(
-	              internal_data_stream->data_cluster_block_stream,
-	              (intptr_t *) internal_data_stream->file_io_handle,
-	              buffer,
-	              buffer_size,
-	              0,
-	              error );
-
-	if( read_count < 0 )
+	if( libfdata_stream_get_offset(
+	     internal_data_stream->data_cluster_block_stream,
+	     &current_offset,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from data cluster block stream.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current offset from data cluster block stream.",
 		 function );
 
 		read_count = -1;
 	}
+	else
+	{
+		read_count = libfsntfs_internal_data_stream_read_buffer_at_offset(
+		              internal_data_stream,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              current_offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from data stream.",
+			 function );
+
+			read_count = -1;
+		}
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_data_stream->read_write_lock,
@@ -687,13 +919,11 @@ ssize_t libfsntfs_data_stream_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	read_count = libfdata_stream_read_buffer_at_offset(
-	              internal_data_stream->data_cluster_block_stream,
-	              (intptr_t *) internal_data_stream->file_io_handle,
-	              buffer,
+	read_count = libfsntfs_internal_data_stream_read_buffer_at_offset(
+	              internal_data_stream,
+	              (uint8_t *) buffer,
 	              buffer_size,
 	              offset,
-	              0,
 	              error );
 
 	if( read_count < 0 )
@@ -702,11 +932,336 @@ ssize_t libfsntfs_data_stream_read_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from data cluster block stream.",
+		 "%s: unable to read buffer from data stream.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads multiple ranges of data from the data stream
+ * The ranges are read in the order they are stored in the volume, where neighbouring
+ * ranges are read using a single read. The number of bytes read per range is stored
+ * in range_read_counts. The current offset is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_data_stream_read_ranges(
+     libfsntfs_data_stream_t *data_stream,
+     const off64_t *range_offsets,
+     const size_t *range_sizes,
+     uint8_t **range_buffers,
+     ssize_t *range_read_counts,
+     int number_of_ranges,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_data_stream_t *internal_data_stream = NULL;
+	static char *function                                  = "libfsntfs_data_stream_read_ranges";
+	int result                                             = 0;
+
+	if( data_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_stream = (libfsntfs_internal_data_stream_t *) data_stream;
+
+	if( internal_data_stream->data_attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data stream - missing data attribute.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_stream->data_segment_table != NULL )
+	{
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_data_stream->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		result = libfsntfs_data_segment_table_read_ranges(
+		          internal_data_stream->data_segment_table,
+		          internal_data_stream->file_io_handle,
+		          range_offsets,
+		          range_sizes,
+		          range_buffers,
+		          range_read_counts,
+		          number_of_ranges,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ranges from data segment table.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_data_stream->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		return( result );
+	}
+	/* Compressed data is read using the data cluster block stream
+	 */
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_cluster_block_stream_read_ranges(
+	          internal_data_stream->data_cluster_block_stream,
+	          internal_data_stream->file_io_handle,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          number_of_ranges,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read ranges from data cluster block stream.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads data at a specific offset using a specific file IO handle
+ * The current offset is not changed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_internal_data_stream_pread_buffer(
+         libfsntfs_internal_data_stream_t *internal_data_stream,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function  = "libfsntfs_internal_data_stream_pread_buffer";
+	off64_t current_offset = 0;
+	ssize_t read_count     = 0;
+
+	if( internal_data_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data stream.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data segment table is not changed after the data stream was created
+	 * hence a read lock suffices
+	 */
+	if( internal_data_stream->data_segment_table != NULL )
+	{
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_data_stream->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+		              internal_data_stream->data_segment_table,
+		              file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from data segment table.",
+			 function );
+
+			read_count = -1;
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_data_stream->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		return( read_count );
+	}
+	/* Compressed data is read using the data cluster block stream
+	 * after which its current offset is restored
+	 */
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfdata_stream_get_offset(
+	     internal_data_stream->data_cluster_block_stream,
+	     &current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current offset from data cluster block stream.",
 		 function );
 
 		read_count = -1;
 	}
+	else
+	{
+		read_count = libfdata_stream_read_buffer_at_offset(
+		              internal_data_stream->data_cluster_block_stream,
+		              (intptr_t *) file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              0,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from data cluster block stream.",
+			 function );
+
+			read_count = -1;
+		}
+		if( libfdata_stream_seek_offset(
+		     internal_data_stream->data_cluster_block_stream,
+		     current_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to restore current offset of data cluster block stream.",
+			 function );
+
+			read_count = -1;
+		}
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_data_stream->read_write_lock,
@@ -725,6 +1280,83 @@ ssize_t libfsntfs_data_stream_read_buffer_at_offset(
 	return( read_count );
 }
 
+/* Reads data at a specific offset asynchronously
+ * The read is performed by a thread of the asynchronous reader of the volume,
+ * after which the callback function is called on that thread with the number
+ * of bytes read, or -1 and the error if the read failed. The error is freed
+ * after the callback function returns. The current offset is not changed
+ * The data stream and buffer must remain valid until the callback function was called
+ * Changing the number of threads and closing the volume wait for the asynchronous
+ * read threads to stop, hence the callback function must not change the number of
+ * asynchronous read threads of the volume or close the volume
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_data_stream_read_buffer_at_offset_async(
+     libfsntfs_data_stream_t *data_stream,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+             libfsntfs_data_stream_t *data_stream,
+             void *buffer,
+             ssize_t read_count,
+             off64_t offset,
+             libcerror_error_t *error,
+             void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_data_stream_t *internal_data_stream = NULL;
+	static char *function                                  = "libfsntfs_data_stream_read_buffer_at_offset_async";
+
+	if( data_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_stream = (libfsntfs_internal_data_stream_t *) data_stream;
+
+	if( internal_data_stream->async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data stream - missing asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_async_reader_submit_read(
+	     internal_data_stream->async_reader,
+	     (intptr_t *) internal_data_stream,
+	     internal_data_stream->file_io_handle,
+	     (ssize_t (*)(intptr_t *, libbfio_handle_t *, uint8_t *, size_t, off64_t, libcerror_error_t **)) &libfsntfs_internal_data_stream_pread_buffer,
+	     (uint8_t *) buffer,
+	     buffer_size,
+	     offset,
+	     (void (*)(intptr_t *, uint8_t *, ssize_t, off64_t, libcerror_error_t *, void *)) callback_function,
+	     user_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to submit asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Seeks a certain offset
  * Returns the offset if seek is successful or -1 on error
  */
@@ -944,6 +1576,146 @@ int libfsntfs_data_stream_get_size(
 	return( result );
 }
 
+/* Retrieves the next range of data at or after a specific offset
+ * Sparse regions are skipped, so that the data can be read without the holes,
+ * similar to SEEK_DATA and SEEK_HOLE. For compressed data holes are not
+ * detected and the remainder of the data is returned as a single range
+ * Returns 1 if successful, 0 if there is no data at or after the offset or -1 on error
+ */
+int libfsntfs_data_stream_get_next_data_range(
+     libfsntfs_data_stream_t *data_stream,
+     off64_t offset,
+     off64_t *data_range_offset,
+     size64_t *data_range_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_data_stream_t *internal_data_stream = NULL;
+	static char *function                                  = "libfsntfs_data_stream_get_next_data_range";
+	size64_t data_size                                     = 0;
+	int result                                             = 0;
+
+	if( data_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_stream = (libfsntfs_internal_data_stream_t *) data_stream;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data range size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_data_stream->data_segment_table != NULL )
+	{
+		result = libfsntfs_data_segment_table_get_next_data_range(
+		          internal_data_stream->data_segment_table,
+		          offset,
+		          data_range_offset,
+		          data_range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next data range from data segment table.",
+			 function );
+		}
+	}
+	else if( internal_data_stream->data_cluster_block_stream != NULL )
+	{
+		if( libfdata_stream_get_size(
+		     internal_data_stream->data_cluster_block_stream,
+		     &data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data attribute data size.",
+			 function );
+
+			result = -1;
+		}
+		else if( (size64_t) offset < data_size )
+		{
+			*data_range_offset = offset;
+			*data_range_size   = data_size - (size64_t) offset;
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Retrieves the number of extents (decoded data runs)
  * Returns 1 if successful or -1 on error
  */
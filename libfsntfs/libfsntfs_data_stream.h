@@ -25,8 +25,11 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_async_reader.h"
 #include "libfsntfs_extern.h"
 #include "libfsntfs_io_handle.h"
+#include "libfsntfs_data_readahead.h"
+#include "libfsntfs_data_segment_table.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
@@ -47,6 +50,10 @@ struct libfsntfs_internal_data_stream
 	 */
 	libbfio_handle_t *file_io_handle;
 
+	/* The asynchronous reader, owned by the IO handle
+	 */
+	libfsntfs_async_reader_t *async_reader;
+
 	/* The $DATA attribute
 	 */
 	libfsntfs_mft_attribute_t *data_attribute;
@@ -59,6 +66,16 @@ struct libfsntfs_internal_data_stream
 	 */
 	libfdata_stream_t *data_cluster_block_stream;
 
+	/* The $DATA attribute segment table
+	 * Used to read the data without a current offset, not set for compressed data
+	 */
+	libfsntfs_data_segment_table_t *data_segment_table;
+
+	/* The $DATA attribute read-ahead
+	 * Used for sequential reads using the data segment table
+	 */
+	libfsntfs_data_readahead_t *data_readahead;
+
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -104,6 +121,13 @@ int libfsntfs_data_stream_get_utf16_name(
      size_t utf16_string_size,
      libcerror_error_t **error );
 
+ssize_t libfsntfs_internal_data_stream_read_buffer_at_offset(
+         libfsntfs_internal_data_stream_t *internal_data_stream,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 ssize_t libfsntfs_data_stream_read_buffer(
          libfsntfs_data_stream_t *data_stream,
@@ -119,6 +143,40 @@ ssize_t libfsntfs_data_stream_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_data_stream_read_ranges(
+     libfsntfs_data_stream_t *data_stream,
+     const off64_t *range_offsets,
+     const size_t *range_sizes,
+     uint8_t **range_buffers,
+     ssize_t *range_read_counts,
+     int number_of_ranges,
+     libcerror_error_t **error );
+
+ssize_t libfsntfs_internal_data_stream_pread_buffer(
+         libfsntfs_internal_data_stream_t *internal_data_stream,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_data_stream_read_buffer_at_offset_async(
+     libfsntfs_data_stream_t *data_stream,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+             libfsntfs_data_stream_t *data_stream,
+             void *buffer,
+             ssize_t read_count,
+             off64_t offset,
+             libcerror_error_t *error,
+             void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 off64_t libfsntfs_data_stream_seek_offset(
          libfsntfs_data_stream_t *data_stream,
@@ -138,6 +196,14 @@ int libfsntfs_data_stream_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_data_stream_get_next_data_range(
+     libfsntfs_data_stream_t *data_stream,
+     off64_t offset,
+     off64_t *data_range_offset,
+     size64_t *data_range_size,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_data_stream_get_number_of_extents(
      libfsntfs_data_stream_t *data_stream,
@@ -0,0 +1,706 @@
+/*
+ * Directory entries iterator functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_directory_entries_iterator.h"
+#include "libfsntfs_directory_entry.h"
+#include "libfsntfs_file_name_values.h"
+#include "libfsntfs_index.h"
+#include "libfsntfs_index_node.h"
+#include "libfsntfs_index_value.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libfcache.h"
+
+/* Creates a directory entries iterator
+ * Make sure the value directory_entries_iterator is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entries_iterator_initialize(
+     libfsntfs_directory_entries_iterator_t **directory_entries_iterator,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_mft_entry_t *mft_entry,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfsntfs_directory_entries_iterator_initialize";
+	uint32_t attribute_type = 0;
+	uint32_t collation_type = 0;
+	int result              = 0;
+
+	if( directory_entries_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_entries_iterator != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory entries iterator value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*directory_entries_iterator = memory_allocate_structure(
+	                               libfsntfs_directory_entries_iterator_t );
+
+	if( *directory_entries_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create directory entries iterator.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *directory_entries_iterator,
+	     0,
+	     sizeof( libfsntfs_directory_entries_iterator_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear directory entries iterator.",
+		 function );
+
+		memory_free(
+		 *directory_entries_iterator );
+
+		*directory_entries_iterator = NULL;
+
+		return( -1 );
+	}
+	if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) != 0 )
+	{
+		return( 1 );
+	}
+	if( libfsntfs_index_initialize(
+	     &( ( *directory_entries_iterator )->i30_index ),
+	     io_handle,
+	     (uint8_t *) "$I30",
+	     5,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create $I30 index.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsntfs_index_read(
+	          ( *directory_entries_iterator )->i30_index,
+	          file_io_handle,
+	          mft_entry,
+	          flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read $I30 index.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	if( libfsntfs_index_get_attribute_type(
+	     ( *directory_entries_iterator )->i30_index,
+	     &attribute_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attribute type from index.",
+		 function );
+
+		goto on_error;
+	}
+	if( attribute_type != LIBFSNTFS_ATTRIBUTE_TYPE_FILE_NAME )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported index attribute type.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_index_get_collation_type(
+	     ( *directory_entries_iterator )->i30_index,
+	     &collation_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve collation type from index.",
+		 function );
+
+		goto on_error;
+	}
+	if( collation_type != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported index collation type.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_directory_entries_iterator_push_frame(
+	     *directory_entries_iterator,
+	     ( *directory_entries_iterator )->i30_index->root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push root node frame.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *directory_entries_iterator != NULL )
+	{
+		libfsntfs_directory_entries_iterator_free(
+		 directory_entries_iterator,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a directory entries iterator
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entries_iterator_free(
+     libfsntfs_directory_entries_iterator_t **directory_entries_iterator,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_directory_entries_iterator_free";
+	int result            = 1;
+
+	if( directory_entries_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_entries_iterator != NULL )
+	{
+		while( ( *directory_entries_iterator )->number_of_frames > 0 )
+		{
+			if( libfsntfs_directory_entries_iterator_pop_frame(
+			     *directory_entries_iterator,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to pop frame.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( ( *directory_entries_iterator )->i30_index != NULL )
+		{
+			if( libfsntfs_index_free(
+			     &( ( *directory_entries_iterator )->i30_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free $I30 index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *directory_entries_iterator );
+
+		*directory_entries_iterator = NULL;
+	}
+	return( result );
+}
+
+/* Pushes a frame for an index node
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entries_iterator_push_frame(
+     libfsntfs_directory_entries_iterator_t *directory_entries_iterator,
+     libfsntfs_index_node_t *index_node,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entries_iterator_frame_t *frame = NULL;
+	static char *function                               = "libfsntfs_directory_entries_iterator_push_frame";
+
+	if( directory_entries_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( directory_entries_iterator->number_of_frames < 0 )
+	 || ( directory_entries_iterator->number_of_frames > LIBFSNTFS_MAXIMUM_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid directory entries iterator - number of frames value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	frame = &( directory_entries_iterator->frames[ directory_entries_iterator->number_of_frames ] );
+
+	if( memory_set(
+	     frame,
+	     0,
+	     sizeof( libfsntfs_directory_entries_iterator_frame_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear frame.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_index_node_get_number_of_values(
+	     index_node,
+	     &( frame->number_of_index_values ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of values from index node.",
+		 function );
+
+		return( -1 );
+	}
+	/* Use a cache per frame to prevent cache invalidation of the index nodes
+	 * of the parent frames when reading sub nodes.
+	 */
+	if( libfcache_cache_initialize(
+	     &( frame->sub_node_cache ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub node cache.",
+		 function );
+
+		return( -1 );
+	}
+	frame->index_node = index_node;
+
+	directory_entries_iterator->number_of_frames += 1;
+
+	return( 1 );
+}
+
+/* Pops the last frame
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entries_iterator_pop_frame(
+     libfsntfs_directory_entries_iterator_t *directory_entries_iterator,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entries_iterator_frame_t *frame = NULL;
+	static char *function                               = "libfsntfs_directory_entries_iterator_pop_frame";
+
+	if( directory_entries_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( directory_entries_iterator->number_of_frames <= 0 )
+	 || ( directory_entries_iterator->number_of_frames > ( LIBFSNTFS_MAXIMUM_RECURSION_DEPTH + 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid directory entries iterator - number of frames value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	directory_entries_iterator->number_of_frames -= 1;
+
+	frame = &( directory_entries_iterator->frames[ directory_entries_iterator->number_of_frames ] );
+
+	frame->index_node = NULL;
+
+	if( frame->sub_node_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( frame->sub_node_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub node cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the next directory entry
+ * The index B-tree is walked depth first, which returns the directory entries
+ * sorted by file name. Only the index nodes on the path from the root node are
+ * kept in memory. DOS file names are not returned and are not set as short
+ * file name of the directory entries.
+ * Returns 1 if successful, 0 if no more entries or -1 on error
+ */
+int libfsntfs_directory_entries_iterator_get_next_entry(
+     libfsntfs_directory_entries_iterator_t *directory_entries_iterator,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entries_iterator_frame_t *frame = NULL;
+	libfsntfs_file_name_values_t *file_name_values      = NULL;
+	libfsntfs_index_node_t *sub_node                    = NULL;
+	libfsntfs_index_value_t *index_value                = NULL;
+	static char *function                               = "libfsntfs_directory_entries_iterator_get_next_entry";
+	off64_t index_entry_offset                          = 0;
+	int is_allocated                                    = 0;
+
+	if( directory_entries_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	while( directory_entries_iterator->number_of_frames > 0 )
+	{
+		frame = &( directory_entries_iterator->frames[ directory_entries_iterator->number_of_frames - 1 ] );
+
+		if( frame->index_value_entry >= frame->number_of_index_values )
+		{
+			if( libfsntfs_directory_entries_iterator_pop_frame(
+			     directory_entries_iterator,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to pop frame.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( libfsntfs_index_node_get_value_by_index(
+		     frame->index_node,
+		     frame->index_value_entry,
+		     &index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value: %d from index node.",
+			 function,
+			 frame->index_value_entry );
+
+			goto on_error;
+		}
+		/* Return the entries of the sub node before the index value itself
+		 * since this preserves the sorted by file name order
+		 */
+		if( ( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
+		 && ( frame->sub_node_read == 0 ) )
+		{
+			frame->sub_node_read = 1;
+
+			if( index_value->sub_node_vcn > (uint64_t) INT_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: node index value: %d sub node VCN value out of bounds.",
+				 function,
+				 frame->index_value_entry );
+
+				goto on_error;
+			}
+			is_allocated = libfsntfs_index_sub_node_is_allocated(
+			                directory_entries_iterator->i30_index,
+			                (int) index_value->sub_node_vcn,
+			                error );
+
+			if( is_allocated == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if sub node with VCN: %d is allocated.",
+				 function,
+				 (int) index_value->sub_node_vcn );
+
+				goto on_error;
+			}
+			else if( is_allocated != 0 )
+			{
+				index_entry_offset = (off64_t) ( index_value->sub_node_vcn * directory_entries_iterator->i30_index->io_handle->cluster_block_size );
+
+				if( libfsntfs_index_get_sub_node(
+				     directory_entries_iterator->i30_index,
+				     file_io_handle,
+				     frame->sub_node_cache,
+				     index_entry_offset,
+				     (int) index_value->sub_node_vcn,
+				     &sub_node,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve sub node with VCN: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 (int) index_value->sub_node_vcn,
+					 index_entry_offset,
+					 index_entry_offset );
+
+					goto on_error;
+				}
+				if( libfsntfs_directory_entries_iterator_push_frame(
+				     directory_entries_iterator,
+				     sub_node,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push sub node frame.",
+					 function );
+
+					goto on_error;
+				}
+				continue;
+			}
+		}
+		frame->index_value_entry += 1;
+		frame->sub_node_read      = 0;
+
+		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_IS_LAST ) != 0 )
+		{
+			frame->index_value_entry = frame->number_of_index_values;
+
+			continue;
+		}
+		if( libfsntfs_file_name_values_initialize(
+		     &file_name_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file name values.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_file_name_values_read_data(
+		     file_name_values,
+		     index_value->key_data,
+		     (size_t) index_value->key_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file name values.",
+			 function );
+
+			goto on_error;
+		}
+		if( file_name_values->name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file name values - missing name.",
+			 function );
+
+			goto on_error;
+		}
+		/* Ignore the file name with the . as its name and DOS file names
+		 */
+		if( ( ( file_name_values->name_size == 2 )
+		  && ( file_name_values->name[ 0 ] == 0x2e )
+		  && ( file_name_values->name[ 1 ] == 0x00 ) )
+		 || ( file_name_values->name_space == LIBFSNTFS_FILE_NAME_SPACE_DOS ) )
+		{
+			if( libfsntfs_file_name_values_free(
+			     &file_name_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file name values.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( libfsntfs_directory_entry_initialize(
+		     directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entry.",
+			 function );
+
+			goto on_error;
+		}
+		( *directory_entry )->file_reference   = index_value->file_reference;
+		( *directory_entry )->file_name_values = file_name_values;
+
+		return( 1 );
+	}
+	return( 0 );
+
+on_error:
+	if( file_name_values != NULL )
+	{
+		libfsntfs_file_name_values_free(
+		 &file_name_values,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,116 @@
+/*
+ * Directory entries iterator functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_DIRECTORY_ENTRIES_ITERATOR_H )
+#define _LIBFSNTFS_DIRECTORY_ENTRIES_ITERATOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_directory_entry.h"
+#include "libfsntfs_index.h"
+#include "libfsntfs_index_node.h"
+#include "libfsntfs_io_handle.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libfcache.h"
+#include "libfsntfs_mft_entry.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_directory_entries_iterator_frame libfsntfs_directory_entries_iterator_frame_t;
+
+struct libfsntfs_directory_entries_iterator_frame
+{
+	/* The index node
+	 */
+	libfsntfs_index_node_t *index_node;
+
+	/* The sub node cache
+	 */
+	libfcache_cache_t *sub_node_cache;
+
+	/* The number of index values
+	 */
+	int number_of_index_values;
+
+	/* The current index value entry
+	 */
+	int index_value_entry;
+
+	/* Value to indicate the sub node of the current index value was read
+	 */
+	uint8_t sub_node_read;
+};
+
+typedef struct libfsntfs_directory_entries_iterator libfsntfs_directory_entries_iterator_t;
+
+struct libfsntfs_directory_entries_iterator
+{
+	/* The $I30 index
+	 */
+	libfsntfs_index_t *i30_index;
+
+	/* The frames, one per index node on the path from the root node
+	 */
+	libfsntfs_directory_entries_iterator_frame_t frames[ LIBFSNTFS_MAXIMUM_RECURSION_DEPTH + 1 ];
+
+	/* The number of frames
+	 */
+	int number_of_frames;
+};
+
+int libfsntfs_directory_entries_iterator_initialize(
+     libfsntfs_directory_entries_iterator_t **directory_entries_iterator,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_mft_entry_t *mft_entry,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_iterator_free(
+     libfsntfs_directory_entries_iterator_t **directory_entries_iterator,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_iterator_push_frame(
+     libfsntfs_directory_entries_iterator_t *directory_entries_iterator,
+     libfsntfs_index_node_t *index_node,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_iterator_pop_frame(
+     libfsntfs_directory_entries_iterator_t *directory_entries_iterator,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_iterator_get_next_entry(
+     libfsntfs_directory_entries_iterator_t *directory_entries_iterator,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_DIRECTORY_ENTRIES_ITERATOR_H ) */
+
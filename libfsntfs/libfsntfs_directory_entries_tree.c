@@ -37,6 +37,7 @@
 #include "libfsntfs_mft_attribute.h"
 #include "libfsntfs_mft_entry.h"
 #include "libfsntfs_name.h"
+#include "libfsntfs_name_hash_table.h"
 #include "libfsntfs_standard_information_values.h"
 #include "libfsntfs_unused.h"
 
@@ -201,6 +202,22 @@ int libfsntfs_directory_entries_tree_free(
 				result = -1;
 			}
 		}
+		if( ( *directory_entries_tree )->names_hash_table != NULL )
+		{
+			if( libfsntfs_name_hash_table_free(
+			     &( ( *directory_entries_tree )->names_hash_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free names hash table.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *directory_entries_tree );
 
@@ -1163,33 +1180,21 @@ int libfsntfs_directory_entries_tree_get_entry_by_index(
 	return( 1 );
 }
 
-/* Retrieves the directory entry from an index node for an UTF-8 encoded name
- * This function creates a new directory entry
- * Returns 1 if successful, 0 if no such directory entry or -1 on error
+/* Builds the names hash table
+ * The names hash table is only built for directories with a large number of names
+ * Returns 1 if successful, 0 if the number of names is too small or -1 on error
  */
-int libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf8_name(
+int libfsntfs_directory_entries_tree_build_names_hash_table(
      libfsntfs_directory_entries_tree_t *directory_entries_tree,
      libbfio_handle_t *file_io_handle,
-     libfsntfs_index_node_t *index_node,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
-     libfsntfs_directory_entry_t **directory_entry,
-     int recursion_depth,
      libcerror_error_t **error )
 {
-	libcdata_tree_node_t *upper_node                      = NULL;
-	libfsntfs_directory_entry_t *existing_directory_entry = NULL;
-	libfsntfs_directory_entry_t *safe_directory_entry     = NULL;
-	libfsntfs_file_name_values_t *file_name_values        = NULL;
-	libfsntfs_index_node_t *sub_node                      = NULL;
-	libfsntfs_index_value_t *index_value                  = NULL;
-	static char *function                                 = "libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf8_name";
-	off64_t index_entry_offset                            = 0;
-	int compare_result                                    = 0;
-	int index_value_entry                                 = 0;
-	int is_allocated                                      = 0;
-	int number_of_index_values                            = 0;
-	int result                                            = 0;
+	libfsntfs_directory_entry_t *tree_directory_entry = NULL;
+	static char *function                             = "libfsntfs_directory_entries_tree_build_names_hash_table";
+	uint32_t name_hash                                = 0;
+	int entry_index                                   = 0;
+	int number_of_entries                             = 0;
+	int number_of_short_names                         = 0;
 
 	if( directory_entries_tree == NULL )
 	{
@@ -1202,252 +1207,1003 @@ int libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf8_name(
 
 		return( -1 );
 	}
-	if( directory_entries_tree->i30_index == NULL )
+	if( directory_entries_tree->names_hash_table != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid directory entries tree - missing $I30 index.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory entries tree - names hash table value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( directory_entries_tree->i30_index->io_handle == NULL )
+	if( libfdata_list_get_number_of_elements(
+	     directory_entries_tree->entries_list,
+	     &number_of_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid directory entries tree - invalid $I30 index - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from entries list.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( directory_entry == NULL )
+	if( libcdata_btree_get_number_of_values(
+	     directory_entries_tree->short_names_tree,
+	     &number_of_short_names,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid directory entry.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of values from short names tree.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( recursion_depth < 0 )
-	 || ( recursion_depth > LIBFSNTFS_MAXIMUM_RECURSION_DEPTH ) )
+	if( ( number_of_entries < 0 )
+	 || ( number_of_short_names < 0 )
+	 || ( number_of_entries > ( INT_MAX - number_of_short_names ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid recursion depth value out of bounds.",
+		 "%s: invalid number of names value out of bounds.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libfsntfs_index_node_get_number_of_values(
-	     index_node,
-	     &number_of_index_values,
+	if( ( number_of_entries + number_of_short_names ) < LIBFSNTFS_DIRECTORY_ENTRIES_TREE_MINIMUM_NUMBER_OF_HASHED_NAMES )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_name_hash_table_initialize(
+	     &( directory_entries_tree->names_hash_table ),
+	     number_of_entries + number_of_short_names,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of values from index node.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create names hash table.",
 		 function );
 
 		goto on_error;
 	}
-	for( index_value_entry = 0;
-	     index_value_entry < number_of_index_values;
-	     index_value_entry++ )
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
 	{
-		if( libfsntfs_index_node_get_value_by_index(
-		     index_node,
-		     index_value_entry,
-		     &index_value,
+		if( libfdata_list_get_element_value_by_index(
+		     directory_entries_tree->entries_list,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) directory_entries_tree->entries_cache,
+		     entry_index,
+		     (intptr_t **) &tree_directory_entry,
+		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value: %d from index node.",
+			 "%s: unable to retrieve element: %d from entries list.",
 			 function,
-			 index_value_entry );
+			 entry_index );
 
 			goto on_error;
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( ( tree_directory_entry == NULL )
+		 || ( tree_directory_entry->file_name_values == NULL ) )
 		{
-			libcnotify_printf(
-			 "%s: index value: %03d file reference: %" PRIu64 "-%" PRIu64 "\n",
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing directory entry: %d file name values.",
 			 function,
-			 index_value_entry,
-			 index_value->file_reference & 0xffffffffffffUL,
-			 index_value->file_reference >> 48 );
+			 entry_index );
 
-			libcnotify_printf(
-			 "\n" );
+			goto on_error;
 		}
-#endif
-		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
+		if( libfsntfs_name_get_hash(
+		     tree_directory_entry->file_name_values->name,
+		     tree_directory_entry->file_name_values->name_size,
+		     directory_entries_tree->use_case_folding,
+		     directory_entries_tree->upcase_table,
+		     &name_hash,
+		     error ) != 1 )
 		{
-			if( index_value->sub_node_vcn > (uint64_t) INT_MAX )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: node index value: %d sub node VCN value out of bounds.",
-				 function,
-				 index_value_entry );
-
-				goto on_error;
-			}
-			is_allocated = libfsntfs_index_sub_node_is_allocated(
-			                directory_entries_tree->i30_index,
-			                (int) index_value->sub_node_vcn,
-			                error );
-
-			if( is_allocated == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if sub node with VCN: %d is allocated.",
-				 function,
-				 (int) index_value->sub_node_vcn );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry: %d name hash.",
+			 function,
+			 entry_index );
 
-				goto on_error;
-			}
-			else if( is_allocated == 0 )
-			{
-				continue;
-			}
-		}
-		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_IS_LAST ) != 0 )
-		{
-			break;
+			goto on_error;
 		}
-		if( libfsntfs_file_name_values_initialize(
-		     &file_name_values,
+		if( libfsntfs_name_hash_table_insert_value(
+		     directory_entries_tree->names_hash_table,
+		     name_hash,
+		     entry_index,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create file name values.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert directory entry: %d into names hash table.",
+			 function,
+			 entry_index );
 
 			goto on_error;
 		}
-		if( libfsntfs_file_name_values_read_data(
-		     file_name_values,
-		     index_value->key_data,
-		     (size_t) index_value->key_data_size,
+	}
+	/* Short names are stored as a negative value containing -( index + 1 )
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_short_names;
+	     entry_index++ )
+	{
+		if( libcdata_btree_get_value_by_index(
+		     directory_entries_tree->short_names_tree,
+		     entry_index,
+		     (intptr_t **) &tree_directory_entry,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read file name values.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value: %d from short names tree.",
+			 function,
+			 entry_index );
 
 			goto on_error;
 		}
-		compare_result = libfsntfs_name_compare_with_utf8_string(
-		                  file_name_values->name,
-		                  file_name_values->name_size,
-		                  utf8_string,
-		                  utf8_string_length,
-		                  directory_entries_tree->use_case_folding,
-		                  error );
-
-		if( compare_result == -1 )
+		if( ( tree_directory_entry == NULL )
+		 || ( tree_directory_entry->short_file_name_values == NULL ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to compare file name values with UTF-8 string.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing short name directory entry: %d file name values.",
+			 function,
+			 entry_index );
 
 			goto on_error;
 		}
-		if( compare_result != LIBUNA_COMPARE_EQUAL )
+		if( libfsntfs_name_get_hash(
+		     tree_directory_entry->short_file_name_values->name,
+		     tree_directory_entry->short_file_name_values->name_size,
+		     directory_entries_tree->use_case_folding,
+		     directory_entries_tree->upcase_table,
+		     &name_hash,
+		     error ) != 1 )
 		{
-			if( libfsntfs_file_name_values_free(
-			     &file_name_values,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free file name values.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve short name directory entry: %d name hash.",
+			 function,
+			 entry_index );
 
-				goto on_error;
-			}
-		}
-		if( compare_result == LIBUNA_COMPARE_LESS )
-		{
-			if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
-			{
-				break;
-			}
-		}
-		else if( compare_result == LIBUNA_COMPARE_EQUAL )
-		{
-			break;
+			goto on_error;
 		}
-	}
-	if( compare_result == LIBUNA_COMPARE_EQUAL )
-	{
-		if( libfsntfs_directory_entry_initialize(
-		     &safe_directory_entry,
+		if( libfsntfs_name_hash_table_insert_value(
+		     directory_entries_tree->names_hash_table,
+		     name_hash,
+		     -entry_index - 1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create directory entry.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert short name directory entry: %d into names hash table.",
+			 function,
+			 entry_index );
 
 			goto on_error;
 		}
-		safe_directory_entry->file_reference   = index_value->file_reference;
-		safe_directory_entry->file_name_values = file_name_values;
-
-		file_name_values = NULL;
+	}
+	return( 1 );
 
-		if( safe_directory_entry->file_name_values->name_space == LIBFSNTFS_FILE_NAME_SPACE_WINDOWS )
-		{
-			result = libcdata_btree_get_value_by_value(
-			          directory_entries_tree->short_names_tree,
-			          (intptr_t *) directory_entry,
-			          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfsntfs_directory_entry_compare_by_file_reference,
-			          &upper_node,
-			          (intptr_t **) &existing_directory_entry,
-			          error );
+on_error:
+	if( directory_entries_tree->names_hash_table != NULL )
+	{
+		libfsntfs_name_hash_table_free(
+		 &( directory_entries_tree->names_hash_table ),
+		 NULL );
+	}
+	return( -1 );
+}
 
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve directory entry from tree.",
-				 function );
+/* Retrieves the directory entry from the names hash table for an UTF-8 encoded name
+ * This function creates a new directory entry
+ * Returns 1 if successful, 0 if no such directory entry or -1 on error
+ */
+int libfsntfs_directory_entries_tree_get_entry_from_names_hash_table_by_utf8_name(
+     libfsntfs_directory_entries_tree_t *directory_entries_tree,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_t *safe_directory_entry = NULL;
+	libfsntfs_directory_entry_t *tree_directory_entry = NULL;
+	libfsntfs_file_name_values_t *file_name_values    = NULL;
+	static char *function                             = "libfsntfs_directory_entries_tree_get_entry_from_names_hash_table_by_utf8_name";
+	uint32_t name_hash                                = 0;
+	int compare_result                                = 0;
+	int hash_table_entry_index                        = 0;
+	int result                                        = 0;
+	int value                                         = 0;
+
+	if( directory_entries_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entries_tree->names_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid directory entries tree - missing names hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_name_get_hash_from_utf8_string(
+	     utf8_string,
+	     utf8_string_length,
+	     directory_entries_tree->use_case_folding,
+	     directory_entries_tree->upcase_table,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string hash.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		result = libfsntfs_name_hash_table_get_next_value_by_hash(
+		          directory_entries_tree->names_hash_table,
+		          name_hash,
+		          &hash_table_entry_index,
+		          &value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from names hash table.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		/* Short names are stored as a negative value containing -( index + 1 )
+		 */
+		if( value >= 0 )
+		{
+			if( libfdata_list_get_element_value_by_index(
+			     directory_entries_tree->entries_list,
+			     (intptr_t *) file_io_handle,
+			     (libfdata_cache_t *) directory_entries_tree->entries_cache,
+			     value,
+			     (intptr_t **) &tree_directory_entry,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element: %d from entries list.",
+				 function,
+				 value );
+
+				goto on_error;
+			}
+			file_name_values = tree_directory_entry->file_name_values;
+		}
+		else
+		{
+			if( libcdata_btree_get_value_by_index(
+			     directory_entries_tree->short_names_tree,
+			     -value - 1,
+			     (intptr_t **) &tree_directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value: %d from short names tree.",
+				 function,
+				 -value - 1 );
+
+				goto on_error;
+			}
+			file_name_values = tree_directory_entry->short_file_name_values;
+		}
+		if( file_name_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing file name values.",
+			 function );
+
+			goto on_error;
+		}
+		compare_result = libfsntfs_name_compare_with_utf8_string(
+		                  file_name_values->name,
+		                  file_name_values->name_size,
+		                  utf8_string,
+		                  utf8_string_length,
+		                  directory_entries_tree->use_case_folding,
+		                  directory_entries_tree->upcase_table,
+		                  error );
+
+		if( compare_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare file name values with UTF-8 string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( compare_result != LIBUNA_COMPARE_EQUAL );
+
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( value >= 0 )
+	{
+		if( libfsntfs_directory_entry_clone(
+		     &safe_directory_entry,
+		     tree_directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		/* A match on the short name returns a directory entry with the short name as its name
+		 */
+		if( libfsntfs_directory_entry_initialize(
+		     &safe_directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entry.",
+			 function );
+
+			goto on_error;
+		}
+		safe_directory_entry->file_reference = tree_directory_entry->file_reference;
+
+		if( libfsntfs_file_name_values_clone(
+		     &( safe_directory_entry->file_name_values ),
+		     tree_directory_entry->short_file_name_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone short file name values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*directory_entry = safe_directory_entry;
+
+	return( 1 );
+
+on_error:
+	if( safe_directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &safe_directory_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the directory entry from the names hash table for an UTF-16 encoded name
+ * This function creates a new directory entry
+ * Returns 1 if successful, 0 if no such directory entry or -1 on error
+ */
+int libfsntfs_directory_entries_tree_get_entry_from_names_hash_table_by_utf16_name(
+     libfsntfs_directory_entries_tree_t *directory_entries_tree,
+     libbfio_handle_t *file_io_handle,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_t *safe_directory_entry = NULL;
+	libfsntfs_directory_entry_t *tree_directory_entry = NULL;
+	libfsntfs_file_name_values_t *file_name_values    = NULL;
+	static char *function                             = "libfsntfs_directory_entries_tree_get_entry_from_names_hash_table_by_utf16_name";
+	uint32_t name_hash                                = 0;
+	int compare_result                                = 0;
+	int hash_table_entry_index                        = 0;
+	int result                                        = 0;
+	int value                                         = 0;
+
+	if( directory_entries_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entries_tree->names_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid directory entries tree - missing names hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_name_get_hash_from_utf16_string(
+	     utf16_string,
+	     utf16_string_length,
+	     directory_entries_tree->use_case_folding,
+	     directory_entries_tree->upcase_table,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string hash.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		result = libfsntfs_name_hash_table_get_next_value_by_hash(
+		          directory_entries_tree->names_hash_table,
+		          name_hash,
+		          &hash_table_entry_index,
+		          &value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from names hash table.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		/* Short names are stored as a negative value containing -( index + 1 )
+		 */
+		if( value >= 0 )
+		{
+			if( libfdata_list_get_element_value_by_index(
+			     directory_entries_tree->entries_list,
+			     (intptr_t *) file_io_handle,
+			     (libfdata_cache_t *) directory_entries_tree->entries_cache,
+			     value,
+			     (intptr_t **) &tree_directory_entry,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element: %d from entries list.",
+				 function,
+				 value );
+
+				goto on_error;
+			}
+			file_name_values = tree_directory_entry->file_name_values;
+		}
+		else
+		{
+			if( libcdata_btree_get_value_by_index(
+			     directory_entries_tree->short_names_tree,
+			     -value - 1,
+			     (intptr_t **) &tree_directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value: %d from short names tree.",
+				 function,
+				 -value - 1 );
+
+				goto on_error;
+			}
+			file_name_values = tree_directory_entry->short_file_name_values;
+		}
+		if( file_name_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing file name values.",
+			 function );
+
+			goto on_error;
+		}
+		compare_result = libfsntfs_name_compare_with_utf16_string(
+		                  file_name_values->name,
+		                  file_name_values->name_size,
+		                  utf16_string,
+		                  utf16_string_length,
+		                  directory_entries_tree->use_case_folding,
+		                  directory_entries_tree->upcase_table,
+		                  error );
+
+		if( compare_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare file name values with UTF-16 string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( compare_result != LIBUNA_COMPARE_EQUAL );
+
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( value >= 0 )
+	{
+		if( libfsntfs_directory_entry_clone(
+		     &safe_directory_entry,
+		     tree_directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		/* A match on the short name returns a directory entry with the short name as its name
+		 */
+		if( libfsntfs_directory_entry_initialize(
+		     &safe_directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entry.",
+			 function );
+
+			goto on_error;
+		}
+		safe_directory_entry->file_reference = tree_directory_entry->file_reference;
+
+		if( libfsntfs_file_name_values_clone(
+		     &( safe_directory_entry->file_name_values ),
+		     tree_directory_entry->short_file_name_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone short file name values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*directory_entry = safe_directory_entry;
+
+	return( 1 );
+
+on_error:
+	if( safe_directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &safe_directory_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the directory entry from an index node for an UTF-8 encoded name
+ * This function creates a new directory entry
+ * Returns 1 if successful, 0 if no such directory entry or -1 on error
+ */
+int libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf8_name(
+     libfsntfs_directory_entries_tree_t *directory_entries_tree,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_index_node_t *index_node,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     int recursion_depth,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *upper_node                      = NULL;
+	libfsntfs_directory_entry_t *existing_directory_entry = NULL;
+	libfsntfs_directory_entry_t *safe_directory_entry     = NULL;
+	libfsntfs_file_name_values_t *file_name_values        = NULL;
+	libfsntfs_index_node_t *sub_node                      = NULL;
+	libfsntfs_index_value_t *index_value                  = NULL;
+	static char *function                                 = "libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf8_name";
+	off64_t index_entry_offset                            = 0;
+	int compare_result                                    = 0;
+	int index_value_entry                                 = 0;
+	int is_allocated                                      = 0;
+	int number_of_index_values                            = 0;
+	int result                                            = 0;
+
+	if( directory_entries_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entries_tree->i30_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries tree - missing $I30 index.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entries_tree->i30_index->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries tree - invalid $I30 index - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBFSNTFS_MAXIMUM_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_index_node_get_number_of_values(
+	     index_node,
+	     &number_of_index_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of values from index node.",
+		 function );
+
+		goto on_error;
+	}
+	for( index_value_entry = 0;
+	     index_value_entry < number_of_index_values;
+	     index_value_entry++ )
+	{
+		if( libfsntfs_index_node_get_value_by_index(
+		     index_node,
+		     index_value_entry,
+		     &index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value: %d from index node.",
+			 function,
+			 index_value_entry );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: index value: %03d file reference: %" PRIu64 "-%" PRIu64 "\n",
+			 function,
+			 index_value_entry,
+			 index_value->file_reference & 0xffffffffffffUL,
+			 index_value->file_reference >> 48 );
+
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
+		{
+			if( index_value->sub_node_vcn > (uint64_t) INT_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: node index value: %d sub node VCN value out of bounds.",
+				 function,
+				 index_value_entry );
+
+				goto on_error;
+			}
+			is_allocated = libfsntfs_index_sub_node_is_allocated(
+			                directory_entries_tree->i30_index,
+			                (int) index_value->sub_node_vcn,
+			                error );
+
+			if( is_allocated == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if sub node with VCN: %d is allocated.",
+				 function,
+				 (int) index_value->sub_node_vcn );
+
+				goto on_error;
+			}
+			else if( is_allocated == 0 )
+			{
+				continue;
+			}
+		}
+		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_IS_LAST ) != 0 )
+		{
+			break;
+		}
+		if( libfsntfs_file_name_values_initialize(
+		     &file_name_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file name values.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_file_name_values_read_data(
+		     file_name_values,
+		     index_value->key_data,
+		     (size_t) index_value->key_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file name values.",
+			 function );
+
+			goto on_error;
+		}
+		compare_result = libfsntfs_name_compare_with_utf8_string(
+		                  file_name_values->name,
+		                  file_name_values->name_size,
+		                  utf8_string,
+		                  utf8_string_length,
+		                  directory_entries_tree->use_case_folding,
+		                  directory_entries_tree->upcase_table,
+		                  error );
+
+		if( compare_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare file name values with UTF-8 string.",
+			 function );
+
+			goto on_error;
+		}
+		if( compare_result != LIBUNA_COMPARE_EQUAL )
+		{
+			if( libfsntfs_file_name_values_free(
+			     &file_name_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file name values.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( compare_result == LIBUNA_COMPARE_LESS )
+		{
+			if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
+			{
+				break;
+			}
+		}
+		else if( compare_result == LIBUNA_COMPARE_EQUAL )
+		{
+			break;
+		}
+	}
+	if( compare_result == LIBUNA_COMPARE_EQUAL )
+	{
+		if( libfsntfs_directory_entry_initialize(
+		     &safe_directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entry.",
+			 function );
+
+			goto on_error;
+		}
+		safe_directory_entry->file_reference   = index_value->file_reference;
+		safe_directory_entry->file_name_values = file_name_values;
+
+		file_name_values = NULL;
+
+		if( safe_directory_entry->file_name_values->name_space == LIBFSNTFS_FILE_NAME_SPACE_WINDOWS )
+		{
+			result = libcdata_btree_get_value_by_value(
+			          directory_entries_tree->short_names_tree,
+			          (intptr_t *) directory_entry,
+			          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfsntfs_directory_entry_compare_by_file_reference,
+			          &upper_node,
+			          (intptr_t **) &existing_directory_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry from tree.",
+				 function );
 
 				goto on_error;
 			}
@@ -1590,15 +2346,52 @@ int libfsntfs_directory_entries_tree_get_entry_by_utf8_name(
 
 		return( -1 );
 	}
-	result = libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf8_name(
-	          directory_entries_tree,
-	          file_io_handle,
-	          directory_entries_tree->i30_index->root_node,
-	          utf8_string,
-	          utf8_string_length,
-	          directory_entry,
-	          0,
-	          error );
+	if( ( directory_entries_tree->use_names_hash_table != 0 )
+	 && ( directory_entries_tree->names_hash_table == NULL ) )
+	{
+		result = libfsntfs_directory_entries_tree_build_names_hash_table(
+		          directory_entries_tree,
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to build names hash table.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			directory_entries_tree->use_names_hash_table = 0;
+		}
+	}
+	if( directory_entries_tree->names_hash_table != NULL )
+	{
+		result = libfsntfs_directory_entries_tree_get_entry_from_names_hash_table_by_utf8_name(
+		          directory_entries_tree,
+		          file_io_handle,
+		          utf8_string,
+		          utf8_string_length,
+		          directory_entry,
+		          error );
+	}
+	else
+	{
+		result = libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf8_name(
+		          directory_entries_tree,
+		          file_io_handle,
+		          directory_entries_tree->i30_index->root_node,
+		          utf8_string,
+		          utf8_string_length,
+		          directory_entry,
+		          0,
+		          error );
+	}
 
 	if( result == -1 )
 	{
@@ -1820,6 +2613,7 @@ int libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf16_name(
 		                  utf16_string,
 		                  utf16_string_length,
 		                  directory_entries_tree->use_case_folding,
+		                  directory_entries_tree->upcase_table,
 		                  error );
 
 		if( compare_result == -1 )
@@ -2041,15 +2835,52 @@ int libfsntfs_directory_entries_tree_get_entry_by_utf16_name(
 
 		return( -1 );
 	}
-	result = libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf16_name(
-	          directory_entries_tree,
-	          file_io_handle,
-	          directory_entries_tree->i30_index->root_node,
-	          utf16_string,
-	          utf16_string_length,
-	          directory_entry,
-	          0,
-	          error );
+	if( ( directory_entries_tree->use_names_hash_table != 0 )
+	 && ( directory_entries_tree->names_hash_table == NULL ) )
+	{
+		result = libfsntfs_directory_entries_tree_build_names_hash_table(
+		          directory_entries_tree,
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to build names hash table.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			directory_entries_tree->use_names_hash_table = 0;
+		}
+	}
+	if( directory_entries_tree->names_hash_table != NULL )
+	{
+		result = libfsntfs_directory_entries_tree_get_entry_from_names_hash_table_by_utf16_name(
+		          directory_entries_tree,
+		          file_io_handle,
+		          utf16_string,
+		          utf16_string_length,
+		          directory_entry,
+		          error );
+	}
+	else
+	{
+		result = libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf16_name(
+		          directory_entries_tree,
+		          file_io_handle,
+		          directory_entries_tree->i30_index->root_node,
+		          utf16_string,
+		          utf16_string_length,
+		          directory_entry,
+		          0,
+		          error );
+	}
 
 	if( result == -1 )
 	{
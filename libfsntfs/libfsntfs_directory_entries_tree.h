@@ -35,6 +35,8 @@
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
 #include "libfsntfs_mft_entry.h"
+#include "libfsntfs_name_hash_table.h"
+#include "libfsntfs_upcase_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -63,6 +65,19 @@ struct libfsntfs_directory_entries_tree
 	/* Value to indicate case folding should be used
 	 */
 	uint8_t use_case_folding;
+
+	/* The upper case table used for case folding
+	 * The table is managed by the file system
+	 */
+	libfsntfs_upcase_table_t *upcase_table;
+
+	/* Value to indicate the names hash table should be used
+	 */
+	uint8_t use_names_hash_table;
+
+	/* The names hash table
+	 */
+	libfsntfs_name_hash_table_t *names_hash_table;
 };
 
 int libfsntfs_directory_entries_tree_initialize(
@@ -107,6 +122,27 @@ int libfsntfs_directory_entries_tree_get_entry_by_index(
      libfsntfs_directory_entry_t **directory_entry,
      libcerror_error_t **error );
 
+int libfsntfs_directory_entries_tree_build_names_hash_table(
+     libfsntfs_directory_entries_tree_t *directory_entries_tree,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_tree_get_entry_from_names_hash_table_by_utf8_name(
+     libfsntfs_directory_entries_tree_t *directory_entries_tree,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_tree_get_entry_from_names_hash_table_by_utf16_name(
+     libfsntfs_directory_entries_tree_t *directory_entries_tree,
+     libbfio_handle_t *file_io_handle,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
 int libfsntfs_directory_entries_tree_get_entry_from_index_node_by_utf8_name(
      libfsntfs_directory_entries_tree_t *directory_entries_tree,
      libbfio_handle_t *file_io_handle,
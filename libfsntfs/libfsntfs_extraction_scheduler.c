@@ -0,0 +1,1312 @@
+/*
+ * Extraction scheduler functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libfsntfs_data_segment_table.h"
+#include "libfsntfs_extraction_scheduler.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libfdata.h"
+#include "libfsntfs_read_queue.h"
+
+/* Creates an extraction scheduler
+ * Make sure the value extraction_scheduler is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extraction_scheduler_initialize(
+     libfsntfs_extraction_scheduler_t **extraction_scheduler,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extraction_scheduler_initialize";
+
+	if( extraction_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extraction_scheduler != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extraction scheduler value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*extraction_scheduler = memory_allocate_structure(
+	                         libfsntfs_extraction_scheduler_t );
+
+	if( *extraction_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extraction scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *extraction_scheduler,
+	     0,
+	     sizeof( libfsntfs_extraction_scheduler_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extraction scheduler.",
+		 function );
+
+		memory_free(
+		 *extraction_scheduler );
+
+		*extraction_scheduler = NULL;
+
+		return( -1 );
+	}
+	( *extraction_scheduler )->buffer = (uint8_t *) memory_allocate(
+	                                                 sizeof( uint8_t ) * buffer_size );
+
+	if( ( *extraction_scheduler )->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	( *extraction_scheduler )->buffer_size = buffer_size;
+
+	return( 1 );
+
+on_error:
+	if( *extraction_scheduler != NULL )
+	{
+		memory_free(
+		 *extraction_scheduler );
+
+		*extraction_scheduler = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an extraction scheduler
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extraction_scheduler_free(
+     libfsntfs_extraction_scheduler_t **extraction_scheduler,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extraction_scheduler_free";
+	int item_index        = 0;
+
+	if( extraction_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extraction_scheduler != NULL )
+	{
+		if( ( *extraction_scheduler )->items != NULL )
+		{
+			for( item_index = 0;
+			     item_index < ( *extraction_scheduler )->number_of_items;
+			     item_index++ )
+			{
+				if( ( *extraction_scheduler )->items[ item_index ].resident_data != NULL )
+				{
+					memory_free(
+					 ( *extraction_scheduler )->items[ item_index ].resident_data );
+				}
+			}
+			memory_free(
+			 ( *extraction_scheduler )->items );
+		}
+		if( ( *extraction_scheduler )->buffer != NULL )
+		{
+			memory_free(
+			 ( *extraction_scheduler )->buffer );
+		}
+		memory_free(
+		 *extraction_scheduler );
+
+		*extraction_scheduler = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends an item
+ * If resident data is provided a copy of size bytes is stored in the item
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extraction_scheduler_append_item(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     uint64_t mft_entry_index,
+     off64_t data_offset,
+     off64_t start_offset,
+     size64_t size,
+     uint32_t range_flags,
+     const uint8_t *resident_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_extraction_item_t *item  = NULL;
+	libfsntfs_extraction_item_t *items = NULL;
+	uint8_t *safe_resident_data        = NULL;
+	static char *function              = "libfsntfs_extraction_scheduler_append_item";
+	size_t items_size                  = 0;
+	int number_of_allocated_items      = 0;
+
+	if( extraction_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_offset < 0 )
+	 || ( start_offset < 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( resident_data != NULL )
+	{
+		if( size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid resident data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		safe_resident_data = (uint8_t *) memory_allocate(
+		                                  sizeof( uint8_t ) * (size_t) size );
+
+		if( safe_resident_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create resident data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     safe_resident_data,
+		     resident_data,
+		     (size_t) size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy resident data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( extraction_scheduler->number_of_items >= extraction_scheduler->number_of_allocated_items )
+	{
+		if( extraction_scheduler->number_of_allocated_items == 0 )
+		{
+			number_of_allocated_items = 256;
+		}
+		else if( extraction_scheduler->number_of_allocated_items < ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_items = extraction_scheduler->number_of_allocated_items * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of items value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		items_size = sizeof( libfsntfs_extraction_item_t ) * (size_t) number_of_allocated_items;
+
+		if( items_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid items size value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		items = (libfsntfs_extraction_item_t *) memory_reallocate(
+		                                         extraction_scheduler->items,
+		                                         items_size );
+
+		if( items == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize items.",
+			 function );
+
+			goto on_error;
+		}
+		extraction_scheduler->items                     = items;
+		extraction_scheduler->number_of_allocated_items = number_of_allocated_items;
+	}
+	item = &( extraction_scheduler->items[ extraction_scheduler->number_of_items ] );
+
+	item->mft_entry_index = mft_entry_index;
+	item->data_offset     = data_offset;
+	item->start_offset    = start_offset;
+	item->size            = size;
+	item->range_flags     = range_flags;
+	item->resident_data   = safe_resident_data;
+
+	extraction_scheduler->number_of_items += 1;
+
+	return( 1 );
+
+on_error:
+	if( safe_resident_data != NULL )
+	{
+		memory_free(
+		 safe_resident_data );
+	}
+	return( -1 );
+}
+
+/* Appends the items of a data segment table
+ * Segments beyond the data size are not appended
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extraction_scheduler_append_data_segment_table(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     uint64_t mft_entry_index,
+     libfsntfs_data_segment_table_t *data_segment_table,
+     libcerror_error_t **error )
+{
+	libfsntfs_data_segment_t *segment = NULL;
+	static char *function             = "libfsntfs_extraction_scheduler_append_data_segment_table";
+	size64_t segment_size             = 0;
+	int segment_index                 = 0;
+
+	if( extraction_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_segment_table->data_size == 0 )
+	{
+		return( 1 );
+	}
+	if( data_segment_table->resident_data != NULL )
+	{
+		if( libfsntfs_extraction_scheduler_append_item(
+		     extraction_scheduler,
+		     mft_entry_index,
+		     0,
+		     0,
+		     data_segment_table->data_size,
+		     0,
+		     data_segment_table->resident_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append resident data item.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	for( segment_index = 0;
+	     segment_index < data_segment_table->number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( data_segment_table->segments[ segment_index ] );
+
+		if( (size64_t) segment->data_offset >= data_segment_table->data_size )
+		{
+			break;
+		}
+		segment_size = data_segment_table->data_size - (size64_t) segment->data_offset;
+
+		if( segment_size > segment->size )
+		{
+			segment_size = segment->size;
+		}
+		if( segment_size == 0 )
+		{
+			continue;
+		}
+		if( libfsntfs_extraction_scheduler_append_item(
+		     extraction_scheduler,
+		     mft_entry_index,
+		     segment->data_offset,
+		     segment->start_offset,
+		     segment_size,
+		     segment->range_flags,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment: %d item.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Compares two extraction items
+ * Items that do not require a read, resident and sparse data, are ordered first
+ * by MFT entry index and data offset, other items by their start offset in the volume
+ * Returns -1 if first is less than second, 0 if equal or 1 if greater
+ */
+int libfsntfs_extraction_item_compare(
+     const void *first_extraction_item,
+     const void *second_extraction_item )
+{
+	const libfsntfs_extraction_item_t *first_item  = (const libfsntfs_extraction_item_t *) first_extraction_item;
+	const libfsntfs_extraction_item_t *second_item = (const libfsntfs_extraction_item_t *) second_extraction_item;
+	uint8_t first_requires_read                    = 0;
+	uint8_t second_requires_read                   = 0;
+
+	if( ( first_item->resident_data == NULL )
+	 && ( ( first_item->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) == 0 ) )
+	{
+		first_requires_read = 1;
+	}
+	if( ( second_item->resident_data == NULL )
+	 && ( ( second_item->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) == 0 ) )
+	{
+		second_requires_read = 1;
+	}
+	if( first_requires_read != second_requires_read )
+	{
+		return( ( first_requires_read < second_requires_read ) ? -1 : 1 );
+	}
+	if( first_requires_read != 0 )
+	{
+		if( first_item->start_offset < second_item->start_offset )
+		{
+			return( -1 );
+		}
+		else if( first_item->start_offset > second_item->start_offset )
+		{
+			return( 1 );
+		}
+	}
+	if( first_item->mft_entry_index < second_item->mft_entry_index )
+	{
+		return( -1 );
+	}
+	else if( first_item->mft_entry_index > second_item->mft_entry_index )
+	{
+		return( 1 );
+	}
+	if( first_item->data_offset < second_item->data_offset )
+	{
+		return( -1 );
+	}
+	else if( first_item->data_offset > second_item->data_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the next group of items to read
+ * Items that are stored directly after each other are grouped up to the group
+ * buffer size, items that are larger than the group buffer size are read in parts
+ * The item index and item offset are advanced past the group
+ * Returns 1 if successful, 0 if no more groups or -1 on error
+ */
+int libfsntfs_extraction_scheduler_get_next_group(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     int *item_index,
+     size64_t *item_offset,
+     size_t group_buffer_size,
+     libfsntfs_extraction_group_t *extraction_group,
+     libcerror_error_t **error )
+{
+	libfsntfs_extraction_item_t *item      = NULL;
+	libfsntfs_extraction_item_t *next_item = NULL;
+	static char *function                  = "libfsntfs_extraction_scheduler_get_next_group";
+	size_t read_size                       = 0;
+	int last_item_index                    = 0;
+
+	if( extraction_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item index.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( group_buffer_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid group buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extraction_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( *item_index < 0 )
+	 || ( *item_index >= extraction_scheduler->number_of_items ) )
+	{
+		return( 0 );
+	}
+	item = &( extraction_scheduler->items[ *item_index ] );
+
+	if( item->size > (size64_t) group_buffer_size )
+	{
+		read_size = group_buffer_size;
+
+		if( (size64_t) read_size > ( item->size - *item_offset ) )
+		{
+			read_size = (size_t) ( item->size - *item_offset );
+		}
+		extraction_group->first_item_index = *item_index;
+		extraction_group->last_item_index  = *item_index + 1;
+		extraction_group->item_offset      = *item_offset;
+		extraction_group->start_offset     = item->start_offset + (off64_t) *item_offset;
+		extraction_group->read_size        = read_size;
+
+		*item_offset += read_size;
+
+		if( *item_offset >= item->size )
+		{
+			*item_index  += 1;
+			*item_offset  = 0;
+		}
+		return( 1 );
+	}
+	read_size       = (size_t) item->size;
+	last_item_index = *item_index + 1;
+
+	while( last_item_index < extraction_scheduler->number_of_items )
+	{
+		next_item = &( extraction_scheduler->items[ last_item_index ] );
+
+		if( ( next_item->start_offset != ( item->start_offset + (off64_t) read_size ) )
+		 || ( next_item->size > (size64_t) ( group_buffer_size - read_size ) ) )
+		{
+			break;
+		}
+		read_size += (size_t) next_item->size;
+
+		last_item_index++;
+	}
+	extraction_group->first_item_index = *item_index;
+	extraction_group->last_item_index  = last_item_index;
+	extraction_group->item_offset      = 0;
+	extraction_group->start_offset     = item->start_offset;
+	extraction_group->read_size        = read_size;
+
+	*item_index  = last_item_index;
+	*item_offset = 0;
+
+	return( 1 );
+}
+
+/* Submits the read of a group
+ * If a read queue is provided the read is queued, otherwise the data is read directly
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extraction_scheduler_submit_group(
+     libfsntfs_extraction_group_t *extraction_group,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extraction_scheduler_submit_group";
+
+	if( extraction_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction group.",
+		 function );
+
+		return( -1 );
+	}
+	if( extraction_group->is_submitted != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extraction group - already submitted.",
+		 function );
+
+		return( -1 );
+	}
+	extraction_group->read_request.offset      = extraction_group->start_offset;
+	extraction_group->read_request.buffer      = extraction_group->buffer;
+	extraction_group->read_request.buffer_size = extraction_group->read_size;
+
+	if( read_queue != NULL )
+	{
+		if( libfsntfs_read_queue_submit_request(
+		     read_queue,
+		     &( extraction_group->read_request ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to submit read request.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		extraction_group->read_request.read_count = libbfio_handle_read_buffer_at_offset(
+		                                             file_io_handle,
+		                                             extraction_group->buffer,
+		                                             extraction_group->read_size,
+		                                             extraction_group->start_offset,
+		                                             error );
+
+		if( extraction_group->read_request.read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read group data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 extraction_group->start_offset,
+			 extraction_group->start_offset );
+
+			return( -1 );
+		}
+	}
+	extraction_group->is_submitted = 1;
+
+	return( 1 );
+}
+
+/* Waits for the read of a group to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extraction_scheduler_wait_for_group(
+     libfsntfs_extraction_group_t *extraction_group,
+     libfsntfs_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extraction_scheduler_wait_for_group";
+	ssize_t read_count    = 0;
+
+	if( extraction_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction group.",
+		 function );
+
+		return( -1 );
+	}
+	if( extraction_group->is_submitted == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extraction group - not submitted.",
+		 function );
+
+		return( -1 );
+	}
+	extraction_group->is_submitted = 0;
+
+	if( read_queue != NULL )
+	{
+		read_count = libfsntfs_read_queue_wait_for_request(
+		              read_queue,
+		              &( extraction_group->read_request ),
+		              error );
+	}
+	else
+	{
+		read_count = extraction_group->read_request.read_count;
+	}
+	if( read_count != (ssize_t) extraction_group->read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read group data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 extraction_group->start_offset,
+		 extraction_group->start_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Passes the data of a group that was read to the callback function
+ * Returns 1 if successful, 0 if the extraction was stopped or -1 on error
+ */
+int libfsntfs_extraction_scheduler_process_group(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     libfsntfs_extraction_group_t *extraction_group,
+     int (*callback_function)(
+            uint64_t mft_entry_index,
+            off64_t data_offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_extraction_item_t *item = NULL;
+	static char *function             = "libfsntfs_extraction_scheduler_process_group";
+	int item_index                    = 0;
+	int result                        = 1;
+
+	if( extraction_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( extraction_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extraction_group->first_item_index < 0 )
+	 || ( extraction_group->first_item_index >= extraction_group->last_item_index )
+	 || ( extraction_group->last_item_index > extraction_scheduler->number_of_items ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extraction group - item index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	for( item_index = extraction_group->first_item_index;
+	     item_index < extraction_group->last_item_index;
+	     item_index++ )
+	{
+		item = &( extraction_scheduler->items[ item_index ] );
+
+		if( item->size > (size64_t) extraction_group->read_size )
+		{
+			/* The group contains a part of a large item
+			 */
+			result = callback_function(
+			          item->mft_entry_index,
+			          item->data_offset + (off64_t) extraction_group->item_offset,
+			          extraction_group->buffer,
+			          extraction_group->read_size,
+			          user_data );
+		}
+		else
+		{
+			result = callback_function(
+			          item->mft_entry_index,
+			          item->data_offset,
+			          &( extraction_group->buffer[ item->start_offset - extraction_group->start_offset ] ),
+			          (size_t) item->size,
+			          user_data );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: callback function failed for MFT entry: %" PRIu64 ".",
+			 function,
+			 item->mft_entry_index );
+
+			return( -1 );
+		}
+		if( result != 1 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Runs the extraction scheduler
+ * The items are sorted and the data is read in a single forward pass over
+ * the volume. Items that are stored directly after each other in the volume
+ * are grouped and read using a single read up to the group buffer size.
+ * If a read queue is provided the buffer is divided into one group buffer per
+ * queue depth and the reads of the next groups are kept in flight while the
+ * callback function is called for the data of the current group
+ * The callback function is called for every part of the data of an item
+ * and should return 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful, 0 if the extraction was stopped or -1 on error
+ */
+int libfsntfs_extraction_scheduler_run(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_read_queue_t *read_queue,
+     int (*callback_function)(
+            uint64_t mft_entry_index,
+            off64_t data_offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_extraction_group_t *extraction_groups = NULL;
+	libfsntfs_extraction_item_t *item               = NULL;
+	static char *function                           = "libfsntfs_extraction_scheduler_run";
+	size64_t item_offset                            = 0;
+	size_t group_buffer_size                        = 0;
+	size_t read_size                                = 0;
+	int group_index                                 = 0;
+	int item_index                                  = 0;
+	int number_of_groups                            = 0;
+	int result                                      = 1;
+
+	if( extraction_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extraction scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( extraction_scheduler->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extraction scheduler - missing buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( extraction_scheduler->number_of_items == 0 )
+	{
+		return( 1 );
+	}
+	qsort(
+	 extraction_scheduler->items,
+	 (size_t) extraction_scheduler->number_of_items,
+	 sizeof( libfsntfs_extraction_item_t ),
+	 &libfsntfs_extraction_item_compare );
+
+	/* The sparse items are ordered before the items that require a read
+	 * hence the buffer only needs to be cleared once
+	 */
+	if( memory_set(
+	     extraction_scheduler->buffer,
+	     0,
+	     extraction_scheduler->buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* Pass the resident and sparse items first
+	 */
+	while( item_index < extraction_scheduler->number_of_items )
+	{
+		item = &( extraction_scheduler->items[ item_index ] );
+
+		if( item->resident_data != NULL )
+		{
+			result = callback_function(
+			          item->mft_entry_index,
+			          item->data_offset,
+			          item->resident_data,
+			          (size_t) item->size,
+			          user_data );
+		}
+		else if( ( item->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			/* Sparse items are passed in parts of the buffer size
+			 */
+			item_offset = 0;
+
+			while( item_offset < item->size )
+			{
+				read_size = extraction_scheduler->buffer_size;
+
+				if( (size64_t) read_size > ( item->size - item_offset ) )
+				{
+					read_size = (size_t) ( item->size - item_offset );
+				}
+				result = callback_function(
+				          item->mft_entry_index,
+				          item->data_offset + (off64_t) item_offset,
+				          extraction_scheduler->buffer,
+				          read_size,
+				          user_data );
+
+				if( result != 1 )
+				{
+					break;
+				}
+				item_offset += read_size;
+			}
+		}
+		else
+		{
+			break;
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: callback function failed for MFT entry: %" PRIu64 ".",
+			 function,
+			 item->mft_entry_index );
+
+			return( -1 );
+		}
+		if( result != 1 )
+		{
+			return( 0 );
+		}
+		item_index++;
+	}
+	if( item_index >= extraction_scheduler->number_of_items )
+	{
+		return( 1 );
+	}
+	/* Divide the buffer into a group buffer per read that is kept in flight
+	 */
+	number_of_groups = 1;
+
+	if( read_queue != NULL )
+	{
+		number_of_groups = read_queue->queue_depth;
+	}
+	if( (size_t) number_of_groups > extraction_scheduler->buffer_size )
+	{
+		number_of_groups = (int) extraction_scheduler->buffer_size;
+	}
+	group_buffer_size = extraction_scheduler->buffer_size / number_of_groups;
+
+	extraction_groups = (libfsntfs_extraction_group_t *) memory_allocate(
+	                                                      sizeof( libfsntfs_extraction_group_t ) * number_of_groups );
+
+	if( extraction_groups == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extraction groups.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     extraction_groups,
+	     0,
+	     sizeof( libfsntfs_extraction_group_t ) * number_of_groups ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extraction groups.",
+		 function );
+
+		memory_free(
+		 extraction_groups );
+
+		return( -1 );
+	}
+	item_offset = 0;
+
+	for( group_index = 0;
+	     group_index < number_of_groups;
+	     group_index++ )
+	{
+		extraction_groups[ group_index ].buffer = &( extraction_scheduler->buffer[ group_index * group_buffer_size ] );
+	}
+	/* Fill the read queue
+	 */
+	for( group_index = 0;
+	     group_index < number_of_groups;
+	     group_index++ )
+	{
+		result = libfsntfs_extraction_scheduler_get_next_group(
+		          extraction_scheduler,
+		          &item_index,
+		          &item_offset,
+		          group_buffer_size,
+		          &( extraction_groups[ group_index ] ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next group.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libfsntfs_extraction_scheduler_submit_group(
+		     &( extraction_groups[ group_index ] ),
+		     file_io_handle,
+		     read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to submit group: %d.",
+			 function,
+			 group_index );
+
+			goto on_error;
+		}
+	}
+	/* The groups are processed in the order they were submitted, after
+	 * processing a group its buffer is reused to submit the next group
+	 */
+	result      = 1;
+	group_index = 0;
+
+	while( extraction_groups[ group_index ].is_submitted != 0 )
+	{
+		if( libfsntfs_extraction_scheduler_wait_for_group(
+		     &( extraction_groups[ group_index ] ),
+		     read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read item: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 extraction_groups[ group_index ].first_item_index,
+			 extraction_groups[ group_index ].start_offset,
+			 extraction_groups[ group_index ].start_offset );
+
+			goto on_error;
+		}
+		result = libfsntfs_extraction_scheduler_process_group(
+		          extraction_scheduler,
+		          &( extraction_groups[ group_index ] ),
+		          callback_function,
+		          user_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to process group: %d.",
+			 function,
+			 group_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		result = libfsntfs_extraction_scheduler_get_next_group(
+		          extraction_scheduler,
+		          &item_index,
+		          &item_offset,
+		          group_buffer_size,
+		          &( extraction_groups[ group_index ] ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next group.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libfsntfs_extraction_scheduler_submit_group(
+			     &( extraction_groups[ group_index ] ),
+			     file_io_handle,
+			     read_queue,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to submit group: %d.",
+				 function,
+				 group_index );
+
+				goto on_error;
+			}
+		}
+		result      = 1;
+		group_index = ( group_index + 1 ) % number_of_groups;
+	}
+	/* When the extraction was stopped the reads that are still in flight
+	 * reference the buffer and are waited for
+	 */
+	for( group_index = 0;
+	     group_index < number_of_groups;
+	     group_index++ )
+	{
+		if( extraction_groups[ group_index ].is_submitted != 0 )
+		{
+			libfsntfs_extraction_scheduler_wait_for_group(
+			 &( extraction_groups[ group_index ] ),
+			 read_queue,
+			 NULL );
+		}
+	}
+	memory_free(
+	 extraction_groups );
+
+	return( result );
+
+on_error:
+	for( group_index = 0;
+	     group_index < number_of_groups;
+	     group_index++ )
+	{
+		if( extraction_groups[ group_index ].is_submitted != 0 )
+		{
+			libfsntfs_extraction_scheduler_wait_for_group(
+			 &( extraction_groups[ group_index ] ),
+			 read_queue,
+			 NULL );
+		}
+	}
+	memory_free(
+	 extraction_groups );
+
+	return( -1 );
+}
@@ -0,0 +1,207 @@
+/*
+ * Extraction scheduler functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_EXTRACTION_SCHEDULER_H )
+#define _LIBFSNTFS_EXTRACTION_SCHEDULER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_data_segment_table.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_read_queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_extraction_item libfsntfs_extraction_item_t;
+
+struct libfsntfs_extraction_item
+{
+	/* The MFT entry index
+	 */
+	uint64_t mft_entry_index;
+
+	/* The offset of the item in the data
+	 */
+	off64_t data_offset;
+
+	/* The start offset of the item in the volume
+	 */
+	off64_t start_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The range flags
+	 */
+	uint32_t range_flags;
+
+	/* The resident data
+	 * Contains a copy of the resident data or NULL if not set
+	 */
+	uint8_t *resident_data;
+};
+
+typedef struct libfsntfs_extraction_group libfsntfs_extraction_group_t;
+
+struct libfsntfs_extraction_group
+{
+	/* The index of the first item
+	 */
+	int first_item_index;
+
+	/* The index of the item directly after the last item
+	 */
+	int last_item_index;
+
+	/* The offset in the first item, used when an item is larger than the group buffer
+	 */
+	size64_t item_offset;
+
+	/* The start offset in the volume
+	 */
+	off64_t start_offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The read size
+	 */
+	size_t read_size;
+
+	/* The read request
+	 */
+	libfsntfs_read_request_t read_request;
+
+	/* Value to indicate the read was submitted and has not been waited for
+	 */
+	uint8_t is_submitted;
+};
+
+typedef struct libfsntfs_extraction_scheduler libfsntfs_extraction_scheduler_t;
+
+struct libfsntfs_extraction_scheduler
+{
+	/* The items
+	 */
+	libfsntfs_extraction_item_t *items;
+
+	/* The number of items
+	 */
+	int number_of_items;
+
+	/* The number of allocated items
+	 */
+	int number_of_allocated_items;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+};
+
+int libfsntfs_extraction_scheduler_initialize(
+     libfsntfs_extraction_scheduler_t **extraction_scheduler,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libfsntfs_extraction_scheduler_free(
+     libfsntfs_extraction_scheduler_t **extraction_scheduler,
+     libcerror_error_t **error );
+
+int libfsntfs_extraction_scheduler_append_item(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     uint64_t mft_entry_index,
+     off64_t data_offset,
+     off64_t start_offset,
+     size64_t size,
+     uint32_t range_flags,
+     const uint8_t *resident_data,
+     libcerror_error_t **error );
+
+int libfsntfs_extraction_scheduler_append_data_segment_table(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     uint64_t mft_entry_index,
+     libfsntfs_data_segment_table_t *data_segment_table,
+     libcerror_error_t **error );
+
+int libfsntfs_extraction_item_compare(
+     const void *first_extraction_item,
+     const void *second_extraction_item );
+
+int libfsntfs_extraction_scheduler_get_next_group(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     int *item_index,
+     size64_t *item_offset,
+     size_t group_buffer_size,
+     libfsntfs_extraction_group_t *extraction_group,
+     libcerror_error_t **error );
+
+int libfsntfs_extraction_scheduler_submit_group(
+     libfsntfs_extraction_group_t *extraction_group,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+int libfsntfs_extraction_scheduler_wait_for_group(
+     libfsntfs_extraction_group_t *extraction_group,
+     libfsntfs_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+int libfsntfs_extraction_scheduler_process_group(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     libfsntfs_extraction_group_t *extraction_group,
+     int (*callback_function)(
+            uint64_t mft_entry_index,
+            off64_t data_offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+int libfsntfs_extraction_scheduler_run(
+     libfsntfs_extraction_scheduler_t *extraction_scheduler,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_read_queue_t *read_queue,
+     int (*callback_function)(
+            uint64_t mft_entry_index,
+            off64_t data_offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_EXTRACTION_SCHEDULER_H ) */
+
@@ -23,11 +23,15 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsntfs_async_reader.h"
 #include "libfsntfs_attribute.h"
 #include "libfsntfs_cluster_block_stream.h"
 #include "libfsntfs_data_extent.h"
+#include "libfsntfs_data_readahead.h"
+#include "libfsntfs_data_segment_table.h"
 #include "libfsntfs_data_stream.h"
 #include "libfsntfs_definitions.h"
+#include "libfsntfs_directory_entries_iterator.h"
 #include "libfsntfs_directory_entries_tree.h"
 #include "libfsntfs_directory_entry.h"
 #include "libfsntfs_file_entry.h"
@@ -59,13 +63,130 @@ int libfsntfs_file_entry_initialize(
      libfsntfs_directory_entry_t *directory_entry,
      uint8_t flags,
      libcerror_error_t **error )
+{
+	libfsntfs_mft_entry_t *mft_entry = NULL;
+	static char *function            = "libfsntfs_file_entry_initialize";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_file_system_get_mft_entry_by_index_no_cache(
+	     file_system,
+	     file_io_handle,
+	     mft_entry_index,
+	     &mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		return( -1 );
+	}
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		return( -1 );
+	}
+	if( libfsntfs_file_entry_initialize_from_mft_entry(
+	     file_entry,
+	     io_handle,
+	     file_io_handle,
+	     file_system,
+	     mft_entry,
+	     directory_entry,
+	     flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry from MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates a file entry from a MFT entry
+ * Make sure the value file_entry is referencing, is set to NULL
+ * The file entry takes over management of the MFT entry on success
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_entry_initialize_from_mft_entry(
+     libfsntfs_file_entry_t **file_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_file_system_t *file_system,
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_directory_entry_t *directory_entry,
+     uint8_t flags,
+     libcerror_error_t **error )
 {
 	libfsntfs_attribute_t *reparse_point_attribute           = NULL;
 	libfsntfs_internal_file_entry_t *internal_file_entry     = NULL;
 	libfsntfs_mft_attribute_t *data_extents_attribute        = NULL;
 	libfsntfs_mft_attribute_t *wof_compressed_data_attribute = NULL;
-	libfsntfs_mft_entry_t *mft_entry                         = NULL;
-	static char *function                                    = "libfsntfs_file_entry_initialize";
+	static char *function                                    = "libfsntfs_file_entry_initialize_from_mft_entry";
 	uint64_t base_record_file_reference                      = 0;
 	uint32_t compression_method                              = 0;
 	int result                                               = 0;
@@ -114,6 +235,17 @@ int libfsntfs_file_entry_initialize(
 
 		return( -1 );
 	}
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
 	internal_file_entry = memory_allocate_structure(
 	                       libfsntfs_internal_file_entry_t );
 
@@ -145,35 +277,6 @@ int libfsntfs_file_entry_initialize(
 
 		return( -1 );
 	}
-	if( libfsntfs_file_system_get_mft_entry_by_index_no_cache(
-	     file_system,
-	     file_io_handle,
-	     mft_entry_index,
-	     &mft_entry,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
-		 function,
-		 mft_entry_index );
-
-		goto on_error;
-	}
-	if( mft_entry == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing MFT entry: %" PRIu64 ".",
-		 function,
-		 mft_entry_index );
-
-		return( -1 );
-	}
 	if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) == 0 )
 	{
 		result = libfsntfs_mft_entry_get_base_record_file_reference(
@@ -195,39 +298,11 @@ int libfsntfs_file_entry_initialize(
 		if( ( result == 1 )
 		 && ( base_record_file_reference == 0 ) )
 		{
+			/* The directory entries tree is read on demand
+			 */
 			if( mft_entry->has_i30_index != 0 )
 			{
-				if( libfsntfs_directory_entries_tree_initialize(
-				     &( internal_file_entry->directory_entries_tree ),
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create directory entries tree.",
-					 function );
-
-					goto on_error;
-				}
-				if( libfsntfs_directory_entries_tree_read_from_i30_index(
-				     internal_file_entry->directory_entries_tree,
-				     io_handle,
-				     file_io_handle,
-				     mft_entry,
-				     flags,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read MFT entry: %" PRIu32 " directory entries tree.",
-					 function,
-					 mft_entry->index );
-
-					goto on_error;
-				}
+				internal_file_entry->has_directory_entries_tree = 1;
 			}
 			if( mft_entry->data_attribute != NULL )
 			{
@@ -309,6 +384,73 @@ int libfsntfs_file_entry_initialize(
 
 					goto on_error;
 				}
+				if( wof_compressed_data_attribute == NULL )
+				{
+					if( libfsntfs_data_segment_table_initialize(
+					     &( internal_file_entry->data_segment_table ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create data segment table.",
+						 function );
+
+						goto on_error;
+					}
+					result = libfsntfs_data_segment_table_read_data_attribute(
+					          internal_file_entry->data_segment_table,
+					          mft_entry->data_attribute,
+					          error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read data segment table.",
+						 function );
+
+						goto on_error;
+					}
+					else if( result == 0 )
+					{
+						/* Compressed data is read using the data cluster block stream
+						 */
+						if( libfsntfs_data_segment_table_free(
+						     &( internal_file_entry->data_segment_table ),
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+							 "%s: unable to free data segment table.",
+							 function );
+
+							goto on_error;
+						}
+					}
+					else if( io_handle->data_readahead_size > 0 )
+					{
+						if( libfsntfs_data_readahead_initialize(
+						     &( internal_file_entry->data_readahead ),
+						     io_handle->data_readahead_size,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+							 "%s: unable to create data read-ahead.",
+							 function );
+
+							goto on_error;
+						}
+					}
+				}
 			}
 		}
 	}
@@ -340,12 +482,6 @@ int libfsntfs_file_entry_initialize(
 	return( 1 );
 
 on_error:
-	if( mft_entry != NULL )
-	{
-		libfsntfs_mft_entry_free(
-		 &mft_entry,
-		 NULL );
-	}
 	if( internal_file_entry != NULL )
 	{
 		if( internal_file_entry->data_cluster_block_stream != NULL )
@@ -354,6 +490,18 @@ on_error:
 			 &( internal_file_entry->data_cluster_block_stream ),
 			 NULL );
 		}
+		if( internal_file_entry->data_readahead != NULL )
+		{
+			libfsntfs_data_readahead_free(
+			 &( internal_file_entry->data_readahead ),
+			 NULL );
+		}
+		if( internal_file_entry->data_segment_table != NULL )
+		{
+			libfsntfs_data_segment_table_free(
+			 &( internal_file_entry->data_segment_table ),
+			 NULL );
+		}
 		if( internal_file_entry->directory_entries_tree != NULL )
 		{
 			libfsntfs_directory_entries_tree_free(
@@ -433,6 +581,38 @@ int libfsntfs_file_entry_free(
 				result = -1;
 			}
 		}
+		if( internal_file_entry->data_segment_table != NULL )
+		{
+			if( libfsntfs_data_segment_table_free(
+			     &( internal_file_entry->data_segment_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data segment table.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_file_entry->data_readahead != NULL )
+		{
+			if( libfsntfs_data_readahead_free(
+			     &( internal_file_entry->data_readahead ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data read-ahead.",
+				 function );
+
+				result = -1;
+			}
+		}
 		/* The reparse_point_attribute, security_descriptor_attribute and standard_information_attribute references are managed by the attributes_array
 		 */
 		if( internal_file_entry->attributes_array != NULL )
@@ -887,18 +1067,41 @@ int libfsntfs_internal_file_entry_get_attribute_by_index(
 		}
 		if( attribute_type == LIBFSNTFS_ATTRIBUTE_TYPE_ATTRIBUTE_LIST )
 		{
-			( (libfsntfs_internal_attribute_t *) safe_attribute )->value = (intptr_t *) mft_entry->attribute_list;
-		}
-		else
-		{
-			if( libfsntfs_internal_attribute_read_value(
-			     (libfsntfs_internal_attribute_t *) safe_attribute,
-			     internal_file_entry->io_handle,
-			     internal_file_entry->file_io_handle,
-			     internal_file_entry->flags,
-			     error ) != 1 )
+			/* The attribute list is not read when the metadata cache provided
+			 * the attribute list data MFT entries
+			 */
+			if( ( mft_entry->attribute_list == NULL )
+			 && ( mft_entry->list_attribute != NULL )
+			 && ( ( internal_file_entry->flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) == 0 ) )
 			{
-				libcerror_error_set(
+				if( libfsntfs_mft_entry_read_attribute_list(
+				     mft_entry,
+				     internal_file_entry->io_handle,
+				     internal_file_entry->file_io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read attribute list.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			( (libfsntfs_internal_attribute_t *) safe_attribute )->value = (intptr_t *) mft_entry->attribute_list;
+		}
+		else
+		{
+			if( libfsntfs_internal_attribute_read_value(
+			     (libfsntfs_internal_attribute_t *) safe_attribute,
+			     internal_file_entry->io_handle,
+			     internal_file_entry->file_io_handle,
+			     internal_file_entry->flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_READ_FAILED,
@@ -3081,7 +3284,6 @@ int libfsntfs_internal_file_entry_get_path_hint(
 			          internal_file_entry->file_io_handle,
 			          parent_file_reference,
 			          &parent_path_hint,
-			          0,
 			          error );
 
 			if( result == -1 )
@@ -3192,6 +3394,22 @@ int libfsntfs_internal_file_entry_get_path_hint(
 		{
 			safe_path_hint->path[ 0 ] = '\\';
 		}
+		if( parent_path_hint != NULL )
+		{
+			if( libfsntfs_path_hint_free(
+			     &parent_path_hint,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free parent path hint.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		( (libfsntfs_internal_attribute_t *) attribute )->path_hint = safe_path_hint;
 	}
 	*path_hint = ( (libfsntfs_internal_attribute_t *) attribute )->path_hint;
@@ -3199,6 +3417,12 @@ int libfsntfs_internal_file_entry_get_path_hint(
 	return( 1 );
 
 on_error:
+	if( parent_path_hint != NULL )
+	{
+		libfsntfs_path_hint_free(
+		 &parent_path_hint,
+		 NULL );
+	}
 	if( safe_path_hint != NULL )
 	{
 		libfsntfs_path_hint_free(
@@ -5328,6 +5552,97 @@ int libfsntfs_file_entry_get_alternate_data_stream_by_utf16_name(
 	return( result );
 }
 
+/* Reads the directory entries tree if not already read
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_file_entry_read_directory_entries_tree(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entries_tree_t *directory_entries_tree = NULL;
+	static char *function                                      = "libfsntfs_internal_file_entry_read_directory_entries_tree";
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_file_entry->has_directory_entries_tree == 0 )
+	 || ( internal_file_entry->directory_entries_tree != NULL ) )
+	{
+		return( 1 );
+	}
+	if( libfsntfs_directory_entries_tree_initialize(
+	     &directory_entries_tree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory entries tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_file_entry->file_system != NULL )
+	{
+		directory_entries_tree->upcase_table = internal_file_entry->file_system->upcase_table;
+	}
+	if( libfsntfs_directory_entries_tree_read_from_i30_index(
+	     directory_entries_tree,
+	     internal_file_entry->io_handle,
+	     internal_file_entry->file_io_handle,
+	     internal_file_entry->mft_entry,
+	     internal_file_entry->flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu32 " directory entries tree.",
+		 function,
+		 internal_file_entry->mft_entry->index );
+
+		goto on_error;
+	}
+	/* The directory entries tree is kept for the lifetime of the file entry
+	 * hence it is worthwhile to build the names hash table on first lookup
+	 */
+	directory_entries_tree->use_names_hash_table = 1;
+
+	internal_file_entry->directory_entries_tree = directory_entries_tree;
+
+	return( 1 );
+
+on_error:
+	if( directory_entries_tree != NULL )
+	{
+		libfsntfs_directory_entries_tree_free(
+		 &directory_entries_tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Retrieves the number of sub file entries
  * Returns 1 if successful or -1 on error
  */
@@ -5366,7 +5681,7 @@ int libfsntfs_file_entry_get_number_of_sub_file_entries(
 		return( -1 );
 	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_file_entry->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5374,13 +5689,26 @@ int libfsntfs_file_entry_get_number_of_sub_file_entries(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_file_entry->directory_entries_tree != NULL )
+	if( libfsntfs_internal_file_entry_read_directory_entries_tree(
+	     internal_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory entries tree.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_file_entry->directory_entries_tree != NULL )
 	{
 		if( libfsntfs_directory_entries_tree_get_number_of_entries(
 		     internal_file_entry->directory_entries_tree,
@@ -5398,7 +5726,7 @@ int libfsntfs_file_entry_get_number_of_sub_file_entries(
 		}
 	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_file_entry->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5406,7 +5734,7 @@ int libfsntfs_file_entry_get_number_of_sub_file_entries(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -5419,19 +5747,32 @@ int libfsntfs_file_entry_get_number_of_sub_file_entries(
 	return( result );
 }
 
-/* Retrieves the sub file entry for the specific index
- * Returns 1 if successful or -1 on error
+/* Iterates the sub file entries
+ * The sub file entries are read directly from the $I30 index in file name order,
+ * without building the directory entries tree. The sub file entries do not have
+ * their short name set.
+ * The callback function is called with every sub file entry, the sub file entry
+ * is freed after the callback function returns
+ * The file entry is locked during the iteration, hence the callback function
+ * must not use the file entry that is being iterated
+ * The callback function should return 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful, 0 if the iteration was stopped or -1 on error
  */
-int libfsntfs_file_entry_get_sub_file_entry_by_index(
+int libfsntfs_file_entry_iterate_sub_file_entries(
      libfsntfs_file_entry_t *file_entry,
-     int sub_file_entry_index,
-     libfsntfs_file_entry_t **sub_file_entry,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *sub_file_entry,
+            void *user_data ),
+     void *user_data,
      libcerror_error_t **error )
 {
-	libfsntfs_directory_entry_t *sub_directory_entry     = NULL;
-	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
-	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_index";
-	uint64_t mft_entry_index                             = 0;
+	libfsntfs_directory_entries_iterator_t *directory_entries_iterator = NULL;
+	libfsntfs_directory_entry_t *sub_directory_entry                   = NULL;
+	libfsntfs_file_entry_t *sub_file_entry                             = NULL;
+	libfsntfs_internal_file_entry_t *internal_file_entry               = NULL;
+	static char *function                                              = "libfsntfs_file_entry_iterate_sub_file_entries";
+	uint64_t mft_entry_index                                           = 0;
+	int result                                                         = 1;
 
 	if( file_entry == NULL )
 	{
@@ -5446,111 +5787,217 @@ int libfsntfs_file_entry_get_sub_file_entry_by_index(
 	}
 	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
 
-	if( sub_file_entry == NULL )
+	if( callback_function == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid sub file entry.",
+		 "%s: invalid callback function.",
 		 function );
 
 		return( -1 );
 	}
-	if( *sub_file_entry != NULL )
+	if( internal_file_entry->has_directory_entries_tree == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid sub file entry value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-/* TODO add thread lock suport */
-
-	if( libfsntfs_directory_entries_tree_get_entry_by_index(
-	     internal_file_entry->directory_entries_tree,
+#endif
+	if( libfsntfs_directory_entries_iterator_initialize(
+	     &directory_entries_iterator,
+	     internal_file_entry->io_handle,
 	     internal_file_entry->file_io_handle,
-	     sub_file_entry_index,
-	     &sub_directory_entry,
+	     internal_file_entry->mft_entry,
+	     internal_file_entry->flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from directory entries tree.",
-		 function,
-		 sub_file_entry_index );
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory entries iterator.",
+		 function );
 
 		goto on_error;
 	}
-	if( libfsntfs_directory_entry_get_mft_entry_index(
-	     sub_directory_entry,
-	     &mft_entry_index,
+	while( result == 1 )
+	{
+		result = libfsntfs_directory_entries_iterator_get_next_entry(
+		          directory_entries_iterator,
+		          internal_file_entry->file_io_handle,
+		          &sub_directory_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next directory entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			result = 1;
+
+			break;
+		}
+		if( libfsntfs_directory_entry_get_mft_entry_index(
+		     sub_directory_entry,
+		     &mft_entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry index.",
+			 function );
+
+			goto on_error;
+		}
+		/* sub_file_entry takes over management of sub_directory_entry
+		 */
+		if( libfsntfs_file_entry_initialize(
+		     &sub_file_entry,
+		     internal_file_entry->io_handle,
+		     internal_file_entry->file_io_handle,
+		     internal_file_entry->file_system,
+		     mft_entry_index,
+		     sub_directory_entry,
+		     internal_file_entry->flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sub file entry with MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		sub_directory_entry = NULL;
+
+		result = callback_function(
+		          sub_file_entry,
+		          user_data );
+
+		if( libfsntfs_file_entry_free(
+		     &sub_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub file entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: callback function failed for sub file entry with MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+	}
+	if( libfsntfs_directory_entries_iterator_free(
+	     &directory_entries_iterator,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry index.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free directory entries iterator.",
 		 function );
 
 		goto on_error;
 	}
-	/* sub_file_entry takes over management of sub_directory_entry
-	 */
-	if( libfsntfs_file_entry_initialize(
-	     sub_file_entry,
-	     internal_file_entry->io_handle,
-	     internal_file_entry->file_io_handle,
-	     internal_file_entry->file_system,
-	     mft_entry_index,
-	     sub_directory_entry,
-	     internal_file_entry->flags,
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sub file entry: %d with MFT entry: %" PRIu64 ".",
-		 function,
-		 sub_file_entry_index,
-		 mft_entry_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( result );
 
 on_error:
+	if( sub_file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &sub_file_entry,
+		 NULL );
+	}
 	if( sub_directory_entry != NULL )
 	{
 		libfsntfs_directory_entry_free(
 		 &sub_directory_entry,
 		 NULL );
 	}
+	if( directory_entries_iterator != NULL )
+	{
+		libfsntfs_directory_entries_iterator_free(
+		 &directory_entries_iterator,
+		 NULL );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_file_entry->read_write_lock,
+	 NULL );
+#endif
 	return( -1 );
 }
 
-/* Retrieves the sub file entry for an UTF-8 encoded name
- * Returns 1 if successful, 0 if no such file entry or -1 on error
+/* Retrieves the sub file entry for the specific index
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_file_entry_get_sub_file_entry_by_utf8_name(
+int libfsntfs_file_entry_get_sub_file_entry_by_index(
      libfsntfs_file_entry_t *file_entry,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     int sub_file_entry_index,
      libfsntfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error )
 {
 	libfsntfs_directory_entry_t *sub_directory_entry     = NULL;
 	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
-	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_utf8_name";
+	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_index";
 	uint64_t mft_entry_index                             = 0;
-	int result                                           = 0;
+	int result                                           = 1;
 
 	if( file_entry == NULL )
 	{
@@ -5587,30 +6034,71 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf8_name(
 
 		return( -1 );
 	}
-/* TODO add thread lock suport */
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-	result = libfsntfs_directory_entries_tree_get_entry_by_utf8_name(
-	          internal_file_entry->directory_entries_tree,
-	          internal_file_entry->file_io_handle,
-	          utf8_string,
-	          utf8_string_length,
-	          &sub_directory_entry,
-	          error );
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_internal_file_entry_read_directory_entries_tree(
+	     internal_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory entries tree.",
+		 function );
 
-	if( result == -1 )
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve directory entry.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	else if( result == 0 )
+#endif
+	if( result != 1 )
 	{
-		return( 0 );
+		return( -1 );
+	}
+/* TODO add thread lock suport */
+
+	if( libfsntfs_directory_entries_tree_get_entry_by_index(
+	     internal_file_entry->directory_entries_tree,
+	     internal_file_entry->file_io_handle,
+	     sub_file_entry_index,
+	     &sub_directory_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %d from directory entries tree.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
 	}
 	if( libfsntfs_directory_entry_get_mft_entry_index(
 	     sub_directory_entry,
@@ -5642,8 +6130,9 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf8_name(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sub file entry with MFT entry: %" PRIu64 ".",
+		 "%s: unable to create sub file entry: %d with MFT entry: %" PRIu64 ".",
 		 function,
+		 sub_file_entry_index,
 		 mft_entry_index );
 
 		goto on_error;
@@ -5660,21 +6149,21 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the sub file entry for an UTF-16 encoded name
+/* Retrieves the sub file entry for an UTF-8 encoded name
  * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
-int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
+int libfsntfs_file_entry_get_sub_file_entry_by_utf8_name(
      libfsntfs_file_entry_t *file_entry,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
      libfsntfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error )
 {
 	libfsntfs_directory_entry_t *sub_directory_entry     = NULL;
 	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
-	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_utf16_name";
+	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_utf8_name";
 	uint64_t mft_entry_index                             = 0;
-	int result                                           = 0;
+	int result                                           = 1;
 
 	if( file_entry == NULL )
 	{
@@ -5709,15 +6198,62 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
 		 "%s: invalid sub file entry value already set.",
 		 function );
 
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_internal_file_entry_read_directory_entries_tree(
+	     internal_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory entries tree.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
 		return( -1 );
 	}
 /* TODO add thread lock suport */
 
-	result = libfsntfs_directory_entries_tree_get_entry_by_utf16_name(
+	result = libfsntfs_directory_entries_tree_get_entry_by_utf8_name(
 	          internal_file_entry->directory_entries_tree,
 	          internal_file_entry->file_io_handle,
-	          utf16_string,
-	          utf16_string_length,
+	          utf8_string,
+	          utf8_string_length,
 	          &sub_directory_entry,
 	          error );
 
@@ -5764,38 +6300,1012 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sub file entry with MFT entry: %" PRIu64 ".",
-		 function,
-		 mft_entry_index );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub file entry with MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sub_directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &sub_directory_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the sub file entry for an UTF-16 encoded name
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
+     libfsntfs_file_entry_t *file_entry,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_file_entry_t **sub_file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_t *sub_directory_entry     = NULL;
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_utf16_name";
+	uint64_t mft_entry_index                             = 0;
+	int result                                           = 1;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+	if( sub_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sub_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sub file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_internal_file_entry_read_directory_entries_tree(
+	     internal_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory entries tree.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+/* TODO add thread lock suport */
+
+	result = libfsntfs_directory_entries_tree_get_entry_by_utf16_name(
+	          internal_file_entry->directory_entries_tree,
+	          internal_file_entry->file_io_handle,
+	          utf16_string,
+	          utf16_string_length,
+	          &sub_directory_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve directory entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_directory_entry_get_mft_entry_index(
+	     sub_directory_entry,
+	     &mft_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry index.",
+		 function );
+
+		goto on_error;
+	}
+	/* sub_file_entry takes over management of sub_directory_entry
+	 */
+	if( libfsntfs_file_entry_initialize(
+	     sub_file_entry,
+	     internal_file_entry->io_handle,
+	     internal_file_entry->file_io_handle,
+	     internal_file_entry->file_system,
+	     mft_entry_index,
+	     sub_directory_entry,
+	     internal_file_entry->flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub file entry with MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sub_directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &sub_directory_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of child file entries
+ * The child file entries are determined from the parent file reference in
+ * the $FILE_NAME attributes of all the MFT entries. Unlike the sub file entries
+ * this includes deleted and orphaned file entries that are no longer referenced
+ * by the directory index. Children that refer to a previous use of the MFT entry,
+ * with a different parent sequence number, are not included. Since the sequence
+ * number is updated when the MFT entry is deleted, the children of a deleted
+ * directory that refer to the previous sequence number are included.
+ * The children index is read on first use
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_entry_get_number_of_child_file_entries(
+     libfsntfs_file_entry_t *file_entry,
+     int *number_of_child_file_entries,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_get_number_of_child_file_entries";
+	int is_allocated                                     = 0;
+	int result                                           = 1;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	is_allocated = libfsntfs_mft_entry_is_allocated(
+	                internal_file_entry->mft_entry,
+	                error );
+
+	if( is_allocated == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if MFT entry is allocated.",
+		 function );
+
+		result = -1;
+	}
+	else if( libfsntfs_file_system_get_number_of_children(
+	          internal_file_entry->file_system,
+	          internal_file_entry->file_io_handle,
+	          internal_file_entry->mft_entry->file_reference,
+	          (uint8_t) is_allocated,
+	          number_of_child_file_entries,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of children.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the child file entry for the specific index
+ * Refer to libfsntfs_file_entry_get_number_of_child_file_entries for more information
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_entry_get_child_file_entry_by_index(
+     libfsntfs_file_entry_t *file_entry,
+     int child_file_entry_index,
+     libfsntfs_file_entry_t **child_file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_get_child_file_entry_by_index";
+	uint64_t mft_entry_index                             = 0;
+	int is_allocated                                     = 0;
+	int result                                           = 1;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( child_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid child file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *child_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid child file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	is_allocated = libfsntfs_mft_entry_is_allocated(
+	                internal_file_entry->mft_entry,
+	                error );
+
+	if( is_allocated == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if MFT entry is allocated.",
+		 function );
+
+		result = -1;
+	}
+	else if( libfsntfs_file_system_get_child_mft_entry_index_by_index(
+	          internal_file_entry->file_system,
+	          internal_file_entry->file_io_handle,
+	          internal_file_entry->mft_entry->file_reference,
+	          (uint8_t) is_allocated,
+	          child_file_entry_index,
+	          &mft_entry_index,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve child: %d MFT entry index.",
+		 function,
+		 child_file_entry_index );
+
+		result = -1;
+	}
+	else if( libfsntfs_file_entry_initialize(
+	          child_file_entry,
+	          internal_file_entry->io_handle,
+	          internal_file_entry->file_io_handle,
+	          internal_file_entry->file_system,
+	          mft_entry_index,
+	          NULL,
+	          internal_file_entry->flags,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create child file entry: %d with MFT entry: %" PRIu64 ".",
+		 function,
+		 child_file_entry_index,
+		 mft_entry_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		libfsntfs_file_entry_free(
+		 child_file_entry,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads data at a specific offset from the default data stream (nameless $DATA attribute)
+ * and sets the current offset to the end of the data read
+ * Uncompressed data is read using the data segment table, where sequential reads
+ * are read ahead
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_internal_file_entry_read_buffer_at_offset(
+         libfsntfs_internal_file_entry_t *internal_file_entry,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_internal_file_entry_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->data_segment_table == NULL )
+	{
+		read_count = libfdata_stream_read_buffer_at_offset(
+		              internal_file_entry->data_cluster_block_stream,
+		              (intptr_t *) internal_file_entry->file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              0,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from data cluster block stream.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	if( internal_file_entry->data_readahead != NULL )
+	{
+		read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+		              internal_file_entry->data_readahead,
+		              internal_file_entry->data_segment_table,
+		              internal_file_entry->file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+	}
+	else
+	{
+		read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+		              internal_file_entry->data_segment_table,
+		              internal_file_entry->file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+	}
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from data segment table.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data cluster block stream maintains the current offset
+	 */
+	if( libfdata_stream_seek_offset(
+	     internal_file_entry->data_cluster_block_stream,
+	     offset + (off64_t) read_count,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in data cluster block stream.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads data at the current offset from the default data stream (nameless $DATA attribute)
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_file_entry_read_buffer(
+         libfsntfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_read_buffer";
+	off64_t current_offset                               = 0;
+	ssize_t read_count                                   = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->data_attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing data attribute.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfdata_stream_get_offset(
+	     internal_file_entry->data_cluster_block_stream,
+	     &current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current offset from data cluster block stream.",
+		 function );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libfsntfs_internal_file_entry_read_buffer_at_offset(
+		              internal_file_entry,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              current_offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data at a specific offset from the default data stream (nameless $DATA attribute)
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_file_entry_read_buffer_at_offset(
+         libfsntfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_read_buffer_at_offset";
+	ssize_t read_count                                   = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->data_attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing data attribute.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libfsntfs_internal_file_entry_read_buffer_at_offset(
+	              internal_file_entry,
+	              (uint8_t *) buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data at a specific offset from the default data stream (nameless $DATA attribute)
+ * using a specific file IO handle, the current offset is not changed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_internal_file_entry_pread_buffer(
+         libfsntfs_internal_file_entry_t *internal_file_entry,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function  = "libfsntfs_internal_file_entry_pread_buffer";
+	off64_t current_offset = 0;
+	ssize_t read_count     = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->data_attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing data attribute.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data segment table is not changed after the file entry was created
+	 * hence a read lock suffices
+	 */
+	if( internal_file_entry->data_segment_table != NULL )
+	{
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+		              internal_file_entry->data_segment_table,
+		              file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from data segment table.",
+			 function );
+
+			read_count = -1;
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		return( read_count );
+	}
+	/* Compressed data is read using the data cluster block stream
+	 * after which its current offset is restored
+	 */
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfdata_stream_get_offset(
+	     internal_file_entry->data_cluster_block_stream,
+	     &current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current offset from data cluster block stream.",
+		 function );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libfdata_stream_read_buffer_at_offset(
+		              internal_file_entry->data_cluster_block_stream,
+		              (intptr_t *) file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              0,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from data cluster block stream.",
+			 function );
+
+			read_count = -1;
+		}
+		if( libfdata_stream_seek_offset(
+		     internal_file_entry->data_cluster_block_stream,
+		     current_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to restore current offset of data cluster block stream.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data at a specific offset from the default data stream (nameless $DATA attribute)
+ * Unlike libfsntfs_file_entry_read_buffer_at_offset the current offset is not changed,
+ * hence multiple threads can read different parts of the same file entry concurrently
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_file_entry_pread_buffer(
+         libfsntfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_pread_buffer";
+	ssize_t read_count                                   = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
 
-on_error:
-	if( sub_directory_entry != NULL )
+	read_count = libfsntfs_internal_file_entry_pread_buffer(
+	              internal_file_entry,
+	              internal_file_entry->file_io_handle,
+	              (uint8_t *) buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
 	{
-		libfsntfs_directory_entry_free(
-		 &sub_directory_entry,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
 	}
-	return( -1 );
+	return( read_count );
 }
 
-/* Reads data at the current offset from the default data stream (nameless $DATA attribute)
- * Returns the number of bytes read or -1 on error
+/* Reads multiple ranges of data from the default data stream (nameless $DATA attribute)
+ * The ranges are read in the order they are stored in the volume, where neighbouring
+ * ranges are read using a single read. The number of bytes read per range is stored
+ * in range_read_counts. The current offset is not changed
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libfsntfs_file_entry_read_buffer(
-         libfsntfs_file_entry_t *file_entry,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libfsntfs_file_entry_read_ranges(
+     libfsntfs_file_entry_t *file_entry,
+     const off64_t *range_offsets,
+     const size_t *range_sizes,
+     uint8_t **range_buffers,
+     ssize_t *range_read_counts,
+     int number_of_ranges,
+     libcerror_error_t **error )
 {
 	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
-	static char *function                                = "libfsntfs_file_entry_read_buffer";
-	ssize_t read_count                                   = 0;
+	static char *function                                = "libfsntfs_file_entry_read_ranges";
+	int result                                           = 0;
 
 	if( file_entry == NULL )
 	{
@@ -5821,6 +7331,63 @@ ssize_t libfsntfs_file_entry_read_buffer(
 
 		return( -1 );
 	}
+	if( internal_file_entry->data_segment_table != NULL )
+	{
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		result = libfsntfs_data_segment_table_read_ranges(
+		          internal_file_entry->data_segment_table,
+		          internal_file_entry->file_io_handle,
+		          range_offsets,
+		          range_sizes,
+		          range_buffers,
+		          range_read_counts,
+		          number_of_ranges,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ranges from data segment table.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		return( result );
+	}
+	/* Compressed data is read using the data cluster block stream
+	 */
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_file_entry->read_write_lock,
@@ -5836,24 +7403,26 @@ ssize_t libfsntfs_file_entry_read_buffer(
 		return( -1 );
 	}
 #endif
-	read_count = libfdata_stream_read_buffer(
-	              internal_file_entry->data_cluster_block_stream,
-	              (intptr_t *) internal_file_entry->file_io_handle,
-	              buffer,
-	              buffer_size,
-	              0,
-	              error );
+	result = libfsntfs_cluster_block_stream_read_ranges(
+	          internal_file_entry->data_cluster_block_stream,
+	          internal_file_entry->file_io_handle,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          number_of_ranges,
+	          error );
 
-	if( read_count < 0 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from data cluster block stream.",
+		 "%s: unable to read ranges from data cluster block stream.",
 		 function );
 
-		read_count = -1;
+		result = -1;
 	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -5870,22 +7439,37 @@ ssize_t libfsntfs_file_entry_read_buffer(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Reads data at a specific offset from the default data stream (nameless $DATA attribute)
- * Returns the number of bytes read or -1 on error
+/* Reads data at a specific offset from the default data stream (nameless $DATA attribute) asynchronously
+ * The read is performed by a thread of the asynchronous reader of the volume,
+ * after which the callback function is called on that thread with the number
+ * of bytes read, or -1 and the error if the read failed. The error is freed
+ * after the callback function returns. The current offset is not changed
+ * The file entry and buffer must remain valid until the callback function was called
+ * Changing the number of threads and closing the volume wait for the asynchronous
+ * read threads to stop, hence the callback function must not change the number of
+ * asynchronous read threads of the volume or close the volume
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libfsntfs_file_entry_read_buffer_at_offset(
-         libfsntfs_file_entry_t *file_entry,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libfsntfs_file_entry_read_buffer_at_offset_async(
+     libfsntfs_file_entry_t *file_entry,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+             libfsntfs_file_entry_t *file_entry,
+             void *buffer,
+             ssize_t read_count,
+             off64_t offset,
+             libcerror_error_t *error,
+             void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
 {
 	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
-	static char *function                                = "libfsntfs_file_entry_read_buffer_at_offset";
-	ssize_t read_count                                   = 0;
+	static char *function                                = "libfsntfs_file_entry_read_buffer_at_offset_async";
 
 	if( file_entry == NULL )
 	{
@@ -5900,68 +7484,50 @@ ssize_t libfsntfs_file_entry_read_buffer_at_offset(
 	}
 	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
 
-	if( internal_file_entry->data_attribute == NULL )
+	if( internal_file_entry->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file entry - missing data attribute.",
+		 "%s: invalid file entry - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_file_entry->read_write_lock,
-	     error ) != 1 )
+	if( internal_file_entry->data_attribute == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing data attribute.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	read_count = libfdata_stream_read_buffer_at_offset(
-	              internal_file_entry->data_cluster_block_stream,
-	              (intptr_t *) internal_file_entry->file_io_handle,
-	              buffer,
-	              buffer_size,
-	              offset,
-	              0,
-	              error );
-
-	if( read_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from data cluster block stream.",
-		 function );
-
-		read_count = -1;
-	}
-#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_file_entry->read_write_lock,
+	if( libfsntfs_async_reader_submit_read(
+	     internal_file_entry->io_handle->async_reader,
+	     (intptr_t *) internal_file_entry,
+	     internal_file_entry->file_io_handle,
+	     (ssize_t (*)(intptr_t *, libbfio_handle_t *, uint8_t *, size_t, off64_t, libcerror_error_t **)) &libfsntfs_internal_file_entry_pread_buffer,
+	     (uint8_t *) buffer,
+	     buffer_size,
+	     offset,
+	     (void (*)(intptr_t *, uint8_t *, ssize_t, off64_t, libcerror_error_t *, void *)) callback_function,
+	     user_data,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to submit asynchronous read.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( read_count );
+	return( 1 );
 }
 
 /* Seeks a certain offset in the default data stream (nameless $DATA attribute)
@@ -6224,6 +7790,146 @@ int libfsntfs_file_entry_get_size(
 	return( result );
 }
 
+/* Retrieves the next range of data of the default data stream (nameless $DATA attribute) at or after a specific offset
+ * Sparse regions are skipped, so that the data can be read without the holes,
+ * similar to SEEK_DATA and SEEK_HOLE. For compressed data holes are not
+ * detected and the remainder of the data is returned as a single range
+ * Returns 1 if successful, 0 if there is no data at or after the offset or -1 on error
+ */
+int libfsntfs_file_entry_get_next_data_range(
+     libfsntfs_file_entry_t *file_entry,
+     off64_t offset,
+     off64_t *data_range_offset,
+     size64_t *data_range_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_get_next_data_range";
+	size64_t data_size                                   = 0;
+	int result                                           = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data range size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file_entry->data_segment_table != NULL )
+	{
+		result = libfsntfs_data_segment_table_get_next_data_range(
+		          internal_file_entry->data_segment_table,
+		          offset,
+		          data_range_offset,
+		          data_range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next data range from data segment table.",
+			 function );
+		}
+	}
+	else if( internal_file_entry->data_cluster_block_stream != NULL )
+	{
+		if( libfdata_stream_get_size(
+		     internal_file_entry->data_cluster_block_stream,
+		     &data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data attribute data size.",
+			 function );
+
+			result = -1;
+		}
+		else if( (size64_t) offset < data_size )
+		{
+			*data_range_offset = offset;
+			*data_range_size   = data_size - (size64_t) offset;
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Retrieves the number of extents (decoded data runs) of the default data stream (nameless $DATA attribute)
  * Returns 1 if successful or -1 on error
  */
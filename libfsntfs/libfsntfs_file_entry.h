@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_data_readahead.h"
+#include "libfsntfs_data_segment_table.h"
 #include "libfsntfs_directory_entries_tree.h"
 #include "libfsntfs_directory_entry.h"
 #include "libfsntfs_extern.h"
@@ -70,7 +72,11 @@ struct libfsntfs_internal_file_entry
 	 */
 	libfsntfs_directory_entry_t *directory_entry;
 
-	/* The directory entries tree
+	/* Value to indicate the file entry has a directory entries tree
+	 */
+	uint8_t has_directory_entries_tree;
+
+	/* The directory entries tree, read on demand
 	 */
 	libfsntfs_directory_entries_tree_t *directory_entries_tree;
 
@@ -106,6 +112,16 @@ struct libfsntfs_internal_file_entry
 	 */
 	libfdata_stream_t *data_cluster_block_stream;
 
+	/* The default (nameless) $DATA attribute segment table
+	 * Used to read the data without a current offset, not set for compressed data
+	 */
+	libfsntfs_data_segment_table_t *data_segment_table;
+
+	/* The default (nameless) $DATA attribute read-ahead
+	 * Used for sequential reads using the data segment table
+	 */
+	libfsntfs_data_readahead_t *data_readahead;
+
 	/* The flags
 	 */
 	uint8_t flags;
@@ -127,6 +143,16 @@ int libfsntfs_file_entry_initialize(
      uint8_t flags,
      libcerror_error_t **error );
 
+int libfsntfs_file_entry_initialize_from_mft_entry(
+     libfsntfs_file_entry_t **file_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_file_system_t *file_system,
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_directory_entry_t *directory_entry,
+     uint8_t flags,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_file_entry_free(
      libfsntfs_file_entry_t **file_entry,
@@ -439,12 +465,25 @@ int libfsntfs_file_entry_get_alternate_data_stream_by_utf16_name(
      libfsntfs_data_stream_t **alternate_data_stream,
      libcerror_error_t **error );
 
+int libfsntfs_internal_file_entry_read_directory_entries_tree(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_file_entry_get_number_of_sub_file_entries(
      libfsntfs_file_entry_t *file_entry,
      int *number_of_sub_entries,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_file_entry_iterate_sub_file_entries(
+     libfsntfs_file_entry_t *file_entry,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *sub_file_entry,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_file_entry_get_sub_file_entry_by_index(
      libfsntfs_file_entry_t *file_entry,
@@ -468,6 +507,26 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
      libfsntfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_file_entry_get_number_of_child_file_entries(
+     libfsntfs_file_entry_t *file_entry,
+     int *number_of_child_file_entries,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_file_entry_get_child_file_entry_by_index(
+     libfsntfs_file_entry_t *file_entry,
+     int child_file_entry_index,
+     libfsntfs_file_entry_t **child_file_entry,
+     libcerror_error_t **error );
+
+ssize_t libfsntfs_internal_file_entry_read_buffer_at_offset(
+         libfsntfs_internal_file_entry_t *internal_file_entry,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 ssize_t libfsntfs_file_entry_read_buffer(
          libfsntfs_file_entry_t *file_entry,
@@ -483,6 +542,48 @@ ssize_t libfsntfs_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+ssize_t libfsntfs_internal_file_entry_pread_buffer(
+         libfsntfs_internal_file_entry_t *internal_file_entry,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+ssize_t libfsntfs_file_entry_pread_buffer(
+         libfsntfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_file_entry_read_ranges(
+     libfsntfs_file_entry_t *file_entry,
+     const off64_t *range_offsets,
+     const size_t *range_sizes,
+     uint8_t **range_buffers,
+     ssize_t *range_read_counts,
+     int number_of_ranges,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_file_entry_read_buffer_at_offset_async(
+     libfsntfs_file_entry_t *file_entry,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+             libfsntfs_file_entry_t *file_entry,
+             void *buffer,
+             ssize_t read_count,
+             off64_t offset,
+             libcerror_error_t *error,
+             void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 off64_t libfsntfs_file_entry_seek_offset(
          libfsntfs_file_entry_t *file_entry,
@@ -502,6 +603,14 @@ int libfsntfs_file_entry_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_file_entry_get_next_data_range(
+     libfsntfs_file_entry_t *file_entry,
+     off64_t offset,
+     off64_t *data_range_offset,
+     size64_t *data_range_size,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_file_entry_get_number_of_extents(
      libfsntfs_file_entry_t *file_entry,
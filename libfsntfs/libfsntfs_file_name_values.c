@@ -1069,10 +1069,9 @@ int libfsntfs_file_name_values_get_utf8_name_size(
 
 		return( -1 );
 	}
-	if( libuna_utf8_string_size_from_utf16_stream(
+	if( libfsntfs_name_get_utf8_string_size(
 	     file_name_values->name,
 	     (size_t) file_name_values->name_size,
-	     LIBUNA_ENDIAN_LITTLE,
 	     utf8_string_size,
 	     error ) != 1 )
 	{
@@ -1111,12 +1110,11 @@ int libfsntfs_file_name_values_get_utf8_name(
 
 		return( -1 );
 	}
-	if( libuna_utf8_string_copy_from_utf16_stream(
-	     utf8_string,
-	     utf8_string_size,
+	if( libfsntfs_name_copy_to_utf8_string(
 	     file_name_values->name,
 	     (size_t) file_name_values->name_size,
-	     LIBUNA_ENDIAN_LITTLE,
+	     utf8_string,
+	     utf8_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -24,6 +24,8 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsntfs_children_index.h"
+#include "libfsntfs_cluster_allocation_map.h"
 #include "libfsntfs_cluster_block.h"
 #include "libfsntfs_cluster_block_vector.h"
 #include "libfsntfs_definitions.h"
@@ -33,14 +35,19 @@
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcnotify.h"
 #include "libfsntfs_libcthreads.h"
+#include "libfsntfs_libfdata.h"
 #include "libfsntfs_libuna.h"
+#include "libfsntfs_metadata_cache.h"
 #include "libfsntfs_mft.h"
 #include "libfsntfs_mft_attribute_list.h"
 #include "libfsntfs_mft_entry.h"
 #include "libfsntfs_name.h"
+#include "libfsntfs_path_component_cache.h"
 #include "libfsntfs_path_hint.h"
+#include "libfsntfs_path_hint_table.h"
 #include "libfsntfs_security_descriptor_index.h"
 #include "libfsntfs_security_descriptor_values.h"
+#include "libfsntfs_upcase_table.h"
 
 /* Creates a file system
  * Make sure the value file_system is referencing, is set to NULL
@@ -173,18 +180,81 @@ int libfsntfs_file_system_free(
 			result = -1;
 		}
 #endif
-		if( ( *file_system )->path_hints_tree != NULL )
+		if( ( *file_system )->children_index != NULL )
 		{
-			if( libcdata_btree_free(
-			     &( ( *file_system )->path_hints_tree ),
-			     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_path_hint_free,
+			if( libfsntfs_children_index_free(
+			     &( ( *file_system )->children_index ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free path hints tree.",
+				 "%s: unable to free children index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_system )->path_component_cache != NULL )
+		{
+			if( libfsntfs_path_component_cache_free(
+			     &( ( *file_system )->path_component_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free path component cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_system )->upcase_table != NULL )
+		{
+			if( libfsntfs_upcase_table_free(
+			     &( ( *file_system )->upcase_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free upper case table.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_system )->cluster_allocation_map != NULL )
+		{
+			if( libfsntfs_cluster_allocation_map_free(
+			     &( ( *file_system )->cluster_allocation_map ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free cluster allocation map.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_system )->path_hint_table != NULL )
+		{
+			if( libfsntfs_path_hint_table_free(
+			     &( ( *file_system )->path_hint_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free path hint table.",
 				 function );
 
 				result = -1;
@@ -222,6 +292,22 @@ int libfsntfs_file_system_free(
 				result = -1;
 			}
 		}
+		if( ( *file_system )->metadata_cache != NULL )
+		{
+			if( libfsntfs_metadata_cache_free(
+			     &( ( *file_system )->metadata_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free metadata cache.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *file_system );
 
@@ -246,8 +332,11 @@ int libfsntfs_file_system_read_mft(
 	libfsntfs_mft_attribute_t *last_data_attribute = NULL;
 	libfsntfs_mft_entry_t *mft_entry               = NULL;
 	static char *function                          = "libfsntfs_file_system_read_mft";
+	off64_t range_offset                           = 0;
 	size64_t mft_size                              = 0;
+	size64_t range_size                            = 0;
 	uint64_t file_reference                        = 0;
+	uint64_t journal_sequence_number               = 0;
 	uint64_t number_of_mft_entries                 = 0;
 	uint16_t attribute_data_flags                  = 0;
 	int attribute_index                            = 0;
@@ -255,6 +344,9 @@ int libfsntfs_file_system_read_mft(
 	int file_reference_index                       = 0;
 	int number_of_data_runs                        = 0;
 	int number_of_file_entries                     = 0;
+	int number_of_ranges                           = 0;
+	int range_index                                = 0;
+	int result                                     = 0;
 	int segment_index                              = 0;
 
 	if( file_system == NULL )
@@ -423,6 +515,71 @@ int libfsntfs_file_system_read_mft(
 			goto on_error;
 		}
 	}
+	if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) == 0 )
+	{
+		if( libfsntfs_mft_entry_get_journal_sequence_number(
+		     mft_entry,
+		     &journal_sequence_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve journal sequence number of MFT entry: %d.",
+			 function,
+			 LIBFSNTFS_MFT_ENTRY_INDEX_MFT );
+
+			goto on_error;
+		}
+		file_system->mft_journal_sequence_number = journal_sequence_number;
+	}
+	file_system->mft_size = mft_size;
+
+	if( file_system->metadata_cache != NULL )
+	{
+		/* The metadata cache is only used if the $MFT MFT entry was not changed
+		 * since the metadata cache was written
+		 */
+		if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) == 0 )
+		{
+			result = libfsntfs_metadata_cache_matches_mft(
+			          file_system->metadata_cache,
+			          journal_sequence_number,
+			          mft_size,
+			          io_handle->cluster_block_size,
+			          io_handle->mft_entry_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if metadata cache matches MFT.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( result == 0 )
+		{
+			if( libfsntfs_metadata_cache_free(
+			     &( file_system->metadata_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free metadata cache.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
 	if( libfsntfs_mft_initialize(
 	     &( file_system->mft ),
 	     io_handle,
@@ -439,6 +596,8 @@ int libfsntfs_file_system_read_mft(
 
 		goto on_error;
 	}
+	file_system->mft->metadata_cache = file_system->metadata_cache;
+
 	if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) != 0 )
 	{
 		if( libfdata_vector_append_segment(
@@ -460,6 +619,64 @@ int libfsntfs_file_system_read_mft(
 			goto on_error;
 		}
 	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_metadata_cache_get_number_of_mft_ranges(
+		     file_system->metadata_cache,
+		     &number_of_ranges,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of metadata cache MFT ranges.",
+			 function );
+
+			goto on_error;
+		}
+		for( range_index = 0;
+		     range_index < number_of_ranges;
+		     range_index++ )
+		{
+			if( libfsntfs_metadata_cache_get_mft_range_by_index(
+			     file_system->metadata_cache,
+			     range_index,
+			     &range_offset,
+			     &range_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve metadata cache MFT range: %d.",
+				 function,
+				 range_index );
+
+				goto on_error;
+			}
+			if( libfdata_vector_append_segment(
+			     file_system->mft->mft_entry_vector,
+			     &segment_index,
+			     0,
+			     range_offset,
+			     range_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append metadata cache MFT range: %d to MFT entry vector.",
+				 function,
+				 range_index );
+
+				goto on_error;
+			}
+		}
+	}
 	else
 	{
 		if( libfsntfs_mft_attribute_get_number_of_data_runs(
@@ -529,7 +746,11 @@ int libfsntfs_file_system_read_mft(
 		}
 		last_data_attribute = mft_entry->data_attribute;
 	}
-	if( mft_entry->list_attribute != NULL )
+	/* The attribute list data MFT entries only need to be read for their data runs
+	 * which are already provided by the metadata cache
+	 */
+	if( ( result == 0 )
+	 && ( mft_entry->list_attribute != NULL ) )
 	{
 		if( libfsntfs_mft_entry_read_attribute_list(
 		     mft_entry,
@@ -719,16 +940,17 @@ int libfsntfs_file_system_read_mft(
 
 		goto on_error;
 	}
-	if( libcdata_btree_initialize(
-	     &( file_system->path_hints_tree ),
-	     LIBFSNTFS_INDEX_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+	if( libfsntfs_path_hint_table_initialize(
+	     &( file_system->path_hint_table ),
+	     (int) number_of_mft_entries,
+	     io_handle->maximum_number_of_path_hints,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create path hints B-tree.",
+		 "%s: unable to create path hint table.",
 		 function );
 
 		goto on_error;
@@ -736,11 +958,10 @@ int libfsntfs_file_system_read_mft(
 	return( 1 );
 
 on_error:
-	if( file_system->path_hints_tree != NULL )
+	if( file_system->path_hint_table != NULL )
 	{
-		libcdata_btree_free(
-		 &( file_system->path_hints_tree ),
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_path_hint_free,
+		libfsntfs_path_hint_table_free(
+		 &( file_system->path_hint_table ),
 		 NULL );
 	}
 	if( mft_entry != NULL )
@@ -766,11 +987,8 @@ int libfsntfs_file_system_read_bitmap(
 	libfsntfs_cluster_block_t *cluster_block = NULL;
 	libfsntfs_mft_entry_t *mft_entry         = NULL;
 	static char *function                    = "libfsntfs_file_system_read_bitmap";
-	size_t cluster_block_data_offset         = 0;
-	off64_t bitmap_offset                    = 0;
-	off64_t start_offset                     = 0;
-	uint32_t value_32bit                     = 0;
-	uint8_t bit_index                        = 0;
+	size64_t bitmap_data_size                = 0;
+	uint64_t cluster_number                  = 0;
 	int cluster_block_index                  = 0;
 	int number_of_cluster_blocks             = 0;
 
@@ -785,6 +1003,17 @@ int libfsntfs_file_system_read_bitmap(
 
 		return( -1 );
 	}
+	if( file_system->cluster_allocation_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system - cluster allocation map value already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -796,6 +1025,17 @@ int libfsntfs_file_system_read_bitmap(
 
 		return( -1 );
 	}
+	if( io_handle->cluster_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - cluster block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfsntfs_mft_get_mft_entry_by_index(
 	     file_system->mft,
 	     file_io_handle,
@@ -837,6 +1077,54 @@ int libfsntfs_file_system_read_bitmap(
 
 		goto on_error;
 	}
+	if( libfsntfs_mft_attribute_get_data_size(
+	     mft_entry->data_attribute,
+	     &bitmap_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size of MFT entry: %d.",
+		 function,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP );
+
+		goto on_error;
+	}
+	if( bitmap_data_size > (size64_t) ( UINT64_MAX / 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bitmap data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* Bits in the last bitmap byte beyond the end of the volume are not
+	 * cluster allocation data
+	 */
+	if( libfsntfs_cluster_allocation_map_initialize(
+	     &( file_system->cluster_allocation_map ),
+	     (uint64_t) bitmap_data_size * 8,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cluster allocation map.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( io_handle->volume_size != 0 )
+	 && ( ( io_handle->volume_size / io_handle->cluster_block_size ) < file_system->cluster_allocation_map->number_of_clusters ) )
+	{
+		file_system->cluster_allocation_map->number_of_clusters = io_handle->volume_size / io_handle->cluster_block_size;
+	}
 	if( libfsntfs_cluster_block_vector_initialize(
 	     &cluster_block_vector,
 	     io_handle,
@@ -884,6 +1172,10 @@ int libfsntfs_file_system_read_bitmap(
 	     cluster_block_index < number_of_cluster_blocks;
 	     cluster_block_index++ )
 	{
+		if( cluster_number >= file_system->cluster_allocation_map->number_of_clusters )
+		{
+			break;
+		}
 		if( libfdata_vector_get_element_value_by_index(
 		     cluster_block_vector,
 		     (intptr_t *) file_io_handle,
@@ -927,8 +1219,7 @@ int libfsntfs_file_system_read_bitmap(
 
 			goto on_error;
 		}
-		if( ( ( cluster_block->data_size % 4 ) != 0 )
-		 || ( cluster_block->data_size > (size_t) SSIZE_MAX ) )
+		if( cluster_block->data_size > (size_t) SSIZE_MAX )
 		{
 			libcerror_error_set(
 			 error,
@@ -953,107 +1244,24 @@ int libfsntfs_file_system_read_bitmap(
 			 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 		}
 #endif
-		cluster_block_data_offset = 0;
-		start_offset              = -1;
-
-		while( cluster_block_data_offset < cluster_block->data_size )
-		{
-			byte_stream_copy_to_uint32_little_endian(
-			 &( cluster_block->data[ cluster_block_data_offset ] ),
-			 value_32bit );
-
-			for( bit_index = 0;
-			     bit_index < 32;
-			     bit_index++ )
-			{
-				if( ( value_32bit & 0x00000001UL ) == 0 )
-				{
-					if( start_offset >= 0 )
-					{
-#if defined( HAVE_DEBUG_OUTPUT )
-						if( libcnotify_verbose != 0 )
-						{
-							libcnotify_printf(
-							 "%s: offset range\t\t\t: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-							 function,
-							 start_offset,
-							 bitmap_offset,
-							 bitmap_offset - start_offset );
-						}
-#endif
-/*
-						if( libfsntfs_offset_list_append_offset(
-						     offset_list,
-						     start_offset,
-						     bitmap_offset - start_offset,
-						     1,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-							 "%s: unable to append offset range to offset list.",
-							 function );
-
-							goto on_error;
-						}
-*/
-						start_offset = -1;
-					}
-				}
-				else
-				{
-					if( start_offset < 0 )
-					{
-						start_offset = bitmap_offset;
-					}
-				}
-				bitmap_offset += io_handle->cluster_block_size;
-
-				value_32bit >>= 1;
-			}
-			cluster_block_data_offset += 4;
-		}
-		if( start_offset >= 0 )
+		if( libfsntfs_cluster_allocation_map_read_data(
+		     file_system->cluster_allocation_map,
+		     cluster_block->data,
+		     cluster_block->data_size,
+		     cluster_number,
+		     error ) != 1 )
 		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: offset range\t\t\t: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-				 function,
-				 start_offset,
-				 bitmap_offset,
-				 bitmap_offset - start_offset );
-			}
-#endif
-/* TODO
-			if( libfsntfs_offset_list_append_offset(
-			     offset_list,
-			     start_offset,
-			     bitmap_offset - start_offset,
-			     1,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append offset range to offset list.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read cluster allocation map from cluster block: %d.",
+			 function,
+			 cluster_block_index );
 
-				goto on_error;
-			}
-*/
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "\n" );
+			goto on_error;
 		}
-#endif
+		cluster_number += (uint64_t) cluster_block->data_size * 8;
 	}
 	if( libfdata_vector_free(
 	     &cluster_block_vector,
@@ -1096,24 +1304,34 @@ on_error:
 		 &cluster_block_vector,
 		 NULL );
 	}
-	return( -1 );
-}
+	if( file_system->cluster_allocation_map != NULL )
+	{
+		libfsntfs_cluster_allocation_map_free(
+		 &( file_system->cluster_allocation_map ),
+		 NULL );
+	}
+	return( -1 );
+}
 
-/* Reads the security descriptors
+/* Reads the upper case table ($UpCase)
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_file_system_read_security_descriptors(
+int libfsntfs_file_system_read_upcase_table(
      libfsntfs_file_system_t *file_system,
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	libfsntfs_file_name_values_t *file_name_values = NULL;
-	libfsntfs_mft_attribute_t *data_attribute      = NULL;
-	libfsntfs_mft_attribute_t *mft_attribute       = NULL;
-	libfsntfs_mft_entry_t *mft_entry               = NULL;
-	static char *function                          = "libfsntfs_file_system_read_security_descriptors";
-	int result                                     = 0;
+	libfcache_cache_t *cluster_block_cache   = NULL;
+	libfdata_vector_t *cluster_block_vector  = NULL;
+	libfsntfs_cluster_block_t *cluster_block = NULL;
+	libfsntfs_mft_entry_t *mft_entry         = NULL;
+	static char *function                    = "libfsntfs_file_system_read_upcase_table";
+	size64_t upcase_data_size                = 0;
+	size_t data_offset                       = 0;
+	size_t read_size                         = 0;
+	int cluster_block_index                  = 0;
+	int number_of_cluster_blocks             = 0;
 
 	if( file_system == NULL )
 	{
@@ -1126,13 +1344,24 @@ int libfsntfs_file_system_read_security_descriptors(
 
 		return( -1 );
 	}
-	if( file_system->security_descriptor_index != NULL )
+	if( file_system->upcase_table != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file system - security descriptor index value already set.",
+		 "%s: invalid file system - upper case table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
 		 function );
 
 		return( -1 );
@@ -1140,7 +1369,7 @@ int libfsntfs_file_system_read_security_descriptors(
 	if( libfsntfs_mft_get_mft_entry_by_index(
 	     file_system->mft,
 	     file_io_handle,
-	     LIBFSNTFS_MFT_ENTRY_INDEX_SECURE,
+	     LIBFSNTFS_MFT_ENTRY_INDEX_UPPERCASE,
 	     &mft_entry,
 	     error ) != 1 )
 	{
@@ -1150,7 +1379,7 @@ int libfsntfs_file_system_read_security_descriptors(
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 		 "%s: unable to retrieve MFT entry: %d.",
 		 function,
-		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
+		 LIBFSNTFS_MFT_ENTRY_INDEX_UPPERCASE );
 
 		goto on_error;
 	}
@@ -1162,135 +1391,197 @@ int libfsntfs_file_system_read_security_descriptors(
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
 		 "%s: missing MFT entry: %d.",
 		 function,
-		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
+		 LIBFSNTFS_MFT_ENTRY_INDEX_UPPERCASE );
 
 		goto on_error;
 	}
-	if( libfsntfs_mft_entry_get_attribute_by_index(
-	     mft_entry,
-	     mft_entry->file_name_attribute_index,
-	     &mft_attribute,
+	if( mft_entry->data_attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT entry: %d - missing data attribute.",
+		 function,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_UPPERCASE );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_attribute_get_data_size(
+	     mft_entry->data_attribute,
+	     &upcase_data_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve attribute: %d from MFT entry: %d.",
+		 "%s: unable to retrieve data size of MFT entry: %d.",
 		 function,
-		 mft_entry->file_name_attribute_index,
-		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
+		 LIBFSNTFS_MFT_ENTRY_INDEX_UPPERCASE );
 
 		goto on_error;
 	}
-	if( libfsntfs_file_name_values_initialize(
-	     &file_name_values,
+	/* Data beyond the upper case table size is ignored
+	 */
+	if( upcase_data_size > (size64_t) ( LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_VALUES * 2 ) )
+	{
+		upcase_data_size = (size64_t) ( LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_VALUES * 2 );
+	}
+	if( libfsntfs_upcase_table_initialize(
+	     &( file_system->upcase_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file name values.",
+		 "%s: unable to create upper case table.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfsntfs_file_name_values_read_from_mft_attribute(
-	     file_name_values,
-	     mft_attribute,
+	if( libfsntfs_cluster_block_vector_initialize(
+	     &cluster_block_vector,
+	     io_handle,
+	     mft_entry->data_attribute,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read file name values from attribute: %d from MFT entry: %d.",
-		 function,
-		 mft_entry->file_name_attribute_index,
-		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cluster block vector.",
+		 function );
 
 		goto on_error;
 	}
-	result = libfsntfs_name_compare_with_utf8_string(
-	          file_name_values->name,
-	          file_name_values->name_size,
-	          (uint8_t *) "$Secure",
-	          7,
-	          1,
-	          error );
+	if( libfcache_cache_initialize(
+	     &cluster_block_cache,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cluster block cache.",
+		 function );
 
-	if( result == -1 )
+		goto on_error;
+	}
+	if( libfdata_vector_get_number_of_elements(
+	     cluster_block_vector,
+	     &number_of_cluster_blocks,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GENERIC,
-		 "%s: unable to compare UTF-8 string with data attribute name.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cluster blocks.",
 		 function );
 
 		goto on_error;
 	}
-	else if( result == LIBUNA_COMPARE_EQUAL )
+	for( cluster_block_index = 0;
+	     cluster_block_index < number_of_cluster_blocks;
+	     cluster_block_index++ )
 	{
-		if( libfsntfs_mft_entry_get_alternate_data_attribute_by_utf8_name(
-		     mft_entry,
-		     (uint8_t *) "$SDS",
-		     4,
-		     &data_attribute,
+		if( (size64_t) data_offset >= upcase_data_size )
+		{
+			break;
+		}
+		if( libfdata_vector_get_element_value_by_index(
+		     cluster_block_vector,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) cluster_block_cache,
+		     cluster_block_index,
+		     (intptr_t **) &cluster_block,
+		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve $SDS data attribute.",
-			 function );
+			 "%s: unable to retrieve cluster block: %d from vector.",
+			 function,
+			 cluster_block_index );
 
 			goto on_error;
 		}
-		if( libfsntfs_security_descriptor_index_initialize(
-		     &( file_system->security_descriptor_index ),
-		     io_handle,
-		     file_io_handle,
-		     data_attribute,
-		     error ) != 1 )
+		if( cluster_block == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create security descriptor index.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing cluster block: %d.",
+			 function,
+			 cluster_block_index );
 
 			goto on_error;
 		}
-		if( libfsntfs_security_descriptor_index_read_sii_index(
-		     file_system->security_descriptor_index,
-		     io_handle,
-		     file_io_handle,
-		     mft_entry,
+		if( cluster_block->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid cluster block: %d - missing data.",
+			 function,
+			 cluster_block_index );
+
+			goto on_error;
+		}
+		read_size = cluster_block->data_size;
+
+		if( (size64_t) read_size > ( upcase_data_size - data_offset ) )
+		{
+			read_size = (size_t) ( upcase_data_size - data_offset );
+		}
+		if( libfsntfs_upcase_table_read_data(
+		     file_system->upcase_table,
+		     cluster_block->data,
+		     read_size,
+		     data_offset,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read security descriptor identifier ($SII) index.",
-			 function );
+			 "%s: unable to read upper case table from cluster block: %d.",
+			 function,
+			 cluster_block_index );
 
 			goto on_error;
 		}
+		data_offset += read_size;
 	}
-	if( libfsntfs_file_name_values_free(
-	     &file_name_values,
+	if( libfdata_vector_free(
+	     &cluster_block_vector,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free file name values.",
+		 "%s: unable to free cluster block vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_free(
+	     &cluster_block_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cluster block cache.",
 		 function );
 
 		goto on_error;
@@ -1298,30 +1589,42 @@ int libfsntfs_file_system_read_security_descriptors(
 	return( 1 );
 
 on_error:
-	if( file_system->security_descriptor_index != NULL )
+	if( cluster_block_cache != NULL )
 	{
-		libfsntfs_security_descriptor_index_free(
-		 &( file_system->security_descriptor_index ),
+		libfcache_cache_free(
+		 &cluster_block_cache,
 		 NULL );
 	}
-	if( file_name_values != NULL )
+	if( cluster_block_vector != NULL )
 	{
-		libfsntfs_file_name_values_free(
-		 &file_name_values,
+		libfdata_vector_free(
+		 &cluster_block_vector,
+		 NULL );
+	}
+	if( file_system->upcase_table != NULL )
+	{
+		libfsntfs_upcase_table_free(
+		 &( file_system->upcase_table ),
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Retrieves the number of MFT entries
+/* Reads the security descriptors
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_file_system_get_number_of_mft_entries(
+int libfsntfs_file_system_read_security_descriptors(
      libfsntfs_file_system_t *file_system,
-     uint64_t *number_of_mft_entries,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_file_system_get_number_of_mft_entries";
+	libfsntfs_file_name_values_t *file_name_values = NULL;
+	libfsntfs_mft_attribute_t *data_attribute      = NULL;
+	libfsntfs_mft_attribute_t *mft_attribute       = NULL;
+	libfsntfs_mft_entry_t *mft_entry               = NULL;
+	static char *function                          = "libfsntfs_file_system_read_security_descriptors";
+	int result                                     = 0;
 
 	if( file_system == NULL )
 	{
@@ -1334,42 +1637,13 @@ int libfsntfs_file_system_get_number_of_mft_entries(
 
 		return( -1 );
 	}
-	if( libfsntfs_mft_get_number_of_entries(
-	     file_system->mft,
-	     number_of_mft_entries,
-	     error ) != 1 )
+	if( file_system->security_descriptor_index != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of MFT entries.",
-		 function );
-
-		return( -1 );
-	}
-	return( 1 );
-}
-
-/* Retrieves the MFT entry for a specific index
- * Returns 1 if successful or -1 on error
- */
-int libfsntfs_file_system_get_mft_entry_by_index(
-     libfsntfs_file_system_t *file_system,
-     libbfio_handle_t *file_io_handle,
-     uint64_t mft_entry_index,
-     libfsntfs_mft_entry_t **mft_entry,
-     libcerror_error_t **error )
-{
-	static char *function = "libfsntfs_file_system_get_mft_entry_by_index";
-
-	if( file_system == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file system.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system - security descriptor index value already set.",
 		 function );
 
 		return( -1 );
@@ -1377,17 +1651,212 @@ int libfsntfs_file_system_get_mft_entry_by_index(
 	if( libfsntfs_mft_get_mft_entry_by_index(
 	     file_system->mft,
 	     file_io_handle,
-	     mft_entry_index,
-	     mft_entry,
+	     LIBFSNTFS_MFT_ENTRY_INDEX_SECURE,
+	     &mft_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: %" PRIi64 ".",
+		 "%s: unable to retrieve MFT entry: %d.",
 		 function,
-		 mft_entry_index );
+		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
+
+		goto on_error;
+	}
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing MFT entry: %d.",
+		 function,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_entry_get_attribute_by_index(
+	     mft_entry,
+	     mft_entry->file_name_attribute_index,
+	     &mft_attribute,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attribute: %d from MFT entry: %d.",
+		 function,
+		 mft_entry->file_name_attribute_index,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
+
+		goto on_error;
+	}
+	if( libfsntfs_file_name_values_initialize(
+	     &file_name_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file name values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_file_name_values_read_from_mft_attribute(
+	     file_name_values,
+	     mft_attribute,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file name values from attribute: %d from MFT entry: %d.",
+		 function,
+		 mft_entry->file_name_attribute_index,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
+
+		goto on_error;
+	}
+	result = libfsntfs_name_compare_with_utf8_string(
+	          file_name_values->name,
+	          file_name_values->name_size,
+	          (uint8_t *) "$Secure",
+	          7,
+	          1,
+	          file_system->upcase_table,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare UTF-8 string with data attribute name.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == LIBUNA_COMPARE_EQUAL )
+	{
+		if( libfsntfs_mft_entry_get_alternate_data_attribute_by_utf8_name(
+		     mft_entry,
+		     (uint8_t *) "$SDS",
+		     4,
+		     &data_attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve $SDS data attribute.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_security_descriptor_index_initialize(
+		     &( file_system->security_descriptor_index ),
+		     io_handle,
+		     file_io_handle,
+		     data_attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create security descriptor index.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_security_descriptor_index_read_sii_index(
+		     file_system->security_descriptor_index,
+		     io_handle,
+		     file_io_handle,
+		     mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read security descriptor identifier ($SII) index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfsntfs_file_name_values_free(
+	     &file_name_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file name values.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_system->security_descriptor_index != NULL )
+	{
+		libfsntfs_security_descriptor_index_free(
+		 &( file_system->security_descriptor_index ),
+		 NULL );
+	}
+	if( file_name_values != NULL )
+	{
+		libfsntfs_file_name_values_free(
+		 &file_name_values,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of MFT entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_system_get_number_of_mft_entries(
+     libfsntfs_file_system_t *file_system,
+     uint64_t *number_of_mft_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_file_system_get_number_of_mft_entries";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_get_number_of_entries(
+	     file_system->mft,
+	     number_of_mft_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entries.",
+		 function );
 
 		return( -1 );
 	}
@@ -1395,17 +1864,16 @@ int libfsntfs_file_system_get_mft_entry_by_index(
 }
 
 /* Retrieves the MFT entry for a specific index
- * This function creates new MFT entry
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_file_system_get_mft_entry_by_index_no_cache(
+int libfsntfs_file_system_get_mft_entry_by_index(
      libfsntfs_file_system_t *file_system,
      libbfio_handle_t *file_io_handle,
      uint64_t mft_entry_index,
      libfsntfs_mft_entry_t **mft_entry,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_file_system_get_mft_entry_by_index_no_cache";
+	static char *function = "libfsntfs_file_system_get_mft_entry_by_index";
 
 	if( file_system == NULL )
 	{
@@ -1418,7 +1886,7 @@ int libfsntfs_file_system_get_mft_entry_by_index_no_cache(
 
 		return( -1 );
 	}
-	if( libfsntfs_mft_get_mft_entry_by_index_no_cache(
+	if( libfsntfs_mft_get_mft_entry_by_index(
 	     file_system->mft,
 	     file_io_handle,
 	     mft_entry_index,
@@ -1438,19 +1906,18 @@ int libfsntfs_file_system_get_mft_entry_by_index_no_cache(
 	return( 1 );
 }
 
-/* Retrieves the security descriptor for a specific identifier
- * This function creates new security descriptor values
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the MFT entry for a specific index
+ * This function creates new MFT entry
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_file_system_get_security_descriptor_values_by_identifier(
+int libfsntfs_file_system_get_mft_entry_by_index_no_cache(
      libfsntfs_file_system_t *file_system,
      libbfio_handle_t *file_io_handle,
-     uint32_t security_descriptor_identifier,
-     libfsntfs_security_descriptor_values_t **security_descriptor_values,
+     uint64_t mft_entry_index,
+     libfsntfs_mft_entry_t **mft_entry,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_file_system_get_security_descriptor_values_by_identifier";
-	int result            = 0;
+	static char *function = "libfsntfs_file_system_get_mft_entry_by_index_no_cache";
 
 	if( file_system == NULL )
 	{
@@ -1463,35 +1930,175 @@ int libfsntfs_file_system_get_security_descriptor_values_by_identifier(
 
 		return( -1 );
 	}
-	if( file_system->security_descriptor_index != NULL )
+	if( libfsntfs_mft_get_mft_entry_by_index_no_cache(
+	     file_system->mft,
+	     file_io_handle,
+	     mft_entry_index,
+	     mft_entry,
+	     error ) != 1 )
 	{
-		result = libfsntfs_security_descriptor_index_get_entry_by_identifier(
-		          file_system->security_descriptor_index,
-		          file_io_handle,
-		          security_descriptor_identifier,
-		          security_descriptor_values,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve security descriptor from index for identifier: %" PRIu32 ".",
-			 function,
-			 security_descriptor_identifier );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry: %" PRIi64 ".",
+		 function,
+		 mft_entry_index );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	return( result );
+	return( 1 );
 }
 
-/* Retrieves the path hint of a specific file reference
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Reads a specific MFT entry directly, bypassing the MFT entry caches
+ * This function creates new MFT entry
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_file_system_get_path_hint(
+int libfsntfs_file_system_read_mft_entry_by_index(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     uint64_t mft_entry_index,
+     libfsntfs_mft_entry_t **mft_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_file_system_read_mft_entry_by_index";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_read_mft_entry_by_index(
+	     file_system->mft,
+	     file_io_handle,
+	     mft_entry_index,
+	     mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the security descriptor for a specific identifier
+ * This function creates new security descriptor values
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_file_system_get_security_descriptor_values_by_identifier(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     uint32_t security_descriptor_identifier,
+     libfsntfs_security_descriptor_values_t **security_descriptor_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_file_system_get_security_descriptor_values_by_identifier";
+	uint64_t data_offset  = 0;
+	uint32_t data_size    = 0;
+	int result            = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_system->security_descriptor_index != NULL )
+	 && ( file_system->metadata_cache != NULL ) )
+	{
+		/* The $SII index lookup is bypassed if the metadata cache provides the $SDS data range
+		 */
+		result = libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier(
+		          file_system->metadata_cache,
+		          security_descriptor_identifier,
+		          &data_offset,
+		          &data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve security descriptor mapping from metadata cache for identifier: %" PRIu32 ".",
+			 function,
+			 security_descriptor_identifier );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( libfsntfs_security_descriptor_index_read_security_descriptor_values(
+			     file_system->security_descriptor_index,
+			     data_offset,
+			     (uint64_t) data_size,
+			     security_descriptor_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read security descriptor values for identifier: %" PRIu32 ".",
+				 function,
+				 security_descriptor_identifier );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+	}
+	if( file_system->security_descriptor_index != NULL )
+	{
+		result = libfsntfs_security_descriptor_index_get_entry_by_identifier(
+		          file_system->security_descriptor_index,
+		          file_io_handle,
+		          security_descriptor_identifier,
+		          security_descriptor_values,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve security descriptor from index for identifier: %" PRIu32 ".",
+			 function,
+			 security_descriptor_identifier );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the path hint of a specific file reference
+ * The path hint is managed by the path hint table and remains valid until
+ * a next path hint is retrieved, the caller must hold the file system
+ * read/write lock for writing
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_internal_file_system_get_path_hint(
      libfsntfs_file_system_t *file_system,
      libbfio_handle_t *file_io_handle,
      uint64_t file_reference,
@@ -1499,16 +2106,15 @@ int libfsntfs_file_system_get_path_hint(
      int recursion_depth,
      libcerror_error_t **error )
 {
-	libcdata_tree_node_t *upper_node               = NULL;
 	libfsntfs_file_name_values_t *file_name_values = NULL;
 	libfsntfs_mft_attribute_t *mft_attribute       = NULL;
 	libfsntfs_mft_entry_t *mft_entry               = NULL;
-	libfsntfs_path_hint_t *existing_path_hint      = NULL;
-	libfsntfs_path_hint_t *lookup_path_hint        = NULL;
 	libfsntfs_path_hint_t *parent_path_hint        = NULL;
 	libfsntfs_path_hint_t *safe_path_hint          = NULL;
+	const uint8_t *cached_path                     = NULL;
 	uint8_t *parent_path                           = NULL;
-	static char *function                          = "libfsntfs_file_system_get_path_hint";
+	static char *function                          = "libfsntfs_internal_file_system_get_path_hint";
+	size_t cached_path_size                        = 0;
 	size_t name_size                               = 0;
 	size_t parent_path_size                        = 0;
 	uint64_t mft_entry_index                       = 0;
@@ -1521,7 +2127,6 @@ int libfsntfs_file_system_get_path_hint(
 	int attribute_index                            = 0;
 	int number_of_attributes                       = 0;
 	int result                                     = 0;
-	int value_index                                = 0;
 
 	if( file_system == NULL )
 	{
@@ -1623,27 +2228,10 @@ int libfsntfs_file_system_get_path_hint(
 			return( 0 );
 		}
 	}
-	if( libfsntfs_path_hint_initialize(
-	     &lookup_path_hint,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create path hint.",
-		 function );
-
-		goto on_error;
-	}
-	lookup_path_hint->file_reference = mft_entry_file_reference;
-
-	result = libcdata_btree_get_value_by_value(
-	          file_system->path_hints_tree,
-	          (intptr_t *) lookup_path_hint,
-	          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfsntfs_path_hint_compare_by_file_reference,
-	          &upper_node,
-	          (intptr_t **) path_hint,
+	result = libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+	          file_system->path_hint_table,
+	          file_reference,
+	          path_hint,
 	          error );
 
 	if( result == -1 )
@@ -1652,12 +2240,98 @@ int libfsntfs_file_system_get_path_hint(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve path hint from tree.",
+		 "%s: unable to retrieve path hint from table.",
 		 function );
 
 		goto on_error;
 	}
-	else if( result == 0 )
+	if( ( result == 0 )
+	 && ( file_system->metadata_cache != NULL ) )
+	{
+		result = libfsntfs_metadata_cache_get_path_hint_by_file_reference(
+		          file_system->metadata_cache,
+		          file_reference,
+		          &cached_path,
+		          &cached_path_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve path hint from metadata cache.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libfsntfs_path_hint_initialize(
+			     &safe_path_hint,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create path hint.",
+				 function );
+
+				goto on_error;
+			}
+			safe_path_hint->file_reference = file_reference;
+			safe_path_hint->path_size      = cached_path_size;
+
+			safe_path_hint->path = (uint8_t *) memory_allocate(
+							    sizeof( uint8_t ) * safe_path_hint->path_size );
+
+			if( safe_path_hint->path == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create path.",
+				 function );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     safe_path_hint->path,
+			     cached_path,
+			     cached_path_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy cached path to path.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfsntfs_path_hint_table_set_path_hint(
+			     file_system->path_hint_table,
+			     safe_path_hint,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set path hint in table.",
+				 function );
+
+				goto on_error;
+			}
+			*path_hint = safe_path_hint;
+
+			safe_path_hint = NULL;
+		}
+	}
+	if( result == 0 )
 	{
 		if( libfsntfs_mft_entry_get_number_of_attributes(
 		     mft_entry,
@@ -1755,7 +2429,10 @@ int libfsntfs_file_system_get_path_hint(
 			}
 			parent_mft_entry_index = parent_file_reference & 0xffffffffffffUL;
 
-			if( file_name_values->name_space != LIBFSNTFS_FILE_NAME_SPACE_DOS )
+			/* The path hint is based on the first non-DOS name
+			 */
+			if( ( result == 0 )
+			 && ( file_name_values->name_space != LIBFSNTFS_FILE_NAME_SPACE_DOS ) )
 			{
 				parent_path      = NULL;
 				parent_path_size = 0;
@@ -1769,7 +2446,7 @@ int libfsntfs_file_system_get_path_hint(
 				else if( ( parent_mft_entry_index != 0 )
 				      && ( parent_mft_entry_index != mft_entry_index ) )
 				{
-					result = libfsntfs_file_system_get_path_hint(
+					result = libfsntfs_internal_file_system_get_path_hint(
 					          file_system,
 					          file_io_handle,
 					          parent_file_reference,
@@ -1885,49 +2562,24 @@ int libfsntfs_file_system_get_path_hint(
 				{
 					safe_path_hint->path[ 0 ] = '\\';
 				}
-				result = libcdata_btree_insert_value(
-					  file_system->path_hints_tree,
-					  &value_index,
-					  (intptr_t *) safe_path_hint,
-					  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfsntfs_path_hint_compare_by_file_reference,
-					  &upper_node,
-					  (intptr_t **) &existing_path_hint,
-					  error );
-
-				if( result == -1 )
+				if( libfsntfs_path_hint_table_set_path_hint(
+				     file_system->path_hint_table,
+				     safe_path_hint,
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-					 "%s: unable to insert path hint into tree.",
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set path hint in table.",
 					 function );
 
 					goto on_error;
 				}
-				else if( result == 0 )
-				{
-					if( libfsntfs_path_hint_free(
-					     &safe_path_hint,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-						 "%s: unable to free path hint.",
-						 function );
+				*path_hint = safe_path_hint;
 
-						goto on_error;
-					}
-					*path_hint = existing_path_hint;
-				}
-				else
-				{
-					*path_hint = safe_path_hint;
+				safe_path_hint = NULL;
 
-					safe_path_hint = NULL;
-				}
 				result = 1;
 			}
 			if( libfsntfs_file_name_values_free(
@@ -1945,19 +2597,6 @@ int libfsntfs_file_system_get_path_hint(
 			}
 		}
 	}
-	if( libfsntfs_path_hint_free(
-	     &lookup_path_hint,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free path hint.",
-		 function );
-
-		goto on_error;
-	}
 	return( result );
 
 on_error:
@@ -1973,10 +2612,1356 @@ on_error:
 		 &file_name_values,
 		 NULL );
 	}
-	if( lookup_path_hint != NULL )
+	return( -1 );
+}
+
+/* Retrieves the path hint of a specific file reference
+ * The path hint is a copy of the one in the path hint table and must be freed
+ * by the caller
+ * Make sure the value path_hint is referencing, is set to NULL
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_file_system_get_path_hint(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     uint64_t file_reference,
+     libfsntfs_path_hint_t **path_hint,
+     libcerror_error_t **error )
+{
+	libfsntfs_path_hint_t *table_path_hint = NULL;
+	static char *function                  = "libfsntfs_file_system_get_path_hint";
+	int result                             = 0;
+
+	if( file_system == NULL )
 	{
-		libfsntfs_path_hint_free(
-		 &lookup_path_hint,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_hint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_hint != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path hint value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	/* The path hint table is modified on both look up and insert
+	 */
+	if( libcthreads_read_write_lock_grab_for_write(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_internal_file_system_get_path_hint(
+	          file_system,
+	          file_io_handle,
+	          file_reference,
+	          &table_path_hint,
+	          0,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path hint.",
+		 function );
+	}
+	else if( result != 0 )
+	{
+		/* The table path hint can be freed as soon as the lock is released
+		 */
+		if( libfsntfs_path_hint_clone(
+		     path_hint,
+		     table_path_hint,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create path hint.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		libfsntfs_path_hint_free(
+		 path_hint,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum number of path hints
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_system_set_maximum_number_of_path_hints(
+     libfsntfs_file_system_t *file_system,
+     int maximum_number_of_path_hints,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_file_system_set_maximum_number_of_path_hints";
+	int result            = 1;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->path_hint_table == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_path_hint_table_set_maximum_number_of_path_hints(
+	     file_system->path_hint_table,
+	     maximum_number_of_path_hints,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of path hints in table.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the children index
+ * The children index is built from the parent file reference in the $FILE_NAME
+ * attributes of all the MFT entries, including those of deleted MFT entries
+ * The MFT entries are read sequentially and the children index is only read once
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_file_system_read_children_index(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfsntfs_children_index_t *children_index     = NULL;
+	libfsntfs_file_name_values_t *file_name_values = NULL;
+	libfsntfs_mft_attribute_t *mft_attribute       = NULL;
+	libfsntfs_mft_entry_t *mft_entry               = NULL;
+	uint64_t *child_mft_entry_indexes              = NULL;
+	uint64_t *parent_file_references               = NULL;
+	uint64_t *reallocation                         = NULL;
+	static char *function                          = "libfsntfs_internal_file_system_read_children_index";
+	size_t links_size                              = 0;
+	uint64_t base_record_file_reference            = 0;
+	uint64_t first_link_index                      = 0;
+	uint64_t link_index                            = 0;
+	uint64_t maximum_number_of_links               = 0;
+	uint64_t mft_entry_index                       = 0;
+	uint64_t number_of_links                       = 0;
+	uint64_t number_of_mft_entries                 = 0;
+	uint64_t parent_file_reference                 = 0;
+	uint32_t attribute_type                        = 0;
+	int attribute_index                            = 0;
+	int number_of_attributes                       = 0;
+	int result                                     = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->children_index != NULL )
+	{
+		return( 1 );
+	}
+	if( libfsntfs_mft_get_number_of_entries(
+	     file_system->mft,
+	     &number_of_mft_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( mft_entry_index = 0;
+	     mft_entry_index < number_of_mft_entries;
+	     mft_entry_index++ )
+	{
+		/* The MFT entries are read in sequence so that they are served from the MFT read-ahead buffer
+		 */
+		if( libfsntfs_mft_get_mft_entry_by_index_no_cache(
+		     file_system->mft,
+		     file_io_handle,
+		     mft_entry_index,
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		result = libfsntfs_mft_entry_is_empty(
+		          mft_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if MFT entry: %" PRIu64 " is empty.",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			continue;
+		}
+		if( libfsntfs_mft_entry_get_base_record_file_reference(
+		     mft_entry,
+		     &base_record_file_reference,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve base record file reference of MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		if( base_record_file_reference != 0 )
+		{
+			continue;
+		}
+		if( libfsntfs_mft_entry_get_number_of_attributes(
+		     mft_entry,
+		     &number_of_attributes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of attributes of MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		first_link_index = number_of_links;
+
+		for( attribute_index = 0;
+		     attribute_index < number_of_attributes;
+		     attribute_index++ )
+		{
+			if( libfsntfs_mft_entry_get_attribute_by_index(
+			     mft_entry,
+			     attribute_index,
+			     &mft_attribute,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute: %d.",
+				 function,
+				 attribute_index );
+
+				goto on_error;
+			}
+			if( libfsntfs_mft_attribute_get_type(
+			     mft_attribute,
+			     &attribute_type,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute: %d type.",
+				 function,
+				 attribute_index );
+
+				goto on_error;
+			}
+			if( attribute_type != LIBFSNTFS_ATTRIBUTE_TYPE_FILE_NAME )
+			{
+				continue;
+			}
+			if( libfsntfs_file_name_values_initialize(
+			     &file_name_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file name values.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfsntfs_file_name_values_read_from_mft_attribute(
+			     file_name_values,
+			     mft_attribute,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read file name values.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfsntfs_file_name_values_get_parent_file_reference(
+			     file_name_values,
+			     &parent_file_reference,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve parent file reference.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfsntfs_file_name_values_free(
+			     &file_name_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file name values.",
+				 function );
+
+				goto on_error;
+			}
+			/* The DOS and Windows names of a hard link refer to the same parent
+			 */
+			for( link_index = first_link_index;
+			     link_index < number_of_links;
+			     link_index++ )
+			{
+				if( parent_file_references[ link_index ] == parent_file_reference )
+				{
+					break;
+				}
+			}
+			if( link_index < number_of_links )
+			{
+				continue;
+			}
+			if( number_of_links >= maximum_number_of_links )
+			{
+				if( maximum_number_of_links == 0 )
+				{
+					maximum_number_of_links = 1024;
+				}
+				else
+				{
+					maximum_number_of_links *= 2;
+				}
+				if( maximum_number_of_links > ( (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+					 "%s: invalid maximum number of links value exceeds maximum.",
+					 function );
+
+					goto on_error;
+				}
+				links_size = sizeof( uint64_t ) * (size_t) maximum_number_of_links;
+
+				reallocation = (uint64_t *) memory_reallocate(
+				                             parent_file_references,
+				                             links_size );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize parent file references.",
+					 function );
+
+					goto on_error;
+				}
+				parent_file_references = reallocation;
+
+				reallocation = (uint64_t *) memory_reallocate(
+				                             child_mft_entry_indexes,
+				                             links_size );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize child MFT entry indexes.",
+					 function );
+
+					goto on_error;
+				}
+				child_mft_entry_indexes = reallocation;
+			}
+			parent_file_references[ number_of_links ]  = parent_file_reference;
+			child_mft_entry_indexes[ number_of_links ] = mft_entry_index;
+
+			number_of_links++;
+		}
+	}
+	if( libfsntfs_children_index_initialize(
+	     &children_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create children index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_children_index_set_links(
+	     children_index,
+	     number_of_mft_entries,
+	     parent_file_references,
+	     child_mft_entry_indexes,
+	     number_of_links,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set links in children index.",
+		 function );
+
+		goto on_error;
+	}
+	if( child_mft_entry_indexes != NULL )
+	{
+		memory_free(
+		 child_mft_entry_indexes );
+	}
+	if( parent_file_references != NULL )
+	{
+		memory_free(
+		 parent_file_references );
+	}
+	file_system->children_index = children_index;
+
+	return( 1 );
+
+on_error:
+	if( children_index != NULL )
+	{
+		libfsntfs_children_index_free(
+		 &children_index,
+		 NULL );
+	}
+	if( file_name_values != NULL )
+	{
+		libfsntfs_file_name_values_free(
+		 &file_name_values,
+		 NULL );
+	}
+	if( child_mft_entry_indexes != NULL )
+	{
+		memory_free(
+		 child_mft_entry_indexes );
+	}
+	if( parent_file_references != NULL )
+	{
+		memory_free(
+		 parent_file_references );
+	}
+	return( -1 );
+}
+
+/* Reads the children index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_system_read_children_index(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_file_system_read_children_index";
+	int result            = 1;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_internal_file_system_read_children_index(
+	     file_system,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read children index.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of children of a specific parent file reference
+ * The children index is read on first use
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_system_get_number_of_children(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     int *number_of_children,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_file_system_get_number_of_children";
+	int result            = 1;
+
+	if( libfsntfs_file_system_read_children_index(
+	     file_system,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read children index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_children_index_get_number_of_children(
+	     file_system->children_index,
+	     parent_file_reference,
+	     parent_is_allocated,
+	     number_of_children,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of children from children index.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific child MFT entry index of a specific parent file reference
+ * The children index is read on first use
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_system_get_child_mft_entry_index_by_index(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     int child_index,
+     uint64_t *child_mft_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_file_system_get_child_mft_entry_index_by_index";
+	int result            = 1;
+
+	if( libfsntfs_file_system_read_children_index(
+	     file_system,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read children index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_children_index_get_child_by_index(
+	     file_system->children_index,
+	     parent_file_reference,
+	     parent_is_allocated,
+	     child_index,
+	     child_mft_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve child: %d from children index.",
+		 function,
+		 child_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the cluster allocation map
+ * The bitmap ($Bitmap) is read on first use
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_system_get_cluster_allocation_map(
+     libfsntfs_file_system_t *file_system,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_cluster_allocation_map_t **cluster_allocation_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_file_system_get_cluster_allocation_map";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( cluster_allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->cluster_allocation_map == NULL )
+	{
+		if( libfsntfs_file_system_read_bitmap(
+		     file_system,
+		     io_handle,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read bitmap (MFT entry: %d).",
+			 function,
+			 LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP );
+
+			return( -1 );
+		}
+	}
+	*cluster_allocation_map = file_system->cluster_allocation_map;
+
+	return( 1 );
+}
+
+/* Appends the path hints to the metadata cache
+ * This includes the path hints in the path hint table and those of a metadata
+ * cache that was read when the volume was opened
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_system_append_path_hints_to_metadata_cache(
+     libfsntfs_file_system_t *file_system,
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error )
+{
+	libfsntfs_path_hint_t *path_hint = NULL;
+	const uint8_t *cached_path       = NULL;
+	static char *function            = "libfsntfs_file_system_append_path_hints_to_metadata_cache";
+	size_t cached_path_size          = 0;
+	uint64_t file_reference          = 0;
+	uint64_t mft_entry_index         = 0;
+	int entry_index                  = 0;
+	int number_of_path_hints         = 0;
+	int path_hint_index              = 0;
+	int result                       = 1;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->path_hint_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system - missing path hint table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( entry_index = 0;
+	     entry_index < file_system->path_hint_table->number_of_entries;
+	     entry_index++ )
+	{
+		path_hint = file_system->path_hint_table->entries[ entry_index ].path_hint;
+
+		if( path_hint == NULL )
+		{
+			continue;
+		}
+		if( libfsntfs_metadata_cache_append_path_hint(
+		     metadata_cache,
+		     path_hint->file_reference,
+		     path_hint->path,
+		     path_hint->path_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append path hint of MFT entry: %d to metadata cache.",
+			 function,
+			 entry_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+	/* Path hints of the metadata cache that was read are only loaded into
+	 * the path hint table on demand
+	 */
+	if( ( result == 1 )
+	 && ( file_system->metadata_cache != NULL ) )
+	{
+		if( libfsntfs_metadata_cache_get_number_of_path_hints(
+		     file_system->metadata_cache,
+		     &number_of_path_hints,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of path hints from metadata cache.",
+			 function );
+
+			result = -1;
+		}
+		for( path_hint_index = 0;
+		     ( result == 1 ) && ( path_hint_index < number_of_path_hints );
+		     path_hint_index++ )
+		{
+			if( libfsntfs_metadata_cache_get_path_hint_by_index(
+			     file_system->metadata_cache,
+			     path_hint_index,
+			     &file_reference,
+			     &cached_path,
+			     &cached_path_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve path hint: %d from metadata cache.",
+				 function,
+				 path_hint_index );
+
+				result = -1;
+
+				break;
+			}
+			mft_entry_index = file_reference & 0xffffffffffffUL;
+
+			if( mft_entry_index < (uint64_t) file_system->path_hint_table->number_of_entries )
+			{
+				path_hint = file_system->path_hint_table->entries[ mft_entry_index ].path_hint;
+
+				if( ( path_hint != NULL )
+				 && ( path_hint->file_reference == file_reference ) )
+				{
+					continue;
+				}
+			}
+			if( libfsntfs_metadata_cache_append_path_hint(
+			     metadata_cache,
+			     file_reference,
+			     cached_path,
+			     cached_path_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append path hint: %d to metadata cache.",
+				 function,
+				 path_hint_index );
+
+				result = -1;
+
+				break;
+			}
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     file_system->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Appends the file system metadata to the metadata cache
+ * The metadata cache contains the MFT ranges, the attribute list data MFT entries,
+ * the $SII index mappings and the path hints that are currently known
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_file_system_append_to_metadata_cache(
+     libfsntfs_file_system_t *file_system,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint64_t volume_serial_number,
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_entry_t *mft_entry = NULL;
+	static char *function            = "libfsntfs_file_system_append_to_metadata_cache";
+	size64_t segment_size            = 0;
+	off64_t segment_offset           = 0;
+	uint64_t file_reference          = 0;
+	uint64_t mft_entry_index         = 0;
+	uint32_t segment_flags           = 0;
+	int file_reference_index         = 0;
+	int number_of_file_references    = 0;
+	int number_of_segments           = 0;
+	int segment_file_index           = 0;
+	int segment_index                = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system - missing MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_system->mft->flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file system - MFT only.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_metadata_cache_set_volume_values(
+	     metadata_cache,
+	     volume_serial_number,
+	     file_system->mft_journal_sequence_number,
+	     file_system->mft_size,
+	     io_handle->cluster_block_size,
+	     io_handle->mft_entry_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set volume values in metadata cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_get_number_of_segments(
+	     file_system->mft->mft_entry_vector,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entry vector segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libfdata_vector_get_segment_by_index(
+		     file_system->mft->mft_entry_vector,
+		     segment_index,
+		     &segment_file_index,
+		     &segment_offset,
+		     &segment_size,
+		     &segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry vector segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( libfsntfs_metadata_cache_append_mft_range(
+		     metadata_cache,
+		     segment_offset,
+		     segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append MFT range: %d to metadata cache.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+	}
+	/* The MFT entries are read without the MFT entry vector caches
+	 * so that concurrent readers are not affected
+	 */
+	for( mft_entry_index = 0;
+	     mft_entry_index < file_system->mft->number_of_mft_entries;
+	     mft_entry_index++ )
+	{
+		if( libfsntfs_file_system_read_mft_entry_by_index(
+		     file_system,
+		     file_io_handle,
+		     mft_entry_index,
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		if( ( mft_entry->list_attribute != NULL )
+		 && ( mft_entry->attribute_list == NULL ) )
+		{
+			if( libfsntfs_mft_entry_read_attribute_list(
+			     mft_entry,
+			     io_handle,
+			     file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read attribute list of MFT entry: %" PRIu64 ".",
+				 function,
+				 mft_entry_index );
+
+				goto on_error;
+			}
+		}
+		if( mft_entry->attribute_list != NULL )
+		{
+			if( libfsntfs_mft_attribute_list_get_number_of_file_references(
+			     mft_entry->attribute_list,
+			     &number_of_file_references,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of attribute list data MFT entries of MFT entry: %" PRIu64 ".",
+				 function,
+				 mft_entry_index );
+
+				goto on_error;
+			}
+			for( file_reference_index = 0;
+			     file_reference_index < number_of_file_references;
+			     file_reference_index++ )
+			{
+				if( libfsntfs_mft_attribute_list_get_file_reference_by_index(
+				     mft_entry->attribute_list,
+				     file_reference_index,
+				     &file_reference,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve attribute list data MFT entry: %d of MFT entry: %" PRIu64 ".",
+					 function,
+					 file_reference_index,
+					 mft_entry_index );
+
+					goto on_error;
+				}
+				if( libfsntfs_metadata_cache_append_attribute_list_mapping(
+				     metadata_cache,
+				     mft_entry->file_reference,
+				     file_reference,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append attribute list mapping of MFT entry: %" PRIu64 " to metadata cache.",
+					 function,
+					 mft_entry_index );
+
+					goto on_error;
+				}
+			}
+		}
+		if( libfsntfs_mft_entry_free(
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+	}
+	if( file_system->security_descriptor_index != NULL )
+	{
+		if( libfsntfs_security_descriptor_index_append_to_metadata_cache(
+		     file_system->security_descriptor_index,
+		     file_io_handle,
+		     metadata_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append security descriptor mappings to metadata cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfsntfs_file_system_append_path_hints_to_metadata_cache(
+	     file_system,
+	     metadata_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append path hints to metadata cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
 		 NULL );
 	}
 	return( -1 );
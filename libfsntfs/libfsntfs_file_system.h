@@ -25,15 +25,21 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_children_index.h"
+#include "libfsntfs_cluster_allocation_map.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcthreads.h"
+#include "libfsntfs_metadata_cache.h"
 #include "libfsntfs_mft.h"
+#include "libfsntfs_path_component_cache.h"
 #include "libfsntfs_path_hint.h"
+#include "libfsntfs_path_hint_table.h"
 #include "libfsntfs_security_descriptor_index.h"
 #include "libfsntfs_security_descriptor_values.h"
+#include "libfsntfs_upcase_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -55,9 +61,37 @@ struct libfsntfs_file_system
 	 */
 	libcdata_btree_t *list_data_mft_entry_tree;
 
-	/* The path hints B-tree
+	/* The path hint table
 	 */
-	libcdata_btree_t *path_hints_tree;
+	libfsntfs_path_hint_table_t *path_hint_table;
+
+	/* The cluster allocation map
+	 */
+	libfsntfs_cluster_allocation_map_t *cluster_allocation_map;
+
+	/* The upper case table
+	 */
+	libfsntfs_upcase_table_t *upcase_table;
+
+	/* The path component cache
+	 */
+	libfsntfs_path_component_cache_t *path_component_cache;
+
+	/* The children index
+	 */
+	libfsntfs_children_index_t *children_index;
+
+	/* The metadata cache
+	 */
+	libfsntfs_metadata_cache_t *metadata_cache;
+
+	/* The journal sequence number of the $MFT MFT entry
+	 */
+	uint64_t mft_journal_sequence_number;
+
+	/* The $MFT data size
+	 */
+	size64_t mft_size;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
@@ -88,6 +122,12 @@ int libfsntfs_file_system_read_bitmap(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libfsntfs_file_system_read_upcase_table(
+     libfsntfs_file_system_t *file_system,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 int libfsntfs_file_system_read_security_descriptors(
      libfsntfs_file_system_t *file_system,
      libfsntfs_io_handle_t *io_handle,
@@ -113,6 +153,13 @@ int libfsntfs_file_system_get_mft_entry_by_index_no_cache(
      libfsntfs_mft_entry_t **mft_entry,
      libcerror_error_t **error );
 
+int libfsntfs_file_system_read_mft_entry_by_index(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     uint64_t mft_entry_index,
+     libfsntfs_mft_entry_t **mft_entry,
+     libcerror_error_t **error );
+
 int libfsntfs_file_system_get_security_descriptor_values_by_identifier(
      libfsntfs_file_system_t *file_system,
      libbfio_handle_t *file_io_handle,
@@ -120,7 +167,7 @@ int libfsntfs_file_system_get_security_descriptor_values_by_identifier(
      libfsntfs_security_descriptor_values_t **security_descriptor_values,
      libcerror_error_t **error );
 
-int libfsntfs_file_system_get_path_hint(
+int libfsntfs_internal_file_system_get_path_hint(
      libfsntfs_file_system_t *file_system,
      libbfio_handle_t *file_io_handle,
      uint64_t file_reference,
@@ -128,6 +175,65 @@ int libfsntfs_file_system_get_path_hint(
      int recursion_depth,
      libcerror_error_t **error );
 
+int libfsntfs_file_system_get_path_hint(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     uint64_t file_reference,
+     libfsntfs_path_hint_t **path_hint,
+     libcerror_error_t **error );
+
+int libfsntfs_file_system_set_maximum_number_of_path_hints(
+     libfsntfs_file_system_t *file_system,
+     int maximum_number_of_path_hints,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_file_system_read_children_index(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsntfs_file_system_read_children_index(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsntfs_file_system_get_number_of_children(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     int *number_of_children,
+     libcerror_error_t **error );
+
+int libfsntfs_file_system_get_child_mft_entry_index_by_index(
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     uint64_t parent_file_reference,
+     uint8_t parent_is_allocated,
+     int child_index,
+     uint64_t *child_mft_entry_index,
+     libcerror_error_t **error );
+
+int libfsntfs_file_system_get_cluster_allocation_map(
+     libfsntfs_file_system_t *file_system,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_cluster_allocation_map_t **cluster_allocation_map,
+     libcerror_error_t **error );
+
+int libfsntfs_file_system_append_path_hints_to_metadata_cache(
+     libfsntfs_file_system_t *file_system,
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error );
+
+int libfsntfs_file_system_append_to_metadata_cache(
+     libfsntfs_file_system_t *file_system,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint64_t volume_serial_number,
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -332,6 +332,7 @@ int libfsntfs_index_read(
 	static char *function                                 = "libfsntfs_index_read";
 	uint32_t attribute_type                               = 0;
 	int attribute_index                                   = 0;
+	int maximum_number_of_cache_entries                   = 0;
 	int number_of_attributes                              = 0;
 	int result                                            = 0;
 
@@ -540,9 +541,25 @@ int libfsntfs_index_read(
 
 			goto on_error;
 		}
+		if( libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+		     index->io_handle,
+		     LIBFSNTFS_CACHE_TYPE_INDEX_NODES,
+		     (size_t) index->io_handle->index_entry_size,
+		     &maximum_number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve maximum number of index node cache entries.",
+			 function );
+
+			goto on_error;
+		}
 		if( libfcache_cache_initialize(
 		     &( index->index_node_cache ),
-		     LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_INDEX_NODES,
+		     maximum_number_of_cache_entries,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
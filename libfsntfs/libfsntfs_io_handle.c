@@ -23,6 +23,8 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsntfs_async_reader.h"
+#include "libfsntfs_definitions.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libcerror.h"
 
@@ -93,6 +95,23 @@ int libfsntfs_io_handle_initialize(
 
 		return( -1 );
 	}
+	( *io_handle )->mft_readahead_size  = LIBFSNTFS_DEFAULT_MFT_READAHEAD_SIZE;
+	( *io_handle )->data_readahead_size = LIBFSNTFS_DEFAULT_DATA_READAHEAD_SIZE;
+	( *io_handle )->read_queue_depth    = 1;
+
+	if( libfsntfs_async_reader_initialize(
+	     &( ( *io_handle )->async_reader ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create asynchronous reader.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_PROFILER )
 	if( libfsntfs_profiler_initialize(
 	     &( ( *io_handle )->profiler ),
@@ -128,6 +147,12 @@ int libfsntfs_io_handle_initialize(
 on_error:
 	if( *io_handle != NULL )
 	{
+		if( ( *io_handle )->async_reader != NULL )
+		{
+			libfsntfs_async_reader_free(
+			 &( ( *io_handle )->async_reader ),
+			 NULL );
+		}
 #if defined( HAVE_PROFILER )
 		if( ( *io_handle )->profiler != NULL )
 		{
@@ -196,6 +221,19 @@ int libfsntfs_io_handle_free(
 		}
 #endif /* defined( HAVE_PROFILER ) */
 
+		if( libfsntfs_async_reader_free(
+		     &( ( *io_handle )->async_reader ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free asynchronous reader.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *io_handle );
 
@@ -211,10 +249,18 @@ int libfsntfs_io_handle_clear(
      libfsntfs_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function          = "libfsntfs_io_handle_clear";
+	libfsntfs_async_reader_t *async_reader       = NULL;
+	static char *function                        = "libfsntfs_io_handle_clear";
+	size64_t maximum_compressed_block_cache_size = 0;
+	size64_t maximum_index_node_cache_size       = 0;
+	size64_t maximum_mft_entry_cache_size        = 0;
+	size_t data_readahead_size                   = 0;
+	size_t mft_readahead_size                    = 0;
+	int maximum_number_of_path_hints             = 0;
+	int read_queue_depth                         = 0;
 
 #if defined( HAVE_PROFILER )
-	libfsntfs_profiler_t *profiler = NULL;
+	libfsntfs_profiler_t *profiler               = NULL;
 #endif
 
 	if( io_handle == NULL )
@@ -231,6 +277,15 @@ int libfsntfs_io_handle_clear(
 #if defined( HAVE_PROFILER )
 	profiler = io_handle->profiler;
 #endif
+	mft_readahead_size                  = io_handle->mft_readahead_size;
+	data_readahead_size                 = io_handle->data_readahead_size;
+	maximum_mft_entry_cache_size        = io_handle->maximum_mft_entry_cache_size;
+	maximum_index_node_cache_size       = io_handle->maximum_index_node_cache_size;
+	maximum_compressed_block_cache_size = io_handle->maximum_compressed_block_cache_size;
+	maximum_number_of_path_hints        = io_handle->maximum_number_of_path_hints;
+	read_queue_depth                    = io_handle->read_queue_depth;
+	async_reader                        = io_handle->async_reader;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -248,6 +303,104 @@ int libfsntfs_io_handle_clear(
 #if defined( HAVE_PROFILER )
 	io_handle->profiler = profiler;
 #endif
+	io_handle->mft_readahead_size                  = mft_readahead_size;
+	io_handle->data_readahead_size                 = data_readahead_size;
+	io_handle->maximum_mft_entry_cache_size        = maximum_mft_entry_cache_size;
+	io_handle->maximum_index_node_cache_size       = maximum_index_node_cache_size;
+	io_handle->maximum_compressed_block_cache_size = maximum_compressed_block_cache_size;
+	io_handle->maximum_number_of_path_hints        = maximum_number_of_path_hints;
+	io_handle->read_queue_depth                    = read_queue_depth;
+	io_handle->async_reader                        = async_reader;
+
+	return( 1 );
+}
+
+/* Retrieves the maximum number of cache entries for a specific cache type
+ * The number of cache entries is derived from the maximum cache size in bytes
+ * and the size of a cache value, or the default if no maximum cache size was set
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+     libfsntfs_io_handle_t *io_handle,
+     int cache_type,
+     size_t cache_value_size,
+     int *maximum_number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	static char *function         = "libfsntfs_io_handle_get_maximum_number_of_cache_entries";
+	size64_t maximum_cache_size   = 0;
+	uint64_t number_of_entries    = 0;
+	int default_number_of_entries = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_cache_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	switch( cache_type )
+	{
+		case LIBFSNTFS_CACHE_TYPE_COMPRESSED_BLOCKS:
+			maximum_cache_size        = io_handle->maximum_compressed_block_cache_size;
+			default_number_of_entries = LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_COMPRESSED_BLOCKS;
+			break;
+
+		case LIBFSNTFS_CACHE_TYPE_INDEX_NODES:
+			maximum_cache_size        = io_handle->maximum_index_node_cache_size;
+			default_number_of_entries = LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_INDEX_NODES;
+			break;
+
+		case LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES:
+			maximum_cache_size        = io_handle->maximum_mft_entry_cache_size;
+			default_number_of_entries = LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_MFT_ENTRIES;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported cache type: %d.",
+			 function,
+			 cache_type );
+
+			return( -1 );
+	}
+	if( ( maximum_cache_size == 0 )
+	 || ( cache_value_size == 0 ) )
+	{
+		*maximum_number_of_cache_entries = default_number_of_entries;
+
+		return( 1 );
+	}
+	number_of_entries = maximum_cache_size / cache_value_size;
+
+	if( number_of_entries == 0 )
+	{
+		number_of_entries = 1;
+	}
+	else if( number_of_entries > (uint64_t) LIBFSNTFS_MAXIMUM_NUMBER_OF_CACHE_ENTRIES )
+	{
+		number_of_entries = LIBFSNTFS_MAXIMUM_NUMBER_OF_CACHE_ENTRIES;
+	}
+	*maximum_number_of_cache_entries = (int) number_of_entries;
+
 	return( 1 );
 }
 
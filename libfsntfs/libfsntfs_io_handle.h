@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_async_reader.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_profiler.h"
 
@@ -54,6 +55,42 @@ struct libfsntfs_io_handle
 	 */
 	uint16_t bytes_per_sector;
 
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The MFT read-ahead size
+	 */
+	size_t mft_readahead_size;
+
+	/* The data read-ahead size
+	 */
+	size_t data_readahead_size;
+
+	/* The read queue depth, the maximum number of reads in flight
+	 */
+	int read_queue_depth;
+
+	/* The asynchronous reader
+	 */
+	libfsntfs_async_reader_t *async_reader;
+
+	/* The maximum size of the MFT entry cache in bytes, 0 represents the default
+	 */
+	size64_t maximum_mft_entry_cache_size;
+
+	/* The maximum size of an index node cache in bytes, 0 represents the default
+	 */
+	size64_t maximum_index_node_cache_size;
+
+	/* The maximum size of a compressed block cache in bytes, 0 represents the default
+	 */
+	size64_t maximum_compressed_block_cache_size;
+
+	/* The maximum number of path hints, 0 represents no maximum
+	 */
+	int maximum_number_of_path_hints;
+
 #if defined( HAVE_PROFILER )
 	/* The profiler
 	 */
@@ -77,6 +114,13 @@ int libfsntfs_io_handle_clear(
      libfsntfs_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+     libfsntfs_io_handle_t *io_handle,
+     int cache_type,
+     size_t cache_value_size,
+     int *maximum_number_of_cache_entries,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
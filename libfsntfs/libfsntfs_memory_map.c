@@ -0,0 +1,842 @@
+/*
+ * Memory mapped file functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libclocale.h"
+#include "libfsntfs_libuna.h"
+#include "libfsntfs_memory_map.h"
+
+#if !defined( O_CLOEXEC )
+#define O_CLOEXEC	0
+#endif
+
+/* Creates a memory map
+ * Make sure the value memory_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_memory_map_initialize(
+     libfsntfs_memory_map_t **memory_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_memory_map_initialize";
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *memory_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid memory map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*memory_map = memory_allocate_structure(
+	               libfsntfs_memory_map_t );
+
+	if( *memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create memory map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *memory_map,
+	     0,
+	     sizeof( libfsntfs_memory_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear memory map.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *memory_map != NULL )
+	{
+		memory_free(
+		 *memory_map );
+
+		*memory_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a memory map
+ * The mapping is closed if it is still open
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_memory_map_free(
+     libfsntfs_memory_map_t **memory_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_memory_map_free";
+	int result            = 1;
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *memory_map != NULL )
+	{
+		if( ( *memory_map )->data != NULL )
+		{
+			if( libfsntfs_memory_map_close(
+			     *memory_map,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close memory map.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *memory_map );
+
+		*memory_map = NULL;
+	}
+	return( result );
+}
+
+#if defined( WINAPI )
+
+/* Maps a file or device read-only into memory from an open file handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_memory_map_open_file_handle(
+     libfsntfs_memory_map_t *memory_map,
+     HANDLE file_handle,
+     libcerror_error_t **error )
+{
+	LARGE_INTEGER large_integer_size;
+
+	HANDLE mapping_handle = NULL;
+	static char *function = "libfsntfs_memory_map_open_file_handle";
+	DWORD error_code      = 0;
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	if( GetFileSizeEx(
+	     file_handle,
+	     &large_integer_size ) == 0 )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 error_code,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( large_integer_size.QuadPart <= 0 )
+	 || ( (uint64_t) large_integer_size.QuadPart > (uint64_t) SIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	mapping_handle = CreateFileMappingA(
+	                  file_handle,
+	                  NULL,
+	                  PAGE_READONLY,
+	                  0,
+	                  0,
+	                  NULL );
+
+	if( mapping_handle == NULL )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 error_code,
+		 "%s: unable to create file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	memory_map->data = (uint8_t *) MapViewOfFile(
+	                                mapping_handle,
+	                                FILE_MAP_READ,
+	                                0,
+	                                0,
+	                                0 );
+
+	if( memory_map->data == NULL )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 error_code,
+		 "%s: unable to map view of file.",
+		 function );
+
+		CloseHandle(
+		 mapping_handle );
+
+		return( -1 );
+	}
+	memory_map->data_size = (size64_t) large_integer_size.QuadPart;
+
+	/* The view remains valid after the mapping handle is closed
+	 */
+	CloseHandle(
+	 mapping_handle );
+
+	return( 1 );
+}
+
+#elif defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && defined( HAVE_LSEEK )
+
+/* Maps a file or device read-only into memory from an open file descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_memory_map_open_file_descriptor(
+     libfsntfs_memory_map_t *memory_map,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	void *mapped_data     = NULL;
+	static char *function = "libfsntfs_memory_map_open_file_descriptor";
+	off64_t file_size     = 0;
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	/* Seeking to the end also determines the size of a block device
+	 */
+	file_size = (off64_t) lseek(
+	                       file_descriptor,
+	                       0,
+	                       SEEK_END );
+
+	if( file_size < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to determine file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_size == 0 )
+	 || ( (uint64_t) file_size > (uint64_t) SIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	mapped_data = mmap(
+	               NULL,
+	               (size_t) file_size,
+	               PROT_READ,
+	               MAP_SHARED,
+	               file_descriptor,
+	               0 );
+
+	if( mapped_data == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to map file.",
+		 function );
+
+		return( -1 );
+	}
+	memory_map->data      = (uint8_t *) mapped_data;
+	memory_map->data_size = (size64_t) file_size;
+
+	return( 1 );
+}
+
+#endif /* defined( WINAPI ) */
+
+/* Opens a memory map
+ * Maps the entire file or device read-only into memory
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_memory_map_open(
+     libfsntfs_memory_map_t *memory_map,
+     const char *filename,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	HANDLE file_handle    = INVALID_HANDLE_VALUE;
+	DWORD error_code      = 0;
+#elif defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && defined( HAVE_LSEEK )
+	int file_descriptor   = -1;
+#endif
+
+	static char *function = "libfsntfs_memory_map_open";
+	int result            = -1;
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_map->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid memory map - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	file_handle = CreateFileA(
+	               (LPCSTR) filename,
+	               GENERIC_READ,
+	               FILE_SHARE_READ | FILE_SHARE_WRITE,
+	               NULL,
+	               OPEN_EXISTING,
+	               FILE_ATTRIBUTE_NORMAL,
+	               NULL );
+
+	if( file_handle == INVALID_HANDLE_VALUE )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 error_code,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	result = libfsntfs_memory_map_open_file_handle(
+	          memory_map,
+	          file_handle,
+	          error );
+
+	/* The view remains valid after the file handle is closed
+	 */
+	CloseHandle(
+	 file_handle );
+
+#elif defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && defined( HAVE_LSEEK )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY | O_CLOEXEC );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	result = libfsntfs_memory_map_open_file_descriptor(
+	          memory_map,
+	          file_descriptor,
+	          error );
+
+	/* The mapping remains valid after the file descriptor is closed
+	 */
+	close(
+	 file_descriptor );
+
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: memory mapped files are not supported on this platform.",
+	 function );
+
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to map file: %s.",
+		 function,
+		 filename );
+	}
+	return( result );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a memory map
+ * Maps the entire file or device read-only into memory
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_memory_map_open_wide(
+     libfsntfs_memory_map_t *memory_map,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	HANDLE file_handle      = INVALID_HANDLE_VALUE;
+	DWORD error_code        = 0;
+#else
+	char *narrow_filename   = NULL;
+	size_t filename_length  = 0;
+	size_t narrow_size      = 0;
+	int result_conversion   = 0;
+#endif
+
+	static char *function   = "libfsntfs_memory_map_open_wide";
+	int result              = -1;
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_map->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid memory map - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	file_handle = CreateFileW(
+	               (LPCWSTR) filename,
+	               GENERIC_READ,
+	               FILE_SHARE_READ | FILE_SHARE_WRITE,
+	               NULL,
+	               OPEN_EXISTING,
+	               FILE_ATTRIBUTE_NORMAL,
+	               NULL );
+
+	if( file_handle == INVALID_HANDLE_VALUE )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 error_code,
+		 "%s: unable to open file: %ls.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	result = libfsntfs_memory_map_open_file_handle(
+	          memory_map,
+	          file_handle,
+	          error );
+
+	/* The view remains valid after the file handle is closed
+	 */
+	CloseHandle(
+	 file_handle );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to map file: %ls.",
+		 function,
+		 filename );
+	}
+	return( result );
+#else
+	/* Convert the filename into a narrow string using the codepage
+	 * of the system, as done by libbfio for file names
+	 */
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result_conversion = libuna_utf8_string_size_from_utf32(
+		                     (libuna_utf32_character_t *) filename,
+		                     filename_length + 1,
+		                     &narrow_size,
+		                     error );
+#elif SIZEOF_WCHAR_T == 2
+		result_conversion = libuna_utf8_string_size_from_utf16(
+		                     (libuna_utf16_character_t *) filename,
+		                     filename_length + 1,
+		                     &narrow_size,
+		                     error );
+#else
+#error Unsupported size of wchar_t
+#endif
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result_conversion = libuna_byte_stream_size_from_utf32(
+		                     (libuna_utf32_character_t *) filename,
+		                     filename_length + 1,
+		                     libclocale_codepage,
+		                     &narrow_size,
+		                     error );
+#elif SIZEOF_WCHAR_T == 2
+		result_conversion = libuna_byte_stream_size_from_utf16(
+		                     (libuna_utf16_character_t *) filename,
+		                     filename_length + 1,
+		                     libclocale_codepage,
+		                     &narrow_size,
+		                     error );
+#else
+#error Unsupported size of wchar_t
+#endif
+	}
+	if( result_conversion != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine narrow filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( narrow_size == 0 )
+	 || ( narrow_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( char ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid narrow filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	narrow_filename = narrow_string_allocate(
+	                   narrow_size );
+
+	if( narrow_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create narrow filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result_conversion = libuna_utf8_string_copy_from_utf32(
+		                     (libuna_utf8_character_t *) narrow_filename,
+		                     narrow_size,
+		                     (libuna_utf32_character_t *) filename,
+		                     filename_length + 1,
+		                     error );
+#elif SIZEOF_WCHAR_T == 2
+		result_conversion = libuna_utf8_string_copy_from_utf16(
+		                     (libuna_utf8_character_t *) narrow_filename,
+		                     narrow_size,
+		                     (libuna_utf16_character_t *) filename,
+		                     filename_length + 1,
+		                     error );
+#endif
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result_conversion = libuna_byte_stream_copy_from_utf32(
+		                     (uint8_t *) narrow_filename,
+		                     narrow_size,
+		                     libclocale_codepage,
+		                     (libuna_utf32_character_t *) filename,
+		                     filename_length + 1,
+		                     error );
+#elif SIZEOF_WCHAR_T == 2
+		result_conversion = libuna_byte_stream_copy_from_utf16(
+		                     (uint8_t *) narrow_filename,
+		                     narrow_size,
+		                     libclocale_codepage,
+		                     (libuna_utf16_character_t *) filename,
+		                     filename_length + 1,
+		                     error );
+#endif
+	}
+	if( result_conversion != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set narrow filename.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsntfs_memory_map_open(
+	          memory_map,
+	          narrow_filename,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open memory map.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 narrow_filename );
+
+	return( 1 );
+
+on_error:
+	if( narrow_filename != NULL )
+	{
+		memory_free(
+		 narrow_filename );
+	}
+	return( -1 );
+#endif /* defined( WINAPI ) */
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Closes a memory map
+ * Returns 0 if successful or -1 on error
+ */
+int libfsntfs_memory_map_close(
+     libfsntfs_memory_map_t *memory_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_memory_map_close";
+
+#if defined( WINAPI )
+	DWORD error_code      = 0;
+#endif
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_map->data == NULL )
+	{
+		return( 0 );
+	}
+#if defined( WINAPI )
+	if( UnmapViewOfFile(
+	     memory_map->data ) == 0 )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 error_code,
+		 "%s: unable to unmap view of file.",
+		 function );
+
+		return( -1 );
+	}
+#elif defined( HAVE_MUNMAP )
+	if( munmap(
+	     memory_map->data,
+	     (size_t) memory_map->data_size ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to unmap file.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	memory_map->data      = NULL;
+	memory_map->data_size = 0;
+
+	return( 0 );
+}
+
@@ -0,0 +1,90 @@
+/*
+ * Memory mapped file functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_MEMORY_MAP_H )
+#define _LIBFSNTFS_MEMORY_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_memory_map libfsntfs_memory_map_t;
+
+struct libfsntfs_memory_map
+{
+	/* The mapped data
+	 */
+	uint8_t *data;
+
+	/* The mapped data size
+	 */
+	size64_t data_size;
+};
+
+int libfsntfs_memory_map_initialize(
+     libfsntfs_memory_map_t **memory_map,
+     libcerror_error_t **error );
+
+int libfsntfs_memory_map_free(
+     libfsntfs_memory_map_t **memory_map,
+     libcerror_error_t **error );
+
+#if defined( WINAPI )
+int libfsntfs_memory_map_open_file_handle(
+     libfsntfs_memory_map_t *memory_map,
+     HANDLE file_handle,
+     libcerror_error_t **error );
+
+#elif defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && defined( HAVE_LSEEK )
+int libfsntfs_memory_map_open_file_descriptor(
+     libfsntfs_memory_map_t *memory_map,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+#endif
+int libfsntfs_memory_map_open(
+     libfsntfs_memory_map_t *memory_map,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+int libfsntfs_memory_map_open_wide(
+     libfsntfs_memory_map_t *memory_map,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif
+
+int libfsntfs_memory_map_close(
+     libfsntfs_memory_map_t *memory_map,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_MEMORY_MAP_H ) */
+
@@ -0,0 +1,2581 @@
+/*
+ * Metadata cache functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcnotify.h"
+#include "libfsntfs_memory_map.h"
+#include "libfsntfs_metadata_cache.h"
+
+#include "fsntfs_metadata_cache.h"
+
+const char *fsntfs_metadata_cache_signature = "fsntfsmc";
+
+/* Compares two attribute list mappings by their base record file reference
+ * and file reference
+ * Callback for qsort
+ * Returns -1 if the first mapping sorts before the second, 1 if after or 0 if equal
+ */
+int libfsntfs_metadata_cache_attribute_list_mapping_compare(
+     const void *first_mapping_data,
+     const void *second_mapping_data )
+{
+	uint64_t first_value  = 0;
+	uint64_t second_value = 0;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_attribute_list_mapping_t *) first_mapping_data )->base_record_file_reference,
+	 first_value );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_attribute_list_mapping_t *) second_mapping_data )->base_record_file_reference,
+	 second_value );
+
+	if( first_value == second_value )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsntfs_metadata_cache_attribute_list_mapping_t *) first_mapping_data )->file_reference,
+		 first_value );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsntfs_metadata_cache_attribute_list_mapping_t *) second_mapping_data )->file_reference,
+		 second_value );
+	}
+	if( first_value < second_value )
+	{
+		return( -1 );
+	}
+	else if( first_value > second_value )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Compares two security descriptor mappings by their identifier
+ * Callback for qsort
+ * Returns -1 if the first mapping sorts before the second, 1 if after or 0 if equal
+ */
+int libfsntfs_metadata_cache_security_descriptor_mapping_compare(
+     const void *first_mapping_data,
+     const void *second_mapping_data )
+{
+	uint32_t first_identifier  = 0;
+	uint32_t second_identifier = 0;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_security_descriptor_mapping_t *) first_mapping_data )->identifier,
+	 first_identifier );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_security_descriptor_mapping_t *) second_mapping_data )->identifier,
+	 second_identifier );
+
+	if( first_identifier < second_identifier )
+	{
+		return( -1 );
+	}
+	else if( first_identifier > second_identifier )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Compares two path hints by their file reference
+ * Callback for qsort
+ * Returns -1 if the first path hint sorts before the second, 1 if after or 0 if equal
+ */
+int libfsntfs_metadata_cache_path_hint_compare(
+     const void *first_path_hint_data,
+     const void *second_path_hint_data )
+{
+	uint64_t first_file_reference  = 0;
+	uint64_t second_file_reference = 0;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_path_hint_t *) first_path_hint_data )->file_reference,
+	 first_file_reference );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_path_hint_t *) second_path_hint_data )->file_reference,
+	 second_file_reference );
+
+	if( first_file_reference < second_file_reference )
+	{
+		return( -1 );
+	}
+	else if( first_file_reference > second_file_reference )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Appends data to a metadata cache section
+ * If the section references read data, the read data is copied into the buffer first
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_section_append_data(
+     libfsntfs_metadata_cache_section_t *section,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer              = NULL;
+	const uint8_t *read_data     = NULL;
+	static char *function        = "libfsntfs_metadata_cache_section_append_data";
+	size_t buffer_size           = 0;
+	size_t required_size         = 0;
+	uint8_t references_read_data = 0;
+
+	if( section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE - section->data_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( section->data != NULL )
+	 && ( section->data != section->buffer ) )
+	{
+		read_data            = section->data;
+		references_read_data = 1;
+	}
+	required_size = section->data_size + data_size;
+
+	if( ( references_read_data != 0 )
+	 || ( required_size > section->buffer_size ) )
+	{
+		buffer_size = section->buffer_size;
+
+		if( buffer_size < 4096 )
+		{
+			buffer_size = 4096;
+		}
+		while( buffer_size < required_size )
+		{
+			if( buffer_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / 2 ) )
+			{
+				buffer_size = (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE;
+
+				break;
+			}
+			buffer_size *= 2;
+		}
+		buffer = (uint8_t *) memory_reallocate(
+		                      section->buffer,
+		                      sizeof( uint8_t ) * buffer_size );
+
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize buffer.",
+			 function );
+
+			return( -1 );
+		}
+		section->buffer      = buffer;
+		section->buffer_size = buffer_size;
+
+		if( references_read_data != 0 )
+		{
+			if( memory_copy(
+			     section->buffer,
+			     read_data,
+			     section->data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy read data to buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		section->data = section->buffer;
+	}
+	if( memory_copy(
+	     &( section->buffer[ section->data_size ] ),
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data to buffer.",
+		 function );
+
+		return( -1 );
+	}
+	section->data       = section->buffer;
+	section->data_size += data_size;
+
+	return( 1 );
+}
+
+/* Creates a metadata cache
+ * Make sure the value metadata_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_initialize(
+     libfsntfs_metadata_cache_t **metadata_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_metadata_cache_initialize";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*metadata_cache = memory_allocate_structure(
+	                   libfsntfs_metadata_cache_t );
+
+	if( *metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *metadata_cache,
+	     0,
+	     sizeof( libfsntfs_metadata_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear metadata cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *metadata_cache != NULL )
+	{
+		memory_free(
+		 *metadata_cache );
+
+		*metadata_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a metadata cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_free(
+     libfsntfs_metadata_cache_t **metadata_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_metadata_cache_free";
+	int result            = 1;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_cache != NULL )
+	{
+		if( ( *metadata_cache )->memory_map != NULL )
+		{
+			if( libfsntfs_memory_map_free(
+			     &( ( *metadata_cache )->memory_map ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free memory map.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *metadata_cache )->mft_ranges.buffer != NULL )
+		{
+			memory_free(
+			 ( *metadata_cache )->mft_ranges.buffer );
+		}
+		if( ( *metadata_cache )->attribute_list_mappings.buffer != NULL )
+		{
+			memory_free(
+			 ( *metadata_cache )->attribute_list_mappings.buffer );
+		}
+		if( ( *metadata_cache )->security_descriptor_mappings.buffer != NULL )
+		{
+			memory_free(
+			 ( *metadata_cache )->security_descriptor_mappings.buffer );
+		}
+		if( ( *metadata_cache )->path_hints.buffer != NULL )
+		{
+			memory_free(
+			 ( *metadata_cache )->path_hints.buffer );
+		}
+		if( ( *metadata_cache )->path_data.buffer != NULL )
+		{
+			memory_free(
+			 ( *metadata_cache )->path_data.buffer );
+		}
+		memory_free(
+		 *metadata_cache );
+
+		*metadata_cache = NULL;
+	}
+	return( result );
+}
+
+/* Clears a metadata cache
+ * The section buffers are retained for reuse
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_clear(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_metadata_cache_clear";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_cache->memory_map != NULL )
+	{
+		if( libfsntfs_memory_map_free(
+		     &( metadata_cache->memory_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free memory map.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	metadata_cache->volume_serial_number        = 0;
+	metadata_cache->mft_journal_sequence_number = 0;
+	metadata_cache->mft_size                    = 0;
+	metadata_cache->cluster_block_size          = 0;
+	metadata_cache->mft_entry_size              = 0;
+
+	metadata_cache->mft_ranges.data                            = NULL;
+	metadata_cache->mft_ranges.data_size                       = 0;
+	metadata_cache->attribute_list_mappings.data               = NULL;
+	metadata_cache->attribute_list_mappings.data_size          = 0;
+	metadata_cache->attribute_list_mappings.requires_sort      = 0;
+	metadata_cache->security_descriptor_mappings.data          = NULL;
+	metadata_cache->security_descriptor_mappings.data_size     = 0;
+	metadata_cache->security_descriptor_mappings.requires_sort = 0;
+	metadata_cache->path_hints.data                            = NULL;
+	metadata_cache->path_hints.data_size                       = 0;
+	metadata_cache->path_hints.requires_sort                   = 0;
+	metadata_cache->path_data.data                             = NULL;
+	metadata_cache->path_data.data_size                        = 0;
+
+	return( 1 );
+}
+
+/* Reads the metadata cache
+ * The metadata cache references the data, which must remain valid while the metadata cache is used
+ * Returns 1 if successful, 0 if the data does not contain a supported metadata cache or -1 on error
+ */
+int libfsntfs_metadata_cache_read_data(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *previous_record_data             = NULL;
+	const uint8_t *record_data                      = NULL;
+	static char *function                           = "libfsntfs_metadata_cache_read_data";
+	size_t attribute_list_mappings_offset           = 0;
+	size_t data_offset                              = 0;
+	size_t path_data_offset                         = 0;
+	size_t path_hints_offset                        = 0;
+	size_t security_descriptor_mappings_offset      = 0;
+	uint64_t file_reference                         = 0;
+	uint32_t format_version                         = 0;
+	uint32_t number_of_attribute_list_mappings      = 0;
+	uint32_t number_of_mft_ranges                   = 0;
+	uint32_t number_of_path_hints                   = 0;
+	uint32_t number_of_security_descriptor_mappings = 0;
+	uint32_t path_data_size                         = 0;
+	uint32_t path_offset                            = 0;
+	uint32_t path_size                              = 0;
+	uint32_t record_index                           = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < sizeof( fsntfs_metadata_cache_header_t ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     ( (fsntfs_metadata_cache_header_t *) data )->signature,
+	     fsntfs_metadata_cache_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->format_version,
+	 format_version );
+
+	if( format_version != 2 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->number_of_mft_ranges,
+	 number_of_mft_ranges );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->number_of_attribute_list_mappings,
+	 number_of_attribute_list_mappings );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->number_of_security_descriptor_mappings,
+	 number_of_security_descriptor_mappings );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->number_of_path_hints,
+	 number_of_path_hints );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->path_data_size,
+	 path_data_size );
+
+	data_offset = sizeof( fsntfs_metadata_cache_header_t );
+
+	if( ( number_of_mft_ranges > (uint32_t) INT_MAX )
+	 || ( (size_t) number_of_mft_ranges > ( ( data_size - data_offset ) / sizeof( fsntfs_metadata_cache_mft_range_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of MFT ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset += sizeof( fsntfs_metadata_cache_mft_range_t ) * (size_t) number_of_mft_ranges;
+
+	attribute_list_mappings_offset = data_offset;
+
+	if( ( number_of_attribute_list_mappings > (uint32_t) INT_MAX )
+	 || ( (size_t) number_of_attribute_list_mappings > ( ( data_size - data_offset ) / sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of attribute list mappings value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset += sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) * (size_t) number_of_attribute_list_mappings;
+
+	security_descriptor_mappings_offset = data_offset;
+
+	if( ( number_of_security_descriptor_mappings > (uint32_t) INT_MAX )
+	 || ( (size_t) number_of_security_descriptor_mappings > ( ( data_size - data_offset ) / sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of security descriptor mappings value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset += sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ) * (size_t) number_of_security_descriptor_mappings;
+
+	path_hints_offset = data_offset;
+
+	if( ( number_of_path_hints > (uint32_t) INT_MAX )
+	 || ( (size_t) number_of_path_hints > ( ( data_size - data_offset ) / sizeof( fsntfs_metadata_cache_path_hint_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of path hints value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset += sizeof( fsntfs_metadata_cache_path_hint_t ) * (size_t) number_of_path_hints;
+
+	path_data_offset = data_offset;
+
+	if( (size_t) path_data_size > ( data_size - data_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The lookups use a binary search hence the sort order of the sections is validated
+	 */
+	previous_record_data = NULL;
+
+	for( record_index = 0;
+	     record_index < number_of_attribute_list_mappings;
+	     record_index++ )
+	{
+		record_data = &( data[ attribute_list_mappings_offset + ( sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) * record_index ) ] );
+
+		if( ( previous_record_data != NULL )
+		 && ( libfsntfs_metadata_cache_attribute_list_mapping_compare(
+		       previous_record_data,
+		       record_data ) > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported attribute list mapping: %" PRIu32 " - not sorted.",
+			 function,
+			 record_index );
+
+			return( -1 );
+		}
+		previous_record_data = record_data;
+	}
+	previous_record_data = NULL;
+
+	for( record_index = 0;
+	     record_index < number_of_security_descriptor_mappings;
+	     record_index++ )
+	{
+		record_data = &( data[ security_descriptor_mappings_offset + ( sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ) * record_index ) ] );
+
+		if( ( previous_record_data != NULL )
+		 && ( libfsntfs_metadata_cache_security_descriptor_mapping_compare(
+		       previous_record_data,
+		       record_data ) > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported security descriptor mapping: %" PRIu32 " - not sorted.",
+			 function,
+			 record_index );
+
+			return( -1 );
+		}
+		previous_record_data = record_data;
+	}
+	previous_record_data = NULL;
+
+	for( record_index = 0;
+	     record_index < number_of_path_hints;
+	     record_index++ )
+	{
+		record_data = &( data[ path_hints_offset + ( sizeof( fsntfs_metadata_cache_path_hint_t ) * record_index ) ] );
+
+		if( ( previous_record_data != NULL )
+		 && ( libfsntfs_metadata_cache_path_hint_compare(
+		       previous_record_data,
+		       record_data ) > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported path hint: %" PRIu32 " - not sorted.",
+			 function,
+			 record_index );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsntfs_metadata_cache_path_hint_t *) record_data )->file_reference,
+		 file_reference );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fsntfs_metadata_cache_path_hint_t *) record_data )->path_offset,
+		 path_offset );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fsntfs_metadata_cache_path_hint_t *) record_data )->path_size,
+		 path_size );
+
+		if( ( path_size == 0 )
+		 || ( path_offset > path_data_size )
+		 || ( path_size > ( path_data_size - path_offset ) )
+		 || ( data[ path_data_offset + path_offset + path_size - 1 ] != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid path hint: %" PRIu32 " of file reference: %" PRIu64 "-%" PRIu64 " path value out of bounds.",
+			 function,
+			 record_index,
+			 file_reference & 0xffffffffffffUL,
+			 file_reference >> 48 );
+
+			return( -1 );
+		}
+		previous_record_data = record_data;
+	}
+	if( libfsntfs_metadata_cache_clear(
+	     metadata_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->volume_serial_number,
+	 metadata_cache->volume_serial_number );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->mft_journal_sequence_number,
+	 metadata_cache->mft_journal_sequence_number );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->mft_size,
+	 metadata_cache->mft_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->cluster_block_size,
+	 metadata_cache->cluster_block_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->mft_entry_size,
+	 metadata_cache->mft_entry_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: number of MFT ranges\t\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_mft_ranges );
+
+		libcnotify_printf(
+		 "%s: volume serial number\t\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 metadata_cache->volume_serial_number );
+
+		libcnotify_printf(
+		 "%s: MFT journal sequence number\t\t: %" PRIu64 "\n",
+		 function,
+		 metadata_cache->mft_journal_sequence_number );
+
+		libcnotify_printf(
+		 "%s: MFT size\t\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 metadata_cache->mft_size );
+
+		libcnotify_printf(
+		 "%s: cluster block size\t\t\t: %" PRIu32 "\n",
+		 function,
+		 metadata_cache->cluster_block_size );
+
+		libcnotify_printf(
+		 "%s: MFT entry size\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 metadata_cache->mft_entry_size );
+
+		libcnotify_printf(
+		 "%s: number of attribute list mappings\t: %" PRIu32 "\n",
+		 function,
+		 number_of_attribute_list_mappings );
+
+		libcnotify_printf(
+		 "%s: number of security descriptor mappings\t: %" PRIu32 "\n",
+		 function,
+		 number_of_security_descriptor_mappings );
+
+		libcnotify_printf(
+		 "%s: number of path hints\t\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_path_hints );
+
+		libcnotify_printf(
+		 "%s: path data size\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 path_data_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	/* The sections reference the data directly and are not copied
+	 */
+	metadata_cache->mft_ranges.data                        = &( data[ sizeof( fsntfs_metadata_cache_header_t ) ] );
+	metadata_cache->mft_ranges.data_size                   = sizeof( fsntfs_metadata_cache_mft_range_t ) * (size_t) number_of_mft_ranges;
+	metadata_cache->attribute_list_mappings.data           = &( data[ attribute_list_mappings_offset ] );
+	metadata_cache->attribute_list_mappings.data_size      = sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) * (size_t) number_of_attribute_list_mappings;
+	metadata_cache->security_descriptor_mappings.data      = &( data[ security_descriptor_mappings_offset ] );
+	metadata_cache->security_descriptor_mappings.data_size = sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ) * (size_t) number_of_security_descriptor_mappings;
+	metadata_cache->path_hints.data                        = &( data[ path_hints_offset ] );
+	metadata_cache->path_hints.data_size                   = sizeof( fsntfs_metadata_cache_path_hint_t ) * (size_t) number_of_path_hints;
+	metadata_cache->path_data.data                         = &( data[ path_data_offset ] );
+	metadata_cache->path_data.data_size                    = (size_t) path_data_size;
+
+	return( 1 );
+}
+
+/* Opens and reads a metadata cache file
+ * The file is memory mapped and remains mapped until the metadata cache is cleared or freed
+ * Returns 1 if successful, 0 if the file does not contain a supported metadata cache or -1 on error
+ */
+int libfsntfs_metadata_cache_open(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libfsntfs_memory_map_t *memory_map = NULL;
+	static char *function              = "libfsntfs_metadata_cache_open";
+	int result                         = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_memory_map_initialize(
+	     &memory_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory map.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_memory_map_open(
+	     memory_map,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open memory map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_map->data_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid memory map - data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          memory_map->data,
+	          (size_t) memory_map->data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata cache data.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libfsntfs_memory_map_free(
+		     &memory_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free memory map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		metadata_cache->memory_map = memory_map;
+	}
+	return( result );
+
+on_error:
+	if( memory_map != NULL )
+	{
+		libfsntfs_memory_map_free(
+		 &memory_map,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens and reads a metadata cache file
+ * The file is memory mapped and remains mapped until the metadata cache is cleared or freed
+ * Returns 1 if successful, 0 if the file does not contain a supported metadata cache or -1 on error
+ */
+int libfsntfs_metadata_cache_open_wide(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libfsntfs_memory_map_t *memory_map = NULL;
+	static char *function              = "libfsntfs_metadata_cache_open_wide";
+	int result                         = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_memory_map_initialize(
+	     &memory_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory map.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_memory_map_open_wide(
+	     memory_map,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open memory map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_map->data_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid memory map - data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          memory_map->data,
+	          (size_t) memory_map->data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata cache data.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libfsntfs_memory_map_free(
+		     &memory_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free memory map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		metadata_cache->memory_map = memory_map;
+	}
+	return( result );
+
+on_error:
+	if( memory_map != NULL )
+	{
+		libfsntfs_memory_map_free(
+		 &memory_map,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sorts the appended records so they can be looked up and written
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_sort(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_metadata_cache_sort";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	/* Records are only appended to the buffer hence sorting never modifies read data
+	 */
+	if( metadata_cache->attribute_list_mappings.requires_sort != 0 )
+	{
+		qsort(
+		 metadata_cache->attribute_list_mappings.buffer,
+		 metadata_cache->attribute_list_mappings.data_size / sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ),
+		 sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ),
+		 &libfsntfs_metadata_cache_attribute_list_mapping_compare );
+
+		metadata_cache->attribute_list_mappings.requires_sort = 0;
+	}
+	if( metadata_cache->security_descriptor_mappings.requires_sort != 0 )
+	{
+		qsort(
+		 metadata_cache->security_descriptor_mappings.buffer,
+		 metadata_cache->security_descriptor_mappings.data_size / sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ),
+		 sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ),
+		 &libfsntfs_metadata_cache_security_descriptor_mapping_compare );
+
+		metadata_cache->security_descriptor_mappings.requires_sort = 0;
+	}
+	if( metadata_cache->path_hints.requires_sort != 0 )
+	{
+		qsort(
+		 metadata_cache->path_hints.buffer,
+		 metadata_cache->path_hints.data_size / sizeof( fsntfs_metadata_cache_path_hint_t ),
+		 sizeof( fsntfs_metadata_cache_path_hint_t ),
+		 &libfsntfs_metadata_cache_path_hint_compare );
+
+		metadata_cache->path_hints.requires_sort = 0;
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the data needed to write the metadata cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_get_data_size(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_metadata_cache_get_data_size";
+	size_t safe_data_size = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_cache->path_data.data_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata cache - path data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The section buffers are each limited to MEMORY_MAXIMUM_ALLOCATION_SIZE
+	 */
+	safe_data_size = sizeof( fsntfs_metadata_cache_header_t )
+	               + metadata_cache->mft_ranges.data_size
+	               + metadata_cache->attribute_list_mappings.data_size
+	               + metadata_cache->security_descriptor_mappings.data_size
+	               + metadata_cache->path_hints.data_size
+	               + metadata_cache->path_data.data_size;
+
+	if( safe_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = safe_data_size;
+
+	return( 1 );
+}
+
+/* Writes the metadata cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_write_data(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_metadata_cache_section_t *sections[ 5 ];
+
+	static char *function = "libfsntfs_metadata_cache_write_data";
+	size_t data_offset    = 0;
+	size_t required_size  = 0;
+	int section_index     = 0;
+
+	if( libfsntfs_metadata_cache_get_data_size(
+	     metadata_cache,
+	     &required_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < required_size )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_metadata_cache_sort(
+	     metadata_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to sort metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( fsntfs_metadata_cache_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     ( (fsntfs_metadata_cache_header_t *) data )->signature,
+	     fsntfs_metadata_cache_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->format_version,
+	 2 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->number_of_mft_ranges,
+	 (uint32_t) ( metadata_cache->mft_ranges.data_size / sizeof( fsntfs_metadata_cache_mft_range_t ) ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->volume_serial_number,
+	 metadata_cache->volume_serial_number );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->mft_journal_sequence_number,
+	 metadata_cache->mft_journal_sequence_number );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->mft_size,
+	 metadata_cache->mft_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->cluster_block_size,
+	 metadata_cache->cluster_block_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->mft_entry_size,
+	 metadata_cache->mft_entry_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->number_of_attribute_list_mappings,
+	 (uint32_t) ( metadata_cache->attribute_list_mappings.data_size / sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->number_of_security_descriptor_mappings,
+	 (uint32_t) ( metadata_cache->security_descriptor_mappings.data_size / sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ) ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->number_of_path_hints,
+	 (uint32_t) ( metadata_cache->path_hints.data_size / sizeof( fsntfs_metadata_cache_path_hint_t ) ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_header_t *) data )->path_data_size,
+	 (uint32_t) metadata_cache->path_data.data_size );
+
+	/* The sections are stored in their in-memory layout directly following the header
+	 */
+	sections[ 0 ] = &( metadata_cache->mft_ranges );
+	sections[ 1 ] = &( metadata_cache->attribute_list_mappings );
+	sections[ 2 ] = &( metadata_cache->security_descriptor_mappings );
+	sections[ 3 ] = &( metadata_cache->path_hints );
+	sections[ 4 ] = &( metadata_cache->path_data );
+
+	data_offset = sizeof( fsntfs_metadata_cache_header_t );
+
+	for( section_index = 0;
+	     section_index < 5;
+	     section_index++ )
+	{
+		if( sections[ section_index ]->data_size == 0 )
+		{
+			continue;
+		}
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     sections[ section_index ]->data,
+		     sections[ section_index ]->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy section: %d.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		data_offset += sections[ section_index ]->data_size;
+	}
+	return( 1 );
+}
+
+/* Writes the metadata cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_write_file_io_handle(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "libfsntfs_metadata_cache_write_file_io_handle";
+	size_t data_size      = 0;
+	ssize_t write_count   = 0;
+
+	if( libfsntfs_metadata_cache_get_data_size(
+	     metadata_cache,
+	     &data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		goto on_error;
+	}
+	if( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_metadata_cache_write_data(
+	     metadata_cache,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write metadata cache data.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               file_io_handle,
+	               data,
+	               data_size,
+	               0,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write metadata cache data at offset: 0 (0x00000000).",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Sets the volume values the metadata cache is valid for
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_set_volume_values(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t volume_serial_number,
+     uint64_t mft_journal_sequence_number,
+     size64_t mft_size,
+     uint32_t cluster_block_size,
+     uint32_t mft_entry_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_metadata_cache_set_volume_values";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	metadata_cache->volume_serial_number        = volume_serial_number;
+	metadata_cache->mft_journal_sequence_number = mft_journal_sequence_number;
+	metadata_cache->mft_size                    = mft_size;
+	metadata_cache->cluster_block_size          = cluster_block_size;
+	metadata_cache->mft_entry_size              = mft_entry_size;
+
+	return( 1 );
+}
+
+/* Determines if the metadata cache was written for a specific $MFT
+ * A metadata cache is only valid if the journal sequence number of the $MFT MFT entry
+ * and the MFT layout match, the volume serial number is checked by the volume
+ * Returns 1 if the metadata cache matches, 0 if not or -1 on error
+ */
+int libfsntfs_metadata_cache_matches_mft(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t mft_journal_sequence_number,
+     size64_t mft_size,
+     uint32_t cluster_block_size,
+     uint32_t mft_entry_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_metadata_cache_matches_mft";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_cache->mft_ranges.data_size == 0 )
+	 || ( metadata_cache->mft_journal_sequence_number != mft_journal_sequence_number )
+	 || ( metadata_cache->mft_size != mft_size )
+	 || ( metadata_cache->cluster_block_size != cluster_block_size )
+	 || ( metadata_cache->mft_entry_size != mft_entry_size ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Appends a MFT range
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_append_mft_range(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     off64_t range_offset,
+     size64_t range_size,
+     libcerror_error_t **error )
+{
+	fsntfs_metadata_cache_mft_range_t range_data;
+
+	static char *function = "libfsntfs_metadata_cache_append_mft_range";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid range size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_cache->mft_ranges.data_size / sizeof( fsntfs_metadata_cache_mft_range_t ) ) >= (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of MFT ranges value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 range_data.offset,
+	 (uint64_t) range_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 range_data.size,
+	 (uint64_t) range_size );
+
+	if( libfsntfs_metadata_cache_section_append_data(
+	     &( metadata_cache->mft_ranges ),
+	     (uint8_t *) &range_data,
+	     sizeof( fsntfs_metadata_cache_mft_range_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append MFT range.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of MFT ranges
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_get_number_of_mft_ranges(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int *number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_metadata_cache_get_number_of_mft_ranges";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of ranges.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_ranges = (int) ( metadata_cache->mft_ranges.data_size / sizeof( fsntfs_metadata_cache_mft_range_t ) );
+
+	return( 1 );
+}
+
+/* Retrieves a specific MFT range
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_get_mft_range_by_index(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int range_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *range_data  = NULL;
+	static char *function      = "libfsntfs_metadata_cache_get_mft_range_by_index";
+	uint64_t safe_range_size   = 0;
+	uint64_t safe_range_offset = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index < 0 )
+	 || ( (size_t) range_index >= ( metadata_cache->mft_ranges.data_size / sizeof( fsntfs_metadata_cache_mft_range_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	range_data = &( metadata_cache->mft_ranges.data[ sizeof( fsntfs_metadata_cache_mft_range_t ) * (size_t) range_index ] );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_mft_range_t *) range_data )->offset,
+	 safe_range_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_mft_range_t *) range_data )->size,
+	 safe_range_size );
+
+	if( ( safe_range_offset > (uint64_t) INT64_MAX )
+	 || ( safe_range_size > (uint64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT range: %d value out of bounds.",
+		 function,
+		 range_index );
+
+		return( -1 );
+	}
+	*range_offset = (off64_t) safe_range_offset;
+	*range_size   = (size64_t) safe_range_size;
+
+	return( 1 );
+}
+
+/* Appends an attribute list mapping
+ * The mapping relates a base record file reference to the file reference of
+ * one of its attribute list data MFT entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_append_attribute_list_mapping(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t base_record_file_reference,
+     uint64_t file_reference,
+     libcerror_error_t **error )
+{
+	fsntfs_metadata_cache_attribute_list_mapping_t mapping_data;
+
+	static char *function = "libfsntfs_metadata_cache_append_attribute_list_mapping";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_cache->attribute_list_mappings.data_size / sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) ) >= (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of attribute list mappings value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 mapping_data.base_record_file_reference,
+	 base_record_file_reference );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 mapping_data.file_reference,
+	 file_reference );
+
+	if( libfsntfs_metadata_cache_section_append_data(
+	     &( metadata_cache->attribute_list_mappings ),
+	     (uint8_t *) &mapping_data,
+	     sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append attribute list mapping.",
+		 function );
+
+		return( -1 );
+	}
+	metadata_cache->attribute_list_mappings.requires_sort = 1;
+
+	return( 1 );
+}
+
+/* Retrieves the attribute list mappings of a specific base record file reference
+ * The mappings of a base record file reference are stored consecutively,
+ * starting at mapping_index
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t base_record_file_reference,
+     int *mapping_index,
+     int *number_of_mappings,
+     libcerror_error_t **error )
+{
+	const uint8_t *mapping_data = NULL;
+	static char *function       = "libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference";
+	uint64_t mapping_reference  = 0;
+	size_t first_index          = 0;
+	size_t last_index           = 0;
+	size_t middle_index         = 0;
+	size_t number_of_records    = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_cache->attribute_list_mappings.requires_sort != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata cache - attribute list mappings are not sorted.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapping_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapping index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_mappings == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of mappings.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_records = metadata_cache->attribute_list_mappings.data_size / sizeof( fsntfs_metadata_cache_attribute_list_mapping_t );
+
+	/* Determine the first mapping with a base record file reference that is not less
+	 */
+	first_index = 0;
+	last_index  = number_of_records;
+
+	while( first_index < last_index )
+	{
+		middle_index = first_index + ( ( last_index - first_index ) / 2 );
+		mapping_data = &( metadata_cache->attribute_list_mappings.data[ sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) * middle_index ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsntfs_metadata_cache_attribute_list_mapping_t *) mapping_data )->base_record_file_reference,
+		 mapping_reference );
+
+		if( mapping_reference < base_record_file_reference )
+		{
+			first_index = middle_index + 1;
+		}
+		else
+		{
+			last_index = middle_index;
+		}
+	}
+	for( last_index = first_index;
+	     last_index < number_of_records;
+	     last_index++ )
+	{
+		mapping_data = &( metadata_cache->attribute_list_mappings.data[ sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) * last_index ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsntfs_metadata_cache_attribute_list_mapping_t *) mapping_data )->base_record_file_reference,
+		 mapping_reference );
+
+		if( mapping_reference != base_record_file_reference )
+		{
+			break;
+		}
+	}
+	if( last_index == first_index )
+	{
+		return( 0 );
+	}
+	*mapping_index      = (int) first_index;
+	*number_of_mappings = (int) ( last_index - first_index );
+
+	return( 1 );
+}
+
+/* Retrieves a specific attribute list mapping
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_get_attribute_list_mapping_by_index(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int mapping_index,
+     uint64_t *base_record_file_reference,
+     uint64_t *file_reference,
+     libcerror_error_t **error )
+{
+	const uint8_t *mapping_data = NULL;
+	static char *function       = "libfsntfs_metadata_cache_get_attribute_list_mapping_by_index";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mapping_index < 0 )
+	 || ( (size_t) mapping_index >= ( metadata_cache->attribute_list_mappings.data_size / sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mapping index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( base_record_file_reference == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid base record file reference.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_reference == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file reference.",
+		 function );
+
+		return( -1 );
+	}
+	mapping_data = &( metadata_cache->attribute_list_mappings.data[ sizeof( fsntfs_metadata_cache_attribute_list_mapping_t ) * (size_t) mapping_index ] );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_attribute_list_mapping_t *) mapping_data )->base_record_file_reference,
+	 *base_record_file_reference );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_attribute_list_mapping_t *) mapping_data )->file_reference,
+	 *file_reference );
+
+	return( 1 );
+}
+
+/* Appends a security descriptor mapping
+ * The mapping relates a security descriptor identifier to its data in the $SDS data stream
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_append_security_descriptor_mapping(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint32_t security_descriptor_identifier,
+     uint64_t data_offset,
+     uint32_t data_size,
+     libcerror_error_t **error )
+{
+	fsntfs_metadata_cache_security_descriptor_mapping_t mapping_data;
+
+	static char *function = "libfsntfs_metadata_cache_append_security_descriptor_mapping";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_cache->security_descriptor_mappings.data_size / sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ) ) >= (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of security descriptor mappings value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 mapping_data.identifier,
+	 security_descriptor_identifier );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 mapping_data.data_size,
+	 data_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 mapping_data.data_offset,
+	 data_offset );
+
+	if( libfsntfs_metadata_cache_section_append_data(
+	     &( metadata_cache->security_descriptor_mappings ),
+	     (uint8_t *) &mapping_data,
+	     sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append security descriptor mapping.",
+		 function );
+
+		return( -1 );
+	}
+	metadata_cache->security_descriptor_mappings.requires_sort = 1;
+
+	return( 1 );
+}
+
+/* Retrieves the $SDS data offset and size of a specific security descriptor identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint32_t security_descriptor_identifier,
+     uint64_t *data_offset,
+     uint32_t *data_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *mapping_data = NULL;
+	static char *function       = "libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier";
+	size_t first_index          = 0;
+	size_t last_index           = 0;
+	size_t middle_index         = 0;
+	uint32_t mapping_identifier = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_cache->security_descriptor_mappings.requires_sort != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata cache - security descriptor mappings are not sorted.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	first_index = 0;
+	last_index  = metadata_cache->security_descriptor_mappings.data_size / sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t );
+
+	while( first_index < last_index )
+	{
+		middle_index = first_index + ( ( last_index - first_index ) / 2 );
+		mapping_data = &( metadata_cache->security_descriptor_mappings.data[ sizeof( fsntfs_metadata_cache_security_descriptor_mapping_t ) * middle_index ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fsntfs_metadata_cache_security_descriptor_mapping_t *) mapping_data )->identifier,
+		 mapping_identifier );
+
+		if( mapping_identifier < security_descriptor_identifier )
+		{
+			first_index = middle_index + 1;
+		}
+		else if( mapping_identifier > security_descriptor_identifier )
+		{
+			last_index = middle_index;
+		}
+		else
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (fsntfs_metadata_cache_security_descriptor_mapping_t *) mapping_data )->data_offset,
+			 *data_offset );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (fsntfs_metadata_cache_security_descriptor_mapping_t *) mapping_data )->data_size,
+			 *data_size );
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Appends a path hint
+ * The path is stored in the path data and must contain an end-of-string character
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_append_path_hint(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t file_reference,
+     const uint8_t *path,
+     size_t path_size,
+     libcerror_error_t **error )
+{
+	fsntfs_metadata_cache_path_hint_t path_hint_data;
+
+	static char *function = "libfsntfs_metadata_cache_append_path_hint";
+	size_t path_offset    = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	path_offset = metadata_cache->path_data.data_size;
+
+	if( ( path_size == 0 )
+	 || ( path_size > (size_t) UINT32_MAX )
+	 || ( path_offset > ( (size_t) UINT32_MAX - path_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( path[ path_size - 1 ] != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported path - missing end-of-string character.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_cache->path_hints.data_size / sizeof( fsntfs_metadata_cache_path_hint_t ) ) >= (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of path hints value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 path_hint_data.file_reference,
+	 file_reference );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 path_hint_data.path_offset,
+	 (uint32_t) path_offset );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 path_hint_data.path_size,
+	 (uint32_t) path_size );
+
+	if( libfsntfs_metadata_cache_section_append_data(
+	     &( metadata_cache->path_data ),
+	     path,
+	     path_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append path data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_metadata_cache_section_append_data(
+	     &( metadata_cache->path_hints ),
+	     (uint8_t *) &path_hint_data,
+	     sizeof( fsntfs_metadata_cache_path_hint_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append path hint.",
+		 function );
+
+		/* Remove the path data without a path hint
+		 */
+		metadata_cache->path_data.data_size = path_offset;
+
+		return( -1 );
+	}
+	metadata_cache->path_hints.requires_sort = 1;
+
+	return( 1 );
+}
+
+/* Retrieves the path of a specific file reference
+ * The path references the metadata cache data and remains valid until
+ * the metadata cache is changed, cleared or freed
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_metadata_cache_get_path_hint_by_file_reference(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t file_reference,
+     const uint8_t **path,
+     size_t *path_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path_hint_data = NULL;
+	static char *function         = "libfsntfs_metadata_cache_get_path_hint_by_file_reference";
+	size_t first_index            = 0;
+	size_t last_index             = 0;
+	size_t middle_index           = 0;
+	uint64_t path_hint_reference  = 0;
+	uint32_t path_offset          = 0;
+	uint32_t safe_path_size       = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_cache->path_hints.requires_sort != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata cache - path hints are not sorted.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path size.",
+		 function );
+
+		return( -1 );
+	}
+	first_index = 0;
+	last_index  = metadata_cache->path_hints.data_size / sizeof( fsntfs_metadata_cache_path_hint_t );
+
+	while( first_index < last_index )
+	{
+		middle_index   = first_index + ( ( last_index - first_index ) / 2 );
+		path_hint_data = &( metadata_cache->path_hints.data[ sizeof( fsntfs_metadata_cache_path_hint_t ) * middle_index ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsntfs_metadata_cache_path_hint_t *) path_hint_data )->file_reference,
+		 path_hint_reference );
+
+		if( path_hint_reference < file_reference )
+		{
+			first_index = middle_index + 1;
+		}
+		else if( path_hint_reference > file_reference )
+		{
+			last_index = middle_index;
+		}
+		else
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (fsntfs_metadata_cache_path_hint_t *) path_hint_data )->path_offset,
+			 path_offset );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (fsntfs_metadata_cache_path_hint_t *) path_hint_data )->path_size,
+			 safe_path_size );
+
+			if( ( (size_t) path_offset > metadata_cache->path_data.data_size )
+			 || ( (size_t) safe_path_size > ( metadata_cache->path_data.data_size - path_offset ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid path hint - path value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			*path      = &( metadata_cache->path_data.data[ path_offset ] );
+			*path_size = (size_t) safe_path_size;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the number of path hints
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_get_number_of_path_hints(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int *number_of_path_hints,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_metadata_cache_get_number_of_path_hints";
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_path_hints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of path hints.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_path_hints = (int) ( metadata_cache->path_hints.data_size / sizeof( fsntfs_metadata_cache_path_hint_t ) );
+
+	return( 1 );
+}
+
+/* Retrieves a specific path hint
+ * The path is stored in the metadata cache and includes the end-of-string character
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_metadata_cache_get_path_hint_by_index(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int path_hint_index,
+     uint64_t *file_reference,
+     const uint8_t **path,
+     size_t *path_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path_hint_data = NULL;
+	static char *function         = "libfsntfs_metadata_cache_get_path_hint_by_index";
+	uint32_t path_offset          = 0;
+	uint32_t safe_path_size       = 0;
+
+	if( metadata_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path_hint_index < 0 )
+	 || ( (size_t) path_hint_index >= ( metadata_cache->path_hints.data_size / sizeof( fsntfs_metadata_cache_path_hint_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path hint index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_reference == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file reference.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path size.",
+		 function );
+
+		return( -1 );
+	}
+	path_hint_data = &( metadata_cache->path_hints.data[ sizeof( fsntfs_metadata_cache_path_hint_t ) * path_hint_index ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_path_hint_t *) path_hint_data )->path_offset,
+	 path_offset );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fsntfs_metadata_cache_path_hint_t *) path_hint_data )->path_size,
+	 safe_path_size );
+
+	if( ( (size_t) path_offset > metadata_cache->path_data.data_size )
+	 || ( (size_t) safe_path_size > ( metadata_cache->path_data.data_size - path_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path hint - path value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_metadata_cache_path_hint_t *) path_hint_data )->file_reference,
+	 *file_reference );
+
+	*path      = &( metadata_cache->path_data.data[ path_offset ] );
+	*path_size = (size_t) safe_path_size;
+
+	return( 1 );
+}
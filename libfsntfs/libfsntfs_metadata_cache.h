@@ -0,0 +1,284 @@
+/*
+ * Metadata cache functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_METADATA_CACHE_H )
+#define _LIBFSNTFS_METADATA_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_memory_map.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const char *fsntfs_metadata_cache_signature;
+
+typedef struct libfsntfs_metadata_cache_section libfsntfs_metadata_cache_section_t;
+
+struct libfsntfs_metadata_cache_section
+{
+	/* The data, references either the (memory mapped) metadata cache data
+	 * or the buffer. The data contains records in the metadata cache file layout
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The buffer, contains the appended records
+	 */
+	uint8_t *buffer;
+
+	/* The allocated size of the buffer
+	 */
+	size_t buffer_size;
+
+	/* Value to indicate the records need to be sorted before they can be looked up
+	 */
+	uint8_t requires_sort;
+};
+
+typedef struct libfsntfs_metadata_cache libfsntfs_metadata_cache_t;
+
+struct libfsntfs_metadata_cache
+{
+	/* The volume serial number
+	 */
+	uint64_t volume_serial_number;
+
+	/* The journal sequence number of the $MFT MFT entry
+	 */
+	uint64_t mft_journal_sequence_number;
+
+	/* The MFT size
+	 */
+	size64_t mft_size;
+
+	/* The cluster block size
+	 */
+	uint32_t cluster_block_size;
+
+	/* The MFT entry size
+	 */
+	uint32_t mft_entry_size;
+
+	/* The MFT ranges section, stored in $MFT data order
+	 */
+	libfsntfs_metadata_cache_section_t mft_ranges;
+
+	/* The attribute list mappings section, sorted by base record file reference
+	 */
+	libfsntfs_metadata_cache_section_t attribute_list_mappings;
+
+	/* The security descriptor mappings section, sorted by identifier
+	 */
+	libfsntfs_metadata_cache_section_t security_descriptor_mappings;
+
+	/* The path hints section, sorted by file reference
+	 */
+	libfsntfs_metadata_cache_section_t path_hints;
+
+	/* The path data section
+	 */
+	libfsntfs_metadata_cache_section_t path_data;
+
+	/* The memory map, set when the metadata cache was opened from a file
+	 */
+	libfsntfs_memory_map_t *memory_map;
+};
+
+int libfsntfs_metadata_cache_attribute_list_mapping_compare(
+     const void *first_mapping_data,
+     const void *second_mapping_data );
+
+int libfsntfs_metadata_cache_security_descriptor_mapping_compare(
+     const void *first_mapping_data,
+     const void *second_mapping_data );
+
+int libfsntfs_metadata_cache_path_hint_compare(
+     const void *first_path_hint_data,
+     const void *second_path_hint_data );
+
+int libfsntfs_metadata_cache_section_append_data(
+     libfsntfs_metadata_cache_section_t *section,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_initialize(
+     libfsntfs_metadata_cache_t **metadata_cache,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_free(
+     libfsntfs_metadata_cache_t **metadata_cache,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_clear(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_read_data(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_open(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libfsntfs_metadata_cache_open_wide(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libfsntfs_metadata_cache_sort(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_get_data_size(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_write_data(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_write_file_io_handle(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_set_volume_values(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t volume_serial_number,
+     uint64_t mft_journal_sequence_number,
+     size64_t mft_size,
+     uint32_t cluster_block_size,
+     uint32_t mft_entry_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_matches_mft(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t mft_journal_sequence_number,
+     size64_t mft_size,
+     uint32_t cluster_block_size,
+     uint32_t mft_entry_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_append_mft_range(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     off64_t range_offset,
+     size64_t range_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_get_number_of_mft_ranges(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int *number_of_ranges,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_get_mft_range_by_index(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int range_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_append_attribute_list_mapping(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t base_record_file_reference,
+     uint64_t file_reference,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t base_record_file_reference,
+     int *mapping_index,
+     int *number_of_mappings,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_get_attribute_list_mapping_by_index(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int mapping_index,
+     uint64_t *base_record_file_reference,
+     uint64_t *file_reference,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_append_security_descriptor_mapping(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint32_t security_descriptor_identifier,
+     uint64_t data_offset,
+     uint32_t data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint32_t security_descriptor_identifier,
+     uint64_t *data_offset,
+     uint32_t *data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_append_path_hint(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t file_reference,
+     const uint8_t *path,
+     size_t path_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_get_path_hint_by_file_reference(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     uint64_t file_reference,
+     const uint8_t **path,
+     size_t *path_size,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_get_number_of_path_hints(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int *number_of_path_hints,
+     libcerror_error_t **error );
+
+int libfsntfs_metadata_cache_get_path_hint_by_index(
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int path_hint_index,
+     uint64_t *file_reference,
+     const uint8_t **path,
+     size_t *path_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_METADATA_CACHE_H ) */
+
@@ -27,12 +27,15 @@
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcnotify.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
 #include "libfsntfs_mft.h"
 #include "libfsntfs_mft_attribute_list.h"
 #include "libfsntfs_mft_entry.h"
 #include "libfsntfs_types.h"
+#include "libfsntfs_unused.h"
 
 /* Creates a MFT
  * Make sure the value mft is referencing, is set to NULL
@@ -45,7 +48,8 @@ int libfsntfs_mft_initialize(
      uint8_t flags,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_mft_initialize";
+	static char *function               = "libfsntfs_mft_initialize";
+	int maximum_number_of_cache_entries = 0;
 
 	if( mft == NULL )
 	{
@@ -116,10 +120,10 @@ int libfsntfs_mft_initialize(
 	if( libfdata_vector_initialize(
 	     &( ( *mft )->mft_entry_vector ),
 	     mft_entry_size,
-	     (intptr_t *) io_handle,
+	     (intptr_t *) *mft,
 	     NULL,
 	     NULL,
-	     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libfsntfs_mft_entry_read_element_data,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libfsntfs_mft_read_element_data,
 	     NULL,
 	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
 	     error ) != 1 )
@@ -133,9 +137,25 @@ int libfsntfs_mft_initialize(
 
 		goto on_error;
 	}
+	if( libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+	     io_handle,
+	     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	     (size_t) mft_entry_size,
+	     &maximum_number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum number of MFT entry cache entries.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfcache_cache_initialize(
 	     &( ( *mft )->mft_entry_cache ),
-	     LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_MFT_ENTRIES,
+	     maximum_number_of_cache_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -161,14 +181,36 @@ int libfsntfs_mft_initialize(
 
 		goto on_error;
 	}
-	( *mft )->io_handle = io_handle;
-	( *mft )->flags     = flags;
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *mft )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *mft )->io_handle             = io_handle;
+	( *mft )->flags                 = flags;
+	( *mft )->readahead_next_offset = -1;
 
 	return( 1 );
 
 on_error:
 	if( *mft != NULL )
 	{
+		if( ( *mft )->single_mft_entry_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *mft )->single_mft_entry_cache ),
+			 NULL );
+		}
 		if( ( *mft )->mft_entry_cache != NULL )
 		{
 			libfcache_cache_free(
@@ -251,6 +293,26 @@ int libfsntfs_mft_free(
 
 			result = -1;
 		}
+		if( ( *mft )->readahead_data != NULL )
+		{
+			memory_free(
+			 ( *mft )->readahead_data );
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *mft )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		if( ( *mft )->attribute_list_tree != NULL )
 		{
 			if( libcdata_btree_free(
@@ -276,7 +338,417 @@ int libfsntfs_mft_free(
 	return( result );
 }
 
+/* Retrieves MFT data from the read-ahead data
+ * The read-ahead data is refilled when it does not contain the requested range.
+ * Only when the requested range directly follows the previously requested range
+ * at most the read-ahead size of the data run that contains the file offset
+ * is read at once, otherwise only the requested range is read
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_get_readahead_data(
+     libfsntfs_mft_t *mft,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     size_t data_size,
+     const uint8_t **data,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation  = NULL;
+	static char *function  = "libfsntfs_mft_get_readahead_data";
+	size64_t segment_size  = 0;
+	size_t read_size       = 0;
+	ssize_t read_count     = 0;
+	off64_t segment_offset = 0;
+	uint32_t segment_flags = 0;
+	int number_of_segments = 0;
+	int segment_file_index = 0;
+	int segment_index      = 0;
+
+	if( mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mft->readahead_size >= data_size )
+	 && ( file_offset >= mft->readahead_offset )
+	 && ( (size64_t) ( file_offset - mft->readahead_offset ) <= (size64_t) ( mft->readahead_size - data_size ) ) )
+	{
+		*data = &( mft->readahead_data[ file_offset - mft->readahead_offset ] );
+
+		mft->readahead_next_offset = file_offset + (off64_t) data_size;
+
+		return( 1 );
+	}
+	read_size = data_size;
+
+	if( ( file_offset == mft->readahead_next_offset )
+	 && ( mft->io_handle->mft_readahead_size > data_size ) )
+	{
+		if( libfdata_vector_get_number_of_segments(
+		     mft->mft_entry_vector,
+		     &number_of_segments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of MFT entry vector segments.",
+			 function );
+
+			return( -1 );
+		}
+		/* Do not read beyond the end of the data run that contains the file offset
+		 */
+		for( segment_index = 0;
+		     segment_index < number_of_segments;
+		     segment_index++ )
+		{
+			if( libfdata_vector_get_segment_by_index(
+			     mft->mft_entry_vector,
+			     segment_index,
+			     &segment_file_index,
+			     &segment_offset,
+			     &segment_size,
+			     &segment_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve MFT entry vector segment: %d.",
+				 function,
+				 segment_index );
+
+				return( -1 );
+			}
+			if( ( file_offset >= segment_offset )
+			 && ( (size64_t) ( file_offset - segment_offset ) < segment_size ) )
+			{
+				segment_size -= (size64_t) ( file_offset - segment_offset );
+
+				if( segment_size > (size64_t) mft->io_handle->mft_readahead_size )
+				{
+					read_size = mft->io_handle->mft_readahead_size;
+				}
+				else if( segment_size > (size64_t) data_size )
+				{
+					read_size = (size_t) segment_size;
+				}
+				break;
+			}
+		}
+	}
+	if( read_size > mft->readahead_data_size )
+	{
+		reallocation = (uint8_t *) memory_reallocate(
+		                            mft->readahead_data,
+		                            read_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize read-ahead data.",
+			 function );
+
+			return( -1 );
+		}
+		mft->readahead_data      = reallocation;
+		mft->readahead_data_size = read_size;
+	}
+	mft->readahead_size = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading %" PRIzd " bytes of MFT data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 read_size,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              mft->readahead_data,
+	              read_size,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	mft->readahead_offset      = file_offset;
+	mft->readahead_size        = read_size;
+	mft->readahead_next_offset = file_offset + (off64_t) data_size;
+
+	*data = mft->readahead_data;
+
+	return( 1 );
+}
+
+/* Reads a MFT entry
+ * Callback function for the MFT entry vector
+ * Consecutive MFT entries are served from the read-ahead data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_read_element_data(
+     libfsntfs_mft_t *mft,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int element_index,
+     int element_data_file_index LIBFSNTFS_ATTRIBUTE_UNUSED,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_flags LIBFSNTFS_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBFSNTFS_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_entry_t *mft_entry = NULL;
+	const uint8_t *data              = NULL;
+	static char *function            = "libfsntfs_mft_read_element_data";
+	int result                       = 0;
+
+	LIBFSNTFS_UNREFERENCED_PARAMETER( element_data_file_index )
+	LIBFSNTFS_UNREFERENCED_PARAMETER( element_flags )
+	LIBFSNTFS_UNREFERENCED_PARAMETER( read_flags )
+
+	if( mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if ( SIZEOF_INT <= 4 )
+	if( element_index < 0 )
+#else
+	if( ( element_index < 0 )
+	 || ( (int64_t) element_index > (int64_t) UINT32_MAX ) )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_data_size > (size64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_entry_initialize(
+	     &mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create MFT entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( mft->io_handle->mft_readahead_size <= (size_t) element_data_size )
+	{
+		result = libfsntfs_mft_entry_read_file_io_handle(
+		          mft_entry,
+		          file_io_handle,
+		          element_data_offset,
+		          (uint32_t) element_data_size,
+		          (uint32_t) element_index,
+		          error );
+	}
+	else
+	{
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     mft->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		result = libfsntfs_mft_get_readahead_data(
+		          mft,
+		          file_io_handle,
+		          element_data_offset,
+		          (size_t) element_data_size,
+		          &data,
+		          error );
+
+		if( result == 1 )
+		{
+			result = libfsntfs_mft_entry_read_buffer(
+			          mft_entry,
+			          data,
+			          (size_t) element_data_size,
+			          (uint32_t) element_index,
+			          error );
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     mft->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry: %d.",
+		 function,
+		 element_index );
+
+		goto on_error;
+	}
+	if( libfdata_vector_set_element_value_by_index(
+	     vector,
+	     (intptr_t *) file_io_handle,
+	     cache,
+	     element_index,
+	     (intptr_t *) mft_entry,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_mft_entry_free,
+	     LIBFDATA_VECTOR_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set MFT entry as element value.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Reads the attribute list data MFT entries
+ * This maps base record file references to their attribute list data MFT entries
+ * and requires a pass over all the MFT entries. The single MFT entry cache is used
+ * for the pass so that the MFT entry cache is not affected
  * Returns 1 if successful or -1 on error
  */
 int libfsntfs_mft_read_list_data_mft_entries(
@@ -338,10 +810,10 @@ int libfsntfs_mft_read_list_data_mft_entries(
 		if( libfdata_vector_get_element_value_by_index(
 		     mft->mft_entry_vector,
 		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) mft->mft_entry_cache,
+		     (libfdata_cache_t *) mft->single_mft_entry_cache,
 		     (int) mft_entry_index,
 		     (intptr_t **) &mft_entry,
-		     0,
+		     LIBFDATA_READ_FLAG_IGNORE_CACHE,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -462,8 +934,22 @@ int libfsntfs_mft_read_list_data_mft_entries(
 			goto on_error;
 		}
 	}
-	return( 1 );
-
+	if( libfcache_cache_clear_value_by_index(
+	     mft->single_mft_entry_cache,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear single MFT entry cache entry: 0.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
 on_error:
 	if( attribute_list != NULL )
 	{
@@ -530,6 +1016,7 @@ int libfsntfs_mft_get_mft_entry_by_index(
 {
 	libfsntfs_mft_entry_t *safe_mft_entry = NULL;
 	static char *function                 = "libfsntfs_mft_get_mft_entry_by_index";
+	int result                            = 0;
 
 	if( mft == NULL )
 	{
@@ -583,12 +1070,53 @@ int libfsntfs_mft_get_mft_entry_by_index(
 
 		return( -1 );
 	}
+	if( ( ( mft->flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) != 0 )
+	 && ( mft->attribute_list_tree == NULL ) )
+	{
+		/* In MFT only mode the attribute list data cannot be read, hence the
+		 * attribute list data MFT entries are determined on first use
+		 */
+		result = libfsntfs_mft_entry_has_attribute_list_attribute(
+		          safe_mft_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if MFT entry: %" PRIu64 " has an attribute list attribute.",
+			 function,
+			 mft_entry_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( libfsntfs_mft_read_list_data_mft_entries(
+			     mft,
+			     file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read list data MFT entries.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
 	if( libfsntfs_mft_entry_read_attributes(
 	     safe_mft_entry,
 	     mft->io_handle,
 	     file_io_handle,
 	     mft->mft_entry_vector,
 	     mft->attribute_list_tree,
+	     mft->metadata_cache,
 	     mft->flags,
 	     error ) != 1 )
 	{
@@ -619,6 +1147,7 @@ int libfsntfs_mft_get_mft_entry_by_index_no_cache(
 {
 	libfsntfs_mft_entry_t *safe_mft_entry = NULL;
 	static char *function                 = "libfsntfs_mft_get_mft_entry_by_index_no_cache";
+	int result                            = 0;
 
 	if( mft == NULL )
 	{
@@ -672,12 +1201,74 @@ int libfsntfs_mft_get_mft_entry_by_index_no_cache(
 
 		return( -1 );
 	}
+	if( ( ( mft->flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) != 0 )
+	 && ( mft->attribute_list_tree == NULL ) )
+	{
+		/* In MFT only mode the attribute list data cannot be read, hence the
+		 * attribute list data MFT entries are determined on first use
+		 */
+		result = libfsntfs_mft_entry_has_attribute_list_attribute(
+		          safe_mft_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if MFT entry: %" PRIu64 " has an attribute list attribute.",
+			 function,
+			 mft_entry_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( libfsntfs_mft_read_list_data_mft_entries(
+			     mft,
+			     file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read list data MFT entries.",
+				 function );
+
+				return( -1 );
+			}
+			/* Reading the list data MFT entries reuses the single MFT entry cache
+			 */
+			if( libfdata_vector_get_element_value_by_index(
+			     mft->mft_entry_vector,
+			     (intptr_t *) file_io_handle,
+			     (libfdata_cache_t *) mft->single_mft_entry_cache,
+			     (int) mft_entry_index,
+			     (intptr_t **) &safe_mft_entry,
+			     LIBFDATA_READ_FLAG_IGNORE_CACHE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+				 function,
+				 mft_entry_index );
+
+				return( -1 );
+			}
+		}
+	}
 	if( libfsntfs_mft_entry_read_attributes(
 	     safe_mft_entry,
 	     mft->io_handle,
 	     file_io_handle,
 	     mft->mft_entry_vector,
 	     mft->attribute_list_tree,
+	     mft->metadata_cache,
 	     mft->flags,
 	     error ) != 1 )
 	{
@@ -710,3 +1301,283 @@ int libfsntfs_mft_get_mft_entry_by_index_no_cache(
 	return( 1 );
 }
 
+/* Retrieves the offset of a specific MFT entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_get_mft_entry_offset_by_index(
+     libfsntfs_mft_t *mft,
+     uint64_t mft_entry_index,
+     off64_t *mft_entry_offset,
+     libcerror_error_t **error )
+{
+	static char *function    = "libfsntfs_mft_get_mft_entry_offset_by_index";
+	size64_t mft_entry_size  = 0;
+	size64_t segment_size    = 0;
+	off64_t segment_offset   = 0;
+	uint64_t relative_offset = 0;
+	uint32_t segment_flags   = 0;
+	int number_of_segments   = 0;
+	int segment_file_index   = 0;
+	int segment_index        = 0;
+
+	if( mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_index >= mft->number_of_mft_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry offset.",
+		 function );
+
+		return( -1 );
+	}
+	mft_entry_size = (size64_t) mft->io_handle->mft_entry_size;
+
+	if( libfdata_vector_get_number_of_segments(
+	     mft->mft_entry_vector,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entry vector segments.",
+		 function );
+
+		return( -1 );
+	}
+	relative_offset = mft_entry_index * mft_entry_size;
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libfdata_vector_get_segment_by_index(
+		     mft->mft_entry_vector,
+		     segment_index,
+		     &segment_file_index,
+		     &segment_offset,
+		     &segment_size,
+		     &segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry vector segment: %d.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( relative_offset < segment_size )
+		{
+			/* An MFT entry that straddles 2 segments cannot be read directly
+			 */
+			if( mft_entry_size > ( segment_size - relative_offset ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported MFT entry: %" PRIu64 " stored in multiple segments.",
+				 function,
+				 mft_entry_index );
+
+				return( -1 );
+			}
+			*mft_entry_offset = segment_offset + (off64_t) relative_offset;
+
+			return( 1 );
+		}
+		relative_offset -= segment_size;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+	 "%s: invalid MFT entry: %" PRIu64 " offset value out of bounds.",
+	 function,
+	 mft_entry_index );
+
+	return( -1 );
+}
+
+/* Reads a specific MFT entry directly from the file IO handle
+ * This function bypasses the MFT entry vector caches and does not change
+ * the MFT, hence it can be used concurrently with different file IO handles
+ * This function creates new MFT entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_read_mft_entry_by_index(
+     libfsntfs_mft_t *mft,
+     libbfio_handle_t *file_io_handle,
+     uint64_t mft_entry_index,
+     libfsntfs_mft_entry_t **mft_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_entry_t *safe_mft_entry = NULL;
+	static char *function                 = "libfsntfs_mft_read_mft_entry_by_index";
+	off64_t mft_entry_offset              = 0;
+
+	if( mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_index > (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( mft->flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) != 0 )
+	 && ( mft->attribute_list_tree == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT - missing attribute list tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_get_mft_entry_offset_by_index(
+	     mft,
+	     mft_entry_index,
+	     &mft_entry_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry: %" PRIu64 " offset.",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_entry_initialize(
+	     &safe_mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create MFT entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_entry_read_file_io_handle(
+	     safe_mft_entry,
+	     file_io_handle,
+	     mft_entry_offset,
+	     mft->io_handle->mft_entry_size,
+	     (uint32_t) mft_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_entry_read_attributes(
+	     safe_mft_entry,
+	     mft->io_handle,
+	     file_io_handle,
+	     mft->mft_entry_vector,
+	     mft->attribute_list_tree,
+	     mft->metadata_cache,
+	     mft->flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu64 " attributes.",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	*mft_entry = safe_mft_entry;
+
+	return( 1 );
+
+on_error:
+	if( safe_mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &safe_mft_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -29,8 +29,10 @@
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
+#include "libfsntfs_metadata_cache.h"
 #include "libfsntfs_mft_entry.h"
 #include "libfsntfs_types.h"
 
@@ -62,6 +64,10 @@ struct libfsntfs_mft
 	 */
 	libcdata_btree_t *attribute_list_tree;
 
+	/* The metadata cache, which is managed by the file system
+	 */
+	libfsntfs_metadata_cache_t *metadata_cache;
+
 	/* The IO handle
 	 */
 	libfsntfs_io_handle_t *io_handle;
@@ -69,6 +75,34 @@ struct libfsntfs_mft
 	/* The flags
 	 */
 	uint8_t flags;
+
+	/* The read-ahead data
+	 */
+	uint8_t *readahead_data;
+
+	/* The read-ahead data size
+	 */
+	size_t readahead_data_size;
+
+	/* The read-ahead offset
+	 */
+	off64_t readahead_offset;
+
+	/* The read-ahead size, the number of bytes in the read-ahead data
+	 * that are in use
+	 */
+	size_t readahead_size;
+
+	/* The offset directly after the previously requested MFT data,
+	 * used to detect sequential access
+	 */
+	off64_t readahead_next_offset;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 int libfsntfs_mft_initialize(
@@ -82,6 +116,27 @@ int libfsntfs_mft_free(
      libfsntfs_mft_t **mft,
      libcerror_error_t **error );
 
+int libfsntfs_mft_get_readahead_data(
+     libfsntfs_mft_t *mft,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     size_t data_size,
+     const uint8_t **data,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_read_element_data(
+     libfsntfs_mft_t *mft,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int element_index,
+     int element_data_file_index,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 int libfsntfs_mft_read_list_data_mft_entries(
      libfsntfs_mft_t *mft,
      libbfio_handle_t *file_io_handle,
@@ -106,6 +161,19 @@ int libfsntfs_mft_get_mft_entry_by_index_no_cache(
      libfsntfs_mft_entry_t **mft_entry,
      libcerror_error_t **error );
 
+int libfsntfs_mft_get_mft_entry_offset_by_index(
+     libfsntfs_mft_t *mft,
+     uint64_t mft_entry_index,
+     off64_t *mft_entry_offset,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_read_mft_entry_by_index(
+     libfsntfs_mft_t *mft,
+     libbfio_handle_t *file_io_handle,
+     uint64_t mft_entry_index,
+     libfsntfs_mft_entry_t **mft_entry,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -1722,6 +1722,7 @@ int libfsntfs_mft_attribute_compare_name_with_utf8_string(
 	          utf8_string,
 	          utf8_string_length,
 	          0,
+	          NULL,
 	          error );
 
 	if( result == -1 )
@@ -1775,6 +1776,7 @@ int libfsntfs_mft_attribute_compare_name_with_utf16_string(
 	          utf16_string,
 	          utf16_string_length,
 	          0,
+	          NULL,
 	          error );
 
 	if( result == -1 )
@@ -785,6 +785,7 @@ int libfsntfs_mft_attribute_list_entry_compare_name_with_utf8_string(
 	          utf8_string,
 	          utf8_string_length,
 	          0,
+	          NULL,
 	          error );
 
 	if( result == -1 )
@@ -838,6 +839,7 @@ int libfsntfs_mft_attribute_list_entry_compare_name_with_utf16_string(
 	          utf16_string,
 	          utf16_string_length,
 	          0,
+	          NULL,
 	          error );
 
 	if( result == -1 )
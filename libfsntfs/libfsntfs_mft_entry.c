@@ -682,20 +682,15 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the MFT entry
+/* Allocates the MFT entry data
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_mft_entry_read_file_io_handle(
+int libfsntfs_mft_entry_allocate_data(
      libfsntfs_mft_entry_t *mft_entry,
-     libbfio_handle_t *file_io_handle,
-     off64_t file_offset,
-     uint32_t mft_entry_size,
-     uint32_t mft_entry_index,
+     size_t data_size,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_mft_entry_read_file_io_handle";
-	ssize_t read_count    = 0;
-	int result            = 0;
+	static char *function = "libfsntfs_mft_entry_allocate_data";
 
 	if( mft_entry == NULL )
 	{
@@ -719,20 +714,20 @@ int libfsntfs_mft_entry_read_file_io_handle(
 
 		return( -1 );
 	}
-	if( ( (size_t) mft_entry_size <= 42 )
-	 || ( (size_t) mft_entry_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	if( ( data_size <= 42 )
+	 || ( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid MFT entry size value out of bounds.",
+		 "%s: invalid data size value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	mft_entry->data = (uint8_t *) memory_allocate(
-	                               (size_t) mft_entry_size );
+	                               data_size );
 
 	if( mft_entry->data == NULL )
 	{
@@ -743,39 +738,36 @@ int libfsntfs_mft_entry_read_file_io_handle(
 		 "%s: unable to create MFT entry data.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	mft_entry->data_size = (size_t) mft_entry_size;
+	mft_entry->data_size = data_size;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: reading MFT entry at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-		 function,
-		 file_offset,
-		 file_offset );
-	}
-#endif
-	read_count = libbfio_handle_read_buffer_at_offset(
-	              file_io_handle,
-	              mft_entry->data,
-	              mft_entry->data_size,
-	              file_offset,
-	              error );
+	return( 1 );
+}
 
-	if( read_count != (ssize_t) mft_entry->data_size )
+/* Reads the MFT entry from the allocated MFT entry data
+ * This applies the fixup values and reads the attributes, the MFT entry data
+ * is freed if the MFT entry is empty or on error
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_entry_read_allocated_data(
+     libfsntfs_mft_entry_t *mft_entry,
+     uint32_t mft_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_entry_read_allocated_data";
+	int result            = 0;
+
+	if( mft_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read MFT entry data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 file_offset,
-		 file_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	result = libfsntfs_mft_entry_read_data(
 	          mft_entry,
@@ -824,6 +816,168 @@ on_error:
 	return( -1 );
 }
 
+/* Reads the MFT entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_entry_read_file_io_handle(
+     libfsntfs_mft_entry_t *mft_entry,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     uint32_t mft_entry_size,
+     uint32_t mft_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_entry_read_file_io_handle";
+	ssize_t read_count    = 0;
+
+	if( libfsntfs_mft_entry_allocate_data(
+	     mft_entry,
+	     (size_t) mft_entry_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate MFT entry data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading MFT entry at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              mft_entry->data,
+	              mft_entry->data_size,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) mft_entry->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_entry_read_allocated_data(
+	     mft_entry,
+	     mft_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	memory_free(
+	 mft_entry->data );
+
+	mft_entry->data      = NULL;
+	mft_entry->data_size = 0;
+
+	return( -1 );
+}
+
+/* Reads the MFT entry from a buffer
+ * The buffer is copied, since fixup values are applied to the MFT entry data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_entry_read_buffer(
+     libfsntfs_mft_entry_t *mft_entry,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint32_t mft_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_entry_read_buffer";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_entry_allocate_data(
+	     mft_entry,
+	     buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate MFT entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     mft_entry->data,
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy MFT entry data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_entry_read_allocated_data(
+	     mft_entry,
+	     mft_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	memory_free(
+	 mft_entry->data );
+
+	mft_entry->data      = NULL;
+	mft_entry->data_size = 0;
+
+	return( -1 );
+}
+
 /* Reads the MFT attributes
  * Returns 1 if successful or -1 on error
  */
@@ -1074,6 +1228,89 @@ on_error:
 	return( -1 );
 }
 
+/* Determines if the MFT entry has an attribute list ($ATTRIBUTE_LIST) attribute
+ * This function only scans the attribute types in the MFT entry data and
+ * can be used before the attributes are read
+ * Returns 1 if the MFT entry has an attribute list attribute, 0 if not or -1 on error
+ */
+int libfsntfs_mft_entry_has_attribute_list_attribute(
+     libfsntfs_mft_entry_t *mft_entry,
+     libcerror_error_t **error )
+{
+	static char *function      = "libfsntfs_mft_entry_has_attribute_list_attribute";
+	size_t data_offset         = 0;
+	uint32_t attribute_size    = 0;
+	uint32_t attribute_type    = 0;
+	uint16_t attributes_offset = 0;
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry->list_attribute != NULL )
+	{
+		return( 1 );
+	}
+	if( ( mft_entry->is_empty != 0 )
+	 || ( mft_entry->attributes_read != 0 )
+	 || ( mft_entry->data == NULL ) )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_mft_entry_header_get_attributes_offset(
+	     mft_entry->header,
+	     &attributes_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attributes offset.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = (size_t) attributes_offset;
+
+	/* Bounds and size errors are left to be reported when the attributes are read
+	 */
+	while( ( mft_entry->data_size >= 8 )
+	    && ( data_offset <= ( mft_entry->data_size - 8 ) ) )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( mft_entry->data[ data_offset ] ),
+		 attribute_type );
+
+		if( attribute_type == LIBFSNTFS_ATTRIBUTE_TYPE_END_OF_ATTRIBUTES )
+		{
+			break;
+		}
+		if( attribute_type == LIBFSNTFS_ATTRIBUTE_TYPE_ATTRIBUTE_LIST )
+		{
+			return( 1 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( mft_entry->data[ data_offset + 4 ] ),
+		 attribute_size );
+
+		if( ( attribute_size == 0 )
+		 || ( (size_t) attribute_size > ( mft_entry->data_size - data_offset ) ) )
+		{
+			break;
+		}
+		data_offset += (size_t) attribute_size;
+	}
+	return( 0 );
+}
+
 /* Reads the MFT attributes
  * Returns 1 if successful or -1 on error
  */
@@ -1083,6 +1320,7 @@ int libfsntfs_mft_entry_read_attributes(
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *mft_entry_vector,
      libcdata_btree_t *attribute_list_tree,
+     libfsntfs_metadata_cache_t *metadata_cache,
      uint8_t flags,
      libcerror_error_t **error )
 {
@@ -1090,6 +1328,10 @@ int libfsntfs_mft_entry_read_attributes(
 	libfsntfs_mft_attribute_list_t *attribute_list        = NULL;
 	libfsntfs_mft_attribute_list_t *lookup_attribute_list = NULL;
 	static char *function                                 = "libfsntfs_mft_entry_read_attributes";
+	uint64_t base_record_file_reference                   = 0;
+	uint64_t file_reference                               = 0;
+	int mapping_index                                     = 0;
+	int number_of_mappings                                = 0;
 	int result                                            = 0;
 
 	if( mft_entry == NULL )
@@ -1179,22 +1421,103 @@ int libfsntfs_mft_entry_read_attributes(
 			}
 			else
 			{
-				if( libfsntfs_mft_entry_read_attribute_list(
-				     mft_entry,
-				     io_handle,
-				     file_io_handle,
-				     error ) != 1 )
+				if( metadata_cache != NULL )
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read attribute list.",
-					 function );
-
-					goto on_error;
+					result = libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference(
+					          metadata_cache,
+					          mft_entry->file_reference,
+					          &mapping_index,
+					          &number_of_mappings,
+					          error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve attribute list mappings from metadata cache.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				if( result != 0 )
+				{
+					/* The metadata cache provides the attribute list data MFT entries
+					 * hence the attribute list itself is only read on demand
+					 */
+					if( libfsntfs_mft_attribute_list_initialize(
+					     &lookup_attribute_list,
+					     mft_entry->file_reference,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create lookup attribute list.",
+						 function );
+
+						goto on_error;
+					}
+					while( number_of_mappings > 0 )
+					{
+						if( libfsntfs_metadata_cache_get_attribute_list_mapping_by_index(
+						     metadata_cache,
+						     mapping_index,
+						     &base_record_file_reference,
+						     &file_reference,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+							 "%s: unable to retrieve attribute list mapping: %d from metadata cache.",
+							 function,
+							 mapping_index );
+
+							goto on_error;
+						}
+						if( libfsntfs_mft_attribute_list_insert_file_reference(
+						     lookup_attribute_list,
+						     file_reference,
+						     error ) == -1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+							 "%s: unable to insert attribute list data file reference in lookup attribute list.",
+							 function );
+
+							goto on_error;
+						}
+						mapping_index++;
+						number_of_mappings--;
+					}
+					attribute_list = lookup_attribute_list;
+				}
+				else
+				{
+					if( libfsntfs_mft_entry_read_attribute_list(
+					     mft_entry,
+					     io_handle,
+					     file_io_handle,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read attribute list.",
+						 function );
+
+						goto on_error;
+					}
+					attribute_list = mft_entry->attribute_list;
 				}
-				attribute_list = mft_entry->attribute_list;
 			}
 			if( attribute_list != NULL )
 			{
@@ -1220,6 +1543,22 @@ int libfsntfs_mft_entry_read_attributes(
 			{
 				mft_entry->is_corrupted = 1;
 			}
+			if( lookup_attribute_list != NULL )
+			{
+				if( libfsntfs_mft_attribute_list_free(
+				     &lookup_attribute_list,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free lookup attribute list.",
+					 function );
+
+					goto on_error;
+				}
+			}
 		}
 	}
 	mft_entry->attributes_read = 1;
@@ -32,6 +32,7 @@
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
+#include "libfsntfs_metadata_cache.h"
 #include "libfsntfs_mft_attribute.h"
 #include "libfsntfs_mft_attribute_list.h"
 #include "libfsntfs_mft_entry_header.h"
@@ -149,6 +150,16 @@ int libfsntfs_mft_entry_read_data(
      uint32_t mft_entry_index,
      libcerror_error_t **error );
 
+int libfsntfs_mft_entry_allocate_data(
+     libfsntfs_mft_entry_t *mft_entry,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_entry_read_allocated_data(
+     libfsntfs_mft_entry_t *mft_entry,
+     uint32_t mft_entry_index,
+     libcerror_error_t **error );
+
 int libfsntfs_mft_entry_read_file_io_handle(
      libfsntfs_mft_entry_t *mft_entry,
      libbfio_handle_t *file_io_handle,
@@ -157,6 +168,13 @@ int libfsntfs_mft_entry_read_file_io_handle(
      uint32_t mft_entry_index,
      libcerror_error_t **error );
 
+int libfsntfs_mft_entry_read_buffer(
+     libfsntfs_mft_entry_t *mft_entry,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint32_t mft_entry_index,
+     libcerror_error_t **error );
+
 int libfsntfs_mft_entry_read_attributes_data(
      libfsntfs_mft_entry_t *mft_entry,
      libfsntfs_io_handle_t *io_handle,
@@ -164,12 +182,17 @@ int libfsntfs_mft_entry_read_attributes_data(
      size_t data_size,
      libcerror_error_t **error );
 
+int libfsntfs_mft_entry_has_attribute_list_attribute(
+     libfsntfs_mft_entry_t *mft_entry,
+     libcerror_error_t **error );
+
 int libfsntfs_mft_entry_read_attributes(
      libfsntfs_mft_entry_t *mft_entry,
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *mft_entry_vector,
      libcdata_btree_t *attribute_list_tree,
+     libfsntfs_metadata_cache_t *metadata_cache,
      uint8_t flags,
      libcerror_error_t **error );
 
@@ -1070,20 +1070,8 @@ int libfsntfs_internal_mft_metadata_file_open_read(
 
 		goto on_error;
 	}
-	if( libfsntfs_mft_read_list_data_mft_entries(
-	     internal_mft_metadata_file->file_system->mft,
-	     file_io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read list data MFT entries.",
-		 function );
-
-		goto on_error;
-	}
+	/* The attribute list data MFT entries are read on demand
+	 */
 	return( 1 );
 
 on_error:
@@ -2059,3 +2047,91 @@ int libfsntfs_mft_metadata_file_get_file_entry_by_index(
 	return( result );
 }
 
+/* Reads the attribute list data MFT entries of all the MFT entries
+ * By default the attribute list data MFT entries are read when the first
+ * MFT entry with an attribute list is retrieved. This function allows the
+ * corresponding pass over all the MFT entries to be done in advance
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_metadata_file_read_attribute_list_map(
+     libfsntfs_mft_metadata_file_t *mft_metadata_file,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_mft_metadata_file_t *internal_mft_metadata_file = NULL;
+	static char *function                                              = "libfsntfs_mft_metadata_file_read_attribute_list_map";
+	int result                                                         = 1;
+
+	if( mft_metadata_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT metadata file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_mft_metadata_file = (libfsntfs_internal_mft_metadata_file_t *) mft_metadata_file;
+
+	if( internal_mft_metadata_file->file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT metadata file - missing file system.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_mft_metadata_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_mft_metadata_file->file_system->mft->attribute_list_tree == NULL )
+	{
+		if( libfsntfs_mft_read_list_data_mft_entries(
+		     internal_mft_metadata_file->file_system->mft,
+		     internal_mft_metadata_file->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read list data MFT entries.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_mft_metadata_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -192,6 +192,11 @@ int libfsntfs_mft_metadata_file_get_file_entry_by_index(
      libfsntfs_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_mft_metadata_file_read_attribute_list_map(
+     libfsntfs_mft_metadata_file_t *mft_metadata_file,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
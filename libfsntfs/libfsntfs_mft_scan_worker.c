@@ -0,0 +1,824 @@
+/*
+ * MFT scan worker functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_file_entry.h"
+#include "libfsntfs_file_system.h"
+#include "libfsntfs_io_handle.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+#include "libfsntfs_mft_entry.h"
+#include "libfsntfs_mft_scan_worker.h"
+#include "libfsntfs_path_component_cache.h"
+#include "libfsntfs_types.h"
+
+/* Creates a MFT scan worker
+ * Make sure the value mft_scan_worker is referencing, is set to NULL
+ * The worker reads using its own clone of the file IO handle and its own file system
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scan_worker_initialize(
+     libfsntfs_mft_scan_worker_t **mft_scan_worker,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t mft_offset,
+     uint64_t first_mft_entry_index,
+     uint64_t number_of_mft_entries,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            uint64_t mft_entry_index,
+            void *user_data ),
+     void *user_data,
+     uint8_t *stop_scan,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_scan_worker_initialize";
+	int result            = 0;
+
+	if( mft_scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mft_scan_worker != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid MFT scan worker value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( stop_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stop scan.",
+		 function );
+
+		return( -1 );
+	}
+	*mft_scan_worker = memory_allocate_structure(
+	                    libfsntfs_mft_scan_worker_t );
+
+	if( *mft_scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create MFT scan worker.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *mft_scan_worker,
+	     0,
+	     sizeof( libfsntfs_mft_scan_worker_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear MFT scan worker.",
+		 function );
+
+		memory_free(
+		 *mft_scan_worker );
+
+		*mft_scan_worker = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_handle_clone(
+	     &( ( *mft_scan_worker )->file_io_handle ),
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_is_open(
+	          ( *mft_scan_worker )->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libbfio_handle_open(
+		     ( *mft_scan_worker )->file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *mft_scan_worker )->io_handle             = io_handle;
+	( *mft_scan_worker )->mft_offset            = mft_offset;
+	( *mft_scan_worker )->first_mft_entry_index = first_mft_entry_index;
+	( *mft_scan_worker )->number_of_mft_entries = number_of_mft_entries;
+	( *mft_scan_worker )->callback_function     = callback_function;
+	( *mft_scan_worker )->user_data             = user_data;
+	( *mft_scan_worker )->stop_scan             = stop_scan;
+
+	return( 1 );
+
+on_error:
+	if( *mft_scan_worker != NULL )
+	{
+		if( ( *mft_scan_worker )->file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *mft_scan_worker )->file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *mft_scan_worker );
+
+		*mft_scan_worker = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a MFT scan worker
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scan_worker_free(
+     libfsntfs_mft_scan_worker_t **mft_scan_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_scan_worker_free";
+	int result            = 1;
+
+	if( mft_scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mft_scan_worker != NULL )
+	{
+		/* The io_handle, stop_scan and stop_scan_mutex references are freed elsewhere
+		 */
+		if( ( *mft_scan_worker )->file_system != NULL )
+		{
+			if( libfsntfs_file_system_free(
+			     &( ( *mft_scan_worker )->file_system ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file system.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *mft_scan_worker )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_close(
+			     ( *mft_scan_worker )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( ( *mft_scan_worker )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *mft_scan_worker )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *mft_scan_worker )->error ) );
+		}
+		memory_free(
+		 *mft_scan_worker );
+
+		*mft_scan_worker = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the stop scan value
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scan_worker_get_stop_scan(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker,
+     uint8_t *stop_scan,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_scan_worker_get_stop_scan";
+
+	if( mft_scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scan_worker->stop_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT scan worker - missing stop scan.",
+		 function );
+
+		return( -1 );
+	}
+	if( stop_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stop scan.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( mft_scan_worker->stop_scan_mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     mft_scan_worker->stop_scan_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	*stop_scan = *( mft_scan_worker->stop_scan );
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( mft_scan_worker->stop_scan_mutex != NULL )
+	{
+		if( libcthreads_mutex_release(
+		     mft_scan_worker->stop_scan_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( 1 );
+}
+
+/* Signals all the workers that share the stop scan value to stop
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scan_worker_set_stop_scan(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_scan_worker_set_stop_scan";
+
+	if( mft_scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scan_worker->stop_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT scan worker - missing stop scan.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( mft_scan_worker->stop_scan_mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     mft_scan_worker->stop_scan_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	*( mft_scan_worker->stop_scan ) = 1;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( mft_scan_worker->stop_scan_mutex != NULL )
+	{
+		if( libcthreads_mutex_release(
+		     mft_scan_worker->stop_scan_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads the file system of the worker
+ * The file system is read using the file IO handle of the worker, hence the MFT entry,
+ * read-ahead, security descriptor and path hint caches are not shared with the volume
+ * or the other workers
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scan_worker_read_file_system(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_scan_worker_read_file_system";
+
+	if( mft_scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scan_worker->file_system != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid MFT scan worker - file system value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_file_system_initialize(
+	     &( mft_scan_worker->file_system ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_file_system_read_mft(
+	     mft_scan_worker->file_system,
+	     mft_scan_worker->io_handle,
+	     mft_scan_worker->file_io_handle,
+	     mft_scan_worker->mft_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT (MFT entry: 0).",
+		 function );
+
+		goto on_error;
+	}
+	/* Failing to read the upper case table is not fatal, as when opening the volume
+	 */
+	if( libfsntfs_file_system_read_upcase_table(
+	     mft_scan_worker->file_system,
+	     mft_scan_worker->io_handle,
+	     mft_scan_worker->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_free(
+		 error );
+	}
+	if( libfsntfs_path_component_cache_initialize(
+	     &( mft_scan_worker->file_system->path_component_cache ),
+	     LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_PATH_COMPONENTS,
+	     mft_scan_worker->file_system->upcase_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create path component cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_file_system_read_security_descriptors(
+	     mft_scan_worker->file_system,
+	     mft_scan_worker->io_handle,
+	     mft_scan_worker->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read security descriptors (MFT entry: 9).",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( mft_scan_worker->file_system != NULL )
+	{
+		libfsntfs_file_system_free(
+		 &( mft_scan_worker->file_system ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Scans the MFT entries in the range of the worker
+ * Calls the callback function with a file entry for every MFT entry
+ * Returns 1 if successful, 0 if the scan was stopped or -1 on error
+ */
+int libfsntfs_mft_scan_worker_scan(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker,
+     libcerror_error_t **error )
+{
+	libfsntfs_file_entry_t *file_entry = NULL;
+	libfsntfs_mft_entry_t *mft_entry   = NULL;
+	static char *function              = "libfsntfs_mft_scan_worker_scan";
+	uint64_t last_mft_entry_index      = 0;
+	uint64_t mft_entry_index           = 0;
+	uint8_t stop_scan                  = 0;
+	int result                         = 0;
+
+	if( mft_scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scan_worker->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT scan worker - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scan_worker->callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT scan worker - missing callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scan_worker->stop_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT scan worker - missing stop scan.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scan_worker->number_of_mft_entries > ( (uint64_t) UINT64_MAX - mft_scan_worker->first_mft_entry_index ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT scan worker - number of MFT entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	last_mft_entry_index = mft_scan_worker->first_mft_entry_index + mft_scan_worker->number_of_mft_entries;
+
+	if( mft_scan_worker->file_system == NULL )
+	{
+		if( libfsntfs_mft_scan_worker_read_file_system(
+		     mft_scan_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file system.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( mft_entry_index = mft_scan_worker->first_mft_entry_index;
+	     mft_entry_index < last_mft_entry_index;
+	     mft_entry_index++ )
+	{
+		if( libfsntfs_mft_scan_worker_get_stop_scan(
+		     mft_scan_worker,
+		     &stop_scan,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stop scan.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( mft_scan_worker->io_handle->abort != 0 )
+		 || ( stop_scan != 0 ) )
+		{
+			return( 0 );
+		}
+		if( libfsntfs_file_system_read_mft_entry_by_index(
+		     mft_scan_worker->file_system,
+		     mft_scan_worker->file_io_handle,
+		     mft_entry_index,
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		if( libfsntfs_file_entry_initialize_from_mft_entry(
+		     &file_entry,
+		     mft_scan_worker->io_handle,
+		     mft_scan_worker->file_io_handle,
+		     mft_scan_worker->file_system,
+		     mft_entry,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file entry with MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		/* The file entry now manages the MFT entry
+		 */
+		mft_entry = NULL;
+
+		result = mft_scan_worker->callback_function(
+		          file_entry,
+		          mft_entry_index,
+		          mft_scan_worker->user_data );
+
+		if( libfsntfs_file_entry_free(
+		     &file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: callback function failed for MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Runs the MFT scan worker
+ * This function is used as the thread start function, the scan result and
+ * error are stored in the worker. If the scan does not complete the other
+ * workers are signalled to stop.
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scan_worker_run(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker )
+{
+	if( mft_scan_worker == NULL )
+	{
+		return( -1 );
+	}
+	mft_scan_worker->result = libfsntfs_mft_scan_worker_scan(
+	                           mft_scan_worker,
+	                           &( mft_scan_worker->error ) );
+
+	if( mft_scan_worker->result != 1 )
+	{
+		libfsntfs_mft_scan_worker_set_stop_scan(
+		 mft_scan_worker,
+		 NULL );
+	}
+	if( mft_scan_worker->result == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
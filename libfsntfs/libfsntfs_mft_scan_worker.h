@@ -0,0 +1,146 @@
+/*
+ * MFT scan worker functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_MFT_SCAN_WORKER_H )
+#define _LIBFSNTFS_MFT_SCAN_WORKER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_file_system.h"
+#include "libfsntfs_io_handle.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+#include "libfsntfs_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_mft_scan_worker libfsntfs_mft_scan_worker_t;
+
+struct libfsntfs_mft_scan_worker
+{
+	/* The IO handle
+	 */
+	libfsntfs_io_handle_t *io_handle;
+
+	/* The file IO handle, a clone of the volume file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The MFT offset
+	 */
+	off64_t mft_offset;
+
+	/* The file system, which is read using the file IO handle of the worker
+	 * so that the MFT entry and security descriptor caches are not shared
+	 */
+	libfsntfs_file_system_t *file_system;
+
+	/* The first MFT entry index of the range
+	 */
+	uint64_t first_mft_entry_index;
+
+	/* The number of MFT entries in the range
+	 */
+	uint64_t number_of_mft_entries;
+
+	/* The callback function
+	 */
+	int (*callback_function)(
+	       libfsntfs_file_entry_t *file_entry,
+	       uint64_t mft_entry_index,
+	       void *user_data );
+
+	/* The callback function user data
+	 */
+	void *user_data;
+
+	/* Value to indicate the scan should stop, shared by all workers
+	 */
+	uint8_t *stop_scan;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the stop scan value, shared by all workers
+	 */
+	libcthreads_mutex_t *stop_scan_mutex;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* The scan result
+	 */
+	int result;
+
+	/* The scan error
+	 */
+	libcerror_error_t *error;
+};
+
+int libfsntfs_mft_scan_worker_initialize(
+     libfsntfs_mft_scan_worker_t **mft_scan_worker,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t mft_offset,
+     uint64_t first_mft_entry_index,
+     uint64_t number_of_mft_entries,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            uint64_t mft_entry_index,
+            void *user_data ),
+     void *user_data,
+     uint8_t *stop_scan,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scan_worker_free(
+     libfsntfs_mft_scan_worker_t **mft_scan_worker,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scan_worker_get_stop_scan(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker,
+     uint8_t *stop_scan,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scan_worker_set_stop_scan(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scan_worker_read_file_system(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scan_worker_scan(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scan_worker_run(
+     libfsntfs_mft_scan_worker_t *mft_scan_worker );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_MFT_SCAN_WORKER_H ) */
+
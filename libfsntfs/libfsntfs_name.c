@@ -19,7 +19,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_WCTYPE_H )
@@ -29,6 +31,38 @@
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libuna.h"
 #include "libfsntfs_name.h"
+#include "libfsntfs_upcase_table.h"
+
+/* Retrieves the upper case of an Unicode character
+ * The upper case table is used when available, which contains the $UpCase
+ * mappings of the volume, otherwise the C library is used
+ * Returns the upper case Unicode character
+ */
+libuna_unicode_character_t libfsntfs_name_get_upper_case_character(
+                            libuna_unicode_character_t character,
+                            libfsntfs_upcase_table_t *upcase_table )
+{
+	if( character < 0x80 )
+	{
+		if( ( character >= (libuna_unicode_character_t) 'a' )
+		 && ( character <= (libuna_unicode_character_t) 'z' ) )
+		{
+			character -= 0x20;
+		}
+		return( character );
+	}
+	if( upcase_table != NULL )
+	{
+		/* NTFS does not case fold characters outside the basic multilingual plane
+		 */
+		if( character < LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_VALUES )
+		{
+			character = (libuna_unicode_character_t) upcase_table->values[ character ];
+		}
+		return( character );
+	}
+	return( (libuna_unicode_character_t) towupper( (wint_t) character ) );
+}
 
 /* Compares an (other) UTF-16 encoded name with an UTF-16 encoded name
  * Returns LIBUNA_COMPARE_LESS, LIBUNA_COMPARE_EQUAL, LIBUNA_COMPARE_GREATER if successful or -1 on error
@@ -39,6 +73,7 @@ int libfsntfs_name_compare(
      const uint8_t *other_name,
      size_t other_name_size,
      uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
      libcerror_error_t **error )
 {
 	static char *function                           = "libfsntfs_name_compare";
@@ -127,16 +162,49 @@ int libfsntfs_name_compare(
 	{
 		other_name_size -= 2;
 	}
+	/* Skip the common prefix 8 UTF-16 code units at a time, since equal code
+	 * units are also equal after case folding
+	 */
+	while( ( ( name_index + 16 ) <= name_size )
+	    && ( ( name_index + 16 ) <= other_name_size ) )
+	{
+		if( memory_compare(
+		     &( name[ name_index ] ),
+		     &( other_name[ name_index ] ),
+		     16 ) != 0 )
+		{
+			break;
+		}
+		name_index += 16;
+	}
+	/* Do not split a surrogate pair
+	 */
+	if( ( name_index >= 2 )
+	 && ( ( name[ name_index - 1 ] & 0xfc ) == 0xd8 ) )
+	{
+		name_index -= 2;
+	}
+	other_name_index = name_index;
+
 	while( ( name_index < name_size )
 	    && ( other_name_index < other_name_size ) )
 	{
-		if( libuna_unicode_character_copy_from_utf16_stream(
-		     &name_character,
-		     name,
-		     name_size,
-		     &name_index,
-		     LIBUNA_ENDIAN_LITTLE,
-		     error ) != 1 )
+		/* Fast path for ASCII characters
+		 */
+		if( ( ( name_index + 1 ) < name_size )
+		 && ( name[ name_index ] < 0x80 )
+		 && ( name[ name_index + 1 ] == 0 ) )
+		{
+			name_character = (libuna_unicode_character_t) name[ name_index ];
+			name_index    += 2;
+		}
+		else if( libuna_unicode_character_copy_from_utf16_stream(
+		          &name_character,
+		          name,
+		          name_size,
+		          &name_index,
+		          LIBUNA_ENDIAN_LITTLE,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -147,13 +215,22 @@ int libfsntfs_name_compare(
 
 			return( -1 );
 		}
-		if( libuna_unicode_character_copy_from_utf16_stream(
-		     &other_name_character,
-		     other_name,
-		     other_name_size,
-		     &other_name_index,
-		     LIBUNA_ENDIAN_LITTLE,
-		     error ) != 1 )
+		/* Fast path for ASCII characters
+		 */
+		if( ( ( other_name_index + 1 ) < other_name_size )
+		 && ( other_name[ other_name_index ] < 0x80 )
+		 && ( other_name[ other_name_index + 1 ] == 0 ) )
+		{
+			other_name_character = (libuna_unicode_character_t) other_name[ other_name_index ];
+			other_name_index    += 2;
+		}
+		else if( libuna_unicode_character_copy_from_utf16_stream(
+		          &other_name_character,
+		          other_name,
+		          other_name_size,
+		          &other_name_index,
+		          LIBUNA_ENDIAN_LITTLE,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -166,8 +243,12 @@ int libfsntfs_name_compare(
 		}
 		if( use_case_folding != 0 )
 		{
-			name_character       = (libuna_unicode_character_t) towupper( (wint_t) name_character );
-			other_name_character = (libuna_unicode_character_t) towupper( (wint_t) other_name_character );
+			name_character       = libfsntfs_name_get_upper_case_character(
+			                        name_character,
+			                        upcase_table );
+			other_name_character = libfsntfs_name_get_upper_case_character(
+			                        other_name_character,
+			                        upcase_table );
 		}
 		if( other_name_character < name_character )
 		{
@@ -353,8 +434,12 @@ int libfsntfs_name_compare_short(
 		{
 			break;
 		}
-		name_character       = (libuna_unicode_character_t) towupper( (wint_t) name_character );
-		short_name_character = (libuna_unicode_character_t) towupper( (wint_t) short_name_character );
+		name_character       = libfsntfs_name_get_upper_case_character(
+		                        name_character,
+		                        NULL );
+		short_name_character = libfsntfs_name_get_upper_case_character(
+		                        short_name_character,
+		                        NULL );
 
 		if( last_match_short_name_index < 4 )
 		{
@@ -533,8 +618,12 @@ int libfsntfs_name_compare_short(
 
 				return( -1 );
 			}
-			name_character       = (libuna_unicode_character_t) towupper( (wint_t) name_character );
-			short_name_character = (libuna_unicode_character_t) towupper( (wint_t) short_name_character );
+			name_character       = libfsntfs_name_get_upper_case_character(
+			                        name_character,
+			                        NULL );
+			short_name_character = libfsntfs_name_get_upper_case_character(
+			                        short_name_character,
+			                        NULL );
 
 			if( short_name_character != name_character )
 			{
@@ -592,8 +681,12 @@ int libfsntfs_name_compare_short(
 
 				return( -1 );
 			}
-			name_character       = (libuna_unicode_character_t) towupper( (wint_t) name_character );
-			short_name_character = (libuna_unicode_character_t) towupper( (wint_t) short_name_character );
+			name_character       = libfsntfs_name_get_upper_case_character(
+			                        name_character,
+			                        NULL );
+			short_name_character = libfsntfs_name_get_upper_case_character(
+			                        short_name_character,
+			                        NULL );
 
 			if( short_name_character < name_character )
 			{
@@ -617,6 +710,7 @@ int libfsntfs_name_compare_with_utf8_string(
      const libuna_utf8_character_t *utf8_string,
      size_t utf8_string_length,
      uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
      libcerror_error_t **error )
 {
 	static char *function                       = "libfsntfs_name_compare_with_utf8_string";
@@ -696,13 +790,22 @@ int libfsntfs_name_compare_with_utf8_string(
 	while( ( name_index < name_size )
 	    && ( utf8_string_index < utf8_string_length ) )
 	{
-		if( libuna_unicode_character_copy_from_utf16_stream(
-		     &name_character,
-		     name,
-		     name_size,
-		     &name_index,
-		     LIBUNA_ENDIAN_LITTLE,
-		     error ) != 1 )
+		/* Fast path for ASCII characters
+		 */
+		if( ( ( name_index + 1 ) < name_size )
+		 && ( name[ name_index ] < 0x80 )
+		 && ( name[ name_index + 1 ] == 0 ) )
+		{
+			name_character = (libuna_unicode_character_t) name[ name_index ];
+			name_index    += 2;
+		}
+		else if( libuna_unicode_character_copy_from_utf16_stream(
+		          &name_character,
+		          name,
+		          name_size,
+		          &name_index,
+		          LIBUNA_ENDIAN_LITTLE,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -713,12 +816,17 @@ int libfsntfs_name_compare_with_utf8_string(
 
 			return( -1 );
 		}
-		if( libuna_unicode_character_copy_from_utf8(
-		     &string_character,
-		     utf8_string,
-		     utf8_string_length,
-		     &utf8_string_index,
-		     error ) != 1 )
+		if( utf8_string[ utf8_string_index ] < 0x80 )
+		{
+			string_character   = (libuna_unicode_character_t) utf8_string[ utf8_string_index ];
+			utf8_string_index += 1;
+		}
+		else if( libuna_unicode_character_copy_from_utf8(
+		          &string_character,
+		          utf8_string,
+		          utf8_string_length,
+		          &utf8_string_index,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -731,8 +839,12 @@ int libfsntfs_name_compare_with_utf8_string(
 		}
 		if( use_case_folding != 0 )
 		{
-			name_character   = (libuna_unicode_character_t) towupper( (wint_t) name_character );
-			string_character = (libuna_unicode_character_t) towupper( (wint_t) string_character );
+			name_character   = libfsntfs_name_get_upper_case_character(
+			                    name_character,
+			                    upcase_table );
+			string_character = libfsntfs_name_get_upper_case_character(
+			                    string_character,
+			                    upcase_table );
 		}
 		if( string_character < name_character )
 		{
@@ -763,6 +875,7 @@ int libfsntfs_name_compare_with_utf16_string(
      const libuna_utf16_character_t *utf16_string,
      size_t utf16_string_length,
      uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
      libcerror_error_t **error )
 {
 	static char *function                       = "libfsntfs_name_compare_with_utf16_string";
@@ -842,13 +955,22 @@ int libfsntfs_name_compare_with_utf16_string(
 	while( ( name_index < name_size )
 	    && ( utf16_string_index < utf16_string_length ) )
 	{
-		if( libuna_unicode_character_copy_from_utf16_stream(
-		     &name_character,
-		     name,
-		     name_size,
-		     &name_index,
-		     LIBUNA_ENDIAN_LITTLE,
-		     error ) != 1 )
+		/* Fast path for ASCII characters
+		 */
+		if( ( ( name_index + 1 ) < name_size )
+		 && ( name[ name_index ] < 0x80 )
+		 && ( name[ name_index + 1 ] == 0 ) )
+		{
+			name_character = (libuna_unicode_character_t) name[ name_index ];
+			name_index    += 2;
+		}
+		else if( libuna_unicode_character_copy_from_utf16_stream(
+		          &name_character,
+		          name,
+		          name_size,
+		          &name_index,
+		          LIBUNA_ENDIAN_LITTLE,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -859,12 +981,17 @@ int libfsntfs_name_compare_with_utf16_string(
 
 			return( -1 );
 		}
-		if( libuna_unicode_character_copy_from_utf16(
-		     &string_character,
-		     utf16_string,
-		     utf16_string_length,
-		     &utf16_string_index,
-		     error ) != 1 )
+		if( utf16_string[ utf16_string_index ] < 0x80 )
+		{
+			string_character    = (libuna_unicode_character_t) utf16_string[ utf16_string_index ];
+			utf16_string_index += 1;
+		}
+		else if( libuna_unicode_character_copy_from_utf16(
+		          &string_character,
+		          utf16_string,
+		          utf16_string_length,
+		          &utf16_string_index,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -877,8 +1004,12 @@ int libfsntfs_name_compare_with_utf16_string(
 		}
 		if( use_case_folding != 0 )
 		{
-			name_character   = (libuna_unicode_character_t) towupper( (wint_t) name_character );
-			string_character = (libuna_unicode_character_t) towupper( (wint_t) string_character );
+			name_character   = libfsntfs_name_get_upper_case_character(
+			                    name_character,
+			                    upcase_table );
+			string_character = libfsntfs_name_get_upper_case_character(
+			                    string_character,
+			                    upcase_table );
 		}
 		if( string_character < name_character )
 		{
@@ -900,3 +1031,586 @@ int libfsntfs_name_compare_with_utf16_string(
 	return( LIBUNA_COMPARE_EQUAL );
 }
 
+/* Calculates the hash of an UTF-16 encoded name
+ * The hash is calculated over the (case folded) Unicode characters, names that
+ * compare equal have the same hash
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_name_get_hash(
+     const uint8_t *name,
+     size_t name_size,
+     uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint32_t *hash,
+     libcerror_error_t **error )
+{
+	static char *function                = "libfsntfs_name_get_hash";
+	libuna_unicode_character_t character = 0;
+	size_t name_index                    = 0;
+	uint32_t safe_hash                   = 0;
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 encoded name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 encoded name size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if the UTF-16 stream is terminated with zero bytes
+	 */
+	if( ( name_size >= 2 )
+	 && ( name[ name_size - 2 ] == 0 )
+	 && ( name[ name_size - 1 ] == 0 ) )
+	{
+		name_size -= 2;
+	}
+	/* The hash is a 32-bit FNV-1a hash of the Unicode characters
+	 */
+	safe_hash = 0x811c9dc5UL;
+
+	while( name_index < name_size )
+	{
+		/* Fast path for ASCII characters
+		 */
+		if( ( ( name_index + 1 ) < name_size )
+		 && ( name[ name_index ] < 0x80 )
+		 && ( name[ name_index + 1 ] == 0 ) )
+		{
+			character   = (libuna_unicode_character_t) name[ name_index ];
+			name_index += 2;
+		}
+		else if( libuna_unicode_character_copy_from_utf16_stream(
+		          &character,
+		          name,
+		          name_size,
+		          &name_index,
+		          LIBUNA_ENDIAN_LITTLE,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-16 encoded name to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		if( use_case_folding != 0 )
+		{
+			character = libfsntfs_name_get_upper_case_character(
+			             character,
+			             upcase_table );
+		}
+		safe_hash ^= (uint32_t) character;
+		safe_hash *= 0x01000193UL;
+	}
+	*hash = safe_hash;
+
+	return( 1 );
+}
+
+/* Calculates the hash of an UTF-8 string
+ * The hash is calculated over the (case folded) Unicode characters, a string
+ * that compares equal with a name has the same hash as the name
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_name_get_hash_from_utf8_string(
+     const libuna_utf8_character_t *utf8_string,
+     size_t utf8_string_length,
+     uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint32_t *hash,
+     libcerror_error_t **error )
+{
+	static char *function                = "libfsntfs_name_get_hash_from_utf8_string";
+	libuna_unicode_character_t character = 0;
+	size_t utf8_string_index             = 0;
+	uint32_t safe_hash                   = 0;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_string_length >= 1 )
+	 && ( utf8_string[ utf8_string_length - 1 ] == 0 ) )
+	{
+		utf8_string_length -= 1;
+	}
+	/* The hash is a 32-bit FNV-1a hash of the Unicode characters
+	 */
+	safe_hash = 0x811c9dc5UL;
+
+	while( utf8_string_index < utf8_string_length )
+	{
+		if( utf8_string[ utf8_string_index ] < 0x80 )
+		{
+			character          = (libuna_unicode_character_t) utf8_string[ utf8_string_index ];
+			utf8_string_index += 1;
+		}
+		else if( libuna_unicode_character_copy_from_utf8(
+		          &character,
+		          utf8_string,
+		          utf8_string_length,
+		          &utf8_string_index,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-8 string to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		if( use_case_folding != 0 )
+		{
+			character = libfsntfs_name_get_upper_case_character(
+			             character,
+			             upcase_table );
+		}
+		safe_hash ^= (uint32_t) character;
+		safe_hash *= 0x01000193UL;
+	}
+	*hash = safe_hash;
+
+	return( 1 );
+}
+
+/* Calculates the hash of an UTF-16 string
+ * The hash is calculated over the (case folded) Unicode characters, a string
+ * that compares equal with a name has the same hash as the name
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_name_get_hash_from_utf16_string(
+     const libuna_utf16_character_t *utf16_string,
+     size_t utf16_string_length,
+     uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint32_t *hash,
+     libcerror_error_t **error )
+{
+	static char *function                = "libfsntfs_name_get_hash_from_utf16_string";
+	libuna_unicode_character_t character = 0;
+	size_t utf16_string_index            = 0;
+	uint32_t safe_hash                   = 0;
+
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf16_string_length >= 1 )
+	 && ( utf16_string[ utf16_string_length - 1 ] == 0 ) )
+	{
+		utf16_string_length -= 1;
+	}
+	/* The hash is a 32-bit FNV-1a hash of the Unicode characters
+	 */
+	safe_hash = 0x811c9dc5UL;
+
+	while( utf16_string_index < utf16_string_length )
+	{
+		if( utf16_string[ utf16_string_index ] < 0x80 )
+		{
+			character           = (libuna_unicode_character_t) utf16_string[ utf16_string_index ];
+			utf16_string_index += 1;
+		}
+		else if( libuna_unicode_character_copy_from_utf16(
+		          &character,
+		          utf16_string,
+		          utf16_string_length,
+		          &utf16_string_index,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-16 string to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		if( use_case_folding != 0 )
+		{
+			character = libfsntfs_name_get_upper_case_character(
+			             character,
+			             upcase_table );
+		}
+		safe_hash ^= (uint32_t) character;
+		safe_hash *= 0x01000193UL;
+	}
+	*hash = safe_hash;
+
+	return( 1 );
+}
+
+/* Determines the number of ASCII characters in an UTF-16 little-endian name
+ * The characters are tested 4 at a time, the name is considered terminated
+ * at the first end of string character
+ * Returns 1 if the name only contains ASCII characters, 0 if not or -1 on error
+ */
+int libfsntfs_name_get_number_of_ascii_characters(
+     const uint8_t *name,
+     size_t name_size,
+     size_t *number_of_characters,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_name_get_number_of_ascii_characters";
+	size_t name_index     = 0;
+	uint64_t value_64bit  = 0;
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid name size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_characters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of characters.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_size % 2 ) != 0 )
+	{
+		return( 0 );
+	}
+	/* Every 16-bit little-endian value in the 64-bit value must be less than 0x80
+	 * and adding 0x7f to it only sets bit 7 when it is not an end of string character
+	 */
+	while( ( name_index + 8 ) <= name_size )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( name[ name_index ] ),
+		 value_64bit );
+
+		if( ( value_64bit & 0xff80ff80ff80ff80ULL ) != 0 )
+		{
+			return( 0 );
+		}
+		if( ( ( value_64bit + 0x007f007f007f007fULL ) & 0x0080008000800080ULL ) != 0x0080008000800080ULL )
+		{
+			break;
+		}
+		name_index += 8;
+	}
+	while( name_index < name_size )
+	{
+		if( ( name[ name_index + 1 ] != 0 )
+		 || ( name[ name_index ] >= 0x80 ) )
+		{
+			return( 0 );
+		}
+		if( name[ name_index ] == 0 )
+		{
+			break;
+		}
+		name_index += 2;
+	}
+	*number_of_characters = name_index / 2;
+
+	return( 1 );
+}
+
+/* Retrieves the size of an UTF-8 string of an UTF-16 little-endian name
+ * The returned size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_name_get_utf8_string_size(
+     const uint8_t *name,
+     size_t name_size,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfsntfs_name_get_utf8_string_size";
+	size_t number_of_characters = 0;
+	int result                  = 0;
+
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name != NULL )
+	 && ( name_size > 0 ) )
+	{
+		result = libfsntfs_name_get_number_of_ascii_characters(
+		          name,
+		          name_size,
+		          &number_of_characters,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of ASCII characters.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result != 0 )
+	{
+		*utf8_string_size = number_of_characters + 1;
+	}
+	else if( libuna_utf8_string_size_from_utf16_stream(
+	          name,
+	          name_size,
+	          LIBUNA_ENDIAN_LITTLE,
+	          utf8_string_size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Copies an UTF-16 little-endian name to an UTF-8 string
+ * Names that only contain ASCII characters are copied 4 characters at a time
+ * The size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_name_copy_to_utf8_string(
+     const uint8_t *name,
+     size_t name_size,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfsntfs_name_copy_to_utf8_string";
+	size_t name_index           = 0;
+	size_t number_of_characters = 0;
+	size_t utf8_string_index    = 0;
+	uint64_t value_64bit        = 0;
+	uint32_t value_32bit        = 0;
+	int result                  = 0;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name != NULL )
+	 && ( name_size > 0 ) )
+	{
+		result = libfsntfs_name_get_number_of_ascii_characters(
+		          name,
+		          name_size,
+		          &number_of_characters,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of ASCII characters.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		if( libuna_utf8_string_copy_from_utf16_stream(
+		     utf8_string,
+		     utf8_string_size,
+		     name,
+		     name_size,
+		     LIBUNA_ENDIAN_LITTLE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy name to UTF-8 string.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( utf8_string_size < ( number_of_characters + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: UTF-8 string too small.",
+		 function );
+
+		return( -1 );
+	}
+	/* Pack the low bytes of 4 little-endian 16-bit values into a 32-bit value
+	 */
+	while( ( utf8_string_index + 4 ) <= number_of_characters )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( name[ name_index ] ),
+		 value_64bit );
+
+		value_32bit = (uint32_t) ( value_64bit & 0x000000ffUL )
+		            | (uint32_t) ( ( value_64bit >> 8 ) & 0x0000ff00UL )
+		            | (uint32_t) ( ( value_64bit >> 16 ) & 0x00ff0000UL )
+		            | (uint32_t) ( ( value_64bit >> 24 ) & 0xff000000UL );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( utf8_string[ utf8_string_index ] ),
+		 value_32bit );
+
+		name_index        += 8;
+		utf8_string_index += 4;
+	}
+	while( utf8_string_index < number_of_characters )
+	{
+		utf8_string[ utf8_string_index++ ] = name[ name_index ];
+
+		name_index += 2;
+	}
+	utf8_string[ utf8_string_index ] = 0;
+
+	return( 1 );
+}
+
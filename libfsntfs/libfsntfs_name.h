@@ -27,17 +27,23 @@
 
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libuna.h"
+#include "libfsntfs_upcase_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+libuna_unicode_character_t libfsntfs_name_get_upper_case_character(
+                            libuna_unicode_character_t character,
+                            libfsntfs_upcase_table_t *upcase_table );
+
 int libfsntfs_name_compare(
      const uint8_t *name,
      size_t name_size,
      const uint8_t *other_name,
      size_t other_name_size,
      uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
      libcerror_error_t **error );
 
 int libfsntfs_name_compare_short(
@@ -53,6 +59,7 @@ int libfsntfs_name_compare_with_utf8_string(
      const libuna_utf8_character_t *utf8_string,
      size_t utf8_string_length,
      uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
      libcerror_error_t **error );
 
 int libfsntfs_name_compare_with_utf16_string(
@@ -61,6 +68,50 @@ int libfsntfs_name_compare_with_utf16_string(
      const libuna_utf16_character_t *utf16_string,
      size_t utf16_string_length,
      uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
+     libcerror_error_t **error );
+
+int libfsntfs_name_get_hash(
+     const uint8_t *name,
+     size_t name_size,
+     uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint32_t *hash,
+     libcerror_error_t **error );
+
+int libfsntfs_name_get_hash_from_utf8_string(
+     const libuna_utf8_character_t *utf8_string,
+     size_t utf8_string_length,
+     uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint32_t *hash,
+     libcerror_error_t **error );
+
+int libfsntfs_name_get_hash_from_utf16_string(
+     const libuna_utf16_character_t *utf16_string,
+     size_t utf16_string_length,
+     uint8_t use_case_folding,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint32_t *hash,
+     libcerror_error_t **error );
+
+int libfsntfs_name_get_number_of_ascii_characters(
+     const uint8_t *name,
+     size_t name_size,
+     size_t *number_of_characters,
+     libcerror_error_t **error );
+
+int libfsntfs_name_get_utf8_string_size(
+     const uint8_t *name,
+     size_t name_size,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+int libfsntfs_name_copy_to_utf8_string(
+     const uint8_t *name,
+     size_t name_size,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
@@ -0,0 +1,377 @@
+/*
+ * Name hash table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_name_hash_table.h"
+
+/* Creates a name hash table
+ * Make sure the value name_hash_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_name_hash_table_initialize(
+     libfsntfs_name_hash_table_t **name_hash_table,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_name_hash_table_initialize";
+	int number_of_buckets = 1;
+
+	if( name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *name_hash_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid name hash table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( maximum_number_of_entries > ( INT_MAX / 2 ) )
+	 || ( (size_t) maximum_number_of_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsntfs_name_hash_table_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Use at least as many buckets as entries to keep the chains short
+	 */
+	while( number_of_buckets < maximum_number_of_entries )
+	{
+		number_of_buckets <<= 1;
+	}
+	*name_hash_table = memory_allocate_structure(
+	                    libfsntfs_name_hash_table_t );
+
+	if( *name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name hash table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *name_hash_table,
+	     0,
+	     sizeof( libfsntfs_name_hash_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear name hash table.",
+		 function );
+
+		memory_free(
+		 *name_hash_table );
+
+		*name_hash_table = NULL;
+
+		return( -1 );
+	}
+	( *name_hash_table )->buckets = (int *) memory_allocate(
+	                                         sizeof( int ) * number_of_buckets );
+
+	if( ( *name_hash_table )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *name_hash_table )->buckets,
+	     0,
+	     sizeof( int ) * number_of_buckets ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+	( *name_hash_table )->entries = (libfsntfs_name_hash_table_entry_t *) memory_allocate(
+	                                                                       sizeof( libfsntfs_name_hash_table_entry_t ) * maximum_number_of_entries );
+
+	if( ( *name_hash_table )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *name_hash_table )->number_of_buckets         = number_of_buckets;
+	( *name_hash_table )->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *name_hash_table != NULL )
+	{
+		if( ( *name_hash_table )->buckets != NULL )
+		{
+			memory_free(
+			 ( *name_hash_table )->buckets );
+		}
+		memory_free(
+		 *name_hash_table );
+
+		*name_hash_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a name hash table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_name_hash_table_free(
+     libfsntfs_name_hash_table_t **name_hash_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_name_hash_table_free";
+
+	if( name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *name_hash_table != NULL )
+	{
+		if( ( *name_hash_table )->entries != NULL )
+		{
+			memory_free(
+			 ( *name_hash_table )->entries );
+		}
+		if( ( *name_hash_table )->buckets != NULL )
+		{
+			memory_free(
+			 ( *name_hash_table )->buckets );
+		}
+		memory_free(
+		 *name_hash_table );
+
+		*name_hash_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Inserts a value into the name hash table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_name_hash_table_insert_value(
+     libfsntfs_name_hash_table_t *name_hash_table,
+     uint32_t hash,
+     int value,
+     libcerror_error_t **error )
+{
+	libfsntfs_name_hash_table_entry_t *entry = NULL;
+	static char *function                    = "libfsntfs_name_hash_table_insert_value";
+	int bucket_index                         = 0;
+
+	if( name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_hash_table->buckets == NULL )
+	 || ( name_hash_table->entries == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid name hash table - missing buckets or entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_hash_table->number_of_entries >= name_hash_table->maximum_number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid name hash table - number of entries value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index = (int) ( hash & (uint32_t) ( name_hash_table->number_of_buckets - 1 ) );
+
+	entry = &( name_hash_table->entries[ name_hash_table->number_of_entries ] );
+
+	entry->hash       = hash;
+	entry->value      = value;
+	entry->next_entry = name_hash_table->buckets[ bucket_index ];
+
+	name_hash_table->number_of_entries += 1;
+
+	name_hash_table->buckets[ bucket_index ] = name_hash_table->number_of_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the next value with a specific hash
+ * The entry index is used to continue the search, set it to 0 to retrieve the first value
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libfsntfs_name_hash_table_get_next_value_by_hash(
+     libfsntfs_name_hash_table_t *name_hash_table,
+     uint32_t hash,
+     int *entry_index,
+     int *value,
+     libcerror_error_t **error )
+{
+	libfsntfs_name_hash_table_entry_t *entry = NULL;
+	static char *function                    = "libfsntfs_name_hash_table_get_next_value_by_hash";
+	int next_entry                           = 0;
+
+	if( name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_hash_table->buckets == NULL )
+	 || ( name_hash_table->entries == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid name hash table - missing buckets or entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( *entry_index < 0 )
+	 || ( *entry_index > name_hash_table->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	/* The entry index contains the index + 1 of the last returned entry
+	 */
+	if( *entry_index == 0 )
+	{
+		next_entry = name_hash_table->buckets[ hash & (uint32_t) ( name_hash_table->number_of_buckets - 1 ) ];
+	}
+	else
+	{
+		next_entry = name_hash_table->entries[ *entry_index - 1 ].next_entry;
+	}
+	while( next_entry != 0 )
+	{
+		entry = &( name_hash_table->entries[ next_entry - 1 ] );
+
+		if( entry->hash == hash )
+		{
+			*entry_index = next_entry;
+			*value       = entry->value;
+
+			return( 1 );
+		}
+		next_entry = entry->next_entry;
+	}
+	return( 0 );
+}
+
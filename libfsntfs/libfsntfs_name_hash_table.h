@@ -0,0 +1,104 @@
+/*
+ * Name hash table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_NAME_HASH_TABLE_H )
+#define _LIBFSNTFS_NAME_HASH_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_name_hash_table_entry libfsntfs_name_hash_table_entry_t;
+
+struct libfsntfs_name_hash_table_entry
+{
+	/* The hash
+	 */
+	uint32_t hash;
+
+	/* The value
+	 */
+	int value;
+
+	/* The next entry in the same bucket, where 0 represents none
+	 * The value contains the entry index + 1
+	 */
+	int next_entry;
+};
+
+typedef struct libfsntfs_name_hash_table libfsntfs_name_hash_table_t;
+
+struct libfsntfs_name_hash_table
+{
+	/* The buckets, each contains the index + 1 of the first entry or 0 if empty
+	 */
+	int *buckets;
+
+	/* The number of buckets, a power of 2
+	 */
+	int number_of_buckets;
+
+	/* The entries
+	 */
+	libfsntfs_name_hash_table_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+};
+
+int libfsntfs_name_hash_table_initialize(
+     libfsntfs_name_hash_table_t **name_hash_table,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libfsntfs_name_hash_table_free(
+     libfsntfs_name_hash_table_t **name_hash_table,
+     libcerror_error_t **error );
+
+int libfsntfs_name_hash_table_insert_value(
+     libfsntfs_name_hash_table_t *name_hash_table,
+     uint32_t hash,
+     int value,
+     libcerror_error_t **error );
+
+int libfsntfs_name_hash_table_get_next_value_by_hash(
+     libfsntfs_name_hash_table_t *name_hash_table,
+     uint32_t hash,
+     int *entry_index,
+     int *value,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_NAME_HASH_TABLE_H ) */
+
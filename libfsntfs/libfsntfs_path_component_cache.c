@@ -0,0 +1,738 @@
+/*
+ * Path component cache functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_directory_entry.h"
+#include "libfsntfs_file_name_values.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libuna.h"
+#include "libfsntfs_name.h"
+#include "libfsntfs_path_component_cache.h"
+#include "libfsntfs_upcase_table.h"
+
+/* Creates a path component cache
+ * Make sure the value path_component_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_component_cache_initialize(
+     libfsntfs_path_component_cache_t **path_component_cache,
+     int number_of_entries,
+     libfsntfs_upcase_table_t *upcase_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_component_cache_initialize";
+
+	if( path_component_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path component cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_component_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path component cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries <= 0 )
+	 || ( (size_t) number_of_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsntfs_path_component_cache_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*path_component_cache = memory_allocate_structure(
+	                         libfsntfs_path_component_cache_t );
+
+	if( *path_component_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path component cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *path_component_cache,
+	     0,
+	     sizeof( libfsntfs_path_component_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear path component cache.",
+		 function );
+
+		memory_free(
+		 *path_component_cache );
+
+		*path_component_cache = NULL;
+
+		return( -1 );
+	}
+	( *path_component_cache )->entries = (libfsntfs_path_component_cache_entry_t *) memory_allocate(
+	                                                                                 sizeof( libfsntfs_path_component_cache_entry_t ) * number_of_entries );
+
+	if( ( *path_component_cache )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *path_component_cache )->entries,
+	     0,
+	     sizeof( libfsntfs_path_component_cache_entry_t ) * number_of_entries ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *path_component_cache )->number_of_entries = number_of_entries;
+	( *path_component_cache )->upcase_table      = upcase_table;
+
+	return( 1 );
+
+on_error:
+	if( *path_component_cache != NULL )
+	{
+		if( ( *path_component_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *path_component_cache )->entries );
+		}
+		memory_free(
+		 *path_component_cache );
+
+		*path_component_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a path component cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_component_cache_free(
+     libfsntfs_path_component_cache_t **path_component_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_component_cache_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( path_component_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path component cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_component_cache != NULL )
+	{
+		/* The upcase_table reference is freed elsewhere
+		 */
+		if( ( *path_component_cache )->entries != NULL )
+		{
+			for( entry_index = 0;
+			     entry_index < ( *path_component_cache )->number_of_entries;
+			     entry_index++ )
+			{
+				if( ( *path_component_cache )->entries[ entry_index ].directory_entry != NULL )
+				{
+					if( libfsntfs_directory_entry_free(
+					     &( ( *path_component_cache )->entries[ entry_index ].directory_entry ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free directory entry: %d.",
+						 function,
+						 entry_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *path_component_cache )->entries );
+		}
+		memory_free(
+		 *path_component_cache );
+
+		*path_component_cache = NULL;
+	}
+	return( result );
+}
+
+/* Determines the index of the entry for a parent file reference and name hash
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_component_cache_get_entry_index(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     uint32_t name_hash,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_component_cache_get_entry_index";
+	uint32_t value_32bit  = 0;
+
+	if( path_component_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path component cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_component_cache->number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path component cache - number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Mix the MFT entry index of the parent into the name hash so that
+	 * the same name in different directories maps onto different entries
+	 */
+	value_32bit = (uint32_t) ( parent_file_reference & 0xffffffffffffUL ) * 0x9e3779b1UL;
+
+	*entry_index = (int) ( ( name_hash ^ value_32bit ) % (uint32_t) path_component_cache->number_of_entries );
+
+	return( 1 );
+}
+
+/* Retrieves a cached directory entry for an UTF-8 encoded name
+ * The directory entry is managed by the cache and should not be freed
+ * Returns 1 if successful, 0 if not cached or -1 on error
+ */
+int libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_file_name_values_t *file_name_values     = NULL;
+	libfsntfs_path_component_cache_entry_t *cache_entry = NULL;
+	static char *function                               = "libfsntfs_path_component_cache_get_directory_entry_by_utf8_name";
+	uint32_t name_hash                                  = 0;
+	int compare_result                                  = 0;
+	int entry_index                                     = 0;
+
+	if( path_component_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path component cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_name_get_hash_from_utf8_string(
+	     utf8_string,
+	     utf8_string_length,
+	     1,
+	     path_component_cache->upcase_table,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_path_component_cache_get_entry_index(
+	     path_component_cache,
+	     parent_file_reference,
+	     name_hash,
+	     &entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index.",
+		 function );
+
+		return( -1 );
+	}
+	cache_entry = &( path_component_cache->entries[ entry_index ] );
+
+	if( ( cache_entry->directory_entry == NULL )
+	 || ( cache_entry->parent_file_reference != parent_file_reference )
+	 || ( cache_entry->name_hash != name_hash ) )
+	{
+		return( 0 );
+	}
+	if( cache_entry->is_short_name != 0 )
+	{
+		file_name_values = cache_entry->directory_entry->short_file_name_values;
+	}
+	else
+	{
+		file_name_values = cache_entry->directory_entry->file_name_values;
+	}
+	if( file_name_values == NULL )
+	{
+		return( 0 );
+	}
+	compare_result = libfsntfs_name_compare_with_utf8_string(
+	                  file_name_values->name,
+	                  file_name_values->name_size,
+	                  utf8_string,
+	                  utf8_string_length,
+	                  cache_entry->use_case_folding,
+	                  path_component_cache->upcase_table,
+	                  error );
+
+	if( compare_result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare UTF-8 string with name.",
+		 function );
+
+		return( -1 );
+	}
+	else if( compare_result != LIBUNA_COMPARE_EQUAL )
+	{
+		return( 0 );
+	}
+	*directory_entry = cache_entry->directory_entry;
+
+	return( 1 );
+}
+
+/* Retrieves a cached directory entry for an UTF-16 encoded name
+ * The directory entry is managed by the cache and should not be freed
+ * Returns 1 if successful, 0 if not cached or -1 on error
+ */
+int libfsntfs_path_component_cache_get_directory_entry_by_utf16_name(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_file_name_values_t *file_name_values     = NULL;
+	libfsntfs_path_component_cache_entry_t *cache_entry = NULL;
+	static char *function                               = "libfsntfs_path_component_cache_get_directory_entry_by_utf16_name";
+	uint32_t name_hash                                  = 0;
+	int compare_result                                  = 0;
+	int entry_index                                     = 0;
+
+	if( path_component_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path component cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_name_get_hash_from_utf16_string(
+	     utf16_string,
+	     utf16_string_length,
+	     1,
+	     path_component_cache->upcase_table,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_path_component_cache_get_entry_index(
+	     path_component_cache,
+	     parent_file_reference,
+	     name_hash,
+	     &entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index.",
+		 function );
+
+		return( -1 );
+	}
+	cache_entry = &( path_component_cache->entries[ entry_index ] );
+
+	if( ( cache_entry->directory_entry == NULL )
+	 || ( cache_entry->parent_file_reference != parent_file_reference )
+	 || ( cache_entry->name_hash != name_hash ) )
+	{
+		return( 0 );
+	}
+	if( cache_entry->is_short_name != 0 )
+	{
+		file_name_values = cache_entry->directory_entry->short_file_name_values;
+	}
+	else
+	{
+		file_name_values = cache_entry->directory_entry->file_name_values;
+	}
+	if( file_name_values == NULL )
+	{
+		return( 0 );
+	}
+	compare_result = libfsntfs_name_compare_with_utf16_string(
+	                  file_name_values->name,
+	                  file_name_values->name_size,
+	                  utf16_string,
+	                  utf16_string_length,
+	                  cache_entry->use_case_folding,
+	                  path_component_cache->upcase_table,
+	                  error );
+
+	if( compare_result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare UTF-16 string with name.",
+		 function );
+
+		return( -1 );
+	}
+	else if( compare_result != LIBUNA_COMPARE_EQUAL )
+	{
+		return( 0 );
+	}
+	*directory_entry = cache_entry->directory_entry;
+
+	return( 1 );
+}
+
+/* Sets an entry in the cache for the name or short name of a directory entry
+ * A copy of the directory entry is stored, which replaces the entry that
+ * previously occupied the same position
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_component_cache_set_entry(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     uint8_t use_case_folding,
+     uint8_t is_short_name,
+     libfsntfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_t *safe_directory_entry   = NULL;
+	libfsntfs_file_name_values_t *file_name_values      = NULL;
+	libfsntfs_path_component_cache_entry_t *cache_entry = NULL;
+	static char *function                               = "libfsntfs_path_component_cache_set_entry";
+	uint32_t name_hash                                  = 0;
+	int entry_index                                     = 0;
+
+	if( path_component_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path component cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_short_name != 0 )
+	{
+		file_name_values = directory_entry->short_file_name_values;
+	}
+	else
+	{
+		file_name_values = directory_entry->file_name_values;
+	}
+	if( file_name_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid directory entry - missing file name values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_name_get_hash(
+	     file_name_values->name,
+	     file_name_values->name_size,
+	     1,
+	     path_component_cache->upcase_table,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_path_component_cache_get_entry_index(
+	     path_component_cache,
+	     parent_file_reference,
+	     name_hash,
+	     &entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_directory_entry_clone(
+	     &safe_directory_entry,
+	     directory_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory entry.",
+		 function );
+
+		goto on_error;
+	}
+	cache_entry = &( path_component_cache->entries[ entry_index ] );
+
+	if( cache_entry->directory_entry != NULL )
+	{
+		if( libfsntfs_directory_entry_free(
+		     &( cache_entry->directory_entry ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+	}
+	cache_entry->parent_file_reference = parent_file_reference;
+	cache_entry->name_hash             = name_hash;
+	cache_entry->use_case_folding      = use_case_folding;
+	cache_entry->is_short_name         = is_short_name;
+	cache_entry->directory_entry       = safe_directory_entry;
+
+	return( 1 );
+
+on_error:
+	if( safe_directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &safe_directory_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+
+/* Sets a directory entry in the cache
+ * The directory entry is stored for both its name and its short name, since
+ * a path component can match either of them
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_component_cache_set_directory_entry(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     uint8_t use_case_folding,
+     libfsntfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_component_cache_set_directory_entry";
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* The short name is set first so that the name takes precedence
+	 * when both map onto the same position
+	 */
+	if( directory_entry->short_file_name_values != NULL )
+	{
+		if( libfsntfs_path_component_cache_set_entry(
+		     path_component_cache,
+		     parent_file_reference,
+		     use_case_folding,
+		     1,
+		     directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set entry for short name.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfsntfs_path_component_cache_set_entry(
+	     path_component_cache,
+	     parent_file_reference,
+	     use_case_folding,
+	     0,
+	     directory_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set entry for name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,132 @@
+/*
+ * Path component cache functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_PATH_COMPONENT_CACHE_H )
+#define _LIBFSNTFS_PATH_COMPONENT_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_directory_entry.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libuna.h"
+#include "libfsntfs_upcase_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_path_component_cache_entry libfsntfs_path_component_cache_entry_t;
+
+struct libfsntfs_path_component_cache_entry
+{
+	/* The parent file reference
+	 */
+	uint64_t parent_file_reference;
+
+	/* The (case folded) name hash
+	 */
+	uint32_t name_hash;
+
+	/* Value to indicate case folding was used to match the name
+	 */
+	uint8_t use_case_folding;
+
+	/* Value to indicate the short name of the directory entry was hashed
+	 */
+	uint8_t is_short_name;
+
+	/* The directory entry
+	 */
+	libfsntfs_directory_entry_t *directory_entry;
+};
+
+typedef struct libfsntfs_path_component_cache libfsntfs_path_component_cache_t;
+
+struct libfsntfs_path_component_cache
+{
+	/* The entries
+	 */
+	libfsntfs_path_component_cache_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The upper case table
+	 */
+	libfsntfs_upcase_table_t *upcase_table;
+};
+
+int libfsntfs_path_component_cache_initialize(
+     libfsntfs_path_component_cache_t **path_component_cache,
+     int number_of_entries,
+     libfsntfs_upcase_table_t *upcase_table,
+     libcerror_error_t **error );
+
+int libfsntfs_path_component_cache_free(
+     libfsntfs_path_component_cache_t **path_component_cache,
+     libcerror_error_t **error );
+
+int libfsntfs_path_component_cache_get_entry_index(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     uint32_t name_hash,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_path_component_cache_get_directory_entry_by_utf16_name(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_path_component_cache_set_entry(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     uint8_t use_case_folding,
+     uint8_t is_short_name,
+     libfsntfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_path_component_cache_set_directory_entry(
+     libfsntfs_path_component_cache_t *path_component_cache,
+     uint64_t parent_file_reference,
+     uint8_t use_case_folding,
+     libfsntfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_PATH_COMPONENT_CACHE_H ) */
+
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
@@ -136,6 +137,112 @@ int libfsntfs_path_hint_free(
 	return( 1 );
 }
 
+/* Clones a path hint
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_hint_clone(
+     libfsntfs_path_hint_t **destination_path_hint,
+     libfsntfs_path_hint_t *source_path_hint,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_hint_clone";
+
+	if( destination_path_hint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_path_hint != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination path hint value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_path_hint == NULL )
+	{
+		*destination_path_hint = source_path_hint;
+
+		return( 1 );
+	}
+	if( ( source_path_hint->path_size == 0 )
+	 || ( source_path_hint->path_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source path hint - path size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_path_hint_initialize(
+	     destination_path_hint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination path hint.",
+		 function );
+
+		goto on_error;
+	}
+	( *destination_path_hint )->path = (uint8_t *) memory_allocate(
+	                                                sizeof( uint8_t ) * source_path_hint->path_size );
+
+	if( ( *destination_path_hint )->path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination path.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( *destination_path_hint )->path,
+	     source_path_hint->path,
+	     source_path_hint->path_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source path to destination.",
+		 function );
+
+		goto on_error;
+	}
+	( *destination_path_hint )->file_reference = source_path_hint->file_reference;
+	( *destination_path_hint )->path_size      = source_path_hint->path_size;
+
+	return( 1 );
+
+on_error:
+	if( *destination_path_hint != NULL )
+	{
+		libfsntfs_path_hint_free(
+		 destination_path_hint,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Compares 2 path hints by file reference
  * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
  */
@@ -197,6 +304,83 @@ int libfsntfs_path_hint_compare_by_file_reference(
 	return( LIBCDATA_COMPARE_EQUAL );
 }
 
+/* Determines the number of ASCII characters in the path
+ * The characters are tested 8 at a time, the path is considered terminated
+ * at the first end of string character
+ * Returns 1 if the path only contains ASCII characters, 0 if not or -1 on error
+ */
+int libfsntfs_path_hint_get_number_of_ascii_characters(
+     libfsntfs_path_hint_t *path_hint,
+     size_t *number_of_characters,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_hint_get_number_of_ascii_characters";
+	size_t path_index     = 0;
+	uint64_t value_64bit  = 0;
+
+	if( path_hint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_characters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of characters.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path_hint->path == NULL )
+	 || ( path_hint->path_size == 0 ) )
+	{
+		return( 0 );
+	}
+	/* Every byte in the 64-bit value must be less than 0x80 and adding 0x7f
+	 * to it only sets bit 7 when it is not an end of string character
+	 */
+	while( ( path_index + 8 ) <= path_hint->path_size )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( path_hint->path[ path_index ] ),
+		 value_64bit );
+
+		if( ( value_64bit & 0x8080808080808080ULL ) != 0 )
+		{
+			return( 0 );
+		}
+		if( ( ( value_64bit + 0x7f7f7f7f7f7f7f7fULL ) & 0x8080808080808080ULL ) != 0x8080808080808080ULL )
+		{
+			break;
+		}
+		path_index += 8;
+	}
+	while( path_index < path_hint->path_size )
+	{
+		if( path_hint->path[ path_index ] >= 0x80 )
+		{
+			return( 0 );
+		}
+		if( path_hint->path[ path_index ] == 0 )
+		{
+			break;
+		}
+		path_index += 1;
+	}
+	*number_of_characters = path_index;
+
+	return( 1 );
+}
+
 /* Retrieves the size of the UTF-8 encoded path
  * The returned size includes the end of string character
  * Returns 1 if successful or -1 on error
@@ -206,7 +390,9 @@ int libfsntfs_path_hint_get_utf8_path_size(
      size_t *utf8_string_size,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_path_hint_get_utf8_path_size";
+	static char *function       = "libfsntfs_path_hint_get_utf8_path_size";
+	size_t number_of_characters = 0;
+	int result                  = 0;
 
 	if( path_hint == NULL )
 	{
@@ -219,6 +405,39 @@ int libfsntfs_path_hint_get_utf8_path_size(
 
 		return( -1 );
 	}
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_path_hint_get_number_of_ascii_characters(
+	          path_hint,
+	          &number_of_characters,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of ASCII characters.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*utf8_string_size = number_of_characters + 1;
+
+		return( 1 );
+	}
 	if( libuna_utf8_string_size_from_utf8_stream(
 	     path_hint->path,
 	     path_hint->path_size,
@@ -247,7 +466,9 @@ int libfsntfs_path_hint_get_utf8_path(
      size_t utf8_string_size,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_path_hint_get_utf8_path";
+	static char *function       = "libfsntfs_path_hint_get_utf8_path";
+	size_t number_of_characters = 0;
+	int result                  = 0;
 
 	if( path_hint == NULL )
 	{
@@ -260,6 +481,64 @@ int libfsntfs_path_hint_get_utf8_path(
 
 		return( -1 );
 	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_path_hint_get_number_of_ascii_characters(
+	          path_hint,
+	          &number_of_characters,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of ASCII characters.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( utf8_string_size < ( number_of_characters + 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: UTF-8 string too small.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     utf8_string,
+		     path_hint->path,
+		     number_of_characters ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy path to UTF-8 string.",
+			 function );
+
+			return( -1 );
+		}
+		utf8_string[ number_of_characters ] = 0;
+
+		return( 1 );
+	}
 	if( libuna_utf8_string_copy_from_utf8_stream(
 	     utf8_string,
 	     utf8_string_size,
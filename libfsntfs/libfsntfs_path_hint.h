@@ -56,11 +56,21 @@ int libfsntfs_path_hint_free(
      libfsntfs_path_hint_t **path_hint,
      libcerror_error_t **error );
 
+int libfsntfs_path_hint_clone(
+     libfsntfs_path_hint_t **destination_path_hint,
+     libfsntfs_path_hint_t *source_path_hint,
+     libcerror_error_t **error );
+
 int libfsntfs_path_hint_compare_by_file_reference(
      libfsntfs_path_hint_t *first_path_hint,
      libfsntfs_path_hint_t *second_path_hint,
      libcerror_error_t **error );
 
+int libfsntfs_path_hint_get_number_of_ascii_characters(
+     libfsntfs_path_hint_t *path_hint,
+     size_t *number_of_characters,
+     libcerror_error_t **error );
+
 int libfsntfs_path_hint_get_utf8_path_size(
      libfsntfs_path_hint_t *path_hint,
      size_t *utf8_string_size,
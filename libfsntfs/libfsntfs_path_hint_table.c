@@ -0,0 +1,544 @@
+/*
+ * Path hint table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_path_hint.h"
+#include "libfsntfs_path_hint_table.h"
+
+/* Creates a path hint table
+ * Make sure the value path_hint_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_hint_table_initialize(
+     libfsntfs_path_hint_table_t **path_hint_table,
+     int number_of_entries,
+     int maximum_number_of_path_hints,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_hint_table_initialize";
+
+	if( path_hint_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_hint_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path hint table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries < 0 )
+	 || ( number_of_entries == INT_MAX )
+	 || ( (size_t) number_of_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsntfs_path_hint_table_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_path_hints < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of path hints value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*path_hint_table = memory_allocate_structure(
+	                    libfsntfs_path_hint_table_t );
+
+	if( *path_hint_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path hint table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *path_hint_table,
+	     0,
+	     sizeof( libfsntfs_path_hint_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear path hint table.",
+		 function );
+
+		goto on_error;
+	}
+	/* The entries are allocated when the first path hint is set
+	 */
+	( *path_hint_table )->number_of_entries            = number_of_entries;
+	( *path_hint_table )->maximum_number_of_path_hints = maximum_number_of_path_hints;
+
+	return( 1 );
+
+on_error:
+	if( *path_hint_table != NULL )
+	{
+		memory_free(
+		 *path_hint_table );
+
+		*path_hint_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a path hint table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_hint_table_free(
+     libfsntfs_path_hint_table_t **path_hint_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_hint_table_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( path_hint_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_hint_table != NULL )
+	{
+		if( ( *path_hint_table )->entries != NULL )
+		{
+			/* Only the entries in the most recently used list contain a path hint
+			 */
+			entry_index = ( *path_hint_table )->most_recently_used_entry;
+
+			while( entry_index > 0 )
+			{
+				if( libfsntfs_path_hint_free(
+				     &( ( *path_hint_table )->entries[ entry_index - 1 ].path_hint ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free path hint: %d.",
+					 function,
+					 entry_index - 1 );
+
+					result = -1;
+				}
+				entry_index = ( *path_hint_table )->entries[ entry_index - 1 ].next_entry;
+			}
+			memory_free(
+			 ( *path_hint_table )->entries );
+		}
+		memory_free(
+		 *path_hint_table );
+
+		*path_hint_table = NULL;
+	}
+	return( result );
+}
+
+/* Removes an entry from the most recently used list
+ */
+void libfsntfs_path_hint_table_unlink_entry(
+      libfsntfs_path_hint_table_t *path_hint_table,
+      int entry_index )
+{
+	libfsntfs_path_hint_table_entry_t *entry = &( path_hint_table->entries[ entry_index ] );
+
+	if( entry->previous_entry > 0 )
+	{
+		path_hint_table->entries[ entry->previous_entry - 1 ].next_entry = entry->next_entry;
+	}
+	else
+	{
+		path_hint_table->most_recently_used_entry = entry->next_entry;
+	}
+	if( entry->next_entry > 0 )
+	{
+		path_hint_table->entries[ entry->next_entry - 1 ].previous_entry = entry->previous_entry;
+	}
+	else
+	{
+		path_hint_table->least_recently_used_entry = entry->previous_entry;
+	}
+	entry->previous_entry = 0;
+	entry->next_entry     = 0;
+}
+
+/* Adds an entry to the front of the most recently used list
+ */
+void libfsntfs_path_hint_table_link_entry(
+      libfsntfs_path_hint_table_t *path_hint_table,
+      int entry_index )
+{
+	libfsntfs_path_hint_table_entry_t *entry = &( path_hint_table->entries[ entry_index ] );
+
+	entry->previous_entry = 0;
+	entry->next_entry     = path_hint_table->most_recently_used_entry;
+
+	if( path_hint_table->most_recently_used_entry > 0 )
+	{
+		path_hint_table->entries[ path_hint_table->most_recently_used_entry - 1 ].previous_entry = entry_index + 1;
+	}
+	else
+	{
+		path_hint_table->least_recently_used_entry = entry_index + 1;
+	}
+	path_hint_table->most_recently_used_entry = entry_index + 1;
+}
+
+/* Removes the path hint of an entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_hint_table_remove_entry(
+     libfsntfs_path_hint_table_t *path_hint_table,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_hint_table_remove_entry";
+
+	libfsntfs_path_hint_table_unlink_entry(
+	 path_hint_table,
+	 entry_index );
+
+	path_hint_table->number_of_path_hints -= 1;
+
+	if( libfsntfs_path_hint_free(
+	     &( path_hint_table->entries[ entry_index ].path_hint ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free path hint: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a path hint for a specific file reference
+ * The path hint is managed by the table and remains valid until a next path hint is set
+ * The look up updates the most recently used list, hence the table should be locked
+ * for writing when it is shared between threads
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+     libfsntfs_path_hint_table_t *path_hint_table,
+     uint64_t file_reference,
+     libfsntfs_path_hint_t **path_hint,
+     libcerror_error_t **error )
+{
+	libfsntfs_path_hint_table_entry_t *entry = NULL;
+	static char *function                    = "libfsntfs_path_hint_table_get_path_hint_by_file_reference";
+	uint64_t mft_entry_index                 = 0;
+
+	if( path_hint_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint table.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_hint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint.",
+		 function );
+
+		return( -1 );
+	}
+	mft_entry_index = file_reference & 0xffffffffffffUL;
+
+	if( ( path_hint_table->entries == NULL )
+	 || ( mft_entry_index >= (uint64_t) path_hint_table->number_of_entries ) )
+	{
+		return( 0 );
+	}
+	entry = &( path_hint_table->entries[ mft_entry_index ] );
+
+	/* The file reference contains the sequence number, which changes when
+	 * the MFT entry is reused
+	 */
+	if( ( entry->path_hint == NULL )
+	 || ( entry->path_hint->file_reference != file_reference ) )
+	{
+		return( 0 );
+	}
+	if( path_hint_table->most_recently_used_entry != (int) ( mft_entry_index + 1 ) )
+	{
+		libfsntfs_path_hint_table_unlink_entry(
+		 path_hint_table,
+		 (int) mft_entry_index );
+
+		libfsntfs_path_hint_table_link_entry(
+		 path_hint_table,
+		 (int) mft_entry_index );
+	}
+	*path_hint = entry->path_hint;
+
+	return( 1 );
+}
+
+/* Sets a path hint
+ * The table takes over management of the path hint if successful, a path hint
+ * previously set for the same MFT entry is freed and if the maximum number of
+ * path hints is reached the least recently used path hint is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_hint_table_set_path_hint(
+     libfsntfs_path_hint_table_t *path_hint_table,
+     libfsntfs_path_hint_t *path_hint,
+     libcerror_error_t **error )
+{
+	static char *function    = "libfsntfs_path_hint_table_set_path_hint";
+	size_t entries_size      = 0;
+	uint64_t mft_entry_index = 0;
+
+	if( path_hint_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint table.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_hint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint.",
+		 function );
+
+		return( -1 );
+	}
+	mft_entry_index = path_hint->file_reference & 0xffffffffffffUL;
+
+	if( mft_entry_index >= (uint64_t) path_hint_table->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path hint - MFT entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_hint_table->entries == NULL )
+	{
+		entries_size = sizeof( libfsntfs_path_hint_table_entry_t ) * path_hint_table->number_of_entries;
+
+		path_hint_table->entries = (libfsntfs_path_hint_table_entry_t *) memory_allocate(
+		                                                                  entries_size );
+
+		if( path_hint_table->entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     path_hint_table->entries,
+		     0,
+		     entries_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			memory_free(
+			 path_hint_table->entries );
+
+			path_hint_table->entries = NULL;
+
+			return( -1 );
+		}
+	}
+	if( path_hint_table->entries[ mft_entry_index ].path_hint == path_hint )
+	{
+		return( 1 );
+	}
+	if( path_hint_table->entries[ mft_entry_index ].path_hint != NULL )
+	{
+		if( libfsntfs_path_hint_table_remove_entry(
+		     path_hint_table,
+		     (int) mft_entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			return( -1 );
+		}
+	}
+	if( path_hint_table->maximum_number_of_path_hints > 0 )
+	{
+		while( path_hint_table->number_of_path_hints >= path_hint_table->maximum_number_of_path_hints )
+		{
+			if( libfsntfs_path_hint_table_remove_entry(
+			     path_hint_table,
+			     path_hint_table->least_recently_used_entry - 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove least recently used entry.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	path_hint_table->entries[ mft_entry_index ].path_hint = path_hint;
+
+	libfsntfs_path_hint_table_link_entry(
+	 path_hint_table,
+	 (int) mft_entry_index );
+
+	path_hint_table->number_of_path_hints += 1;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of path hints
+ * If the table contains more path hints the least recently used are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_hint_table_set_maximum_number_of_path_hints(
+     libfsntfs_path_hint_table_t *path_hint_table,
+     int maximum_number_of_path_hints,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_path_hint_table_set_maximum_number_of_path_hints";
+
+	if( path_hint_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path hint table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_path_hints < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of path hints value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_path_hints > 0 )
+	{
+		while( path_hint_table->number_of_path_hints > maximum_number_of_path_hints )
+		{
+			if( libfsntfs_path_hint_table_remove_entry(
+			     path_hint_table,
+			     path_hint_table->least_recently_used_entry - 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove least recently used entry.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	path_hint_table->maximum_number_of_path_hints = maximum_number_of_path_hints;
+
+	return( 1 );
+}
+
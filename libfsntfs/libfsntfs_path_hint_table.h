@@ -0,0 +1,129 @@
+/*
+ * Path hint table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_PATH_HINT_TABLE_H )
+#define _LIBFSNTFS_PATH_HINT_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_path_hint.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_path_hint_table_entry libfsntfs_path_hint_table_entry_t;
+
+struct libfsntfs_path_hint_table_entry
+{
+	/* The path hint
+	 */
+	libfsntfs_path_hint_t *path_hint;
+
+	/* The previous (more recently used) entry, where 0 represents none
+	 * The value contains the entry index + 1
+	 */
+	int previous_entry;
+
+	/* The next (less recently used) entry, where 0 represents none
+	 * The value contains the entry index + 1
+	 */
+	int next_entry;
+};
+
+typedef struct libfsntfs_path_hint_table libfsntfs_path_hint_table_t;
+
+struct libfsntfs_path_hint_table
+{
+	/* The entries, indexed by MFT entry index
+	 */
+	libfsntfs_path_hint_table_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of path hints
+	 */
+	int number_of_path_hints;
+
+	/* The maximum number of path hints, 0 represents no maximum
+	 */
+	int maximum_number_of_path_hints;
+
+	/* The most recently used entry, where 0 represents none
+	 * The value contains the entry index + 1
+	 */
+	int most_recently_used_entry;
+
+	/* The least recently used entry, where 0 represents none
+	 * The value contains the entry index + 1
+	 */
+	int least_recently_used_entry;
+};
+
+int libfsntfs_path_hint_table_initialize(
+     libfsntfs_path_hint_table_t **path_hint_table,
+     int number_of_entries,
+     int maximum_number_of_path_hints,
+     libcerror_error_t **error );
+
+int libfsntfs_path_hint_table_free(
+     libfsntfs_path_hint_table_t **path_hint_table,
+     libcerror_error_t **error );
+
+void libfsntfs_path_hint_table_unlink_entry(
+      libfsntfs_path_hint_table_t *path_hint_table,
+      int entry_index );
+
+void libfsntfs_path_hint_table_link_entry(
+      libfsntfs_path_hint_table_t *path_hint_table,
+      int entry_index );
+
+int libfsntfs_path_hint_table_remove_entry(
+     libfsntfs_path_hint_table_t *path_hint_table,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+     libfsntfs_path_hint_table_t *path_hint_table,
+     uint64_t file_reference,
+     libfsntfs_path_hint_t **path_hint,
+     libcerror_error_t **error );
+
+int libfsntfs_path_hint_table_set_path_hint(
+     libfsntfs_path_hint_table_t *path_hint_table,
+     libfsntfs_path_hint_t *path_hint,
+     libcerror_error_t **error );
+
+int libfsntfs_path_hint_table_set_maximum_number_of_path_hints(
+     libfsntfs_path_hint_table_t *path_hint_table,
+     int maximum_number_of_path_hints,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_PATH_HINT_TABLE_H ) */
+
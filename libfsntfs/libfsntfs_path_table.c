@@ -0,0 +1,1468 @@
+/*
+ * Path table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_file_name_values.h"
+#include "libfsntfs_file_system.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libuna.h"
+#include "libfsntfs_mft_attribute.h"
+#include "libfsntfs_mft_entry.h"
+#include "libfsntfs_path_table.h"
+
+/* Creates a path table
+ * Make sure the value path_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_table_initialize(
+     libfsntfs_path_table_t **path_table,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_table_t *internal_path_table = NULL;
+	static char *function                                = "libfsntfs_path_table_initialize";
+
+	if( path_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_table = memory_allocate_structure(
+	                       libfsntfs_internal_path_table_t );
+
+	if( internal_path_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_path_table,
+	     0,
+	     sizeof( libfsntfs_internal_path_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear path table.",
+		 function );
+
+		goto on_error;
+	}
+	*path_table = (libfsntfs_path_table_t *) internal_path_table;
+
+	return( 1 );
+
+on_error:
+	if( internal_path_table != NULL )
+	{
+		memory_free(
+		 internal_path_table );
+	}
+	return( -1 );
+}
+
+/* Frees a path table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_table_free(
+     libfsntfs_path_table_t **path_table,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_table_t *internal_path_table = NULL;
+	static char *function                                = "libfsntfs_path_table_free";
+
+	if( path_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_table != NULL )
+	{
+		internal_path_table = (libfsntfs_internal_path_table_t *) *path_table;
+		*path_table         = NULL;
+
+		if( internal_path_table->string_pool != NULL )
+		{
+			memory_free(
+			 internal_path_table->string_pool );
+		}
+		if( internal_path_table->path_offsets != NULL )
+		{
+			memory_free(
+			 internal_path_table->path_offsets );
+		}
+		memory_free(
+		 internal_path_table );
+	}
+	return( 1 );
+}
+
+/* Resizes a string pool to contain at least the required size
+ * The allocated size is doubled to limit the number of reallocations
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_table_resize_string_pool(
+     uint8_t **string_pool,
+     size_t *string_pool_allocated_size,
+     size_t required_size,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation = NULL;
+	static char *function = "libfsntfs_path_table_resize_string_pool";
+	size_t allocated_size = 0;
+
+	if( string_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_pool_allocated_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string pool allocated size.",
+		 function );
+
+		return( -1 );
+	}
+	if( required_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid required size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( required_size <= *string_pool_allocated_size )
+	{
+		return( 1 );
+	}
+	allocated_size = *string_pool_allocated_size;
+
+	if( allocated_size < LIBFSNTFS_PATH_TABLE_MINIMUM_STRING_POOL_SIZE )
+	{
+		allocated_size = LIBFSNTFS_PATH_TABLE_MINIMUM_STRING_POOL_SIZE;
+	}
+	while( allocated_size < required_size )
+	{
+		if( allocated_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / 2 ) )
+		{
+			allocated_size = (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE;
+
+			break;
+		}
+		allocated_size *= 2;
+	}
+	reallocation = (uint8_t *) memory_reallocate(
+	                            *string_pool,
+	                            sizeof( uint8_t ) * allocated_size );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize string pool.",
+		 function );
+
+		return( -1 );
+	}
+	*string_pool                = reallocation;
+	*string_pool_allocated_size = allocated_size;
+
+	return( 1 );
+}
+
+/* Reads the file names of the MFT entries
+ * The MFT entries are read sequentially, for every MFT entry the file reference,
+ * the parent file reference and the first non-DOS name are stored in the entries
+ * and the UTF-8 encoded name is added to the name pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_path_table_read_file_names(
+     libfsntfs_internal_path_table_t *internal_path_table,
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_path_table_entry_t *entries,
+     uint8_t **name_pool,
+     size_t *name_pool_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_file_name_values_t *file_name_values = NULL;
+	libfsntfs_mft_attribute_t *mft_attribute       = NULL;
+	libfsntfs_mft_entry_t *mft_entry               = NULL;
+	libfsntfs_path_table_entry_t *entry            = NULL;
+	static char *function                          = "libfsntfs_internal_path_table_read_file_names";
+	size_t name_pool_allocated_size                = 0;
+	size_t name_size                               = 0;
+	uint64_t base_record_file_reference            = 0;
+	uint64_t mft_entry_index                       = 0;
+	uint32_t attribute_type                        = 0;
+	int attribute_index                            = 0;
+	int number_of_attributes                       = 0;
+	int result                                     = 0;
+
+	if( internal_path_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path table.",
+		 function );
+
+		return( -1 );
+	}
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_pool_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name pool size.",
+		 function );
+
+		return( -1 );
+	}
+	name_pool_allocated_size = *name_pool_size;
+
+	for( mft_entry_index = 0;
+	     mft_entry_index < internal_path_table->number_of_entries;
+	     mft_entry_index++ )
+	{
+		entry = &( entries[ mft_entry_index ] );
+
+		/* The MFT entries are read in sequence so that they are served from the MFT read-ahead buffer
+		 */
+		if( libfsntfs_file_system_get_mft_entry_by_index_no_cache(
+		     file_system,
+		     file_io_handle,
+		     mft_entry_index,
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		result = libfsntfs_mft_entry_is_empty(
+		          mft_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if MFT entry: %" PRIu64 " is empty.",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			continue;
+		}
+		if( libfsntfs_mft_entry_get_base_record_file_reference(
+		     mft_entry,
+		     &base_record_file_reference,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve base record file reference of MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		if( base_record_file_reference != 0 )
+		{
+			continue;
+		}
+		if( libfsntfs_mft_entry_get_file_reference(
+		     mft_entry,
+		     &( entry->file_reference ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file reference of MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		result = libfsntfs_mft_entry_is_allocated(
+		          mft_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if MFT entry: %" PRIu64 " is allocated.",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		entry->is_allocated = (uint8_t) result;
+
+		if( libfsntfs_mft_entry_get_number_of_attributes(
+		     mft_entry,
+		     &number_of_attributes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of attributes of MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		for( attribute_index = 0;
+		     attribute_index < number_of_attributes;
+		     attribute_index++ )
+		{
+			if( libfsntfs_mft_entry_get_attribute_by_index(
+			     mft_entry,
+			     attribute_index,
+			     &mft_attribute,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute: %d.",
+				 function,
+				 attribute_index );
+
+				goto on_error;
+			}
+			if( libfsntfs_mft_attribute_get_type(
+			     mft_attribute,
+			     &attribute_type,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute: %d type.",
+				 function,
+				 attribute_index );
+
+				goto on_error;
+			}
+			if( attribute_type != LIBFSNTFS_ATTRIBUTE_TYPE_FILE_NAME )
+			{
+				continue;
+			}
+			if( libfsntfs_file_name_values_initialize(
+			     &file_name_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file name values.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfsntfs_file_name_values_read_from_mft_attribute(
+			     file_name_values,
+			     mft_attribute,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read file name values.",
+				 function );
+
+				goto on_error;
+			}
+			/* The path is based on the first non-DOS name, as the path hint
+			 */
+			if( file_name_values->name_space != LIBFSNTFS_FILE_NAME_SPACE_DOS )
+			{
+				if( libfsntfs_file_name_values_get_parent_file_reference(
+				     file_name_values,
+				     &( entry->parent_file_reference ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve parent file reference.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfsntfs_file_name_values_get_utf8_name_size(
+				     file_name_values,
+				     &name_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve size of UTF-8 name.",
+					 function );
+
+					goto on_error;
+				}
+				if( name_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE - *name_pool_size ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+					 "%s: invalid name size value exceeds maximum.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfsntfs_path_table_resize_string_pool(
+				     name_pool,
+				     &name_pool_allocated_size,
+				     *name_pool_size + name_size + 1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+					 "%s: unable to resize name pool.",
+					 function );
+
+					goto on_error;
+				}
+				if( name_size > 0 )
+				{
+					if( libfsntfs_file_name_values_get_utf8_name(
+					     file_name_values,
+					     &( ( *name_pool )[ *name_pool_size ] ),
+					     name_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve UTF-8 name.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				( *name_pool )[ *name_pool_size + name_size ] = 0;
+
+				entry->name_offset = *name_pool_size + 1;
+				entry->state       = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME;
+
+				*name_pool_size += name_size + 1;
+			}
+			if( libfsntfs_file_name_values_free(
+			     &file_name_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file name values.",
+				 function );
+
+				goto on_error;
+			}
+			if( entry->state == LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME )
+			{
+				break;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( file_name_values != NULL )
+	{
+		libfsntfs_file_name_values_free(
+		 &file_name_values,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Resolves the paths of the entries
+ * The path of a parent is resolved before that of its children and every path
+ * is resolved only once, children use the path of their parent from the string pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_path_table_resolve_paths(
+     libfsntfs_internal_path_table_t *internal_path_table,
+     libfsntfs_path_table_entry_t *entries,
+     const uint8_t *name_pool,
+     size_t name_pool_size,
+     libcerror_error_t **error )
+{
+	uint64_t mft_entry_index_stack[ LIBFSNTFS_MAXIMUM_RECURSION_DEPTH + 1 ];
+
+	libfsntfs_path_table_entry_t *entry        = NULL;
+	libfsntfs_path_table_entry_t *parent_entry = NULL;
+	const uint8_t *name                        = NULL;
+	const uint8_t *parent_path                 = NULL;
+	uint8_t *path                              = NULL;
+	static char *function                      = "libfsntfs_internal_path_table_resolve_paths";
+	size_t name_size                           = 0;
+	size_t parent_path_offset                  = 0;
+	size_t parent_path_size                    = 0;
+	size_t path_size                           = 0;
+	size_t string_pool_allocated_size          = 0;
+	uint64_t first_mft_entry_index             = 0;
+	uint64_t mft_entry_index                   = 0;
+	uint64_t parent_mft_entry_index            = 0;
+	uint16_t parent_sequence_number            = 0;
+	int stack_depth                            = 0;
+
+	if( internal_path_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path table.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_path_table->path_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid path table - missing path offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_pool == NULL )
+	 && ( name_pool_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name pool.",
+		 function );
+
+		return( -1 );
+	}
+	string_pool_allocated_size = internal_path_table->string_pool_size;
+
+	for( first_mft_entry_index = 0;
+	     first_mft_entry_index < internal_path_table->number_of_entries;
+	     first_mft_entry_index++ )
+	{
+		if( entries[ first_mft_entry_index ].state != LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME )
+		{
+			continue;
+		}
+		entries[ first_mft_entry_index ].state = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_RESOLVING;
+
+		mft_entry_index_stack[ 0 ] = first_mft_entry_index;
+		stack_depth                = 1;
+
+		while( stack_depth > 0 )
+		{
+			mft_entry_index        = mft_entry_index_stack[ stack_depth - 1 ];
+			entry                  = &( entries[ mft_entry_index ] );
+			parent_mft_entry_index = entry->parent_file_reference & 0xffffffffffffUL;
+
+			parent_path        = NULL;
+			parent_path_offset = 0;
+			parent_path_size   = 0;
+
+			if( ( mft_entry_index != LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY )
+			 && ( parent_mft_entry_index == LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY ) )
+			{
+				parent_path      = (uint8_t *) "";
+				parent_path_size = 1;
+			}
+			else if( ( parent_mft_entry_index != 0 )
+			      && ( parent_mft_entry_index != mft_entry_index ) )
+			{
+				parent_entry = NULL;
+
+				if( parent_mft_entry_index < internal_path_table->number_of_entries )
+				{
+					parent_entry = &( entries[ parent_mft_entry_index ] );
+
+					if( parent_entry->state == LIBFSNTFS_PATH_TABLE_ENTRY_STATE_UNUSED )
+					{
+						parent_entry = NULL;
+					}
+					else if( parent_entry->file_reference != entry->parent_file_reference )
+					{
+						/* The sequence number is updated when the MFT entry is deleted
+						 */
+						parent_sequence_number = (uint16_t) ( parent_entry->file_reference >> 48 );
+
+						if( ( parent_entry->is_allocated != 0 )
+						 || ( (uint16_t) ( entry->parent_file_reference >> 48 ) != (uint16_t) ( parent_sequence_number - 1 ) ) )
+						{
+							parent_entry = NULL;
+						}
+					}
+				}
+				/* A parent beyond the maximum recursion depth is not resolved
+				 * before its child, the child is stored as an orphan instead
+				 */
+				if( ( parent_entry != NULL )
+				 && ( parent_entry->state == LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME )
+				 && ( stack_depth <= LIBFSNTFS_MAXIMUM_RECURSION_DEPTH ) )
+				{
+					parent_entry->state = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_RESOLVING;
+
+					mft_entry_index_stack[ stack_depth++ ] = parent_mft_entry_index;
+
+					continue;
+				}
+				if( ( parent_entry != NULL )
+				 && ( parent_entry->state == LIBFSNTFS_PATH_TABLE_ENTRY_STATE_RESOLVED ) )
+				{
+					parent_path_offset = internal_path_table->path_offsets[ parent_mft_entry_index ];
+					parent_path_size   = 1 + narrow_string_length(
+					                          (char *) &( internal_path_table->string_pool[ parent_path_offset - 1 ] ) );
+				}
+				else
+				{
+					/* The parent is missing, has been reallocated, is part of a loop
+					 * or exceeds the maximum recursion depth
+					 */
+					parent_path      = (uint8_t *) "$Orphan";
+					parent_path_size = 8;
+				}
+			}
+			if( ( entry->name_offset == 0 )
+			 || ( entry->name_offset > name_pool_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid entry: %" PRIu64 " - name offset value out of bounds.",
+				 function,
+				 mft_entry_index );
+
+				return( -1 );
+			}
+			name      = &( name_pool[ entry->name_offset - 1 ] );
+			name_size = 1 + narrow_string_length(
+			                 (char *) name );
+
+			path_size = parent_path_size + name_size;
+
+			if( path_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE - internal_path_table->string_pool_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid path size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			if( libfsntfs_path_table_resize_string_pool(
+			     &( internal_path_table->string_pool ),
+			     &string_pool_allocated_size,
+			     internal_path_table->string_pool_size + path_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize string pool.",
+				 function );
+
+				return( -1 );
+			}
+			/* The parent path is retrieved after resizing since the string pool can be moved
+			 */
+			if( parent_path_offset != 0 )
+			{
+				parent_path = &( internal_path_table->string_pool[ parent_path_offset - 1 ] );
+			}
+			path = &( internal_path_table->string_pool[ internal_path_table->string_pool_size ] );
+
+			if( ( parent_path != NULL )
+			 && ( parent_path_size > 0 ) )
+			{
+				if( memory_copy(
+				     path,
+				     parent_path,
+				     parent_path_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy parent path to path.",
+					 function );
+
+					return( -1 );
+				}
+				path[ parent_path_size - 1 ] = '\\';
+			}
+			if( memory_copy(
+			     &( path[ parent_path_size ] ),
+			     name,
+			     name_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy name to path.",
+				 function );
+
+				return( -1 );
+			}
+			if( mft_entry_index == LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY )
+			{
+				path[ 0 ] = '\\';
+			}
+			internal_path_table->path_offsets[ mft_entry_index ] = internal_path_table->string_pool_size + 1;
+			internal_path_table->string_pool_size               += path_size;
+
+			entry->state = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_RESOLVED;
+
+			stack_depth--;
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the paths of all the MFT entries of the file system
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_path_table_read_file_system(
+     libfsntfs_internal_path_table_t *internal_path_table,
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfsntfs_path_table_entry_t *entries = NULL;
+	uint8_t *name_pool                    = NULL;
+	uint8_t *reallocation                 = NULL;
+	static char *function                 = "libfsntfs_internal_path_table_read_file_system";
+	size_t entries_size                   = 0;
+	size_t name_pool_size                 = 0;
+	size_t path_offsets_size              = 0;
+	uint64_t number_of_entries            = 0;
+
+	if( internal_path_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path table.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_path_table->path_offsets != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path table - path offsets value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_file_system_get_number_of_mft_entries(
+	     file_system,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_entries == 0 )
+	 || ( number_of_entries > ( (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsntfs_path_table_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of MFT entries value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	path_offsets_size = sizeof( size_t ) * (size_t) number_of_entries;
+
+	internal_path_table->path_offsets = (size_t *) memory_allocate(
+	                                                path_offsets_size );
+
+	if( internal_path_table->path_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path offsets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_path_table->path_offsets,
+	     0,
+	     path_offsets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear path offsets.",
+		 function );
+
+		goto on_error;
+	}
+	internal_path_table->number_of_entries = number_of_entries;
+
+	entries_size = sizeof( libfsntfs_path_table_entry_t ) * (size_t) number_of_entries;
+
+	entries = (libfsntfs_path_table_entry_t *) memory_allocate(
+	                                            entries_size );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_internal_path_table_read_file_names(
+	     internal_path_table,
+	     file_system,
+	     file_io_handle,
+	     entries,
+	     &name_pool,
+	     &name_pool_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file names.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_internal_path_table_resolve_paths(
+	     internal_path_table,
+	     entries,
+	     name_pool,
+	     name_pool_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve paths.",
+		 function );
+
+		goto on_error;
+	}
+	if( name_pool != NULL )
+	{
+		memory_free(
+		 name_pool );
+
+		name_pool = NULL;
+	}
+	memory_free(
+	 entries );
+
+	entries = NULL;
+
+	/* Release the unused part of the string pool
+	 */
+	if( internal_path_table->string_pool_size > 0 )
+	{
+		reallocation = (uint8_t *) memory_reallocate(
+		                            internal_path_table->string_pool,
+		                            sizeof( uint8_t ) * internal_path_table->string_pool_size );
+
+		if( reallocation != NULL )
+		{
+			internal_path_table->string_pool = reallocation;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( name_pool != NULL )
+	{
+		memory_free(
+		 name_pool );
+	}
+	if( entries != NULL )
+	{
+		memory_free(
+		 entries );
+	}
+	if( internal_path_table->string_pool != NULL )
+	{
+		memory_free(
+		 internal_path_table->string_pool );
+
+		internal_path_table->string_pool = NULL;
+	}
+	internal_path_table->string_pool_size = 0;
+
+	if( internal_path_table->path_offsets != NULL )
+	{
+		memory_free(
+		 internal_path_table->path_offsets );
+
+		internal_path_table->path_offsets = NULL;
+	}
+	internal_path_table->number_of_entries = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the number of entries
+ * The number of entries corresponds to the number of MFT entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_table_get_number_of_entries(
+     libfsntfs_path_table_t *path_table,
+     uint64_t *number_of_entries,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_table_t *internal_path_table = NULL;
+	static char *function                                = "libfsntfs_path_table_get_number_of_entries";
+
+	if( path_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path table.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_table = (libfsntfs_internal_path_table_t *) path_table;
+
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_entries = internal_path_table->number_of_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the UTF-8 encoded path of a specific MFT entry from the string pool
+ * The path size includes the end-of-string character
+ * Returns 1 if successful, 0 if the MFT entry has no path or -1 on error
+ */
+int libfsntfs_internal_path_table_get_path(
+     libfsntfs_internal_path_table_t *internal_path_table,
+     uint64_t mft_entry_index,
+     const uint8_t **path,
+     size_t *path_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_internal_path_table_get_path";
+	size_t path_offset    = 0;
+
+	if( internal_path_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path table.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_index >= internal_path_table->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path size.",
+		 function );
+
+		return( -1 );
+	}
+	path_offset = internal_path_table->path_offsets[ mft_entry_index ];
+
+	if( path_offset == 0 )
+	{
+		return( 0 );
+	}
+	if( path_offset > internal_path_table->string_pool_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*path      = &( internal_path_table->string_pool[ path_offset - 1 ] );
+	*path_size = 1 + narrow_string_length(
+	                  (char *) *path );
+
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-8 encoded path of a specific MFT entry
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if the MFT entry has no path or -1 on error
+ */
+int libfsntfs_path_table_get_utf8_path_size(
+     libfsntfs_path_table_t *path_table,
+     uint64_t mft_entry_index,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path   = NULL;
+	static char *function = "libfsntfs_path_table_get_utf8_path_size";
+	size_t path_size      = 0;
+	int result            = 0;
+
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_internal_path_table_get_path(
+	          (libfsntfs_internal_path_table_t *) path_table,
+	          mft_entry_index,
+	          &path,
+	          &path_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*utf8_string_size = path_size;
+	}
+	return( result );
+}
+
+/* Retrieves the UTF-8 encoded path of a specific MFT entry
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if the MFT entry has no path or -1 on error
+ */
+int libfsntfs_path_table_get_utf8_path(
+     libfsntfs_path_table_t *path_table,
+     uint64_t mft_entry_index,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path   = NULL;
+	static char *function = "libfsntfs_path_table_get_utf8_path";
+	size_t path_size      = 0;
+	int result            = 0;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_internal_path_table_get_path(
+	          (libfsntfs_internal_path_table_t *) path_table,
+	          mft_entry_index,
+	          &path,
+	          &path_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The paths in the string pool are stored UTF-8 encoded
+		 */
+		if( utf8_string_size < path_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: UTF-8 string too small.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     utf8_string,
+		     path,
+		     path_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy path to UTF-8 string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the size of the UTF-16 encoded path of a specific MFT entry
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if the MFT entry has no path or -1 on error
+ */
+int libfsntfs_path_table_get_utf16_path_size(
+     libfsntfs_path_table_t *path_table,
+     uint64_t mft_entry_index,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path   = NULL;
+	static char *function = "libfsntfs_path_table_get_utf16_path_size";
+	size_t path_size      = 0;
+	int result            = 0;
+
+	result = libfsntfs_internal_path_table_get_path(
+	          (libfsntfs_internal_path_table_t *) path_table,
+	          mft_entry_index,
+	          &path,
+	          &path_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libuna_utf16_string_size_from_utf8_stream(
+		     path,
+		     path_size,
+		     utf16_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve UTF-16 string size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the UTF-16 encoded path of a specific MFT entry
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if the MFT entry has no path or -1 on error
+ */
+int libfsntfs_path_table_get_utf16_path(
+     libfsntfs_path_table_t *path_table,
+     uint64_t mft_entry_index,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path   = NULL;
+	static char *function = "libfsntfs_path_table_get_utf16_path";
+	size_t path_size      = 0;
+	int result            = 0;
+
+	result = libfsntfs_internal_path_table_get_path(
+	          (libfsntfs_internal_path_table_t *) path_table,
+	          mft_entry_index,
+	          &path,
+	          &path_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libuna_utf16_string_copy_from_utf8_stream(
+		     utf16_string,
+		     utf16_string_size,
+		     path,
+		     path_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve UTF-16 string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
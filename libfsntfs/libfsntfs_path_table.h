@@ -0,0 +1,172 @@
+/*
+ * Path table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_PATH_TABLE_H )
+#define _LIBFSNTFS_PATH_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_extern.h"
+#include "libfsntfs_file_system.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_path_table_entry libfsntfs_path_table_entry_t;
+
+struct libfsntfs_path_table_entry
+{
+	/* The file reference
+	 */
+	uint64_t file_reference;
+
+	/* The parent file reference
+	 */
+	uint64_t parent_file_reference;
+
+	/* The offset of the name in the name pool + 1 or 0 if not set
+	 */
+	size_t name_offset;
+
+	/* The state
+	 */
+	uint8_t state;
+
+	/* Value to indicate the MFT entry is allocated
+	 */
+	uint8_t is_allocated;
+};
+
+typedef struct libfsntfs_internal_path_table libfsntfs_internal_path_table_t;
+
+struct libfsntfs_internal_path_table
+{
+	/* The number of entries
+	 */
+	uint64_t number_of_entries;
+
+	/* The path offsets
+	 * Each value contains the offset of the path in the string pool + 1
+	 * or 0 if the MFT entry has no path
+	 */
+	size_t *path_offsets;
+
+	/* The string pool
+	 * Contains the UTF-8 encoded paths including their end-of-string character
+	 */
+	uint8_t *string_pool;
+
+	/* The string pool size
+	 */
+	size_t string_pool_size;
+};
+
+int libfsntfs_path_table_initialize(
+     libfsntfs_path_table_t **path_table,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_table_free(
+     libfsntfs_path_table_t **path_table,
+     libcerror_error_t **error );
+
+int libfsntfs_path_table_resize_string_pool(
+     uint8_t **string_pool,
+     size_t *string_pool_allocated_size,
+     size_t required_size,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_table_read_file_names(
+     libfsntfs_internal_path_table_t *internal_path_table,
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_path_table_entry_t *entries,
+     uint8_t **name_pool,
+     size_t *name_pool_size,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_table_resolve_paths(
+     libfsntfs_internal_path_table_t *internal_path_table,
+     libfsntfs_path_table_entry_t *entries,
+     const uint8_t *name_pool,
+     size_t name_pool_size,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_table_read_file_system(
+     libfsntfs_internal_path_table_t *internal_path_table,
+     libfsntfs_file_system_t *file_system,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_table_get_number_of_entries(
+     libfsntfs_path_table_t *path_table,
+     uint64_t *number_of_entries,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_table_get_path(
+     libfsntfs_internal_path_table_t *internal_path_table,
+     uint64_t mft_entry_index,
+     const uint8_t **path,
+     size_t *path_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_table_get_utf8_path_size(
+     libfsntfs_path_table_t *path_table,
+     uint64_t mft_entry_index,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_table_get_utf8_path(
+     libfsntfs_path_table_t *path_table,
+     uint64_t mft_entry_index,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_table_get_utf16_path_size(
+     libfsntfs_path_table_t *path_table,
+     uint64_t mft_entry_index,
+     size_t *utf16_string_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_table_get_utf16_path(
+     libfsntfs_path_table_t *path_table,
+     uint64_t mft_entry_index,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_PATH_TABLE_H ) */
+
@@ -0,0 +1,1012 @@
+/*
+ * Read queue functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+#include "libfsntfs_read_queue.h"
+
+/* Creates a read queue
+ * Make sure the value read_queue is referencing, is set to NULL
+ * A queue depth of 1 reads directly from the file IO handle, a larger
+ * queue depth reads concurrently using a thread and file IO handle per read
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_read_queue_initialize(
+     libfsntfs_read_queue_t **read_queue,
+     libbfio_handle_t *file_io_handle,
+     int queue_depth,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_read_queue_initialize";
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	int handle_index      = 0;
+	int result            = 0;
+#endif
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth < 1 )
+	 || ( queue_depth > LIBFSNTFS_MAXIMUM_READ_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_queue = memory_allocate_structure(
+	               libfsntfs_read_queue_t );
+
+	if( *read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_queue,
+	     0,
+	     sizeof( libfsntfs_read_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read queue.",
+		 function );
+
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+
+		return( -1 );
+	}
+	( *read_queue )->read_requests = (libfsntfs_read_request_t *) memory_allocate(
+	                                                               sizeof( libfsntfs_read_request_t ) * queue_depth );
+
+	if( ( *read_queue )->read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *read_queue )->read_requests,
+	     0,
+	     sizeof( libfsntfs_read_request_t ) * queue_depth ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read requests.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_queue )->file_io_handle = file_io_handle;
+	( *read_queue )->queue_depth    = queue_depth;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( queue_depth > 1 )
+	{
+		( *read_queue )->file_io_handles = (libbfio_handle_t **) memory_allocate(
+		                                                          sizeof( libbfio_handle_t * ) * queue_depth );
+
+		if( ( *read_queue )->file_io_handles == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create file IO handles.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     ( *read_queue )->file_io_handles,
+		     0,
+		     sizeof( libbfio_handle_t * ) * queue_depth ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear file IO handles.",
+			 function );
+
+			memory_free(
+			 ( *read_queue )->file_io_handles );
+
+			( *read_queue )->file_io_handles = NULL;
+
+			goto on_error;
+		}
+		if( libcthreads_queue_initialize(
+		     &( ( *read_queue )->file_io_handles_queue ),
+		     queue_depth,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handles queue.",
+			 function );
+
+			goto on_error;
+		}
+		for( handle_index = 0;
+		     handle_index < queue_depth;
+		     handle_index++ )
+		{
+			if( libbfio_handle_clone(
+			     &( ( *read_queue )->file_io_handles[ handle_index ] ),
+			     file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file IO handle: %d.",
+				 function,
+				 handle_index );
+
+				goto on_error;
+			}
+			result = libbfio_handle_is_open(
+			          ( *read_queue )->file_io_handles[ handle_index ],
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if file IO handle: %d is open.",
+				 function,
+				 handle_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				if( libbfio_handle_open(
+				     ( *read_queue )->file_io_handles[ handle_index ],
+				     LIBBFIO_OPEN_READ,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_OPEN_FAILED,
+					 "%s: unable to open file IO handle: %d.",
+					 function,
+					 handle_index );
+
+					goto on_error;
+				}
+			}
+			if( libcthreads_queue_push(
+			     ( *read_queue )->file_io_handles_queue,
+			     (intptr_t *) ( *read_queue )->file_io_handles[ handle_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push file IO handle: %d onto queue.",
+				 function,
+				 handle_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_initialize(
+		     &( ( *read_queue )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( ( *read_queue )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( ( *read_queue )->thread_pool ),
+		     NULL,
+		     queue_depth,
+		     queue_depth,
+		     (int (*)(intptr_t *, void *)) &libfsntfs_read_queue_process_request,
+		     (void *) *read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+
+on_error:
+	if( *read_queue != NULL )
+	{
+		libfsntfs_read_queue_free(
+		 read_queue,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a read queue
+ * Read requests that are still queued are completed before the threads are joined
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_read_queue_free(
+     libfsntfs_read_queue_t **read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_read_queue_free";
+	int result            = 1;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	int handle_index      = 0;
+#endif
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		/* The file_io_handle reference is freed elsewhere
+		 */
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( ( *read_queue )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *read_queue )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_queue )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *read_queue )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_queue )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *read_queue )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_queue )->file_io_handles_queue != NULL )
+		{
+			/* The file IO handles in the queue are freed below
+			 */
+			if( libcthreads_queue_free(
+			     &( ( *read_queue )->file_io_handles_queue ),
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handles queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_queue )->file_io_handles != NULL )
+		{
+			for( handle_index = 0;
+			     handle_index < ( *read_queue )->queue_depth;
+			     handle_index++ )
+			{
+				if( ( *read_queue )->file_io_handles[ handle_index ] == NULL )
+				{
+					continue;
+				}
+				if( libbfio_handle_close(
+				     ( *read_queue )->file_io_handles[ handle_index ],
+				     error ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+					 "%s: unable to close file IO handle: %d.",
+					 function,
+					 handle_index );
+
+					result = -1;
+				}
+				if( libbfio_handle_free(
+				     &( ( *read_queue )->file_io_handles[ handle_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free file IO handle: %d.",
+					 function,
+					 handle_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *read_queue )->file_io_handles );
+		}
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+		if( ( *read_queue )->read_requests != NULL )
+		{
+			memory_free(
+			 ( *read_queue )->read_requests );
+		}
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+/* Processes a read request
+ * This function is called by the threads of the thread pool, the read
+ * request is always marked as completed, also when the read fails
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_read_queue_process_request(
+     libfsntfs_read_request_t *read_request,
+     libfsntfs_read_queue_t *read_queue )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	static char *function            = "libfsntfs_read_queue_process_request";
+	ssize_t read_count               = -1;
+	int result                       = 1;
+
+	if( read_request == NULL )
+	{
+		return( -1 );
+	}
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		result = -1;
+	}
+	else if( libcthreads_queue_pop(
+	          read_queue->file_io_handles_queue,
+	          (intptr_t **) &file_io_handle,
+	          &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop file IO handle from queue.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              read_request->buffer,
+		              read_request->buffer_size,
+		              read_request->offset,
+		              &error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_request->offset,
+			 read_request->offset );
+
+			result = -1;
+		}
+		if( libcthreads_queue_push(
+		     read_queue->file_io_handles_queue,
+		     (intptr_t *) file_io_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push file IO handle onto queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		read_count = -1;
+	}
+	if( read_queue == NULL )
+	{
+		read_request->error        = error;
+		read_request->read_count   = read_count;
+		read_request->is_completed = 1;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     NULL ) != 1 )
+	{
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		return( -1 );
+	}
+	read_request->error        = error;
+	read_request->read_count   = read_count;
+	read_request->is_completed = 1;
+
+	libcthreads_condition_broadcast(
+	 read_queue->condition,
+	 NULL );
+
+	libcthreads_mutex_release(
+	 read_queue->mutex,
+	 NULL );
+
+	/* The read request can be reused by the caller from here on
+	 */
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+/* Submits a read request
+ * The read request must remain valid until it has been waited for
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_read_queue_submit_request(
+     libfsntfs_read_queue_t *read_queue,
+     libfsntfs_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_read_queue_submit_request";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request - missing buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request->buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read request - buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	read_request->read_queue   = read_queue;
+	read_request->read_count   = 0;
+	read_request->error        = NULL;
+	read_request->is_completed = 0;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( read_queue->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     read_queue->thread_pool,
+		     (intptr_t *) read_request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push read request onto thread pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
+	/* Without a thread pool the read request is completed directly
+	 */
+	read_request->read_count = libbfio_handle_read_buffer_at_offset(
+	                            read_queue->file_io_handle,
+	                            read_request->buffer,
+	                            read_request->buffer_size,
+	                            read_request->offset,
+	                            &( read_request->error ) );
+
+	read_request->is_completed = 1;
+
+	return( 1 );
+}
+
+/* Waits for a read request to complete
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_read_queue_wait_for_request(
+         libfsntfs_read_queue_t *read_queue,
+         libfsntfs_read_request_t *read_request,
+         libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_read_queue_wait_for_request";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request->read_queue != read_queue )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request - not submitted to read queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( read_queue->thread_pool != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     read_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( read_request->is_completed == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     read_queue->condition,
+			     read_queue->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 read_queue->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( libcthreads_mutex_release(
+		     read_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	read_request->read_queue = NULL;
+
+	if( read_request->read_count < 0 )
+	{
+		/* Pass the error of the read request on to the caller
+		 */
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error = read_request->error;
+
+			read_request->error = NULL;
+		}
+		else if( read_request->error != NULL )
+		{
+			libcerror_error_free(
+			 &( read_request->error ) );
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 read_request->offset,
+		 read_request->offset );
+
+		return( -1 );
+	}
+	return( read_request->read_count );
+}
+
+/* Reads a buffer at a specific offset
+ * Large reads are split into parts that are read concurrently, one part
+ * per thread up to the queue depth
+ * This function is not reentrant, the read requests of the read queue are reused
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_read_queue_read_buffer_at_offset(
+         libfsntfs_read_queue_t *read_queue,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfsntfs_read_request_t *read_request = NULL;
+	static char *function                  = "libfsntfs_read_queue_read_buffer_at_offset";
+	size_t buffer_offset                   = 0;
+	size_t request_size                    = 0;
+	ssize_t read_count                     = 0;
+	ssize_t total_read_count               = 0;
+	int number_of_requests                 = 0;
+	int request_index                      = 0;
+	int result                             = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_queue->queue_depth <= 1 )
+	 || ( buffer_size < ( 2 * LIBFSNTFS_READ_QUEUE_MINIMUM_READ_SIZE ) ) )
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              read_queue->file_io_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	request_size = buffer_size / read_queue->queue_depth;
+
+	if( ( buffer_size % read_queue->queue_depth ) != 0 )
+	{
+		request_size += 1;
+	}
+	if( request_size < LIBFSNTFS_READ_QUEUE_MINIMUM_READ_SIZE )
+	{
+		request_size = LIBFSNTFS_READ_QUEUE_MINIMUM_READ_SIZE;
+	}
+	while( buffer_offset < buffer_size )
+	{
+		read_request = &( read_queue->read_requests[ number_of_requests ] );
+
+		read_request->offset      = offset + (off64_t) buffer_offset;
+		read_request->buffer      = &( buffer[ buffer_offset ] );
+		read_request->buffer_size = request_size;
+
+		if( read_request->buffer_size > ( buffer_size - buffer_offset ) )
+		{
+			read_request->buffer_size = buffer_size - buffer_offset;
+		}
+		if( libfsntfs_read_queue_submit_request(
+		     read_queue,
+		     read_request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to submit read request: %d.",
+			 function,
+			 number_of_requests );
+
+			result = -1;
+
+			break;
+		}
+		buffer_offset += read_request->buffer_size;
+
+		number_of_requests++;
+	}
+	/* All submitted read requests are waited for, also after an error,
+	 * since they reference the buffer
+	 */
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		read_request = &( read_queue->read_requests[ request_index ] );
+
+		if( result != 1 )
+		{
+			libfsntfs_read_queue_wait_for_request(
+			 read_queue,
+			 read_request,
+			 NULL );
+
+			continue;
+		}
+		read_count = libfsntfs_read_queue_wait_for_request(
+		              read_queue,
+		              read_request,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read request: %d.",
+			 function,
+			 request_index );
+
+			result = -1;
+		}
+		else if( total_read_count == ( read_request->offset - offset ) )
+		{
+			/* Only count data that directly follows the previous part,
+			 * a short read ends the data
+			 */
+			total_read_count += read_count;
+		}
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( total_read_count );
+}
+
@@ -0,0 +1,148 @@
+/*
+ * Read queue functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_READ_QUEUE_H )
+#define _LIBFSNTFS_READ_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_read_queue libfsntfs_read_queue_t;
+
+typedef struct libfsntfs_read_request libfsntfs_read_request_t;
+
+struct libfsntfs_read_request
+{
+	/* The read queue
+	 */
+	libfsntfs_read_queue_t *read_queue;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The number of bytes read or -1 on error
+	 */
+	ssize_t read_count;
+
+	/* The read error
+	 */
+	libcerror_error_t *error;
+
+	/* Value to indicate the request was completed
+	 */
+	uint8_t is_completed;
+};
+
+struct libfsntfs_read_queue
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The queue depth
+	 */
+	int queue_depth;
+
+	/* The read requests
+	 */
+	libfsntfs_read_request_t *read_requests;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	/* The file IO handles, clones of the file IO handle, one per thread
+	 */
+	libbfio_handle_t **file_io_handles;
+
+	/* The queue of file IO handles that are not in use
+	 */
+	libcthreads_queue_t *file_io_handles_queue;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that protects the completion of the read requests
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a read request completes
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libfsntfs_read_queue_initialize(
+     libfsntfs_read_queue_t **read_queue,
+     libbfio_handle_t *file_io_handle,
+     int queue_depth,
+     libcerror_error_t **error );
+
+int libfsntfs_read_queue_free(
+     libfsntfs_read_queue_t **read_queue,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+int libfsntfs_read_queue_process_request(
+     libfsntfs_read_request_t *read_request,
+     libfsntfs_read_queue_t *read_queue );
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+int libfsntfs_read_queue_submit_request(
+     libfsntfs_read_queue_t *read_queue,
+     libfsntfs_read_request_t *read_request,
+     libcerror_error_t **error );
+
+ssize_t libfsntfs_read_queue_wait_for_request(
+         libfsntfs_read_queue_t *read_queue,
+         libfsntfs_read_request_t *read_request,
+         libcerror_error_t **error );
+
+ssize_t libfsntfs_read_queue_read_buffer_at_offset(
+         libfsntfs_read_queue_t *read_queue,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_READ_QUEUE_H ) */
+
@@ -33,6 +33,8 @@
 #include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcnotify.h"
+#include "libfsntfs_libfcache.h"
+#include "libfsntfs_metadata_cache.h"
 #include "libfsntfs_mft_attribute.h"
 #include "libfsntfs_mft_entry.h"
 #include "libfsntfs_security_descriptor_index.h"
@@ -348,6 +350,243 @@ on_error:
 	return( -1 );
 }
 
+/* Reads the security descriptor values from the $SDS data stream
+ * This function creates new security descriptor values
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_security_descriptor_index_read_security_descriptor_values(
+     libfsntfs_security_descriptor_index_t *security_descriptor_index,
+     uint64_t data_offset,
+     uint64_t data_size,
+     libfsntfs_security_descriptor_values_t **security_descriptor_values,
+     libcerror_error_t **error )
+{
+	uint8_t secure_index_value_data[ sizeof( fsntfs_secure_index_value_t ) ];
+
+	libfsntfs_sds_index_value_t *sds_index_value                            = NULL;
+	libfsntfs_security_descriptor_values_t *safe_security_descriptor_values = NULL;
+	static char *function                                                   = "libfsntfs_security_descriptor_index_read_security_descriptor_values";
+	size_t security_descriptor_data_size                                    = 0;
+	ssize_t read_count                                                      = 0;
+
+	if( security_descriptor_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid security descriptor index.",
+		 function );
+
+		return( -1 );
+	}
+	if( security_descriptor_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid security descriptor values.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < (uint64_t) ( sizeof( fsntfs_secure_index_value_t ) + 20 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported security descriptor stream ($SDS) data size: %" PRIu64 "\n",
+		 function,
+		 data_size );
+
+		return( -1 );
+	}
+	read_count = libfsntfs_data_stream_read_buffer_at_offset(
+	              security_descriptor_index->data_stream,
+	              secure_index_value_data,
+	              sizeof( fsntfs_secure_index_value_t ),
+	              (off64_t) data_offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read security descriptor stream ($SDS) data at offset: 0x%08" PRIx64 ".",
+		 function,
+		 data_offset );
+
+		goto on_error;
+	}
+	if( libfsntfs_sds_index_value_initialize(
+	     &sds_index_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create $SDS index value.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_sds_index_value_read_data(
+	     sds_index_value,
+	     secure_index_value_data,
+	     sizeof( fsntfs_secure_index_value_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read $SDS index value data.",
+		 function );
+
+		goto on_error;
+	}
+/* TODO check index values against secure_index_value */
+
+	if( libfsntfs_sds_index_value_free(
+	     &sds_index_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free $SDS index value.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_security_descriptor_values_initialize(
+	     &safe_security_descriptor_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create security descriptor values.",
+		 function );
+
+		goto on_error;
+	}
+	security_descriptor_data_size = (size_t) ( data_size - sizeof( fsntfs_secure_index_value_t ) );
+
+	if( ( security_descriptor_data_size == 0 )
+	 || ( security_descriptor_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid security descriptor values data value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	safe_security_descriptor_values->data = memory_allocate(
+	                                         sizeof( uint8_t ) * security_descriptor_data_size );
+
+	if( safe_security_descriptor_values->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create security descriptor values data.",
+		 function );
+
+		goto on_error;
+	}
+	safe_security_descriptor_values->data_size = security_descriptor_data_size;
+
+	if( memory_set(
+	     safe_security_descriptor_values->data,
+	     0,
+	     sizeof( uint8_t ) * safe_security_descriptor_values->data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear security descriptor data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libfsntfs_data_stream_read_buffer_at_offset(
+	              security_descriptor_index->data_stream,
+	              safe_security_descriptor_values->data,
+	              safe_security_descriptor_values->data_size,
+	              (off64_t) ( data_offset + sizeof( fsntfs_secure_index_value_t ) ),
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read security descriptor data at offset: 0x%08" PRIx64 ".",
+		 function,
+		 data_offset );
+
+		goto on_error;
+	}
+	if( libfsntfs_security_descriptor_values_read_data(
+	     safe_security_descriptor_values,
+	     safe_security_descriptor_values->data,
+	     safe_security_descriptor_values->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read security descriptor values.",
+		 function );
+
+		goto on_error;
+	}
+	*security_descriptor_values = safe_security_descriptor_values;
+
+	return( 1 );
+
+on_error:
+	if( safe_security_descriptor_values != NULL )
+	{
+		libfsntfs_security_descriptor_values_free(
+		 &safe_security_descriptor_values,
+		 NULL );
+	}
+	if( sds_index_value != NULL )
+	{
+		libfsntfs_sds_index_value_free(
+		 &sds_index_value,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Retrieves the security descriptor from an index node for a specific identifier
  * This function creates new security descriptor values
  * Returns 1 if successful, 0 if no such security descriptor or -1 on error
@@ -361,16 +600,10 @@ int libfsntfs_security_descriptor_index_get_entry_from_index_node_by_identifier(
      int recursion_depth,
      libcerror_error_t **error )
 {
-	uint8_t secure_index_value_data[ sizeof( fsntfs_secure_index_value_t ) ];
-
 	libfsntfs_index_node_t *sub_node                                             = NULL;
 	libfsntfs_index_value_t *index_value                                         = NULL;
-	libfsntfs_sds_index_value_t *sds_index_value                                 = NULL;
 	libfsntfs_security_descriptor_index_value_t *security_descriptor_index_value = NULL;
-	libfsntfs_security_descriptor_values_t *safe_security_descriptor_values      = NULL;
 	static char *function                                                        = "libfsntfs_security_descriptor_index_get_entry_from_index_node_by_identifier";
-	size_t security_descriptor_data_size                                         = 0;
-	ssize_t read_count                                                           = 0;
 	off64_t index_entry_offset                                                   = 0;
 	int compare_result                                                           = 0;
 	int index_value_entry                                                        = 0;
@@ -578,160 +811,35 @@ int libfsntfs_security_descriptor_index_get_entry_from_index_node_by_identifier(
 	}
 	if( compare_result == LIBCDATA_COMPARE_EQUAL )
 	{
-		if( security_descriptor_index_value->data_size < (size64_t) ( sizeof( fsntfs_secure_index_value_t ) + 20 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported security descriptor stream ($SDS) data size: %" PRIu64 "\n",
-			 function,
-			 security_descriptor_index_value->data_size );
-
-			return( -1 );
-		}
-		read_count = libfsntfs_data_stream_read_buffer_at_offset(
-		              security_descriptor_index->data_stream,
-		              secure_index_value_data,
-		              sizeof( fsntfs_secure_index_value_t ),
-		              (off64_t) security_descriptor_index_value->data_offset,
-		              error );
-
-		if( read_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read security descriptor stream ($SDS) data at offset: 0x%08" PRIx64 ".",
-			 function,
-			 security_descriptor_index_value->data_offset );
-
-			goto on_error;
-		}
-		if( libfsntfs_sds_index_value_initialize(
-		     &sds_index_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create $SDS index value.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsntfs_sds_index_value_read_data(
-		     sds_index_value,
-		     secure_index_value_data,
-		     sizeof( fsntfs_secure_index_value_t ),
+		if( libfsntfs_security_descriptor_index_read_security_descriptor_values(
+		     security_descriptor_index,
+		     security_descriptor_index_value->data_offset,
+		     security_descriptor_index_value->data_size,
+		     security_descriptor_values,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read $SDS index value data.",
+			 "%s: unable to read security descriptor values.",
 			 function );
 
 			goto on_error;
 		}
-/* TODO check index values against secure_index_value */
-
-		if( libfsntfs_security_descriptor_values_initialize(
-		     &safe_security_descriptor_values,
+		if( libfsntfs_security_descriptor_index_value_free(
+		     &security_descriptor_index_value,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create security descriptor values.",
-			 function );
-
-			goto on_error;
-		}
-		security_descriptor_data_size = (size_t) ( security_descriptor_index_value->data_size - sizeof( fsntfs_secure_index_value_t ) );
-
-		if( ( security_descriptor_data_size == 0 )
-		 || ( security_descriptor_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid security descriptor values data value out of bounds.",
-			 function,
-			 index_value_entry );
-
-			goto on_error;
-		}
-		safe_security_descriptor_values->data = memory_allocate(
-		                                         sizeof( uint8_t ) * security_descriptor_data_size );
-
-		if( safe_security_descriptor_values->data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create security descriptor values data.",
-			 function );
-
-			goto on_error;
-		}
-		safe_security_descriptor_values->data_size = security_descriptor_data_size;
-
-		if( memory_set(
-		     safe_security_descriptor_values->data,
-		     0,
-		     sizeof( uint8_t ) * safe_security_descriptor_values->data_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear security descriptor data.",
-			 function );
-
-			goto on_error;
-		}
-		read_count = libfsntfs_data_stream_read_buffer(
-		              security_descriptor_index->data_stream,
-		              safe_security_descriptor_values->data,
-		              safe_security_descriptor_values->data_size,
-		              error );
-
-		if( read_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read security descriptor data at offset: 0x%08" PRIx64 ".",
-			 function,
-			 security_descriptor_index_value->data_offset );
-
-			goto on_error;
-		}
-		if( libfsntfs_security_descriptor_values_read_data(
-		     safe_security_descriptor_values,
-		     safe_security_descriptor_values->data,
-		     safe_security_descriptor_values->data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read security descriptor values.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free security descriptor index value.",
 			 function );
 
 			goto on_error;
 		}
-		*security_descriptor_values = safe_security_descriptor_values;
-
 		result = 1;
 	}
 	else if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
@@ -784,12 +892,6 @@ int libfsntfs_security_descriptor_index_get_entry_from_index_node_by_identifier(
 	return( result );
 
 on_error:
-	if( safe_security_descriptor_values != NULL )
-	{
-		libfsntfs_security_descriptor_values_free(
-		 &safe_security_descriptor_values,
-		 NULL );
-	}
 	if( security_descriptor_index_value != NULL )
 	{
 		libfsntfs_security_descriptor_index_value_free(
@@ -847,3 +949,344 @@ int libfsntfs_security_descriptor_index_get_entry_by_identifier(
 	return( result );
 }
 
+
+/* Appends the security descriptor mappings of an index node to the metadata cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_security_descriptor_index_append_to_metadata_cache_from_index_node(
+     libfsntfs_security_descriptor_index_t *security_descriptor_index,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_index_node_t *index_node,
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int recursion_depth,
+     libcerror_error_t **error )
+{
+	libfcache_cache_t *sub_node_cache                                            = NULL;
+	libfsntfs_index_node_t *sub_node                                             = NULL;
+	libfsntfs_index_value_t *index_value                                         = NULL;
+	libfsntfs_security_descriptor_index_value_t *security_descriptor_index_value = NULL;
+	static char *function                                                        = "libfsntfs_security_descriptor_index_append_to_metadata_cache_from_index_node";
+	off64_t index_entry_offset                                                   = 0;
+	int index_value_entry                                                        = 0;
+	int is_allocated                                                             = 0;
+	int number_of_index_values                                                   = 0;
+
+	if( security_descriptor_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid security descriptor index.",
+		 function );
+
+		return( -1 );
+	}
+	if( security_descriptor_index->sii_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid security descriptor index - missing $SII index.",
+		 function );
+
+		return( -1 );
+	}
+	if( security_descriptor_index->sii_index->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid security descriptor index - invalid $SII index - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBFSNTFS_MAXIMUM_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_index_node_get_number_of_values(
+	     index_node,
+	     &number_of_index_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of values from index node.",
+		 function );
+
+		goto on_error;
+	}
+	/* Use a local cache to prevent cache invalidation of index node
+	 * when reading sub nodes.
+	 */
+	if( libfcache_cache_initialize(
+	     &sub_node_cache,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub node cache.",
+		 function );
+
+		goto on_error;
+	}
+	for( index_value_entry = 0;
+	     index_value_entry < number_of_index_values;
+	     index_value_entry++ )
+	{
+		if( libfsntfs_index_node_get_value_by_index(
+		     index_node,
+		     index_value_entry,
+		     &index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value: %d from index node.",
+			 function,
+			 index_value_entry );
+
+			goto on_error;
+		}
+		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
+		{
+			if( index_value->sub_node_vcn > (uint64_t) INT_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: node index value: %d sub node VCN value out of bounds.",
+				 function,
+				 index_value_entry );
+
+				goto on_error;
+			}
+			is_allocated = libfsntfs_index_sub_node_is_allocated(
+			                security_descriptor_index->sii_index,
+			                (int) index_value->sub_node_vcn,
+			                error );
+
+			if( is_allocated == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if sub node with VCN: %d is allocated.",
+				 function,
+				 (int) index_value->sub_node_vcn );
+
+				goto on_error;
+			}
+			else if( is_allocated != 0 )
+			{
+				index_entry_offset = (off64_t) ( index_value->sub_node_vcn * security_descriptor_index->sii_index->io_handle->cluster_block_size );
+
+				if( libfsntfs_index_get_sub_node(
+				     security_descriptor_index->sii_index,
+				     file_io_handle,
+				     sub_node_cache,
+				     index_entry_offset,
+				     (int) index_value->sub_node_vcn,
+				     &sub_node,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve sub node with VCN: %d at offset: 0x%08" PRIx64 ".",
+					 function,
+					 (int) index_value->sub_node_vcn,
+					 index_entry_offset );
+
+					goto on_error;
+				}
+				if( libfsntfs_security_descriptor_index_append_to_metadata_cache_from_index_node(
+				     security_descriptor_index,
+				     file_io_handle,
+				     sub_node,
+				     metadata_cache,
+				     recursion_depth + 1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append security descriptor mappings from index entry with VCN: %d at offset: 0x%08" PRIx64 " to metadata cache.",
+					 function,
+					 (int) index_value->sub_node_vcn,
+					 index_entry_offset );
+
+					goto on_error;
+				}
+			}
+		}
+		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_IS_LAST ) != 0 )
+		{
+			break;
+		}
+		if( libfsntfs_security_descriptor_index_value_initialize(
+		     &security_descriptor_index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create security descriptor index value.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_security_descriptor_index_value_read_data(
+		     security_descriptor_index_value,
+		     index_value->value_data,
+		     (size_t) index_value->value_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read security descriptor index value.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_metadata_cache_append_security_descriptor_mapping(
+		     metadata_cache,
+		     security_descriptor_index_value->identifier,
+		     security_descriptor_index_value->data_offset,
+		     security_descriptor_index_value->data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append security descriptor mapping: %" PRIu32 " to metadata cache.",
+			 function,
+			 security_descriptor_index_value->identifier );
+
+			goto on_error;
+		}
+		if( libfsntfs_security_descriptor_index_value_free(
+		     &security_descriptor_index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free security descriptor index value.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfcache_cache_free(
+	     &sub_node_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sub node cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( security_descriptor_index_value != NULL )
+	{
+		libfsntfs_security_descriptor_index_value_free(
+		 &security_descriptor_index_value,
+		 NULL );
+	}
+	if( sub_node_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sub_node_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends the security descriptor mappings of the $SII index to the metadata cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_security_descriptor_index_append_to_metadata_cache(
+     libfsntfs_security_descriptor_index_t *security_descriptor_index,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_security_descriptor_index_append_to_metadata_cache";
+
+	if( security_descriptor_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid security descriptor index.",
+		 function );
+
+		return( -1 );
+	}
+	if( security_descriptor_index->sii_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid security descriptor index - missing $SII index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_security_descriptor_index_append_to_metadata_cache_from_index_node(
+	     security_descriptor_index,
+	     file_io_handle,
+	     security_descriptor_index->sii_index->root_node,
+	     metadata_cache,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append security descriptor mappings to metadata cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -31,6 +31,7 @@
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_metadata_cache.h"
 #include "libfsntfs_mft_attribute.h"
 #include "libfsntfs_mft_entry.h"
 #include "libfsntfs_security_descriptor_values.h"
@@ -70,6 +71,13 @@ int libfsntfs_security_descriptor_index_read_sii_index(
      libfsntfs_mft_entry_t *mft_entry,
      libcerror_error_t **error );
 
+int libfsntfs_security_descriptor_index_read_security_descriptor_values(
+     libfsntfs_security_descriptor_index_t *security_descriptor_index,
+     uint64_t data_offset,
+     uint64_t data_size,
+     libfsntfs_security_descriptor_values_t **security_descriptor_values,
+     libcerror_error_t **error );
+
 int libfsntfs_security_descriptor_index_get_entry_from_index_node_by_identifier(
      libfsntfs_security_descriptor_index_t *security_descriptor_index,
      libbfio_handle_t *file_io_handle,
@@ -86,6 +94,20 @@ int libfsntfs_security_descriptor_index_get_entry_by_identifier(
      libfsntfs_security_descriptor_values_t **security_descriptor_values,
      libcerror_error_t **error );
 
+int libfsntfs_security_descriptor_index_append_to_metadata_cache_from_index_node(
+     libfsntfs_security_descriptor_index_t *security_descriptor_index,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_index_node_t *index_node,
+     libfsntfs_metadata_cache_t *metadata_cache,
+     int recursion_depth,
+     libcerror_error_t **error );
+
+int libfsntfs_security_descriptor_index_append_to_metadata_cache(
+     libfsntfs_security_descriptor_index_t *security_descriptor_index,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_metadata_cache_t *metadata_cache,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
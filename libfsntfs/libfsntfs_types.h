@@ -39,6 +39,7 @@ typedef struct libfsntfs_attribute_list_entry {}	libfsntfs_attribute_list_entry_
 typedef struct libfsntfs_data_stream {}			libfsntfs_data_stream_t;
 typedef struct libfsntfs_file_entry {}			libfsntfs_file_entry_t;
 typedef struct libfsntfs_mft_metadata_file {}		libfsntfs_mft_metadata_file_t;
+typedef struct libfsntfs_path_table {}			libfsntfs_path_table_t;
 typedef struct libfsntfs_usn_change_journal {}		libfsntfs_usn_change_journal_t;
 typedef struct libfsntfs_volume {}			libfsntfs_volume_t;
 
@@ -48,6 +49,7 @@ typedef intptr_t libfsntfs_attribute_list_entry_t;
 typedef intptr_t libfsntfs_data_stream_t;
 typedef intptr_t libfsntfs_file_entry_t;
 typedef intptr_t libfsntfs_mft_metadata_file_t;
+typedef intptr_t libfsntfs_path_table_t;
 typedef intptr_t libfsntfs_usn_change_journal_t;
 typedef intptr_t libfsntfs_volume_t;
 
@@ -0,0 +1,218 @@
+/*
+ * Upper case table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_upcase_table.h"
+
+/* Creates an upper case table
+ * Make sure the value upcase_table is referencing, is set to NULL
+ * The table initially only maps the ASCII lower case characters
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_upcase_table_initialize(
+     libfsntfs_upcase_table_t **upcase_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_upcase_table_initialize";
+	uint32_t value_index  = 0;
+
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upper case table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *upcase_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid upper case table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*upcase_table = memory_allocate_structure(
+	                 libfsntfs_upcase_table_t );
+
+	if( *upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create upper case table.",
+		 function );
+
+		goto on_error;
+	}
+	for( value_index = 0;
+	     value_index < LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		( *upcase_table )->values[ value_index ] = (uint16_t) value_index;
+	}
+	for( value_index = (uint32_t) 'a';
+	     value_index <= (uint32_t) 'z';
+	     value_index++ )
+	{
+		( *upcase_table )->values[ value_index ] = (uint16_t) ( value_index - 0x20 );
+	}
+	return( 1 );
+
+on_error:
+	if( *upcase_table != NULL )
+	{
+		memory_free(
+		 *upcase_table );
+
+		*upcase_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an upper case table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_upcase_table_free(
+     libfsntfs_upcase_table_t **upcase_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_upcase_table_free";
+
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upper case table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *upcase_table != NULL )
+	{
+		memory_free(
+		 *upcase_table );
+
+		*upcase_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads (part of) the upper case table from $UpCase data
+ * The data offset contains the offset of the data relative to the start of the $UpCase data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_upcase_table_read_data(
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *data,
+     size_t data_size,
+     size_t data_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_upcase_table_read_data";
+	size_t read_offset    = 0;
+	size_t read_size      = 0;
+	size_t value_index    = 0;
+
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upper case table.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_offset % 2 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported data offset value not a multitude of 2.",
+		 function );
+
+		return( -1 );
+	}
+	/* Data beyond the 65536 values of the table is ignored
+	 */
+	if( data_offset >= ( LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_VALUES * 2 ) )
+	{
+		return( 1 );
+	}
+	read_size = ( LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_VALUES * 2 ) - data_offset;
+
+	if( read_size > data_size )
+	{
+		read_size = data_size;
+	}
+	value_index = data_offset / 2;
+
+	while( ( read_offset + 2 ) <= read_size )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 &( data[ read_offset ] ),
+		 upcase_table->values[ value_index ] );
+
+		read_offset += 2;
+		value_index += 1;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,65 @@
+/*
+ * Upper case table functions
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_UPCASE_TABLE_H )
+#define _LIBFSNTFS_UPCASE_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_VALUES		65536
+
+typedef struct libfsntfs_upcase_table libfsntfs_upcase_table_t;
+
+struct libfsntfs_upcase_table
+{
+	/* The upper case values of the UCS-2 characters
+	 */
+	uint16_t values[ LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_VALUES ];
+};
+
+int libfsntfs_upcase_table_initialize(
+     libfsntfs_upcase_table_t **upcase_table,
+     libcerror_error_t **error );
+
+int libfsntfs_upcase_table_free(
+     libfsntfs_upcase_table_t **upcase_table,
+     libcerror_error_t **error );
+
+int libfsntfs_upcase_table_read_data(
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *data,
+     size_t data_size,
+     size_t data_offset,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSNTFS_UPCASE_TABLE_H ) */
+
@@ -25,11 +25,14 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libfsntfs_async_reader.h"
 #include "libfsntfs_attribute.h"
+#include "libfsntfs_cluster_allocation_map.h"
 #include "libfsntfs_debug.h"
 #include "libfsntfs_definitions.h"
 #include "libfsntfs_directory_entries_tree.h"
 #include "libfsntfs_directory_entry.h"
+#include "libfsntfs_extraction_scheduler.h"
 #include "libfsntfs_file_entry.h"
 #include "libfsntfs_file_name_values.h"
 #include "libfsntfs_file_system.h"
@@ -39,7 +42,13 @@
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
 #include "libfsntfs_libuna.h"
+#include "libfsntfs_memory_map.h"
+#include "libfsntfs_metadata_cache.h"
 #include "libfsntfs_mft_entry.h"
+#include "libfsntfs_mft_scan_worker.h"
+#include "libfsntfs_path_component_cache.h"
+#include "libfsntfs_path_table.h"
+#include "libfsntfs_read_queue.h"
 #include "libfsntfs_usn_change_journal.h"
 #include "libfsntfs_volume.h"
 #include "libfsntfs_volume_header.h"
@@ -229,6 +238,18 @@ int libfsntfs_volume_free(
 
 			result = -1;
 		}
+		if( internal_volume->metadata_cache_filename != NULL )
+		{
+			memory_free(
+			 internal_volume->metadata_cache_filename );
+		}
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+		if( internal_volume->metadata_cache_filename_wide != NULL )
+		{
+			memory_free(
+			 internal_volume->metadata_cache_filename_wide );
+		}
+#endif
 		memory_free(
 		 internal_volume );
 	}
@@ -441,20 +462,19 @@ on_error:
 	return( -1 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Opens a volume
+/* Opens a volume using a read-only memory mapping of the file or device
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_open_wide(
+int libfsntfs_volume_open_mapped(
      libfsntfs_volume_t *volume,
-     const wchar_t *filename,
+     const char *filename,
      int access_flags,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle             = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_open_wide";
+	libfsntfs_memory_map_t *memory_map           = NULL;
+	static char *function                        = "libfsntfs_volume_open_mapped";
 
 	if( volume == NULL )
 	{
@@ -469,6 +489,17 @@ int libfsntfs_volume_open_wide(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
+	if( internal_volume->memory_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - memory map value already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( filename == NULL )
 	{
 		libcerror_error_set(
@@ -503,7 +534,37 @@ int libfsntfs_volume_open_wide(
 
 		return( -1 );
 	}
-	if( libbfio_file_initialize(
+	if( libfsntfs_memory_map_initialize(
+	     &memory_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory map.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_memory_map_open(
+	     memory_map,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open memory map: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	/* The memory range IO handle reads directly from the mapping
+	 */
+	if( libbfio_memory_range_initialize(
 	     &file_io_handle,
 	     error ) != 1 )
 	{
@@ -532,18 +593,17 @@ int libfsntfs_volume_open_wide(
 		goto on_error;
 	}
 #endif
-	if( libbfio_file_set_name_wide(
+	if( libbfio_memory_range_set(
 	     file_io_handle,
-	     filename,
-	     wide_string_length(
-	      filename ) + 1,
+	     memory_map->data,
+	     (size_t) memory_map->data_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set filename in file IO handle.",
+		 "%s: unable to set memory range in file IO handle.",
 		 function );
 
 		goto on_error;
@@ -558,7 +618,7 @@ int libfsntfs_volume_open_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open volume: %ls.",
+		 "%s: unable to open volume: %s.",
 		 function,
 		 filename );
 
@@ -580,6 +640,7 @@ int libfsntfs_volume_open_wide(
 	}
 #endif
 	internal_volume->file_io_handle_created_in_library = 1;
+	internal_volume->memory_map                        = memory_map;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -594,6 +655,7 @@ int libfsntfs_volume_open_wide(
 		 function );
 
 		internal_volume->file_io_handle_created_in_library = 0;
+		internal_volume->memory_map                        = NULL;
 
 		goto on_error;
 	}
@@ -607,25 +669,29 @@ on_error:
 		 &file_io_handle,
 		 NULL );
 	}
+	if( memory_map != NULL )
+	{
+		libfsntfs_memory_map_free(
+		 &memory_map,
+		 NULL );
+	}
 	return( -1 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Opens a volume using a Basic File IO (bfio) handle
+/* Opens a volume
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_open_file_io_handle(
+int libfsntfs_volume_open_wide(
      libfsntfs_volume_t *volume,
-     libbfio_handle_t *file_io_handle,
+     const wchar_t *filename,
      int access_flags,
      libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle             = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_open_file_io_handle";
-	int bfio_access_flags                        = 0;
-	int file_io_handle_is_open                   = 0;
-	int file_io_handle_opened_in_library         = 0;
+	static char *function                        = "libfsntfs_volume_open_wide";
 
 	if( volume == NULL )
 	{
@@ -640,24 +706,13 @@ int libfsntfs_volume_open_file_io_handle(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
-	if( internal_volume->file_io_handle != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
-		 function );
-
-		return( -1 );
-	}
-	if( file_io_handle == NULL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO handle.",
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
@@ -685,54 +740,64 @@ int libfsntfs_volume_open_file_io_handle(
 
 		return( -1 );
 	}
-	if( ( access_flags & LIBFSNTFS_ACCESS_FLAG_READ ) != 0 )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
-		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
-	}
-	file_io_handle_is_open = libbfio_handle_is_open(
-	                          file_io_handle,
-	                          error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
 
-	if( file_io_handle_is_open == -1 )
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libbfio_handle_set_track_offsets_read(
+	     file_io_handle,
+	     1,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open volume.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set track offsets read in file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	else if( file_io_handle_is_open == 0 )
+#endif
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     wide_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
 	{
-		if( libbfio_handle_open(
-		     file_io_handle,
-		     bfio_access_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to open file IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
 
-			goto on_error;
-		}
-		file_io_handle_opened_in_library = 1;
+		goto on_error;
 	}
-	if( libfsntfs_internal_volume_open_read(
-	     internal_volume,
+	if( libfsntfs_volume_open_file_io_handle(
+	     volume,
 	     file_io_handle,
+	     access_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from file IO handle.",
-		 function );
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume: %ls.",
+		 function,
+		 filename );
 
 		goto on_error;
 	}
@@ -751,8 +816,7 @@ int libfsntfs_volume_open_file_io_handle(
 		goto on_error;
 	}
 #endif
-	internal_volume->file_io_handle                   = file_io_handle;
-	internal_volume->file_io_handle_opened_in_library = (uint8_t) file_io_handle_opened_in_library;
+	internal_volume->file_io_handle_created_in_library = 1;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -766,8 +830,7 @@ int libfsntfs_volume_open_file_io_handle(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		internal_volume->file_io_handle                   = NULL;
-		internal_volume->file_io_handle_opened_in_library = 0;
+		internal_volume->file_io_handle_created_in_library = 0;
 
 		goto on_error;
 	}
@@ -775,25 +838,28 @@ int libfsntfs_volume_open_file_io_handle(
 	return( 1 );
 
 on_error:
-	if( file_io_handle_opened_in_library != 0 )
+	if( file_io_handle != NULL )
 	{
-		libbfio_handle_close(
-		 file_io_handle,
-		 error );
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
 	return( -1 );
 }
 
-/* Closes a volume
- * Returns 0 if successful or -1 on error
+/* Opens a volume using a read-only memory mapping of the file or device
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_close(
+int libfsntfs_volume_open_mapped_wide(
      libfsntfs_volume_t *volume,
+     const wchar_t *filename,
+     int access_flags,
      libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle             = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_close";
-	int result                                   = 0;
+	libfsntfs_memory_map_t *memory_map           = NULL;
+	static char *function                        = "libfsntfs_volume_open_mapped_wide";
 
 	if( volume == NULL )
 	{
@@ -808,182 +874,159 @@ int libfsntfs_volume_close(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
-	if( internal_volume->file_io_handle == NULL )
+	if( internal_volume->memory_map != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing file IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - memory map value already set.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( ( ( access_flags & LIBFSNTFS_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( access_flags & LIBFSNTFS_ACCESS_FLAG_WRITE ) == 0 ) )
 	{
-		if( internal_volume->file_io_handle_created_in_library != 0 )
-		{
-			if( libfsntfs_debug_print_read_offsets(
-			     internal_volume->file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print the read offsets.",
-				 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
 
-				result = -1;
-			}
-		}
+		return( -1 );
 	}
-#endif
-	if( internal_volume->file_io_handle_opened_in_library != 0 )
+	if( ( access_flags & LIBFSNTFS_ACCESS_FLAG_WRITE ) != 0 )
 	{
-		if( libbfio_handle_close(
-		     internal_volume->file_io_handle,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close file IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
 
-			result = -1;
-		}
-		internal_volume->file_io_handle_opened_in_library = 0;
+		return( -1 );
 	}
-	if( internal_volume->file_io_handle_created_in_library != 0 )
+	if( libfsntfs_memory_map_initialize(
+	     &memory_map,
+	     error ) != 1 )
 	{
-		if( libbfio_handle_free(
-		     &( internal_volume->file_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO handle.",
-			 function );
-
-			result = -1;
-		}
-		internal_volume->file_io_handle_created_in_library = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory map.",
+		 function );
+
+		goto on_error;
 	}
-	internal_volume->file_io_handle = NULL;
+	if( libfsntfs_memory_map_open_wide(
+	     memory_map,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open memory map: %ls.",
+		 function,
+		 filename );
 
-	if( libfsntfs_io_handle_clear(
-	     internal_volume->io_handle,
+		goto on_error;
+	}
+	/* The memory range IO handle reads directly from the mapping
+	 */
+	if( libbfio_memory_range_initialize(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( internal_volume->volume_header != NULL )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libbfio_handle_set_track_offsets_read(
+	     file_io_handle,
+	     1,
+	     error ) != 1 )
 	{
-		if( libfsntfs_volume_header_free(
-		     &( internal_volume->volume_header ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free volume header.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set track offsets read in file IO handle.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_volume->volume_mft_entry != NULL )
+#endif
+	if( libbfio_memory_range_set(
+	     file_io_handle,
+	     memory_map->data,
+	     (size_t) memory_map->data_size,
+	     error ) != 1 )
 	{
-		if( libfsntfs_mft_entry_free(
-		     &( internal_volume->volume_mft_entry ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free volume MFT entry.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set memory range in file IO handle.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_volume->volume_information_attribute != NULL )
+	if( libfsntfs_volume_open_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     access_flags,
+	     error ) != 1 )
 	{
-		if( libfsntfs_internal_attribute_free(
-		     (libfsntfs_internal_attribute_t **) &( internal_volume->volume_information_attribute ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free volume information attribute.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume: %ls.",
+		 function,
+		 filename );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_volume->volume_name_attribute != NULL )
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libfsntfs_internal_attribute_free(
-		     (libfsntfs_internal_attribute_t **) &( internal_volume->volume_name_attribute ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free volume name attribute.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_volume->file_system != NULL )
-	{
-		if( libfsntfs_file_system_free(
-		     &( internal_volume->file_system ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file system.",
-			 function );
+#endif
+	internal_volume->file_io_handle_created_in_library = 1;
+	internal_volume->memory_map                        = memory_map;
 
-			result = -1;
-		}
-	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -996,292 +1039,2554 @@ int libfsntfs_volume_close(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		internal_volume->file_io_handle_created_in_library = 0;
+		internal_volume->memory_map                        = NULL;
+
+		goto on_error;
 	}
 #endif
-	return( result );
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( memory_map != NULL )
+	{
+		libfsntfs_memory_map_free(
+		 &memory_map,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Opens a volume for reading
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens a volume using a Basic File IO (bfio) handle
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_internal_volume_open_read(
-     libfsntfs_internal_volume_t *internal_volume,
+int libfsntfs_volume_open_file_io_handle(
+     libfsntfs_volume_t *volume,
      libbfio_handle_t *file_io_handle,
+     int access_flags,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_internal_volume_open_read";
-	off64_t mft_offset    = 0;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_open_file_io_handle";
+	int bfio_access_flags                        = 0;
+	int file_io_handle_is_open                   = 0;
+	int file_io_handle_opened_in_library         = 0;
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid internal volume.",
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle == NULL )
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid internal volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->volume_header != NULL )
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid internal volume - volume header value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->file_system != NULL )
+	if( ( ( access_flags & LIBFSNTFS_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( access_flags & LIBFSNTFS_ACCESS_FLAG_WRITE ) == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid internal volume - file system value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading volume header:\n" );
-	}
-#endif
-	if( libfsntfs_volume_header_initialize(
-	     &( internal_volume->volume_header ),
-	     error ) != 1 )
+	if( ( access_flags & LIBFSNTFS_ACCESS_FLAG_WRITE ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create volume header.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfsntfs_volume_header_read_file_io_handle(
-	     internal_volume->volume_header,
-	     file_io_handle,
-	     0,
-	     error ) != 1 )
+	if( ( access_flags & LIBFSNTFS_ACCESS_FLAG_READ ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read volume header at offset: 0 (0x00000000).",
-		 function );
-
-		goto on_error;
+		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
 	}
-	if( libfsntfs_volume_header_get_bytes_per_sector(
-	     internal_volume->volume_header,
-	     &( internal_volume->io_handle->bytes_per_sector ),
-	     error ) != 1 )
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve bytes per sector.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfsntfs_volume_header_get_cluster_block_size(
-	     internal_volume->volume_header,
-	     &( internal_volume->io_handle->cluster_block_size ),
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     bfio_access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle_opened_in_library = 1;
+	}
+	if( libfsntfs_internal_volume_open_read(
+	     internal_volume,
+	     file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve cluster block size.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfsntfs_volume_header_get_mft_entry_size(
-	     internal_volume->volume_header,
-	     &( internal_volume->io_handle->mft_entry_size ),
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfsntfs_volume_header_get_index_entry_size(
-	     internal_volume->volume_header,
-	     &( internal_volume->io_handle->index_entry_size ),
+#endif
+	internal_volume->file_io_handle                   = file_io_handle;
+	internal_volume->file_io_handle_opened_in_library = (uint8_t) file_io_handle_opened_in_library;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve index entry size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
+		internal_volume->file_io_handle                   = NULL;
+		internal_volume->file_io_handle_opened_in_library = 0;
+
 		goto on_error;
 	}
-	if( libfsntfs_volume_header_get_mft_offset(
-	     internal_volume->volume_header,
-	     &mft_offset,
-	     error ) != 1 )
+#endif
+	return( 1 );
+
+on_error:
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 error );
+	}
+	return( -1 );
+}
+
+/* Closes a volume
+ * Closing waits for the outstanding asynchronous reads to complete, hence the volume
+ * must not be closed by the callback function of an asynchronous read
+ * Returns 0 if successful or -1 on error
+ */
+int libfsntfs_volume_close(
+     libfsntfs_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_close";
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT offset.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfsntfs_file_system_initialize(
-	     &( internal_volume->file_system ),
+	/* The outstanding asynchronous reads are completed before the volume is closed,
+	 * the lock is not held since their callback functions can use the volume
+	 */
+	if( libfsntfs_async_reader_stop(
+	     internal_volume->io_handle->async_reader,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file system.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop asynchronous reader.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( mft_offset < 0 )
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid MFT offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
+#endif
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
-		libcnotify_printf(
-		 "Reading MFT entry: 0 ($MFT):\n" );
+		if( internal_volume->file_io_handle_created_in_library != 0 )
+		{
+			if( libfsntfs_debug_print_read_offsets(
+			     internal_volume->file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print the read offsets.",
+				 function );
+
+				result = -1;
+			}
+		}
 	}
 #endif
-	if( libfsntfs_file_system_read_mft(
-	     internal_volume->file_system,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     mft_offset,
-	     0,
-	     error ) != 1 )
+	if( internal_volume->file_io_handle_opened_in_library != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read MFT (MFT entry: 0).",
-		 function );
+		if( libbfio_handle_close(
+		     internal_volume->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
 
-		goto on_error;
+			result = -1;
+		}
+		internal_volume->file_io_handle_opened_in_library = 0;
 	}
-/* TODO what about the mirror MFT ? */
+	if( internal_volume->file_io_handle_created_in_library != 0 )
+	{
+		if( libbfio_handle_free(
+		     &( internal_volume->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+			result = -1;
+		}
+		internal_volume->file_io_handle_created_in_library = 0;
+	}
+	internal_volume->file_io_handle = NULL;
+
+	/* The memory map is freed after the file IO handle that references it
+	 */
+	if( internal_volume->memory_map != NULL )
 	{
-		libcnotify_printf(
-		 "Reading MFT entry: 6 ($Bitmap):\n" );
+		if( libfsntfs_memory_map_free(
+		     &( internal_volume->memory_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free memory map.",
+			 function );
+
+			result = -1;
+		}
 	}
-	if( libfsntfs_file_system_read_bitmap(
-	     internal_volume->file_system,
+
+	if( libfsntfs_io_handle_clear(
 	     internal_volume->io_handle,
-	     file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read bitmap (MFT entry: 6).",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
 		 function );
 
-		goto on_error;
+		result = -1;
 	}
-	if( libcnotify_verbose != 0 )
+	if( internal_volume->volume_header != NULL )
 	{
-		libcnotify_printf(
-		 "Reading MFT entry: 9 ($Secure):\n" );
+		if( libfsntfs_volume_header_free(
+		     &( internal_volume->volume_header ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free volume header.",
+			 function );
+
+			result = -1;
+		}
 	}
-#endif
-	if( libfsntfs_file_system_read_security_descriptors(
-	     internal_volume->file_system,
-	     internal_volume->io_handle,
-	     file_io_handle,
+	if( internal_volume->volume_mft_entry != NULL )
+	{
+		if( libfsntfs_mft_entry_free(
+		     &( internal_volume->volume_mft_entry ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free volume MFT entry.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->volume_information_attribute != NULL )
+	{
+		if( libfsntfs_internal_attribute_free(
+		     (libfsntfs_internal_attribute_t **) &( internal_volume->volume_information_attribute ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free volume information attribute.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->volume_name_attribute != NULL )
+	{
+		if( libfsntfs_internal_attribute_free(
+		     (libfsntfs_internal_attribute_t **) &( internal_volume->volume_name_attribute ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free volume name attribute.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->file_system != NULL )
+	{
+		if( libfsntfs_file_system_free(
+		     &( internal_volume->file_system ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file system.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the metadata cache filename
+ * The metadata cache is read by subsequent calls to open the volume and is
+ * ignored if it was not written for the same volume and $MFT
+ * Use libfsntfs_volume_write_metadata_cache to create the metadata cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_set_metadata_cache_filename(
+     libfsntfs_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	char *safe_filename                          = NULL;
+	static char *function                        = "libfsntfs_volume_set_metadata_cache_filename";
+	size_t filename_size                         = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_size = narrow_string_length(
+	                 filename ) + 1;
+
+	if( filename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( char ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid filename size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	safe_filename = narrow_string_allocate(
+	                 filename_size );
+
+	if( safe_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata cache filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     safe_filename,
+	     filename,
+	     filename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy metadata cache filename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_volume->metadata_cache_filename != NULL )
+	{
+		memory_free(
+		 internal_volume->metadata_cache_filename );
+	}
+	internal_volume->metadata_cache_filename = safe_filename;
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+	if( internal_volume->metadata_cache_filename_wide != NULL )
+	{
+		memory_free(
+		 internal_volume->metadata_cache_filename_wide );
+
+		internal_volume->metadata_cache_filename_wide = NULL;
+	}
+#endif
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( safe_filename != NULL )
+	{
+		memory_free(
+		 safe_filename );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the metadata cache filename
+ * The metadata cache is read by subsequent calls to open the volume and is
+ * ignored if it was not written for the same volume and $MFT
+ * Use libfsntfs_volume_write_metadata_cache_wide to create the metadata cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_set_metadata_cache_filename_wide(
+     libfsntfs_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	wchar_t *safe_filename                       = NULL;
+	static char *function                        = "libfsntfs_volume_set_metadata_cache_filename_wide";
+	size_t filename_size                         = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_size = wide_string_length(
+	                 filename ) + 1;
+
+	if( filename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( wchar_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid filename size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	safe_filename = wide_string_allocate(
+	                 filename_size );
+
+	if( safe_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata cache filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( wide_string_copy(
+	     safe_filename,
+	     filename,
+	     filename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy metadata cache filename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_volume->metadata_cache_filename_wide != NULL )
+	{
+		memory_free(
+		 internal_volume->metadata_cache_filename_wide );
+	}
+	internal_volume->metadata_cache_filename_wide = safe_filename;
+
+	if( internal_volume->metadata_cache_filename != NULL )
+	{
+		memory_free(
+		 internal_volume->metadata_cache_filename );
+
+		internal_volume->metadata_cache_filename = NULL;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( safe_filename != NULL )
+	{
+		memory_free(
+		 safe_filename );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the MFT read-ahead size
+ * Sequentially read MFT entries are read in blocks of at most the read-ahead size,
+ * a size of 0 disables MFT read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_set_mft_readahead_size(
+     libfsntfs_volume_t *volume,
+     size_t readahead_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_set_mft_readahead_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( readahead_size > (size_t) LIBFSNTFS_MAXIMUM_MFT_READAHEAD_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read-ahead size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->mft_readahead_size = readahead_size;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the data read-ahead size
+ * Sequential reads of the data of a file entry or data stream are read ahead in
+ * a growing window of at most the read-ahead size, a size of 0 disables data read-ahead
+ * The read-ahead size applies to file entries and data streams created afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_set_data_readahead_size(
+     libfsntfs_volume_t *volume,
+     size_t readahead_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_set_data_readahead_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( readahead_size > (size_t) LIBFSNTFS_MAXIMUM_DATA_READAHEAD_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read-ahead size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->data_readahead_size = readahead_size;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the read queue depth
+ * The read queue depth is the maximum number of reads that are in flight
+ * concurrently when extracting data, a depth of 1 reads one buffer at a time
+ * A larger depth keeps the reads of the next parts of the data in flight while
+ * the callback function is called, the extraction buffer is divided over them
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_set_read_queue_depth(
+     libfsntfs_volume_t *volume,
+     int read_queue_depth,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_set_read_queue_depth";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_queue_depth < 1 )
+	 || ( read_queue_depth > LIBFSNTFS_MAXIMUM_READ_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->read_queue_depth = read_queue_depth;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of threads used for asynchronous reads
+ * Running threads are stopped after the outstanding asynchronous reads have
+ * completed, the new number of threads is started on the next asynchronous read
+ * The calling thread waits for the running threads to stop, hence the number of
+ * threads must not be changed by the callback function of an asynchronous read
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_set_number_of_async_read_threads(
+     libfsntfs_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_set_number_of_async_read_threads";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The asynchronous reader has its own mutex
+	 */
+	if( libfsntfs_async_reader_set_number_of_threads(
+	     internal_volume->io_handle->async_reader,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of threads of asynchronous reader.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the cache limits
+ * The limits are the maximum sizes in bytes of the MFT entry cache, of each
+ * index node cache and of each compressed block cache, 0 represents the default
+ * The limits are not a budget for the volume as a whole: every directory index
+ * and compressed data stream in use has its own cache, so the total grows with
+ * the number of file entries that are open at the same time. A cache holds at
+ * most 65536 entries regardless of the limit.
+ * The MFT entry cache limit applies to volumes opened afterwards, the other limits
+ * to the caches created afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_set_cache_limits(
+     libfsntfs_volume_t *volume,
+     size64_t mft_entry_cache_size,
+     size64_t index_node_cache_size,
+     size64_t compressed_block_cache_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_set_cache_limits";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->maximum_mft_entry_cache_size        = mft_entry_cache_size;
+	internal_volume->io_handle->maximum_index_node_cache_size       = index_node_cache_size;
+	internal_volume->io_handle->maximum_compressed_block_cache_size = compressed_block_cache_size;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of path hints
+ * The path hints are used to construct the path hint of file entries, when the
+ * maximum is reached the least recently used path hint is freed, 0 represents no maximum
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_set_maximum_number_of_path_hints(
+     libfsntfs_volume_t *volume,
+     int maximum_number_of_path_hints,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_set_maximum_number_of_path_hints";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_path_hints < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of path hints value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->maximum_number_of_path_hints = maximum_number_of_path_hints;
+
+	if( internal_volume->file_system != NULL )
+	{
+		if( libfsntfs_file_system_set_maximum_number_of_path_hints(
+		     internal_volume->file_system,
+		     maximum_number_of_path_hints,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of path hints.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Opens a volume for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_volume_open_read(
+     libfsntfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_internal_volume_open_read";
+	off64_t mft_offset    = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid internal volume - volume header value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_system != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid internal volume - file system value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading volume header:\n" );
+	}
+#endif
+	if( libfsntfs_volume_header_initialize(
+	     &( internal_volume->volume_header ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create volume header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_volume_header_read_file_io_handle(
+	     internal_volume->volume_header,
+	     file_io_handle,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header at offset: 0 (0x00000000).",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_volume_header_get_bytes_per_sector(
+	     internal_volume->volume_header,
+	     &( internal_volume->io_handle->bytes_per_sector ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_volume_header_get_cluster_block_size(
+	     internal_volume->volume_header,
+	     &( internal_volume->io_handle->cluster_block_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster block size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_volume_header_get_mft_entry_size(
+	     internal_volume->volume_header,
+	     &( internal_volume->io_handle->mft_entry_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_volume_header_get_index_entry_size(
+	     internal_volume->volume_header,
+	     &( internal_volume->io_handle->index_entry_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index entry size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_volume_header_get_volume_size(
+	     internal_volume->volume_header,
+	     &( internal_volume->io_handle->volume_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_volume_header_get_mft_offset(
+	     internal_volume->volume_header,
+	     &mft_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT offset.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_file_system_initialize(
+	     &( internal_volume->file_system ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system.",
+		 function );
+
+		goto on_error;
+	}
+	if( mft_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* A missing, stale or corrupt metadata cache is not fatal
+	 * the metadata is read from the volume instead
+	 */
+	if( libfsntfs_internal_volume_read_metadata_cache(
+	     internal_volume,
+	     error ) == -1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading MFT entry: 0 ($MFT):\n" );
+	}
+#endif
+	if( libfsntfs_file_system_read_mft(
+	     internal_volume->file_system,
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     mft_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT (MFT entry: 0).",
+		 function );
+
+		goto on_error;
+	}
+/* TODO what about the mirror MFT ? */
+
+	/* The bitmap ($Bitmap) is read on demand
+	 */
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading MFT entry: 10 ($UpCase):\n" );
+	}
+#endif
+	/* Failing to read the upper case table does not prevent the volume from
+	 * being opened, case folding then falls back to the C library
+	 */
+	if( libfsntfs_file_system_read_upcase_table(
+	     internal_volume->file_system,
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+	}
+	if( libfsntfs_path_component_cache_initialize(
+	     &( internal_volume->file_system->path_component_cache ),
+	     LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_PATH_COMPONENTS,
+	     internal_volume->file_system->upcase_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create path component cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading MFT entry: 9 ($Secure):\n" );
+	}
+#endif
+	if( libfsntfs_file_system_read_security_descriptors(
+	     internal_volume->file_system,
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read security descriptors (MFT entry: 9).",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( internal_volume->file_system != NULL )
+	{
+		libfsntfs_file_system_free(
+		 &( internal_volume->file_system ),
+		 NULL );
+	}
+	if( internal_volume->volume_header != NULL )
+	{
+		libfsntfs_volume_header_free(
+		 &( internal_volume->volume_header ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the metadata cache
+ * A metadata cache of another volume is ignored
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_internal_volume_read_metadata_cache(
+     libfsntfs_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	libfsntfs_metadata_cache_t *metadata_cache = NULL;
+	static char *function                      = "libfsntfs_internal_volume_read_metadata_cache";
+	uint64_t volume_serial_number              = 0;
+	int result                                 = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal volume - missing file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_system->metadata_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid internal volume - invalid file system - metadata cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_volume_header_get_volume_serial_number(
+	     internal_volume->volume_header,
+	     &volume_serial_number,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume serial number.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_metadata_cache_initialize(
+	     &metadata_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create metadata cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+	if( internal_volume->metadata_cache_filename_wide != NULL )
+	{
+		result = libfsntfs_metadata_cache_open_wide(
+		          metadata_cache,
+		          internal_volume->metadata_cache_filename_wide,
+		          error );
+	}
+	else
+#endif
+	if( internal_volume->metadata_cache_filename != NULL )
+	{
+		result = libfsntfs_metadata_cache_open(
+		          metadata_cache,
+		          internal_volume->metadata_cache_filename,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open metadata cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( result != 0 )
+	 && ( metadata_cache->volume_serial_number != volume_serial_number ) )
+	{
+		result = 0;
+	}
+	if( result != 0 )
+	{
+		internal_volume->file_system->metadata_cache = metadata_cache;
+	}
+	else
+	{
+		if( libfsntfs_metadata_cache_free(
+		     &metadata_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free metadata cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( metadata_cache != NULL )
+	{
+		libfsntfs_metadata_cache_free(
+		 &metadata_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the metadata cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_volume_write_metadata_cache(
+     libfsntfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *metadata_cache_file_io_handle,
+     libcerror_error_t **error )
+{
+	libfsntfs_metadata_cache_t *metadata_cache = NULL;
+	static char *function                      = "libfsntfs_internal_volume_write_metadata_cache";
+	uint64_t volume_serial_number              = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal volume - missing file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_volume_header_get_volume_serial_number(
+	     internal_volume->volume_header,
+	     &volume_serial_number,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume serial number.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_metadata_cache_initialize(
+	     &metadata_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create metadata cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_file_system_append_to_metadata_cache(
+	     internal_volume->file_system,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     volume_serial_number,
+	     metadata_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve metadata cache values from file system.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     metadata_cache_file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open metadata cache file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_metadata_cache_write_file_io_handle(
+	     metadata_cache,
+	     metadata_cache_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write metadata cache.",
+		 function );
+
+		libbfio_handle_close(
+		 metadata_cache_file_io_handle,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     metadata_cache_file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close metadata cache file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_metadata_cache_free(
+	     &metadata_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free metadata cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( metadata_cache != NULL )
+	{
+		libfsntfs_metadata_cache_free(
+		 &metadata_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the metadata cache of the volume to a file
+ * The metadata cache contains the MFT layout, the attribute list data MFT entries,
+ * the $Secure $SII index and the path hints that are currently known
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_write_metadata_cache(
+     libfsntfs_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle             = NULL;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_write_metadata_cache";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create metadata cache file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     narrow_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in metadata cache file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libfsntfs_internal_volume_write_metadata_cache(
+	     internal_volume,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write metadata cache.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free metadata cache file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Writes the metadata cache of the volume to a file
+ * The metadata cache contains the MFT layout, the attribute list data MFT entries,
+ * the $Secure $SII index and the path hints that are currently known
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_write_metadata_cache_wide(
+     libfsntfs_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle             = NULL;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_write_metadata_cache_wide";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create metadata cache file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     wide_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in metadata cache file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libfsntfs_internal_volume_write_metadata_cache(
+	     internal_volume,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write metadata cache.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free metadata cache file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Determines if the volume has BitLocker Drive Encryption (BDE)
+ * Returns 1 if the volume has BitLocker Drive Encryption, 0 if not or -1 on error
+ */
+int libfsntfs_volume_has_bitlocker_drive_encryption(
+     libfsntfs_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_has_bitlocker_drive_encryption";
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+/* TODO implement */
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determines if the volume has Volume Shadow Snapshots (VSS)
+ * Returns 1 if the volume has Volume Shadow Snapshots, 0 if not or -1 on error
+ */
+int libfsntfs_volume_has_volume_shadow_snapshots(
+     libfsntfs_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_has_volume_shadow_snapshots";
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+/* TODO implement */
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the $VOLUME_INFORMATION attribute from MFT entry 3
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_internal_volume_get_volume_information_attribute(
+     libfsntfs_internal_volume_t *internal_volume,
+     libfsntfs_attribute_t **attribute,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_attribute_t *mft_attribute = NULL;
+	static char *function                    = "libfsntfs_internal_volume_get_volume_information_attribute";
+	int result                               = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_mft_entry == NULL )
+	{
+		if( libfsntfs_file_system_get_mft_entry_by_index_no_cache(
+		     internal_volume->file_system,
+		     internal_volume->file_io_handle,
+		     LIBFSNTFS_MFT_ENTRY_INDEX_VOLUME,
+		     &( internal_volume->volume_mft_entry ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry: %d.",
+			 function,
+			 LIBFSNTFS_MFT_ENTRY_INDEX_VOLUME );
+
+			return( -1 );
+		}
+	}
+	if( internal_volume->volume_information_attribute == NULL )
+	{
+		result = libfsntfs_mft_entry_get_volume_information_attribute(
+		          internal_volume->volume_mft_entry,
+		          &mft_attribute,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve $VOLUME_INFORMATION attribute.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( libfsntfs_attribute_initialize(
+		     &( internal_volume->volume_information_attribute ),
+		     mft_attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create $VOLUME_INFORMATION attribute.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsntfs_internal_attribute_read_value(
+		     (libfsntfs_internal_attribute_t *) internal_volume->volume_information_attribute,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read value of $VOLUME_INFORMATION attribute.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*attribute = internal_volume->volume_information_attribute;
+
+	return( 1 );
+}
+
+/* Retrieves the $VOLUME_NAME attribute from MFT entry 3
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsntfs_internal_volume_get_volume_name_attribute(
+     libfsntfs_internal_volume_t *internal_volume,
+     libfsntfs_attribute_t **attribute,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_attribute_t *mft_attribute = NULL;
+	static char *function                    = "libfsntfs_internal_volume_get_volume_name_attribute";
+	int result                               = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_mft_entry == NULL )
+	{
+		if( libfsntfs_file_system_get_mft_entry_by_index_no_cache(
+		     internal_volume->file_system,
+		     internal_volume->file_io_handle,
+		     LIBFSNTFS_MFT_ENTRY_INDEX_VOLUME,
+		     &( internal_volume->volume_mft_entry ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry: %d.",
+			 function,
+			 LIBFSNTFS_MFT_ENTRY_INDEX_VOLUME );
+
+			return( -1 );
+		}
+	}
+	if( internal_volume->volume_name_attribute == NULL )
+	{
+		result = libfsntfs_mft_entry_get_volume_name_attribute(
+		          internal_volume->volume_mft_entry,
+		          &mft_attribute,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve $VOLUME_NAME attribute.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( libfsntfs_attribute_initialize(
+		     &( internal_volume->volume_name_attribute ),
+		     mft_attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create $VOLUME_NAME attribute.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsntfs_internal_attribute_read_value(
+		     (libfsntfs_internal_attribute_t *) internal_volume->volume_name_attribute,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read value of $VOLUME_NAME attribute.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*attribute = internal_volume->volume_name_attribute;
+
+	return( 1 );
+}
+
+/* Retrieves the bytes per sector
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_bytes_per_sector(
+     libfsntfs_volume_t *volume,
+     uint16_t *bytes_per_sector,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_bytes_per_sector";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_volume_header_get_bytes_per_sector(
+	     internal_volume->volume_header,
+	     bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read security descriptors (MFT entry: 9).",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		goto on_error;
-	}
-	return( 1 );
-
-on_error:
-	if( internal_volume->file_system != NULL )
-	{
-		libfsntfs_file_system_free(
-		 &( internal_volume->file_system ),
-		 NULL );
-	}
-	if( internal_volume->volume_header != NULL )
-	{
-		libfsntfs_volume_header_free(
-		 &( internal_volume->volume_header ),
-		 NULL );
+		return( -1 );
 	}
-	return( -1 );
+#endif
+	return( result );
 }
 
-/* Determines if the volume has BitLocker Drive Encryption (BDE)
- * Returns 1 if the volume has BitLocker Drive Encryption, 0 if not or -1 on error
+/* Retrieves the cluster block size
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_has_bitlocker_drive_encryption(
+int libfsntfs_volume_get_cluster_block_size(
      libfsntfs_volume_t *volume,
+     size32_t *cluster_block_size,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_has_bitlocker_drive_encryption";
-	int result                                   = 0;
+	static char *function                        = "libfsntfs_volume_get_cluster_block_size";
+	int result                                   = 1;
 
 	if( volume == NULL )
 	{
@@ -1311,8 +3616,20 @@ int libfsntfs_volume_has_bitlocker_drive_encryption(
 		return( -1 );
 	}
 #endif
-/* TODO implement */
+	if( libfsntfs_volume_header_get_cluster_block_size(
+	     internal_volume->volume_header,
+	     cluster_block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster block size.",
+		 function );
 
+		result = -1;
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -1331,16 +3648,17 @@ int libfsntfs_volume_has_bitlocker_drive_encryption(
 	return( result );
 }
 
-/* Determines if the volume has Volume Shadow Snapshots (VSS)
- * Returns 1 if the volume has Volume Shadow Snapshots, 0 if not or -1 on error
+/* Retrieves the MFT entry size
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_has_volume_shadow_snapshots(
+int libfsntfs_volume_get_mft_entry_size(
      libfsntfs_volume_t *volume,
+     size32_t *mft_entry_size,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_has_volume_shadow_snapshots";
-	int result                                   = 0;
+	static char *function                        = "libfsntfs_volume_get_mft_entry_size";
+	int result                                   = 1;
 
 	if( volume == NULL )
 	{
@@ -1370,8 +3688,20 @@ int libfsntfs_volume_has_volume_shadow_snapshots(
 		return( -1 );
 	}
 #endif
-/* TODO implement */
+	if( libfsntfs_volume_header_get_mft_entry_size(
+	     internal_volume->volume_header,
+	     mft_entry_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry size.",
+		 function );
 
+		result = -1;
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -1390,19 +3720,19 @@ int libfsntfs_volume_has_volume_shadow_snapshots(
 	return( result );
 }
 
-/* Retrieves the $VOLUME_INFORMATION attribute from MFT entry 3
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the index entry size
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_internal_volume_get_volume_information_attribute(
-     libfsntfs_internal_volume_t *internal_volume,
-     libfsntfs_attribute_t **attribute,
+int libfsntfs_volume_get_index_entry_size(
+     libfsntfs_volume_t *volume,
+     size32_t *index_entry_size,
      libcerror_error_t **error )
 {
-	libfsntfs_mft_attribute_t *mft_attribute = NULL;
-	static char *function                    = "libfsntfs_internal_volume_get_volume_information_attribute";
-	int result                               = 0;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_index_entry_size";
+	int result                                   = 1;
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1413,108 +3743,71 @@ int libfsntfs_internal_volume_get_volume_information_attribute(
 
 		return( -1 );
 	}
-	if( attribute == NULL )
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid attribute.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->volume_mft_entry == NULL )
+#endif
+	if( libfsntfs_volume_header_get_index_entry_size(
+	     internal_volume->volume_header,
+	     index_entry_size,
+	     error ) != 1 )
 	{
-		if( libfsntfs_file_system_get_mft_entry_by_index_no_cache(
-		     internal_volume->file_system,
-		     internal_volume->file_io_handle,
-		     LIBFSNTFS_MFT_ENTRY_INDEX_VOLUME,
-		     &( internal_volume->volume_mft_entry ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve MFT entry: %d.",
-			 function,
-			 LIBFSNTFS_MFT_ENTRY_INDEX_VOLUME );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index entry size.",
+		 function );
 
-			return( -1 );
-		}
+		result = -1;
 	}
-	if( internal_volume->volume_information_attribute == NULL )
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		result = libfsntfs_mft_entry_get_volume_information_attribute(
-		          internal_volume->volume_mft_entry,
-		          &mft_attribute,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve $VOLUME_INFORMATION attribute.",
-			 function );
-
-			return( -1 );
-		}
-		else if( result == 0 )
-		{
-			return( 0 );
-		}
-		if( libfsntfs_attribute_initialize(
-		     &( internal_volume->volume_information_attribute ),
-		     mft_attribute,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create $VOLUME_INFORMATION attribute.",
-			 function );
-
-			return( -1 );
-		}
-		if( libfsntfs_internal_attribute_read_value(
-		     (libfsntfs_internal_attribute_t *) internal_volume->volume_information_attribute,
-		     internal_volume->io_handle,
-		     internal_volume->file_io_handle,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read value of $VOLUME_INFORMATION attribute.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	*attribute = internal_volume->volume_information_attribute;
-
-	return( 1 );
+#endif
+	return( result );
 }
 
-/* Retrieves the $VOLUME_NAME attribute from MFT entry 3
+/* Retrieves the size of the UTF-8 encoded name
+ * The returned size includes the end of string character
+ * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
  * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libfsntfs_internal_volume_get_volume_name_attribute(
-     libfsntfs_internal_volume_t *internal_volume,
-     libfsntfs_attribute_t **attribute,
+int libfsntfs_volume_get_utf8_name_size(
+     libfsntfs_volume_t *volume,
+     size_t *utf8_string_size,
      libcerror_error_t **error )
 {
-	libfsntfs_mft_attribute_t *mft_attribute = NULL;
-	static char *function                    = "libfsntfs_internal_volume_get_volume_name_attribute";
-	int result                               = 0;
+	libfsntfs_attribute_t *volume_name_attribute = NULL;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_utf8_name_size";
+	int result                                   = 0;
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1525,106 +3818,89 @@ int libfsntfs_internal_volume_get_volume_name_attribute(
 
 		return( -1 );
 	}
-	if( attribute == NULL )
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid attribute.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->volume_mft_entry == NULL )
+#endif
+	result = libfsntfs_internal_volume_get_volume_name_attribute(
+	          internal_volume,
+	          &volume_name_attribute,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume name attribute.",
+		 function );
+
+		result = -1;
+	}
+	else if( result != 0 )
 	{
-		if( libfsntfs_file_system_get_mft_entry_by_index_no_cache(
-		     internal_volume->file_system,
-		     internal_volume->file_io_handle,
-		     LIBFSNTFS_MFT_ENTRY_INDEX_VOLUME,
-		     &( internal_volume->volume_mft_entry ),
+		if( libfsntfs_volume_name_attribute_get_utf8_name_size(
+		     volume_name_attribute,
+		     utf8_string_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve MFT entry: %d.",
-			 function,
-			 LIBFSNTFS_MFT_ENTRY_INDEX_VOLUME );
+			 "%s: unable to retrieve size of UTF-8 name from volume name attribute.",
+			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	if( internal_volume->volume_name_attribute == NULL )
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		result = libfsntfs_mft_entry_get_volume_name_attribute(
-		          internal_volume->volume_mft_entry,
-		          &mft_attribute,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve $VOLUME_NAME attribute.",
-			 function );
-
-			return( -1 );
-		}
-		else if( result == 0 )
-		{
-			return( 0 );
-		}
-		if( libfsntfs_attribute_initialize(
-		     &( internal_volume->volume_name_attribute ),
-		     mft_attribute,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create $VOLUME_NAME attribute.",
-			 function );
-
-			return( -1 );
-		}
-		if( libfsntfs_internal_attribute_read_value(
-		     (libfsntfs_internal_attribute_t *) internal_volume->volume_name_attribute,
-		     internal_volume->io_handle,
-		     internal_volume->file_io_handle,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read value of $VOLUME_NAME attribute.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	*attribute = internal_volume->volume_name_attribute;
-
-	return( 1 );
+#endif
+	return( result );
 }
 
-/* Retrieves the bytes per sector
- * Returns 1 if successful or -1 on error
+/* Retrieves the UTF-8 encoded name
+ * The size should include the end of string character
+ * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libfsntfs_volume_get_bytes_per_sector(
+int libfsntfs_volume_get_utf8_name(
      libfsntfs_volume_t *volume,
-     uint16_t *bytes_per_sector,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
      libcerror_error_t **error )
 {
+	libfsntfs_attribute_t *volume_name_attribute = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_bytes_per_sector";
-	int result                                   = 1;
+	static char *function                        = "libfsntfs_volume_get_utf8_name";
+	int result                                   = 0;
 
 	if( volume == NULL )
 	{
@@ -1640,7 +3916,7 @@ int libfsntfs_volume_get_bytes_per_sector(
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1648,28 +3924,48 @@ int libfsntfs_volume_get_bytes_per_sector(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libfsntfs_volume_header_get_bytes_per_sector(
-	     internal_volume->volume_header,
-	     bytes_per_sector,
-	     error ) != 1 )
+	result = libfsntfs_internal_volume_get_volume_name_attribute(
+	          internal_volume,
+	          &volume_name_attribute,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve bytes per sector.",
+		 "%s: unable to retrieve volume name attribute.",
 		 function );
 
 		result = -1;
 	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_volume_name_attribute_get_utf8_name(
+		     volume_name_attribute,
+		     utf8_string,
+		     utf8_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve UTF-8 name from volume name attribute.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1677,7 +3973,7 @@ int libfsntfs_volume_get_bytes_per_sector(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -1686,17 +3982,20 @@ int libfsntfs_volume_get_bytes_per_sector(
 	return( result );
 }
 
-/* Retrieves the cluster block size
- * Returns 1 if successful or -1 on error
+/* Retrieves the size of the UTF-16 encoded name
+ * The returned size includes the end of string character
+ * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libfsntfs_volume_get_cluster_block_size(
+int libfsntfs_volume_get_utf16_name_size(
      libfsntfs_volume_t *volume,
-     size32_t *cluster_block_size,
+     size_t *utf16_string_size,
      libcerror_error_t **error )
 {
+	libfsntfs_attribute_t *volume_name_attribute = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_cluster_block_size";
-	int result                                   = 1;
+	static char *function                        = "libfsntfs_volume_get_utf16_name_size";
+	int result                                   = 0;
 
 	if( volume == NULL )
 	{
@@ -1712,7 +4011,7 @@ int libfsntfs_volume_get_cluster_block_size(
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1720,28 +4019,47 @@ int libfsntfs_volume_get_cluster_block_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libfsntfs_volume_header_get_cluster_block_size(
-	     internal_volume->volume_header,
-	     cluster_block_size,
-	     error ) != 1 )
+	result = libfsntfs_internal_volume_get_volume_name_attribute(
+	          internal_volume,
+	          &volume_name_attribute,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve cluster block size.",
+		 "%s: unable to retrieve volume name attribute.",
 		 function );
 
 		result = -1;
 	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_volume_name_attribute_get_utf16_name_size(
+		     volume_name_attribute,
+		     utf16_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of UTF-16 name from volume name attribute.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1749,7 +4067,7 @@ int libfsntfs_volume_get_cluster_block_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -1758,17 +4076,21 @@ int libfsntfs_volume_get_cluster_block_size(
 	return( result );
 }
 
-/* Retrieves the MFT entry size
- * Returns 1 if successful or -1 on error
+/* Retrieves the UTF-16 encoded name
+ * The size should include the end of string character
+ * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libfsntfs_volume_get_mft_entry_size(
+int libfsntfs_volume_get_utf16_name(
      libfsntfs_volume_t *volume,
-     size32_t *mft_entry_size,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
      libcerror_error_t **error )
 {
+	libfsntfs_attribute_t *volume_name_attribute = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_mft_entry_size";
-	int result                                   = 1;
+	static char *function                        = "libfsntfs_volume_get_utf16_name";
+	int result                                   = 0;
 
 	if( volume == NULL )
 	{
@@ -1784,7 +4106,7 @@ int libfsntfs_volume_get_mft_entry_size(
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1792,28 +4114,48 @@ int libfsntfs_volume_get_mft_entry_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libfsntfs_volume_header_get_mft_entry_size(
-	     internal_volume->volume_header,
-	     mft_entry_size,
-	     error ) != 1 )
+	result = libfsntfs_internal_volume_get_volume_name_attribute(
+	          internal_volume,
+	          &volume_name_attribute,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry size.",
+		 "%s: unable to retrieve volume name attribute.",
 		 function );
 
 		result = -1;
 	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_volume_name_attribute_get_utf16_name(
+		     volume_name_attribute,
+		     utf16_string,
+		     utf16_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve UTF-16 name from volume name attribute.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1821,7 +4163,7 @@ int libfsntfs_volume_get_mft_entry_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -1830,17 +4172,19 @@ int libfsntfs_volume_get_mft_entry_size(
 	return( result );
 }
 
-/* Retrieves the index entry size
- * Returns 1 if successful or -1 on error
+/* Retrieves the version
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libfsntfs_volume_get_index_entry_size(
+int libfsntfs_volume_get_version(
      libfsntfs_volume_t *volume,
-     size32_t *index_entry_size,
+     uint8_t *major_version,
+     uint8_t *minor_version,
      libcerror_error_t **error )
 {
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_index_entry_size";
-	int result                                   = 1;
+	libfsntfs_attribute_t *volume_information_attribute = NULL;
+	libfsntfs_internal_volume_t *internal_volume        = NULL;
+	static char *function                               = "libfsntfs_volume_get_version";
+	int result                                          = 0;
 
 	if( volume == NULL )
 	{
@@ -1856,7 +4200,7 @@ int libfsntfs_volume_get_index_entry_size(
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1864,28 +4208,48 @@ int libfsntfs_volume_get_index_entry_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libfsntfs_volume_header_get_index_entry_size(
-	     internal_volume->volume_header,
-	     index_entry_size,
-	     error ) != 1 )
+	result = libfsntfs_internal_volume_get_volume_information_attribute(
+	          internal_volume,
+	          &volume_information_attribute,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve index entry size.",
+		 "%s: unable to retrieve volume information attribute.",
 		 function );
 
 		result = -1;
 	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_volume_information_attribute_get_version(
+		     volume_information_attribute,
+		     major_version,
+		     minor_version,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve version from volume information attribute.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1893,7 +4257,7 @@ int libfsntfs_volume_get_index_entry_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -1902,20 +4266,18 @@ int libfsntfs_volume_get_index_entry_size(
 	return( result );
 }
 
-/* Retrieves the size of the UTF-8 encoded name
- * The returned size includes the end of string character
- * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
+/* Retrieves the flags
  * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libfsntfs_volume_get_utf8_name_size(
+int libfsntfs_volume_get_flags(
      libfsntfs_volume_t *volume,
-     size_t *utf8_string_size,
+     uint16_t *flags,
      libcerror_error_t **error )
 {
-	libfsntfs_attribute_t *volume_name_attribute = NULL;
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_utf8_name_size";
-	int result                                   = 0;
+	libfsntfs_attribute_t *volume_information_attribute = NULL;
+	libfsntfs_internal_volume_t *internal_volume        = NULL;
+	static char *function                               = "libfsntfs_volume_get_flags";
+	int result                                          = 0;
 
 	if( volume == NULL )
 	{
@@ -1945,9 +4307,9 @@ int libfsntfs_volume_get_utf8_name_size(
 		return( -1 );
 	}
 #endif
-	result = libfsntfs_internal_volume_get_volume_name_attribute(
+	result = libfsntfs_internal_volume_get_volume_information_attribute(
 	          internal_volume,
-	          &volume_name_attribute,
+	          &volume_information_attribute,
 	          error );
 
 	if( result == -1 )
@@ -1956,23 +4318,23 @@ int libfsntfs_volume_get_utf8_name_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume name attribute.",
+		 "%s: unable to retrieve volume information attribute.",
 		 function );
 
 		result = -1;
 	}
 	else if( result != 0 )
 	{
-		if( libfsntfs_volume_name_attribute_get_utf8_name_size(
-		     volume_name_attribute,
-		     utf8_string_size,
+		if( libfsntfs_volume_information_attribute_get_flags(
+		     volume_information_attribute,
+		     flags,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve size of UTF-8 name from volume name attribute.",
+			 "%s: unable to retrieve flags from volume information attribute.",
 			 function );
 
 			result = -1;
@@ -1996,21 +4358,17 @@ int libfsntfs_volume_get_utf8_name_size(
 	return( result );
 }
 
-/* Retrieves the UTF-8 encoded name
- * The size should include the end of string character
- * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the serial number
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_utf8_name(
+int libfsntfs_volume_get_serial_number(
      libfsntfs_volume_t *volume,
-     uint8_t *utf8_string,
-     size_t utf8_string_size,
+     uint64_t *serial_number,
      libcerror_error_t **error )
 {
-	libfsntfs_attribute_t *volume_name_attribute = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_utf8_name";
-	int result                                   = 0;
+	static char *function                        = "libfsntfs_volume_get_serial_number";
+	int result                                   = 1;
 
 	if( volume == NULL )
 	{
@@ -2026,7 +4384,7 @@ int libfsntfs_volume_get_utf8_name(
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2034,48 +4392,28 @@ int libfsntfs_volume_get_utf8_name(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libfsntfs_internal_volume_get_volume_name_attribute(
-	          internal_volume,
-	          &volume_name_attribute,
-	          error );
-
-	if( result == -1 )
+	if( libfsntfs_volume_header_get_volume_serial_number(
+	     internal_volume->volume_header,
+	     serial_number,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume name attribute.",
+		 "%s: unable to retrieve volume serial number.",
 		 function );
 
 		result = -1;
 	}
-	else if( result != 0 )
-	{
-		if( libfsntfs_volume_name_attribute_get_utf8_name(
-		     volume_name_attribute,
-		     utf8_string,
-		     utf8_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve UTF-8 name from volume name attribute.",
-			 function );
-
-			result = -1;
-		}
-	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2083,7 +4421,7 @@ int libfsntfs_volume_get_utf8_name(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -2092,20 +4430,17 @@ int libfsntfs_volume_get_utf8_name(
 	return( result );
 }
 
-/* Retrieves the size of the UTF-16 encoded name
- * The returned size includes the end of string character
- * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the number of file entries (MFT entries)
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_utf16_name_size(
+int libfsntfs_volume_get_number_of_file_entries(
      libfsntfs_volume_t *volume,
-     size_t *utf16_string_size,
+     uint64_t *number_of_file_entries,
      libcerror_error_t **error )
 {
-	libfsntfs_attribute_t *volume_name_attribute = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_utf16_name_size";
-	int result                                   = 0;
+	static char *function                        = "libfsntfs_volume_get_number_of_file_entries";
+	int result                                   = 1;
 
 	if( volume == NULL )
 	{
@@ -2121,7 +4456,7 @@ int libfsntfs_volume_get_utf16_name_size(
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2129,44 +4464,126 @@ int libfsntfs_volume_get_utf16_name_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libfsntfs_internal_volume_get_volume_name_attribute(
-	          internal_volume,
-	          &volume_name_attribute,
-	          error );
-
-	if( result == -1 )
+	if( libfsntfs_file_system_get_number_of_mft_entries(
+	     internal_volume->file_system,
+	     number_of_file_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume name attribute.",
+		 "%s: unable to retrieve number of MFT entries.",
 		 function );
 
 		result = -1;
 	}
-	else if( result != 0 )
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libfsntfs_volume_name_attribute_get_utf16_name_size(
-		     volume_name_attribute,
-		     utf16_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve size of UTF-16 name from volume name attribute.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the file entry of a specific MFT entry index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_file_entry_by_index(
+     libfsntfs_volume_t *volume,
+     uint64_t mft_entry_index,
+     libfsntfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_file_entry_by_index";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_file_entry_initialize(
+	     file_entry,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     internal_volume->file_system,
+	     mft_entry_index,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry with MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
 
-			result = -1;
-		}
+		result = -1;
 	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2186,21 +4603,43 @@ int libfsntfs_volume_get_utf16_name_size(
 	return( result );
 }
 
-/* Retrieves the UTF-16 encoded name
- * The size should include the end of string character
- * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Scans the MFT entries
+ * The MFT entries are divided into ranges that are scanned concurrently,
+ * each range with its own file IO handle and file system
+ * The volume is locked during the scan, hence the callback function cannot use
+ * the volume, it must not call any of the libfsntfs_volume functions, and closing
+ * the volume waits for the scan to complete
+ * The callback function is called with a file entry for every MFT entry,
+ * the file entry can be used by the callback function and is freed after
+ * the callback function returns
+ * The callback function should return 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful, 0 if the scan was stopped or -1 on error
  */
-int libfsntfs_volume_get_utf16_name(
+int libfsntfs_volume_scan_mft_entries(
      libfsntfs_volume_t *volume,
-     uint16_t *utf16_string,
-     size_t utf16_string_size,
+     int number_of_threads,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            uint64_t mft_entry_index,
+            void *user_data ),
+     void *user_data,
      libcerror_error_t **error )
 {
-	libfsntfs_attribute_t *volume_name_attribute = NULL;
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_utf16_name";
-	int result                                   = 0;
+	libfsntfs_internal_volume_t *internal_volume   = NULL;
+	libfsntfs_mft_scan_worker_t **mft_scan_workers = NULL;
+	static char *function                          = "libfsntfs_volume_scan_mft_entries";
+	off64_t mft_offset                             = 0;
+	uint64_t first_mft_entry_index                 = 0;
+	uint64_t number_of_mft_entries                 = 0;
+	uint64_t number_of_worker_mft_entries          = 0;
+	uint8_t stop_scan                              = 0;
+	int number_of_workers                          = 0;
+	int result                                     = 1;
+	int worker_index                               = 0;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_t *stop_scan_mutex           = NULL;
+#endif
 
 	if( volume == NULL )
 	{
@@ -2215,57 +4654,55 @@ int libfsntfs_volume_get_utf16_name(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libfsntfs_internal_volume_get_volume_name_attribute(
-	          internal_volume,
-	          &volume_name_attribute,
-	          error );
-
-	if( result == -1 )
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > LIBFSNTFS_MAXIMUM_NUMBER_OF_SCAN_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume name attribute.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	else if( result != 0 )
+	if( callback_function == NULL )
 	{
-		if( libfsntfs_volume_name_attribute_get_utf16_name(
-		     volume_name_attribute,
-		     utf16_string,
-		     utf16_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve UTF-16 name from volume name attribute.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_mutex_initialize(
+	     &stop_scan_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stop scan mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2273,93 +4710,274 @@ int libfsntfs_volume_get_utf16_name(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
+		libcthreads_mutex_free(
+		 &stop_scan_mutex,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
-	return( result );
-}
-
-/* Retrieves the version
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libfsntfs_volume_get_version(
-     libfsntfs_volume_t *volume,
-     uint8_t *major_version,
-     uint8_t *minor_version,
-     libcerror_error_t **error )
-{
-	libfsntfs_attribute_t *volume_information_attribute = NULL;
-	libfsntfs_internal_volume_t *internal_volume        = NULL;
-	static char *function                               = "libfsntfs_volume_get_version";
-	int result                                          = 0;
-
-	if( volume == NULL )
+	/* The volume remains locked for reading until the workers have completed
+	 * so that the volume cannot be closed while the workers are reading
+	 */
+	if( internal_volume->file_system == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file system.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	internal_volume = (libfsntfs_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	else if( libfsntfs_volume_header_get_mft_offset(
+	          internal_volume->volume_header,
+	          &mft_offset,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT offset.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	result = libfsntfs_internal_volume_get_volume_information_attribute(
-	          internal_volume,
-	          &volume_information_attribute,
-	          error );
-
-	if( result == -1 )
+	else if( libfsntfs_file_system_get_number_of_mft_entries(
+	          internal_volume->file_system,
+	          &number_of_mft_entries,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume information attribute.",
+		 "%s: unable to retrieve number of MFT entries.",
 		 function );
 
 		result = -1;
 	}
-	else if( result != 0 )
+	else if( number_of_mft_entries > 0 )
 	{
-		if( libfsntfs_volume_information_attribute_get_version(
-		     volume_information_attribute,
-		     major_version,
-		     minor_version,
-		     error ) != 1 )
+		number_of_workers = number_of_threads;
+
+		if( (uint64_t) number_of_workers > number_of_mft_entries )
+		{
+			number_of_workers = (int) number_of_mft_entries;
+		}
+		mft_scan_workers = (libfsntfs_mft_scan_worker_t **) memory_allocate(
+		                                                     sizeof( libfsntfs_mft_scan_worker_t * ) * number_of_workers );
+
+		if( mft_scan_workers == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve version from volume information attribute.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create MFT scan workers.",
+			 function );
+
+			result = -1;
+		}
+		else if( memory_set(
+		          mft_scan_workers,
+		          0,
+		          sizeof( libfsntfs_mft_scan_worker_t * ) * number_of_workers ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear MFT scan workers.",
 			 function );
 
+			memory_free(
+			 mft_scan_workers );
+
+			mft_scan_workers = NULL;
+
 			result = -1;
 		}
+		for( worker_index = 0;
+		     ( result == 1 ) && ( worker_index < number_of_workers );
+		     worker_index++ )
+		{
+			number_of_worker_mft_entries = ( number_of_mft_entries - first_mft_entry_index )
+			                             / (uint64_t) ( number_of_workers - worker_index );
+
+			if( libfsntfs_mft_scan_worker_initialize(
+			     &( mft_scan_workers[ worker_index ] ),
+			     internal_volume->io_handle,
+			     internal_volume->file_io_handle,
+			     mft_offset,
+			     first_mft_entry_index,
+			     number_of_worker_mft_entries,
+			     callback_function,
+			     user_data,
+			     &stop_scan,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create MFT scan worker: %d.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+			else
+			{
+				mft_scan_workers[ worker_index ]->stop_scan_mutex = stop_scan_mutex;
+			}
+#endif
+			first_mft_entry_index += number_of_worker_mft_entries;
+		}
 	}
+	if( result == 1 )
+	{
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( mft_scan_workers[ worker_index ]->thread ),
+			     NULL,
+			     (int (*)(void *)) &libfsntfs_mft_scan_worker_run,
+			     (void *) mft_scan_workers[ worker_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread: %d.",
+				 function,
+				 worker_index );
+
+				/* Signal the workers that already started to stop
+				 */
+				libfsntfs_mft_scan_worker_set_stop_scan(
+				 mft_scan_workers[ worker_index ],
+				 NULL );
+
+				result = -1;
+
+				break;
+			}
+		}
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			if( mft_scan_workers[ worker_index ]->thread == NULL )
+			{
+				continue;
+			}
+			if( libcthreads_thread_join(
+			     &( mft_scan_workers[ worker_index ]->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread: %d.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+#else
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			libfsntfs_mft_scan_worker_run(
+			 mft_scan_workers[ worker_index ] );
+		}
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			if( ( result == 1 )
+			 && ( mft_scan_workers[ worker_index ]->result == -1 ) )
+			{
+				/* Pass the error of the worker on to the caller
+				 */
+				if( ( error != NULL )
+				 && ( *error == NULL ) )
+				{
+					*error = mft_scan_workers[ worker_index ]->error;
+
+					mft_scan_workers[ worker_index ]->error = NULL;
+				}
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to scan MFT entries in worker: %d.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+		/* All the workers have completed hence the stop scan value is no longer shared
+		 */
+		if( result == 1 )
+		{
+			if( stop_scan != 0 )
+			{
+				result = 0;
+			}
+			else if( internal_volume->io_handle->abort != 0 )
+			{
+				result = 0;
+			}
+		}
+	}
+	if( mft_scan_workers != NULL )
+	{
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			if( mft_scan_workers[ worker_index ] == NULL )
+			{
+				continue;
+			}
+			if( libfsntfs_mft_scan_worker_free(
+			     &( mft_scan_workers[ worker_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MFT scan worker: %d.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 mft_scan_workers );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2367,27 +4985,44 @@ int libfsntfs_volume_get_version(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		result = -1;
+	}
+	if( libcthreads_mutex_free(
+	     &stop_scan_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free stop scan mutex.",
+		 function );
+
+		result = -1;
 	}
 #endif
 	return( result );
 }
 
-/* Retrieves the flags
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Builds a path table of all the MFT entries
+ * The MFT entries are read in a single sequential pass after which the paths
+ * are resolved from the parent file references without reading additional MFT entries
+ * The paths of MFT entries of which the parent is missing, has been reallocated,
+ * is part of a loop or exceeds the maximum recursion depth start with $Orphan
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_flags(
+int libfsntfs_volume_build_path_table(
      libfsntfs_volume_t *volume,
-     uint16_t *flags,
+     libfsntfs_path_table_t **path_table,
      libcerror_error_t **error )
 {
-	libfsntfs_attribute_t *volume_information_attribute = NULL;
-	libfsntfs_internal_volume_t *internal_volume        = NULL;
-	static char *function                               = "libfsntfs_volume_get_flags";
-	int result                                          = 0;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	libfsntfs_path_table_t *safe_path_table      = NULL;
+	static char *function                        = "libfsntfs_volume_build_path_table";
+	int result                                   = 1;
 
 	if( volume == NULL )
 	{
@@ -2402,6 +5037,41 @@ int libfsntfs_volume_get_flags(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
+	if( path_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_path_table_initialize(
+	     &safe_path_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create path table.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
@@ -2414,42 +5084,28 @@ int libfsntfs_volume_get_flags(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
+		libfsntfs_path_table_free(
+		 &safe_path_table,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
-	result = libfsntfs_internal_volume_get_volume_information_attribute(
-	          internal_volume,
-	          &volume_information_attribute,
-	          error );
-
-	if( result == -1 )
+	if( libfsntfs_internal_path_table_read_file_system(
+	     (libfsntfs_internal_path_table_t *) safe_path_table,
+	     internal_volume->file_system,
+	     internal_volume->file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume information attribute.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read path table.",
 		 function );
 
 		result = -1;
 	}
-	else if( result != 0 )
-	{
-		if( libfsntfs_volume_information_attribute_get_flags(
-		     volume_information_attribute,
-		     flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve flags from volume information attribute.",
-			 function );
-
-			result = -1;
-		}
-	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -2462,22 +5118,35 @@ int libfsntfs_volume_get_flags(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
+		libfsntfs_path_table_free(
+		 &safe_path_table,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
-	return( result );
+	if( result != 1 )
+	{
+		libfsntfs_path_table_free(
+		 &safe_path_table,
+		 NULL );
+
+		return( -1 );
+	}
+	*path_table = safe_path_table;
+
+	return( 1 );
 }
 
-/* Retrieves the serial number
+/* Reads the children index
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_serial_number(
+int libfsntfs_volume_read_children_index(
      libfsntfs_volume_t *volume,
-     uint64_t *serial_number,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_serial_number";
+	static char *function                        = "libfsntfs_volume_read_children_index";
 	int result                                   = 1;
 
 	if( volume == NULL )
@@ -2494,7 +5163,7 @@ int libfsntfs_volume_get_serial_number(
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2502,28 +5171,28 @@ int libfsntfs_volume_get_serial_number(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libfsntfs_volume_header_get_volume_serial_number(
-	     internal_volume->volume_header,
-	     serial_number,
+	if( libfsntfs_file_system_read_children_index(
+	     internal_volume->file_system,
+	     internal_volume->file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume serial number.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read children index.",
 		 function );
 
 		result = -1;
 	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2531,7 +5200,7 @@ int libfsntfs_volume_get_serial_number(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -2540,19 +5209,33 @@ int libfsntfs_volume_get_serial_number(
 	return( result );
 }
 
-/* Retrieves the number of file entries (MFT entries)
- * Returns 1 if successful or -1 on error
+/* Extracts the data of a file entry using a buffer
+ * This is used for data that cannot be mapped onto the volume, such as compressed data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the extraction was stopped or -1 on error
  */
-int libfsntfs_volume_get_number_of_file_entries(
-     libfsntfs_volume_t *volume,
-     uint64_t *number_of_file_entries,
+int libfsntfs_internal_volume_extract_file_entry_data(
+     libfsntfs_internal_volume_t *internal_volume,
+     uint64_t mft_entry_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     int (*callback_function)(
+            uint64_t mft_entry_index,
+            off64_t data_offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
      libcerror_error_t **error )
 {
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_number_of_file_entries";
-	int result                                   = 1;
+	libfsntfs_file_entry_t *file_entry = NULL;
+	static char *function              = "libfsntfs_internal_volume_extract_file_entry_data";
+	size64_t data_size                 = 0;
+	ssize_t read_count                 = 0;
+	off64_t data_offset                = 0;
+	int result                         = 1;
 
-	if( volume == NULL )
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2563,67 +5246,191 @@ int libfsntfs_volume_get_number_of_file_entries(
 
 		return( -1 );
 	}
-	internal_volume = (libfsntfs_internal_volume_t *) volume;
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libfsntfs_file_system_get_number_of_mft_entries(
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_file_entry_initialize(
+	     &file_entry,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
 	     internal_volume->file_system,
-	     number_of_file_entries,
+	     mft_entry_index,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry with MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	if( libfsntfs_file_entry_get_size(
+	     file_entry,
+	     &data_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of MFT entries.",
-		 function );
+		 "%s: unable to retrieve size of file entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
 
-		result = -1;
+		goto on_error;
 	}
-#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
+	while( (size64_t) data_offset < data_size )
+	{
+		read_count = libfsntfs_file_entry_pread_buffer(
+		              file_entry,
+		              buffer,
+		              buffer_size,
+		              data_offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data of file entry: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 mft_entry_index,
+			 data_offset,
+			 data_offset );
+
+			goto on_error;
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		result = callback_function(
+		          mft_entry_index,
+		          data_offset,
+		          buffer,
+		          (size_t) read_count,
+		          user_data );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: callback function failed for MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		else if( result != 1 )
+		{
+			result = 0;
+
+			break;
+		}
+		data_offset += (off64_t) read_count;
+	}
+	if( libfsntfs_file_entry_free(
+	     &file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file entry.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
 	return( result );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the file entry of a specific MFT entry index
- * Returns 1 if successful or -1 on error
+/* Extracts the data of multiple MFT entries in the order it is stored in the volume
+ * The data runs of the default data stream of the MFT entries are gathered first
+ * and the data is then read in a single forward pass over the volume, which
+ * avoids the seeks of extracting the MFT entries one after the other
+ * The callback function is called for every part of the data with the MFT entry index
+ * and the offset of the part in the data. The parts of an MFT entry are not passed
+ * in order and the parts of different MFT entries are interleaved. Data that cannot
+ * be mapped onto the volume, such as compressed data, is passed after the forward
+ * pass. MFT entries without data are skipped
+ * The volume is locked during the extraction, hence the callback function
+ * cannot use the volume and closing the volume waits for the extraction to complete
+ * The callback function should return 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful, 0 if the extraction was stopped or -1 on error
  */
-int libfsntfs_volume_get_file_entry_by_index(
+int libfsntfs_volume_extract_data(
      libfsntfs_volume_t *volume,
-     uint64_t mft_entry_index,
-     libfsntfs_file_entry_t **file_entry,
+     const uint64_t *mft_entry_indexes,
+     int number_of_mft_entry_indexes,
+     int (*callback_function)(
+            uint64_t mft_entry_index,
+            off64_t data_offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
      libcerror_error_t **error )
 {
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_file_entry_by_index";
-	int result                                   = 1;
+	libfsntfs_extraction_scheduler_t *extraction_scheduler = NULL;
+	libfsntfs_file_entry_t *file_entry                     = NULL;
+	libfsntfs_internal_file_entry_t *internal_file_entry   = NULL;
+	libfsntfs_internal_volume_t *internal_volume           = NULL;
+	libfsntfs_read_queue_t *read_queue                     = NULL;
+	uint64_t *unmapped_mft_entry_indexes                   = NULL;
+	static char *function                                  = "libfsntfs_volume_extract_data";
+	int entry_index                                        = 0;
+	int number_of_unmapped_mft_entry_indexes               = 0;
+	int result                                             = 1;
 
 	if( volume == NULL )
 	{
@@ -2638,27 +5445,71 @@ int libfsntfs_volume_get_file_entry_by_index(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
-	if( file_entry == NULL )
+	if( mft_entry_indexes == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file entry.",
+		 "%s: invalid MFT entry indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_mft_entry_indexes < 0 )
+	 || ( (size_t) number_of_mft_entry_indexes > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of MFT entry indexes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_mft_entry_indexes == 0 )
+	{
+		return( 1 );
+	}
+	if( libfsntfs_extraction_scheduler_initialize(
+	     &extraction_scheduler,
+	     LIBFSNTFS_EXTRACTION_SCHEDULER_BUFFER_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extraction scheduler.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( *file_entry != NULL )
+	unmapped_mft_entry_indexes = (uint64_t *) memory_allocate(
+	                                           sizeof( uint64_t ) * (size_t) number_of_mft_entry_indexes );
+
+	if( unmapped_mft_entry_indexes == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file entry value already set.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create unmapped MFT entry indexes.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
@@ -2672,28 +5523,146 @@ int libfsntfs_volume_get_file_entry_by_index(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	if( libfsntfs_file_entry_initialize(
-	     file_entry,
-	     internal_volume->io_handle,
-	     internal_volume->file_io_handle,
-	     internal_volume->file_system,
-	     mft_entry_index,
-	     NULL,
-	     0,
-	     error ) != 1 )
+	for( entry_index = 0;
+	     entry_index < number_of_mft_entry_indexes;
+	     entry_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file entry with MFT entry: %" PRIu64 ".",
-		 function,
-		 mft_entry_index );
+		if( libfsntfs_file_entry_initialize(
+		     &file_entry,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     internal_volume->file_system,
+		     mft_entry_indexes[ entry_index ],
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file entry with MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_indexes[ entry_index ] );
 
-		result = -1;
+			result = -1;
+
+			break;
+		}
+		internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+		if( internal_file_entry->data_segment_table != NULL )
+		{
+			if( libfsntfs_extraction_scheduler_append_data_segment_table(
+			     extraction_scheduler,
+			     mft_entry_indexes[ entry_index ],
+			     internal_file_entry->data_segment_table,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append data of MFT entry: %" PRIu64 " to extraction scheduler.",
+				 function,
+				 mft_entry_indexes[ entry_index ] );
+
+				result = -1;
+			}
+		}
+		else if( internal_file_entry->data_cluster_block_stream != NULL )
+		{
+			unmapped_mft_entry_indexes[ number_of_unmapped_mft_entry_indexes++ ] = mft_entry_indexes[ entry_index ];
+		}
+		if( libfsntfs_file_entry_free(
+		     &file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file entry.",
+			 function );
+
+			result = -1;
+		}
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	/* The read queue clones the file IO handle hence it is created while
+	 * the volume is locked
+	 */
+	if( ( result == 1 )
+	 && ( internal_volume->io_handle->read_queue_depth > 1 ) )
+	{
+		if( libfsntfs_read_queue_initialize(
+		     &read_queue,
+		     internal_volume->file_io_handle,
+		     internal_volume->io_handle->read_queue_depth,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The volume remains locked during the extraction so that the volume
+	 * cannot be closed while its file IO handle is being read
+	 */
+	if( result == 1 )
+	{
+		result = libfsntfs_extraction_scheduler_run(
+		          extraction_scheduler,
+		          internal_volume->file_io_handle,
+		          read_queue,
+		          callback_function,
+		          user_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run extraction scheduler.",
+			 function );
+		}
+	}
+	for( entry_index = 0;
+	     ( result == 1 ) && ( entry_index < number_of_unmapped_mft_entry_indexes );
+	     entry_index++ )
+	{
+		result = libfsntfs_internal_volume_extract_file_entry_data(
+		          internal_volume,
+		          unmapped_mft_entry_indexes[ entry_index ],
+		          extraction_scheduler->buffer,
+		          extraction_scheduler->buffer_size,
+		          callback_function,
+		          user_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to extract data of MFT entry: %" PRIu64 ".",
+			 function,
+			 unmapped_mft_entry_indexes[ entry_index ] );
+		}
 	}
 #if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2707,10 +5676,69 @@ int libfsntfs_volume_get_file_entry_by_index(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
 #endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	memory_free(
+	 unmapped_mft_entry_indexes );
+
+	unmapped_mft_entry_indexes = NULL;
+
+	if( read_queue != NULL )
+	{
+		if( libfsntfs_read_queue_free(
+		     &read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
+
+	if( libfsntfs_extraction_scheduler_free(
+	     &extraction_scheduler,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free extraction scheduler.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
+
+on_error:
+	if( unmapped_mft_entry_indexes != NULL )
+	{
+		memory_free(
+		 unmapped_mft_entry_indexes );
+	}
+	if( read_queue != NULL )
+	{
+		libfsntfs_read_queue_free(
+		 &read_queue,
+		 NULL );
+	}
+	if( extraction_scheduler != NULL )
+	{
+		libfsntfs_extraction_scheduler_free(
+		 &extraction_scheduler,
+		 NULL );
+	}
+	return( -1 );
 }
 
 /* Retrieves the MFT entry for an UTF-8 encoded path
@@ -2726,6 +5754,7 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
      libcerror_error_t **error )
 {
 	libfsntfs_directory_entries_tree_t *directory_entries_tree = NULL;
+	libfsntfs_directory_entry_t *cached_directory_entry        = NULL;
 	libfsntfs_directory_entry_t *safe_directory_entry          = NULL;
 	const uint8_t *utf8_string_segment                         = NULL;
 	static char *function                                      = "libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path";
@@ -2733,6 +5762,8 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
 	size_t utf8_string_index                                   = 0;
 	size_t utf8_string_segment_length                          = 0;
 	uint64_t mft_entry_index                                   = 0;
+	uint64_t parent_file_reference                             = 0;
+	uint8_t read_mft_entry                                     = 0;
 	int result                                                 = 0;
 
 	if( internal_volume == NULL )
@@ -2815,6 +5846,20 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
 
 		goto on_error;
 	}
+	if( libfsntfs_mft_entry_get_file_reference(
+	     *mft_entry,
+	     &parent_file_reference,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file reference from MFT entry: 5.",
+		 function );
+
+		goto on_error;
+	}
 	if( ( utf8_string_length == 0 )
 	 || ( utf8_string_length == 1 ) )
 	{
@@ -2822,143 +5867,242 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
 	}
 	else while( utf8_string_index < utf8_string_length )
 	{
-		if( directory_entries_tree != NULL )
+		utf8_string_segment        = &( utf8_string[ utf8_string_index ] );
+		utf8_string_segment_length = utf8_string_index;
+
+		while( utf8_string_index < utf8_string_length )
+		{
+			if( libuna_unicode_character_copy_from_utf8(
+			     &unicode_character,
+			     utf8_string,
+			     utf8_string_length,
+			     &utf8_string_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy UTF-8 string to Unicode character.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( unicode_character == (libuna_unicode_character_t) LIBFSNTFS_SEPARATOR )
+			 || ( unicode_character == 0 ) )
+			{
+				utf8_string_segment_length += 1;
+
+				break;
+			}
+		}
+		utf8_string_segment_length = utf8_string_index - utf8_string_segment_length;
+
+		if( utf8_string_segment_length == 0 )
+		{
+			result = 0;
+
+			break;
+		}
+		if( safe_directory_entry != NULL )
+		{
+			if( libfsntfs_directory_entry_free(
+			     &safe_directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory entry.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* Path components that were resolved before are retrieved from the path
+		 * component cache, which does not require the directory entries tree
+		 * of the parent to be read
+		 */
+		result = 0;
+
+		if( internal_volume->file_system->path_component_cache != NULL )
+		{
+			result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+			          internal_volume->file_system->path_component_cache,
+			          parent_file_reference,
+			          utf8_string_segment,
+			          utf8_string_segment_length,
+			          &cached_directory_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry by UTF-8 name from path component cache.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( libfsntfs_directory_entry_clone(
+				     &safe_directory_entry,
+				     cached_directory_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create directory entry.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( result == 0 )
 		{
-			if( libfsntfs_directory_entries_tree_free(
+			if( read_mft_entry != 0 )
+			{
+				mft_entry_index = parent_file_reference & 0xffffffffffffUL;
+
+				if( libfsntfs_file_system_get_mft_entry_by_index(
+				     internal_volume->file_system,
+				     internal_volume->file_io_handle,
+				     mft_entry_index,
+				     mft_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+					 function,
+					 mft_entry_index );
+
+					goto on_error;
+				}
+				read_mft_entry = 0;
+			}
+			if( directory_entries_tree != NULL )
+			{
+				if( libfsntfs_directory_entries_tree_free(
+				     &directory_entries_tree,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free directory entries tree.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libfsntfs_directory_entries_tree_initialize(
 			     &directory_entries_tree,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free directory entries tree.",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create directory entries tree.",
 				 function );
 
 				goto on_error;
 			}
-		}
-		if( libfsntfs_directory_entries_tree_initialize(
-		     &directory_entries_tree,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create directory entries tree.",
-			 function );
+			directory_entries_tree->upcase_table = internal_volume->file_system->upcase_table;
 
-			goto on_error;
-		}
-		if( libfsntfs_directory_entries_tree_read_from_i30_index(
-		     directory_entries_tree,
-		     internal_volume->io_handle,
-		     internal_volume->file_io_handle,
-		     *mft_entry,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read directory entries tree from MFT entry: %" PRIu64 ".",
-			 function,
-			 mft_entry_index );
+			if( libfsntfs_directory_entries_tree_read_from_i30_index(
+			     directory_entries_tree,
+			     internal_volume->io_handle,
+			     internal_volume->file_io_handle,
+			     *mft_entry,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read directory entries tree from MFT entry: %" PRIu64 ".",
+				 function,
+				 mft_entry_index );
 
-			goto on_error;
-		}
-		utf8_string_segment        = &( utf8_string[ utf8_string_index ] );
-		utf8_string_segment_length = utf8_string_index;
+				goto on_error;
+			}
+			result = libfsntfs_directory_entries_tree_get_entry_by_utf8_name(
+			          directory_entries_tree,
+			          internal_volume->file_io_handle,
+			          utf8_string_segment,
+			          utf8_string_segment_length,
+			          &safe_directory_entry,
+			          error );
 
-		while( utf8_string_index < utf8_string_length )
-		{
-			if( libuna_unicode_character_copy_from_utf8(
-			     &unicode_character,
-			     utf8_string,
-			     utf8_string_length,
-			     &utf8_string_index,
-			     error ) != 1 )
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-				 "%s: unable to copy UTF-8 string to Unicode character.",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry by UTF-8 name.",
 				 function );
 
 				goto on_error;
 			}
-			if( ( unicode_character == (libuna_unicode_character_t) LIBFSNTFS_SEPARATOR )
-			 || ( unicode_character == 0 ) )
+			else if( result == 0 )
 			{
-				utf8_string_segment_length += 1;
-
 				break;
 			}
-		}
-		utf8_string_segment_length = utf8_string_index - utf8_string_segment_length;
-
-		if( utf8_string_segment_length == 0 )
-		{
-			result = 0;
-		}
-		else
-		{
-			if( safe_directory_entry != NULL )
+			if( internal_volume->file_system->path_component_cache != NULL )
 			{
-				if( libfsntfs_directory_entry_free(
-				     &safe_directory_entry,
+				if( libfsntfs_path_component_cache_set_directory_entry(
+				     internal_volume->file_system->path_component_cache,
+				     parent_file_reference,
+				     directory_entries_tree->use_case_folding,
+				     safe_directory_entry,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free directory entry.",
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set directory entry in path component cache.",
 					 function );
 
 					goto on_error;
 				}
 			}
-			result = libfsntfs_directory_entries_tree_get_entry_by_utf8_name(
-			          directory_entries_tree,
-			          internal_volume->file_io_handle,
-			          utf8_string_segment,
-			          utf8_string_segment_length,
-			          &safe_directory_entry,
-			          error );
 		}
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve directory entry by UTF-8 name.",
-			 function );
-
-			goto on_error;
-		}
-		else if( result == 0 )
-		{
-			break;
-		}
-		if( libfsntfs_directory_entry_get_mft_entry_index(
+		if( libfsntfs_directory_entry_get_file_reference(
 		     safe_directory_entry,
-		     &mft_entry_index,
+		     &parent_file_reference,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve MFT entry index.",
+			 "%s: unable to retrieve file reference.",
 			 function );
 
 			goto on_error;
 		}
+		read_mft_entry = 1;
+	}
+	if( ( result != 0 )
+	 && ( read_mft_entry != 0 ) )
+	{
+		mft_entry_index = parent_file_reference & 0xffffffffffffUL;
+
 		if( libfsntfs_file_system_get_mft_entry_by_index(
 		     internal_volume->file_system,
 		     internal_volume->file_io_handle,
@@ -3188,6 +6332,7 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
      libcerror_error_t **error )
 {
 	libfsntfs_directory_entries_tree_t *directory_entries_tree = NULL;
+	libfsntfs_directory_entry_t *cached_directory_entry        = NULL;
 	libfsntfs_directory_entry_t *safe_directory_entry          = NULL;
 	const uint16_t *utf16_string_segment                       = NULL;
 	static char *function                                      = "libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path";
@@ -3195,6 +6340,8 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	size_t utf16_string_index                                  = 0;
 	size_t utf16_string_segment_length                         = 0;
 	uint64_t mft_entry_index                                   = 0;
+	uint64_t parent_file_reference                             = 0;
+	uint8_t read_mft_entry                                     = 0;
 	int result                                                 = 0;
 
 	if( internal_volume == NULL )
@@ -3277,6 +6424,20 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 
 		goto on_error;
 	}
+	if( libfsntfs_mft_entry_get_file_reference(
+	     *mft_entry,
+	     &parent_file_reference,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file reference from MFT entry: 5.",
+		 function );
+
+		goto on_error;
+	}
 	if( ( utf16_string_length == 0 )
 	 || ( utf16_string_length == 1 ) )
 	{
@@ -3284,53 +6445,6 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	}
 	else while( utf16_string_index < utf16_string_length )
 	{
-		if( directory_entries_tree != NULL )
-		{
-			if( libfsntfs_directory_entries_tree_free(
-			     &directory_entries_tree,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free directory entries tree.",
-				 function );
-
-				goto on_error;
-			}
-		}
-		if( libfsntfs_directory_entries_tree_initialize(
-		     &directory_entries_tree,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create directory entries tree.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsntfs_directory_entries_tree_read_from_i30_index(
-		     directory_entries_tree,
-		     internal_volume->io_handle,
-		     internal_volume->file_io_handle,
-		     *mft_entry,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read directory entries tree from MFT entry: %" PRIu64 ".",
-			 function,
-			 mft_entry_index );
-
-			goto on_error;
-		}
 		utf16_string_segment        = &( utf16_string[ utf16_string_index ] );
 		utf16_string_segment_length = utf16_string_index;
 
@@ -3365,25 +6479,144 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 		if( utf16_string_segment_length == 0 )
 		{
 			result = 0;
+
+			break;
 		}
-		else
+		if( safe_directory_entry != NULL )
+		{
+			if( libfsntfs_directory_entry_free(
+			     &safe_directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory entry.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* Path components that were resolved before are retrieved from the path
+		 * component cache, which does not require the directory entries tree
+		 * of the parent to be read
+		 */
+		result = 0;
+
+		if( internal_volume->file_system->path_component_cache != NULL )
 		{
-			if( safe_directory_entry != NULL )
+			result = libfsntfs_path_component_cache_get_directory_entry_by_utf16_name(
+			          internal_volume->file_system->path_component_cache,
+			          parent_file_reference,
+			          utf16_string_segment,
+			          utf16_string_segment_length,
+			          &cached_directory_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry by UTF-16 name from path component cache.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
 			{
-				if( libfsntfs_directory_entry_free(
+				if( libfsntfs_directory_entry_clone(
 				     &safe_directory_entry,
+				     cached_directory_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create directory entry.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( result == 0 )
+		{
+			if( read_mft_entry != 0 )
+			{
+				mft_entry_index = parent_file_reference & 0xffffffffffffUL;
+
+				if( libfsntfs_file_system_get_mft_entry_by_index(
+				     internal_volume->file_system,
+				     internal_volume->file_io_handle,
+				     mft_entry_index,
+				     mft_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+					 function,
+					 mft_entry_index );
+
+					goto on_error;
+				}
+				read_mft_entry = 0;
+			}
+			if( directory_entries_tree != NULL )
+			{
+				if( libfsntfs_directory_entries_tree_free(
+				     &directory_entries_tree,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free directory entry.",
+					 "%s: unable to free directory entries tree.",
 					 function );
 
 					goto on_error;
 				}
 			}
+			if( libfsntfs_directory_entries_tree_initialize(
+			     &directory_entries_tree,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create directory entries tree.",
+				 function );
+
+				goto on_error;
+			}
+			directory_entries_tree->upcase_table = internal_volume->file_system->upcase_table;
+
+			if( libfsntfs_directory_entries_tree_read_from_i30_index(
+			     directory_entries_tree,
+			     internal_volume->io_handle,
+			     internal_volume->file_io_handle,
+			     *mft_entry,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read directory entries tree from MFT entry: %" PRIu64 ".",
+				 function,
+				 mft_entry_index );
+
+				goto on_error;
+			}
 			result = libfsntfs_directory_entries_tree_get_entry_by_utf16_name(
 			          directory_entries_tree,
 			          internal_volume->file_io_handle,
@@ -3391,36 +6624,63 @@ int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 			          utf16_string_segment_length,
 			          &safe_directory_entry,
 			          error );
-		}
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve directory entry by UTF-16 name.",
-			 function );
 
-			goto on_error;
-		}
-		else if( result == 0 )
-		{
-			break;
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry by UTF-16 name.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			if( internal_volume->file_system->path_component_cache != NULL )
+			{
+				if( libfsntfs_path_component_cache_set_directory_entry(
+				     internal_volume->file_system->path_component_cache,
+				     parent_file_reference,
+				     directory_entries_tree->use_case_folding,
+				     safe_directory_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set directory entry in path component cache.",
+					 function );
+
+					goto on_error;
+				}
+			}
 		}
-		if( libfsntfs_directory_entry_get_mft_entry_index(
+		if( libfsntfs_directory_entry_get_file_reference(
 		     safe_directory_entry,
-		     &mft_entry_index,
+		     &parent_file_reference,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve MFT entry index.",
+			 "%s: unable to retrieve file reference.",
 			 function );
 
 			goto on_error;
 		}
+		read_mft_entry = 1;
+	}
+	if( ( result != 0 )
+	 && ( read_mft_entry != 0 ) )
+	{
+		mft_entry_index = parent_file_reference & 0xffffffffffffUL;
+
 		if( libfsntfs_file_system_get_mft_entry_by_index(
 		     internal_volume->file_system,
 		     internal_volume->file_io_handle,
@@ -3890,3 +7150,329 @@ on_error:
 	return( -1 );
 }
 
+/* Determines if a specific cluster is allocated
+ * The bitmap ($Bitmap) is read on first use
+ * Returns 1 if allocated, 0 if not or -1 on error
+ */
+int libfsntfs_volume_is_cluster_allocated(
+     libfsntfs_volume_t *volume,
+     uint64_t cluster_number,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_allocation_map_t *cluster_allocation_map = NULL;
+	libfsntfs_internal_volume_t *internal_volume               = NULL;
+	static char *function                                      = "libfsntfs_volume_is_cluster_allocated";
+	int result                                                 = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_file_system_get_cluster_allocation_map(
+	          internal_volume->file_system,
+	          internal_volume->io_handle,
+	          internal_volume->file_io_handle,
+	          &cluster_allocation_map,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster allocation map.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		result = libfsntfs_cluster_allocation_map_is_cluster_allocated(
+		          cluster_allocation_map,
+		          cluster_number,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if cluster: %" PRIu64 " is allocated.",
+			 function,
+			 cluster_number );
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of unallocated ranges
+ * The bitmap ($Bitmap) is read on first use
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_number_of_unallocated_ranges(
+     libfsntfs_volume_t *volume,
+     int *number_of_ranges,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_allocation_map_t *cluster_allocation_map = NULL;
+	libfsntfs_internal_volume_t *internal_volume               = NULL;
+	static char *function                                      = "libfsntfs_volume_get_number_of_unallocated_ranges";
+	int result                                                 = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_file_system_get_cluster_allocation_map(
+	          internal_volume->file_system,
+	          internal_volume->io_handle,
+	          internal_volume->file_io_handle,
+	          &cluster_allocation_map,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster allocation map.",
+		 function );
+
+		result = -1;
+	}
+	else if( libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges(
+	          cluster_allocation_map,
+	          number_of_ranges,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of unallocated ranges.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific unallocated range
+ * The range offset and size are in bytes relative to the start of the volume
+ * The bitmap ($Bitmap) is read on first use
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_unallocated_range_by_index(
+     libfsntfs_volume_t *volume,
+     int range_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_allocation_map_t *cluster_allocation_map = NULL;
+	libfsntfs_internal_volume_t *internal_volume               = NULL;
+	static char *function                                      = "libfsntfs_volume_get_unallocated_range_by_index";
+	uint64_t first_cluster_number                              = 0;
+	uint64_t number_of_clusters                                = 0;
+	int result                                                 = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_file_system_get_cluster_allocation_map(
+	          internal_volume->file_system,
+	          internal_volume->io_handle,
+	          internal_volume->file_io_handle,
+	          &cluster_allocation_map,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster allocation map.",
+		 function );
+
+		result = -1;
+	}
+	else if( libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+	          cluster_allocation_map,
+	          range_index,
+	          &first_cluster_number,
+	          &number_of_clusters,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve unallocated range: %d.",
+		 function,
+		 range_index );
+
+		result = -1;
+	}
+	else
+	{
+		*range_offset = (off64_t) ( first_cluster_number * internal_volume->io_handle->cluster_block_size );
+		*range_size   = (size64_t) ( number_of_clusters * internal_volume->io_handle->cluster_block_size );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
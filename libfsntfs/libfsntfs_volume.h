@@ -32,6 +32,8 @@
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcthreads.h"
+#include "libfsntfs_memory_map.h"
+#include "libfsntfs_metadata_cache.h"
 #include "libfsntfs_mft.h"
 #include "libfsntfs_mft_entry.h"
 #include "libfsntfs_types.h"
@@ -61,10 +63,24 @@ struct libfsntfs_internal_volume
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The memory map, used when the volume was opened mapped
+	 */
+	libfsntfs_memory_map_t *memory_map;
+
 	/* The volume serial number
 	 */
 	uint64_t volume_serial_number;
 
+	/* The metadata cache filename
+	 */
+	char *metadata_cache_filename;
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+	/* The metadata cache filename
+	 */
+	wchar_t *metadata_cache_filename_wide;
+#endif
+
 	/* The volume header
 	 */
 	libfsntfs_volume_header_t *volume_header;
@@ -118,6 +134,13 @@ int libfsntfs_volume_open(
      int access_flags,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_open_mapped(
+     libfsntfs_volume_t *volume,
+     const char *filename,
+     int access_flags,
+     libcerror_error_t **error );
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
 LIBFSNTFS_EXTERN \
@@ -127,6 +150,13 @@ int libfsntfs_volume_open_wide(
      int access_flags,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_open_mapped_wide(
+     libfsntfs_volume_t *volume,
+     const wchar_t *filename,
+     int access_flags,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
 LIBFSNTFS_EXTERN \
@@ -141,11 +171,90 @@ int libfsntfs_volume_close(
      libfsntfs_volume_t *volume,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_metadata_cache_filename(
+     libfsntfs_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_metadata_cache_filename_wide(
+     libfsntfs_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_write_metadata_cache(
+     libfsntfs_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_write_metadata_cache_wide(
+     libfsntfs_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_mft_readahead_size(
+     libfsntfs_volume_t *volume,
+     size_t readahead_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_data_readahead_size(
+     libfsntfs_volume_t *volume,
+     size_t readahead_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_read_queue_depth(
+     libfsntfs_volume_t *volume,
+     int read_queue_depth,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_number_of_async_read_threads(
+     libfsntfs_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_cache_limits(
+     libfsntfs_volume_t *volume,
+     size64_t mft_entry_cache_size,
+     size64_t index_node_cache_size,
+     size64_t compressed_block_cache_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_maximum_number_of_path_hints(
+     libfsntfs_volume_t *volume,
+     int maximum_number_of_path_hints,
+     libcerror_error_t **error );
+
 int libfsntfs_internal_volume_open_read(
      libfsntfs_internal_volume_t *internal_volume,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libfsntfs_internal_volume_read_metadata_cache(
+     libfsntfs_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_volume_write_metadata_cache(
+     libfsntfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *metadata_cache_file_io_handle,
+     libcerror_error_t **error );
+
 int libfsntfs_internal_volume_read_bitmap(
      libfsntfs_internal_volume_t *internal_volume,
      libbfio_handle_t *file_io_handle,
@@ -253,6 +362,56 @@ int libfsntfs_volume_get_file_entry_by_index(
      libfsntfs_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_scan_mft_entries(
+     libfsntfs_volume_t *volume,
+     int number_of_threads,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            uint64_t mft_entry_index,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_build_path_table(
+     libfsntfs_volume_t *volume,
+     libfsntfs_path_table_t **path_table,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_read_children_index(
+     libfsntfs_volume_t *volume,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_volume_extract_file_entry_data(
+     libfsntfs_internal_volume_t *internal_volume,
+     uint64_t mft_entry_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     int (*callback_function)(
+            uint64_t mft_entry_index,
+            off64_t data_offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_extract_data(
+     libfsntfs_volume_t *volume,
+     const uint64_t *mft_entry_indexes,
+     int number_of_mft_entry_indexes,
+     int (*callback_function)(
+            uint64_t mft_entry_index,
+            off64_t data_offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
 int libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
      libfsntfs_internal_volume_t *internal_volume,
      const uint8_t *utf8_string,
@@ -297,6 +456,26 @@ int libfsntfs_volume_get_usn_change_journal(
      libfsntfs_usn_change_journal_t **usn_change_journal,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_is_cluster_allocated(
+     libfsntfs_volume_t *volume,
+     uint64_t cluster_number,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_get_number_of_unallocated_ranges(
+     libfsntfs_volume_t *volume,
+     int *number_of_ranges,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_get_unallocated_range_by_index(
+     libfsntfs_volume_t *volume,
+     int range_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
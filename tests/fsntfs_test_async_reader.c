@@ -0,0 +1,1037 @@
+/*
+ * Library async_reader type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_functions.h"
+#include "fsntfs_test_libbfio.h"
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_async_reader.h"
+#include "../libfsntfs/libfsntfs_definitions.h"
+
+#define FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS	64
+
+typedef struct fsntfs_test_async_reader_result fsntfs_test_async_reader_result_t;
+
+struct fsntfs_test_async_reader_result
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The number of bytes read
+	 */
+	ssize_t read_count;
+
+	/* Value to indicate an error was passed
+	 */
+	int has_error;
+
+	/* The number of times the callback function was called
+	 */
+	int number_of_calls;
+};
+
+uint8_t fsntfs_test_async_reader_data[ 4096 ];
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Reads data for the asynchronous reader tests
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t fsntfs_test_async_reader_read_function(
+         intptr_t *object FSNTFS_TEST_ATTRIBUTE_UNUSED,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( object )
+
+	return( libbfio_handle_read_buffer_at_offset(
+	         file_io_handle,
+	         buffer,
+	         buffer_size,
+	         offset,
+	         error ) );
+}
+
+/* Fails to read data for the asynchronous reader tests
+ * Returns -1 on error
+ */
+ssize_t fsntfs_test_async_reader_failing_read_function(
+         intptr_t *object FSNTFS_TEST_ATTRIBUTE_UNUSED,
+         libbfio_handle_t *file_io_handle FSNTFS_TEST_ATTRIBUTE_UNUSED,
+         uint8_t *buffer FSNTFS_TEST_ATTRIBUTE_UNUSED,
+         size_t buffer_size FSNTFS_TEST_ATTRIBUTE_UNUSED,
+         off64_t offset FSNTFS_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "fsntfs_test_async_reader_failing_read_function";
+
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( object )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( buffer )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( buffer_size )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( offset )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "%s: unable to read.",
+	 function );
+
+	return( -1 );
+}
+
+/* Stores the result of an asynchronous read
+ */
+void fsntfs_test_async_reader_callback_function(
+      intptr_t *object FSNTFS_TEST_ATTRIBUTE_UNUSED,
+      uint8_t *buffer FSNTFS_TEST_ATTRIBUTE_UNUSED,
+      ssize_t read_count,
+      off64_t offset,
+      libcerror_error_t *error,
+      void *user_data )
+{
+	fsntfs_test_async_reader_result_t *read_result = NULL;
+
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( object )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	read_result = (fsntfs_test_async_reader_result_t *) user_data;
+
+	read_result->offset           = offset;
+	read_result->read_count       = read_count;
+	read_result->has_error        = ( error != NULL );
+	read_result->number_of_calls += 1;
+}
+
+/* Tests the libfsntfs_async_reader_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_async_reader_initialize(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libfsntfs_async_reader_t *async_reader = NULL;
+	int result                             = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests        = 1;
+	int number_of_memset_fail_tests        = 1;
+	int test_number                        = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_async_reader_initialize(
+	          &async_reader,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "async_reader",
+	 async_reader );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "async_reader->number_of_threads",
+	 async_reader->number_of_threads,
+	 LIBFSNTFS_DEFAULT_NUMBER_OF_ASYNC_READ_THREADS );
+
+	result = libfsntfs_async_reader_free(
+	          &async_reader,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_async_reader_initialize(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	async_reader = (libfsntfs_async_reader_t *) 0x12345678UL;
+
+	result = libfsntfs_async_reader_initialize(
+	          &async_reader,
+	          &error );
+
+	async_reader = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_async_reader_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_async_reader_initialize(
+		          &async_reader,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( async_reader != NULL )
+			{
+				libfsntfs_async_reader_free(
+				 &async_reader,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "async_reader",
+			 async_reader );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_async_reader_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_async_reader_initialize(
+		          &async_reader,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( async_reader != NULL )
+			{
+				libfsntfs_async_reader_free(
+				 &async_reader,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "async_reader",
+			 async_reader );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_reader != NULL )
+	{
+		libfsntfs_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_async_reader_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_async_reader_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_async_reader_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_async_reader_set_number_of_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_async_reader_set_number_of_threads(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libfsntfs_async_reader_t *async_reader = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_async_reader_initialize(
+	          &async_reader,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "async_reader",
+	 async_reader );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_async_reader_set_number_of_threads(
+	          async_reader,
+	          2,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "async_reader->number_of_threads",
+	 async_reader->number_of_threads,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_async_reader_set_number_of_threads(
+	          NULL,
+	          2,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_set_number_of_threads(
+	          async_reader,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_set_number_of_threads(
+	          async_reader,
+	          LIBFSNTFS_MAXIMUM_NUMBER_OF_ASYNC_READ_THREADS + 1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_async_reader_free(
+	          &async_reader,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_reader != NULL )
+	{
+		libfsntfs_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_async_reader_submit_read and libfsntfs_async_reader_stop functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_async_reader_submit_read(
+     void )
+{
+	uint8_t buffers[ FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS ][ 64 ];
+
+	fsntfs_test_async_reader_result_t read_results[ FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS ];
+
+	libbfio_handle_t *file_io_handle       = NULL;
+	libcerror_error_t *error               = NULL;
+	libfsntfs_async_reader_t *async_reader = NULL;
+	off64_t read_offset                    = 0;
+	int data_index                         = 0;
+	int read_index                         = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 4096;
+	     data_index++ )
+	{
+		fsntfs_test_async_reader_data[ data_index ] = (uint8_t) ( data_index / 64 );
+	}
+	result = fsntfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsntfs_test_async_reader_data,
+	          4096,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_async_reader_initialize(
+	          &async_reader,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_set(
+	          read_results,
+	          0,
+	          sizeof( fsntfs_test_async_reader_result_t ) * FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS ) != NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 * The reads are submitted in reverse order of their offsets
+	 */
+	for( read_index = 0;
+	     read_index < FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS;
+	     read_index++ )
+	{
+		read_offset = (off64_t) ( FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS - 1 - read_index ) * 64;
+
+		result = libfsntfs_async_reader_submit_read(
+		          async_reader,
+		          (intptr_t *) file_io_handle,
+		          file_io_handle,
+		          &fsntfs_test_async_reader_read_function,
+		          buffers[ read_index ],
+		          64,
+		          read_offset,
+		          &fsntfs_test_async_reader_callback_function,
+		          (void *) &( read_results[ read_index ] ),
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Stopping completes the outstanding reads
+	 */
+	result = libfsntfs_async_reader_stop(
+	          async_reader,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( read_index = 0;
+	     read_index < FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS;
+	     read_index++ )
+	{
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "read_results[ read_index ].number_of_calls",
+		 read_results[ read_index ].number_of_calls,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_results[ read_index ].read_count",
+		 read_results[ read_index ].read_count,
+		 (ssize_t) 64 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "read_results[ read_index ].has_error",
+		 read_results[ read_index ].has_error,
+		 0 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT64(
+		 "read_results[ read_index ].offset",
+		 (int64_t) read_results[ read_index ].offset,
+		 (int64_t) ( FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS - 1 - read_index ) * 64 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+		 "buffers[ read_index ][ 0 ]",
+		 buffers[ read_index ][ 0 ],
+		 (uint8_t) ( FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS - 1 - read_index ) );
+
+		FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+		 "buffers[ read_index ][ 63 ]",
+		 buffers[ read_index ][ 63 ],
+		 (uint8_t) ( FSNTFS_TEST_ASYNC_READER_NUMBER_OF_READS - 1 - read_index ) );
+	}
+	/* Test a read that fails, its error is passed to the callback function
+	 */
+	result = memory_set(
+	          read_results,
+	          0,
+	          sizeof( fsntfs_test_async_reader_result_t ) ) != NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfsntfs_async_reader_submit_read(
+	          async_reader,
+	          (intptr_t *) file_io_handle,
+	          file_io_handle,
+	          &fsntfs_test_async_reader_failing_read_function,
+	          buffers[ 0 ],
+	          64,
+	          0,
+	          &fsntfs_test_async_reader_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_async_reader_stop(
+	          async_reader,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "read_results[ 0 ].number_of_calls",
+	 read_results[ 0 ].number_of_calls,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_results[ 0 ].read_count",
+	 read_results[ 0 ].read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "read_results[ 0 ].has_error",
+	 read_results[ 0 ].has_error,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_async_reader_submit_read(
+	          NULL,
+	          (intptr_t *) file_io_handle,
+	          file_io_handle,
+	          &fsntfs_test_async_reader_read_function,
+	          buffers[ 0 ],
+	          64,
+	          0,
+	          &fsntfs_test_async_reader_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_submit_read(
+	          async_reader,
+	          NULL,
+	          file_io_handle,
+	          &fsntfs_test_async_reader_read_function,
+	          buffers[ 0 ],
+	          64,
+	          0,
+	          &fsntfs_test_async_reader_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_submit_read(
+	          async_reader,
+	          (intptr_t *) file_io_handle,
+	          NULL,
+	          &fsntfs_test_async_reader_read_function,
+	          buffers[ 0 ],
+	          64,
+	          0,
+	          &fsntfs_test_async_reader_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_submit_read(
+	          async_reader,
+	          (intptr_t *) file_io_handle,
+	          file_io_handle,
+	          NULL,
+	          buffers[ 0 ],
+	          64,
+	          0,
+	          &fsntfs_test_async_reader_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_submit_read(
+	          async_reader,
+	          (intptr_t *) file_io_handle,
+	          file_io_handle,
+	          &fsntfs_test_async_reader_read_function,
+	          NULL,
+	          64,
+	          0,
+	          &fsntfs_test_async_reader_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_submit_read(
+	          async_reader,
+	          (intptr_t *) file_io_handle,
+	          file_io_handle,
+	          &fsntfs_test_async_reader_read_function,
+	          buffers[ 0 ],
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          &fsntfs_test_async_reader_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_submit_read(
+	          async_reader,
+	          (intptr_t *) file_io_handle,
+	          file_io_handle,
+	          &fsntfs_test_async_reader_read_function,
+	          buffers[ 0 ],
+	          64,
+	          -1,
+	          &fsntfs_test_async_reader_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_submit_read(
+	          async_reader,
+	          (intptr_t *) file_io_handle,
+	          file_io_handle,
+	          &fsntfs_test_async_reader_read_function,
+	          buffers[ 0 ],
+	          64,
+	          0,
+	          NULL,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_async_reader_stop(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_async_reader_free(
+	          &async_reader,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsntfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_reader != NULL )
+	{
+		libfsntfs_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_async_reader_initialize",
+	 fsntfs_test_async_reader_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_async_reader_free",
+	 fsntfs_test_async_reader_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_async_reader_set_number_of_threads",
+	 fsntfs_test_async_reader_set_number_of_threads );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_async_reader_submit_read",
+	 fsntfs_test_async_reader_submit_read );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+on_error:
+	return( EXIT_FAILURE );
+#endif
+}
+
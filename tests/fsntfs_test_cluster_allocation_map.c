@@ -0,0 +1,1234 @@
+/*
+ * Library cluster_allocation_map type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_cluster_allocation_map.h"
+
+uint8_t fsntfs_test_cluster_allocation_map_data1[ 10 ] = {
+	0xff, 0x00, 0x0f, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xfe, 0xff };
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_cluster_allocation_map_get_number_of_trailing_zero_bits function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_cluster_allocation_map_get_number_of_trailing_zero_bits(
+     void )
+{
+	uint8_t number_of_bits = 0;
+
+	/* Test regular cases
+	 */
+	number_of_bits = libfsntfs_cluster_allocation_map_get_number_of_trailing_zero_bits(
+	                  0x0000000000000001ULL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_bits",
+	 number_of_bits,
+	 0 );
+
+	number_of_bits = libfsntfs_cluster_allocation_map_get_number_of_trailing_zero_bits(
+	                  0x0000000000f00000ULL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_bits",
+	 number_of_bits,
+	 20 );
+
+	number_of_bits = libfsntfs_cluster_allocation_map_get_number_of_trailing_zero_bits(
+	                  0x8000000000000000ULL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_bits",
+	 number_of_bits,
+	 63 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libfsntfs_cluster_allocation_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_cluster_allocation_map_initialize(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfsntfs_cluster_allocation_map_t *cluster_allocation_map = NULL;
+	int result                                                 = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                            = 1;
+	int number_of_memset_fail_tests                            = 1;
+	int test_number                                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_cluster_allocation_map_initialize(
+	          &cluster_allocation_map,
+	          80,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cluster_allocation_map",
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_free(
+	          &cluster_allocation_map,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "cluster_allocation_map",
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_cluster_allocation_map_initialize(
+	          NULL,
+	          80,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	cluster_allocation_map = (libfsntfs_cluster_allocation_map_t *) 0x12345678UL;
+
+	result = libfsntfs_cluster_allocation_map_initialize(
+	          &cluster_allocation_map,
+	          80,
+	          &error );
+
+	cluster_allocation_map = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_cluster_allocation_map_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_cluster_allocation_map_initialize(
+		          &cluster_allocation_map,
+		          80,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( cluster_allocation_map != NULL )
+			{
+				libfsntfs_cluster_allocation_map_free(
+				 &cluster_allocation_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "cluster_allocation_map",
+			 cluster_allocation_map );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_cluster_allocation_map_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_cluster_allocation_map_initialize(
+		          &cluster_allocation_map,
+		          80,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( cluster_allocation_map != NULL )
+			{
+				libfsntfs_cluster_allocation_map_free(
+				 &cluster_allocation_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "cluster_allocation_map",
+			 cluster_allocation_map );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cluster_allocation_map != NULL )
+	{
+		libfsntfs_cluster_allocation_map_free(
+		 &cluster_allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_cluster_allocation_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_cluster_allocation_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_cluster_allocation_map_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_cluster_allocation_map_append_unallocated_range function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_cluster_allocation_map_append_unallocated_range(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfsntfs_cluster_allocation_map_t *cluster_allocation_map = NULL;
+	int number_of_ranges                                       = 0;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_cluster_allocation_map_initialize(
+	          &cluster_allocation_map,
+	          80,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cluster_allocation_map",
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_cluster_allocation_map_append_unallocated_range(
+	          cluster_allocation_map,
+	          8,
+	          4,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that an adjacent range is merged
+	 */
+	result = libfsntfs_cluster_allocation_map_append_unallocated_range(
+	          cluster_allocation_map,
+	          12,
+	          4,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a range beyond the number of clusters is ignored
+	 */
+	result = libfsntfs_cluster_allocation_map_append_unallocated_range(
+	          cluster_allocation_map,
+	          96,
+	          4,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges(
+	          cluster_allocation_map,
+	          &number_of_ranges,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_cluster_allocation_map_append_unallocated_range(
+	          NULL,
+	          32,
+	          4,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_cluster_allocation_map_append_unallocated_range(
+	          cluster_allocation_map,
+	          10,
+	          4,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_cluster_allocation_map_free(
+	          &cluster_allocation_map,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "cluster_allocation_map",
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cluster_allocation_map != NULL )
+	{
+		libfsntfs_cluster_allocation_map_free(
+		 &cluster_allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_cluster_allocation_map_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_cluster_allocation_map_read_data(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfsntfs_cluster_allocation_map_t *cluster_allocation_map = NULL;
+	uint64_t first_cluster_number                              = 0;
+	uint64_t number_of_clusters                                = 0;
+	int number_of_ranges                                       = 0;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_cluster_allocation_map_initialize(
+	          &cluster_allocation_map,
+	          80,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cluster_allocation_map",
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_cluster_allocation_map_read_data(
+	          cluster_allocation_map,
+	          fsntfs_test_cluster_allocation_map_data1,
+	          10,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges(
+	          cluster_allocation_map,
+	          &number_of_ranges,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 3 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+	          cluster_allocation_map,
+	          0,
+	          &first_cluster_number,
+	          &number_of_clusters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "first_cluster_number",
+	 first_cluster_number,
+	 (uint64_t) 8 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_clusters",
+	 number_of_clusters,
+	 (uint64_t) 8 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+	          cluster_allocation_map,
+	          1,
+	          &first_cluster_number,
+	          &number_of_clusters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "first_cluster_number",
+	 first_cluster_number,
+	 (uint64_t) 20 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_clusters",
+	 number_of_clusters,
+	 (uint64_t) 4 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The unallocated cluster 63 and 64 span the 64-bit word boundary
+	 */
+	result = libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+	          cluster_allocation_map,
+	          2,
+	          &first_cluster_number,
+	          &number_of_clusters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "first_cluster_number",
+	 first_cluster_number,
+	 (uint64_t) 63 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_clusters",
+	 number_of_clusters,
+	 (uint64_t) 2 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_cluster_allocation_map_read_data(
+	          NULL,
+	          fsntfs_test_cluster_allocation_map_data1,
+	          10,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_cluster_allocation_map_read_data(
+	          cluster_allocation_map,
+	          NULL,
+	          10,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_cluster_allocation_map_read_data(
+	          cluster_allocation_map,
+	          fsntfs_test_cluster_allocation_map_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where data overlaps previously read data
+	 */
+	result = libfsntfs_cluster_allocation_map_read_data(
+	          cluster_allocation_map,
+	          fsntfs_test_cluster_allocation_map_data1,
+	          10,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_cluster_allocation_map_free(
+	          &cluster_allocation_map,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "cluster_allocation_map",
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cluster_allocation_map != NULL )
+	{
+		libfsntfs_cluster_allocation_map_free(
+		 &cluster_allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_cluster_allocation_map_get_number_of_unallocated_ranges(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_ranges     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges(
+	          cluster_allocation_map,
+	          &number_of_ranges,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges(
+	          NULL,
+	          &number_of_ranges,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges(
+	          cluster_allocation_map,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_cluster_allocation_map_get_unallocated_range_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_cluster_allocation_map_get_unallocated_range_by_index(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map )
+{
+	libcerror_error_t *error      = NULL;
+	uint64_t first_cluster_number = 0;
+	uint64_t number_of_clusters   = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+	          cluster_allocation_map,
+	          0,
+	          &first_cluster_number,
+	          &number_of_clusters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+	          NULL,
+	          0,
+	          &first_cluster_number,
+	          &number_of_clusters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+	          cluster_allocation_map,
+	          -1,
+	          &first_cluster_number,
+	          &number_of_clusters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+	          cluster_allocation_map,
+	          0,
+	          NULL,
+	          &number_of_clusters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_cluster_allocation_map_get_unallocated_range_by_index(
+	          cluster_allocation_map,
+	          0,
+	          &first_cluster_number,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_cluster_allocation_map_is_cluster_allocated function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_cluster_allocation_map_is_cluster_allocated(
+     libfsntfs_cluster_allocation_map_t *cluster_allocation_map )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_cluster_allocation_map_is_cluster_allocated(
+	          cluster_allocation_map,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_is_cluster_allocated(
+	          cluster_allocation_map,
+	          8,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_is_cluster_allocated(
+	          cluster_allocation_map,
+	          15,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_is_cluster_allocated(
+	          cluster_allocation_map,
+	          16,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_is_cluster_allocated(
+	          cluster_allocation_map,
+	          64,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_is_cluster_allocated(
+	          cluster_allocation_map,
+	          79,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_cluster_allocation_map_is_cluster_allocated(
+	          NULL,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_cluster_allocation_map_is_cluster_allocated(
+	          cluster_allocation_map,
+	          80,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+	libcerror_error_t *error                                   = NULL;
+	libfsntfs_cluster_allocation_map_t *cluster_allocation_map = NULL;
+	int result                                                 = 0;
+#endif
+
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_cluster_allocation_map_get_number_of_trailing_zero_bits",
+	 fsntfs_test_cluster_allocation_map_get_number_of_trailing_zero_bits );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_cluster_allocation_map_initialize",
+	 fsntfs_test_cluster_allocation_map_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_cluster_allocation_map_free",
+	 fsntfs_test_cluster_allocation_map_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_cluster_allocation_map_append_unallocated_range",
+	 fsntfs_test_cluster_allocation_map_append_unallocated_range );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_cluster_allocation_map_read_data",
+	 fsntfs_test_cluster_allocation_map_read_data );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize cluster_allocation_map for tests
+	 */
+	result = libfsntfs_cluster_allocation_map_initialize(
+	          &cluster_allocation_map,
+	          80,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cluster_allocation_map",
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_cluster_allocation_map_read_data(
+	          cluster_allocation_map,
+	          fsntfs_test_cluster_allocation_map_data1,
+	          10,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_cluster_allocation_map_get_number_of_unallocated_ranges",
+	 fsntfs_test_cluster_allocation_map_get_number_of_unallocated_ranges,
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_cluster_allocation_map_get_unallocated_range_by_index",
+	 fsntfs_test_cluster_allocation_map_get_unallocated_range_by_index,
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_cluster_allocation_map_is_cluster_allocated",
+	 fsntfs_test_cluster_allocation_map_is_cluster_allocated,
+	 cluster_allocation_map );
+
+	/* Clean up
+	 */
+	result = libfsntfs_cluster_allocation_map_free(
+	          &cluster_allocation_map,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "cluster_allocation_map",
+	 cluster_allocation_map );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cluster_allocation_map != NULL )
+	{
+		libfsntfs_cluster_allocation_map_free(
+		 &cluster_allocation_map,
+		 NULL );
+	}
+#endif
+	return( EXIT_FAILURE );
+}
+
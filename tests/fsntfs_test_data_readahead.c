@@ -0,0 +1,847 @@
+/*
+ * Library data_readahead type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_functions.h"
+#include "fsntfs_test_libbfio.h"
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_data_readahead.h"
+#include "../libfsntfs/libfsntfs_data_segment_table.h"
+#include "../libfsntfs/libfsntfs_libfdata.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_data_readahead_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_readahead_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libfsntfs_data_readahead_t *data_readahead = NULL;
+	int result                                 = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests            = 1;
+	int number_of_memset_fail_tests            = 1;
+	int test_number                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_data_readahead_initialize(
+	          &data_readahead,
+	          64,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_readahead",
+	 data_readahead );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_readahead_free(
+	          &data_readahead,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "data_readahead",
+	 data_readahead );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_data_readahead_initialize(
+	          NULL,
+	          64,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	data_readahead = (libfsntfs_data_readahead_t *) 0x12345678UL;
+
+	result = libfsntfs_data_readahead_initialize(
+	          &data_readahead,
+	          64,
+	          &error );
+
+	data_readahead = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_data_readahead_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_data_readahead_initialize(
+		          &data_readahead,
+		          64,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( data_readahead != NULL )
+			{
+				libfsntfs_data_readahead_free(
+				 &data_readahead,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "data_readahead",
+			 data_readahead );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_data_readahead_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_data_readahead_initialize(
+		          &data_readahead,
+		          64,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( data_readahead != NULL )
+			{
+				libfsntfs_data_readahead_free(
+				 &data_readahead,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "data_readahead",
+			 data_readahead );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_readahead != NULL )
+	{
+		libfsntfs_data_readahead_free(
+		 &data_readahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+
+/* Tests the libfsntfs_data_readahead_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_readahead_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_data_readahead_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_data_readahead_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_readahead_read_buffer_at_offset(
+     void )
+{
+	uint8_t buffer[ 16 ];
+	uint8_t data[ 256 ];
+
+	libbfio_handle_t *file_io_handle                   = NULL;
+	libcerror_error_t *error                           = NULL;
+	libfsntfs_data_readahead_t *data_readahead         = NULL;
+	libfsntfs_data_segment_table_t *data_segment_table = NULL;
+	ssize_t read_count                                 = 0;
+	int data_index                                     = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 256;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) data_index;
+	}
+	result = fsntfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          256,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_initialize(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          256,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_segment_table->data_size = 256;
+
+	result = libfsntfs_data_readahead_initialize(
+	          &data_readahead,
+	          64,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_readahead",
+	 data_readahead );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 15 ]",
+	 buffer[ 15 ],
+	 15 );
+
+	/* The first read is not considered sequential
+	 */
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "data_readahead->size",
+	 data_readahead->size,
+	 (size_t) 0 );
+
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              16,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 16 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 15 ]",
+	 buffer[ 15 ],
+	 31 );
+
+	/* The second read is sequential and reads ahead twice the read size
+	 */
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "data_readahead->data_offset",
+	 (int64_t) data_readahead->data_offset,
+	 (int64_t) 16 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "data_readahead->size",
+	 data_readahead->size,
+	 (size_t) 32 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "data_readahead->window_size",
+	 data_readahead->window_size,
+	 (size_t) 64 );
+
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              32,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 32 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 15 ]",
+	 buffer[ 15 ],
+	 47 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "data_readahead->data_offset",
+	 (int64_t) data_readahead->data_offset,
+	 (int64_t) 16 );
+
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              48,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 48 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 15 ]",
+	 buffer[ 15 ],
+	 63 );
+
+	/* The window is limited to the maximum size
+	 */
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "data_readahead->data_offset",
+	 (int64_t) data_readahead->data_offset,
+	 (int64_t) 48 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "data_readahead->size",
+	 data_readahead->size,
+	 (size_t) 64 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "data_readahead->window_size",
+	 data_readahead->window_size,
+	 (size_t) 64 );
+
+	/* A read that is not sequential resets the window
+	 */
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              200,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 200 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "data_readahead->window_size",
+	 data_readahead->window_size,
+	 (size_t) 0 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "data_readahead->data_offset",
+	 (int64_t) data_readahead->data_offset,
+	 (int64_t) 48 );
+
+	/* Sequential reads stop at the end of the data
+	 */
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              216,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              232,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              248,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 8 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 7 ]",
+	 buffer[ 7 ],
+	 255 );
+
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              256,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              NULL,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              NULL,
+	              16,
+	              0,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfsntfs_data_readahead_read_buffer_at_offset(
+	              data_readahead,
+	              data_segment_table,
+	              file_io_handle,
+	              buffer,
+	              16,
+	              -1,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_data_readahead_free(
+	          &data_readahead,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "data_readahead",
+	 data_readahead );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_free(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsntfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_readahead != NULL )
+	{
+		libfsntfs_data_readahead_free(
+		 &data_readahead,
+		 NULL );
+	}
+	if( data_segment_table != NULL )
+	{
+		libfsntfs_data_segment_table_free(
+		 &data_segment_table,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_data_readahead_initialize",
+	 fsntfs_test_data_readahead_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_data_readahead_free",
+	 fsntfs_test_data_readahead_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_data_readahead_read_buffer_at_offset",
+	 fsntfs_test_data_readahead_read_buffer_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+on_error:
+	return( EXIT_FAILURE );
+#endif
+}
+
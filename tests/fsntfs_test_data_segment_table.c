@@ -0,0 +1,1658 @@
+/*
+ * Library data_segment_table type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_functions.h"
+#include "fsntfs_test_libbfio.h"
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_data_segment_table.h"
+#include "../libfsntfs/libfsntfs_libfdata.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_data_segment_table_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_segment_table_initialize(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libfsntfs_data_segment_table_t *data_segment_table = NULL;
+	int result                                         = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                    = 1;
+	int number_of_memset_fail_tests                    = 1;
+	int test_number                                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_data_segment_table_initialize(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_free(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_data_segment_table_initialize(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	data_segment_table = (libfsntfs_data_segment_table_t *) 0x12345678UL;
+
+	result = libfsntfs_data_segment_table_initialize(
+	          &data_segment_table,
+	          &error );
+
+	data_segment_table = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_data_segment_table_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_data_segment_table_initialize(
+		          &data_segment_table,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( data_segment_table != NULL )
+			{
+				libfsntfs_data_segment_table_free(
+				 &data_segment_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "data_segment_table",
+			 data_segment_table );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_data_segment_table_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_data_segment_table_initialize(
+		          &data_segment_table,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( data_segment_table != NULL )
+			{
+				libfsntfs_data_segment_table_free(
+				 &data_segment_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "data_segment_table",
+			 data_segment_table );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_segment_table != NULL )
+	{
+		libfsntfs_data_segment_table_free(
+		 &data_segment_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+
+/* Tests the libfsntfs_data_segment_table_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_segment_table_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_data_segment_table_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_data_segment_table_get_segment_index_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_segment_table_get_segment_index_at_offset(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libfsntfs_data_segment_table_t *data_segment_table = NULL;
+	int result                                         = 0;
+	int segment_index                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_data_segment_table_initialize(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( segment_index = 0;
+	     segment_index < 32;
+	     segment_index++ )
+	{
+		result = libfsntfs_data_segment_table_append_segment(
+		          data_segment_table,
+		          (off64_t) segment_index * 8192,
+		          4096,
+		          0,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "data_segment_table->number_of_segments",
+	 data_segment_table->number_of_segments,
+	 32 );
+
+	/* A segment that is stored directly after the last segment is coalesced
+	 */
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          ( 31 * 8192 ) + 4096,
+	          4096,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "data_segment_table->number_of_segments",
+	 data_segment_table->number_of_segments,
+	 32 );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_data_segment_table_get_segment_index_at_offset(
+	          data_segment_table,
+	          0,
+	          &segment_index,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "segment_index",
+	 segment_index,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_get_segment_index_at_offset(
+	          data_segment_table,
+	          ( 21 * 4096 ) + 17,
+	          &segment_index,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "segment_index",
+	 segment_index,
+	 21 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_get_segment_index_at_offset(
+	          data_segment_table,
+	          32 * 4096,
+	          &segment_index,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "segment_index",
+	 segment_index,
+	 31 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_get_segment_index_at_offset(
+	          data_segment_table,
+	          33 * 4096,
+	          &segment_index,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_data_segment_table_get_segment_index_at_offset(
+	          NULL,
+	          0,
+	          &segment_index,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_segment_table_get_segment_index_at_offset(
+	          data_segment_table,
+	          0,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_data_segment_table_free(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_segment_table != NULL )
+	{
+		libfsntfs_data_segment_table_free(
+		 &data_segment_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_data_segment_table_get_next_data_range function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_segment_table_get_next_data_range(
+     void )
+{
+	uint8_t resident_data[ 32 ];
+
+	libcerror_error_t *error                           = NULL;
+	libfsntfs_data_segment_table_t *data_segment_table = NULL;
+	size64_t range_size                                = 0;
+	off64_t range_offset                               = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_data_segment_table_initialize(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          4096,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          8192,
+	          4096,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          12288,
+	          4096,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          4096,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          4096,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          40960,
+	          4096,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          4096,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_segment_table->data_size = 7 * 4096;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "data_segment_table->number_of_segments",
+	 data_segment_table->number_of_segments,
+	 5 );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 4096 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 8192 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          5000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 5000 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 12288 - 5000 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          12288,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 20480 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 4096 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          20480 + 17,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 20480 + 17 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 4096 - 17 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          24576,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          7 * 4096,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test resident data
+	 */
+	data_segment_table->resident_data = resident_data;
+	data_segment_table->data_size     = 32;
+
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          8,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 8 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 24 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_segment_table->resident_data = NULL;
+	data_segment_table->data_size     = 7 * 4096;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          -1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_segment_table_get_next_data_range(
+	          data_segment_table,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_data_segment_table_free(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_segment_table != NULL )
+	{
+		libfsntfs_data_segment_table_free(
+		 &data_segment_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_data_segment_table_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_segment_table_read_buffer_at_offset(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	uint8_t resident_data[ 32 ] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+		0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+
+	libcerror_error_t *error                           = NULL;
+	libfsntfs_data_segment_table_t *data_segment_table = NULL;
+	ssize_t read_count                                 = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_data_segment_table_initialize(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_segment_table->resident_data = resident_data;
+	data_segment_table->data_size     = 32;
+
+	/* Test regular cases
+	 */
+	read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+	              data_segment_table,
+	              NULL,
+	              buffer,
+	              64,
+	              24,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 8 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( resident_data[ 24 ] ),
+	          8 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+	              data_segment_table,
+	              NULL,
+	              buffer,
+	              64,
+	              32,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test sparse segments
+	 */
+	data_segment_table->resident_data = NULL;
+	data_segment_table->data_size     = 48;
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          16,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          32,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 buffer,
+	 0xff,
+	 64 );
+
+	read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+	              data_segment_table,
+	              NULL,
+	              buffer,
+	              64,
+	              8,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 40 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 39 ]",
+	 buffer[ 39 ],
+	 0x00 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 40 ]",
+	 buffer[ 40 ],
+	 0xff );
+
+	/* Test error cases
+	 */
+	read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+	              NULL,
+	              NULL,
+	              buffer,
+	              64,
+	              0,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+	              data_segment_table,
+	              NULL,
+	              NULL,
+	              64,
+	              0,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfsntfs_data_segment_table_read_buffer_at_offset(
+	              data_segment_table,
+	              NULL,
+	              buffer,
+	              64,
+	              -1,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_data_segment_table_free(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_segment_table != NULL )
+	{
+		libfsntfs_data_segment_table_free(
+		 &data_segment_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_data_segment_table_read_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_segment_table_read_ranges(
+     void )
+{
+	uint8_t data[ 256 ];
+	uint8_t range_data[ 5 ][ 32 ];
+
+	off64_t range_offsets[ 5 ] = { 100, 0, 16, 60, 150 };
+	size_t range_sizes[ 5 ]    = { 8, 16, 16, 10, 20 };
+	ssize_t range_read_counts[ 5 ];
+	uint8_t *range_buffers[ 5 ];
+
+	libbfio_handle_t *file_io_handle                   = NULL;
+	libcerror_error_t *error                           = NULL;
+	libfsntfs_data_segment_table_t *data_segment_table = NULL;
+	int data_index                                     = 0;
+	int range_index                                    = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 256;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) data_index;
+	}
+	for( range_index = 0;
+	     range_index < 5;
+	     range_index++ )
+	{
+		memory_set(
+		 range_data[ range_index ],
+		 0xff,
+		 32 );
+
+		range_buffers[ range_index ] = range_data[ range_index ];
+	}
+	result = fsntfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          256,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_initialize(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Data offset 0 - 63 is stored at volume offset 128 - 191,
+	 * data offset 64 - 95 is sparse and
+	 * data offset 96 - 159 is stored at volume offset 0 - 63
+	 */
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          128,
+	          64,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          32,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          64,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_segment_table->data_size = 160;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_data_segment_table_read_ranges(
+	          data_segment_table,
+	          file_io_handle,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          5,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "range_read_counts[ 0 ]",
+	 range_read_counts[ 0 ],
+	 (ssize_t) 8 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 0 ][ 0 ]",
+	 range_data[ 0 ][ 0 ],
+	 4 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 0 ][ 7 ]",
+	 range_data[ 0 ][ 7 ],
+	 11 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "range_read_counts[ 1 ]",
+	 range_read_counts[ 1 ],
+	 (ssize_t) 16 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 1 ][ 0 ]",
+	 range_data[ 1 ][ 0 ],
+	 128 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 1 ][ 15 ]",
+	 range_data[ 1 ][ 15 ],
+	 143 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "range_read_counts[ 2 ]",
+	 range_read_counts[ 2 ],
+	 (ssize_t) 16 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 2 ][ 0 ]",
+	 range_data[ 2 ][ 0 ],
+	 144 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 2 ][ 15 ]",
+	 range_data[ 2 ][ 15 ],
+	 159 );
+
+	/* The range spans the end of the first segment and the sparse segment
+	 */
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "range_read_counts[ 3 ]",
+	 range_read_counts[ 3 ],
+	 (ssize_t) 10 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 3 ][ 3 ]",
+	 range_data[ 3 ][ 3 ],
+	 191 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 3 ][ 4 ]",
+	 range_data[ 3 ][ 4 ],
+	 0 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 3 ][ 10 ]",
+	 range_data[ 3 ][ 10 ],
+	 0xff );
+
+	/* The range is truncated at the end of the data
+	 */
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "range_read_counts[ 4 ]",
+	 range_read_counts[ 4 ],
+	 (ssize_t) 10 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 4 ][ 0 ]",
+	 range_data[ 4 ][ 0 ],
+	 54 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 4 ][ 9 ]",
+	 range_data[ 4 ][ 9 ],
+	 63 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "range_data[ 4 ][ 10 ]",
+	 range_data[ 4 ][ 10 ],
+	 0xff );
+
+	result = libfsntfs_data_segment_table_read_ranges(
+	          data_segment_table,
+	          file_io_handle,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_data_segment_table_read_ranges(
+	          NULL,
+	          file_io_handle,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          5,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_segment_table_read_ranges(
+	          data_segment_table,
+	          file_io_handle,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          -1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_segment_table_read_ranges(
+	          data_segment_table,
+	          file_io_handle,
+	          NULL,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          5,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	range_buffers[ 2 ] = NULL;
+
+	result = libfsntfs_data_segment_table_read_ranges(
+	          data_segment_table,
+	          file_io_handle,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          5,
+	          &error );
+
+	range_buffers[ 2 ] = range_data[ 2 ];
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_data_segment_table_free(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "data_segment_table",
+	 data_segment_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsntfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_segment_table != NULL )
+	{
+		libfsntfs_data_segment_table_free(
+		 &data_segment_table,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_data_segment_table_initialize",
+	 fsntfs_test_data_segment_table_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_data_segment_table_free",
+	 fsntfs_test_data_segment_table_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_data_segment_table_get_segment_index_at_offset",
+	 fsntfs_test_data_segment_table_get_segment_index_at_offset );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_data_segment_table_get_next_data_range",
+	 fsntfs_test_data_segment_table_get_next_data_range );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_data_segment_table_read_buffer_at_offset",
+	 fsntfs_test_data_segment_table_read_buffer_at_offset );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_data_segment_table_read_ranges",
+	 fsntfs_test_data_segment_table_read_ranges );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+on_error:
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -45,6 +46,7 @@
 #include "fsntfs_test_rwlock.h"
 #include "fsntfs_test_unused.h"
 
+#include "../libfsntfs/libfsntfs_async_reader.h"
 #include "../libfsntfs/libfsntfs_data_stream.h"
 #include "../libfsntfs/libfsntfs_io_handle.h"
 #include "../libfsntfs/libfsntfs_mft_attribute.h"
@@ -54,6 +56,29 @@
  */
 
 #define FSNTFS_TEST_DATA_STREAM_READ_BUFFER_SIZE	4096
+#define FSNTFS_TEST_DATA_STREAM_NUMBER_OF_ASYNC_READS	4
+#define FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES	6
+
+typedef struct fsntfs_test_data_stream_async_result fsntfs_test_data_stream_async_result_t;
+
+struct fsntfs_test_data_stream_async_result
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The number of bytes read
+	 */
+	ssize_t read_count;
+
+	/* Value to indicate an error was passed
+	 */
+	int has_error;
+
+	/* The number of times the callback function was called
+	 */
+	int number_of_calls;
+};
 
 uint8_t fsntfs_test_data_stream_data1[ 112 ] = {
 	0x80, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x01, 0x11, 0x40, 0x00, 0x00, 0x00, 0x05, 0x00,
@@ -2558,6 +2583,500 @@ on_error:
 	return( 0 );
 }
 
+/* Stores the result of an asynchronous read
+ */
+void fsntfs_test_data_stream_read_buffer_at_offset_async_callback_function(
+      libfsntfs_data_stream_t *data_stream FSNTFS_TEST_ATTRIBUTE_UNUSED,
+      void *buffer FSNTFS_TEST_ATTRIBUTE_UNUSED,
+      ssize_t read_count,
+      off64_t offset,
+      libcerror_error_t *error,
+      void *user_data )
+{
+	fsntfs_test_data_stream_async_result_t *read_result = NULL;
+
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( data_stream )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	read_result = (fsntfs_test_data_stream_async_result_t *) user_data;
+
+	read_result->offset           = offset;
+	read_result->read_count       = read_count;
+	read_result->has_error        = ( error != NULL );
+	read_result->number_of_calls += 1;
+}
+
+/* Tests the libfsntfs_data_stream_read_buffer_at_offset_async function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_stream_read_buffer_at_offset_async(
+     libfsntfs_data_stream_t *data_stream )
+{
+	uint8_t async_buffers[ FSNTFS_TEST_DATA_STREAM_NUMBER_OF_ASYNC_READS ][ 512 ];
+	uint8_t buffer[ 512 ];
+
+	fsntfs_test_data_stream_async_result_t read_results[ FSNTFS_TEST_DATA_STREAM_NUMBER_OF_ASYNC_READS ];
+	off64_t read_offsets[ FSNTFS_TEST_DATA_STREAM_NUMBER_OF_ASYNC_READS ];
+
+	libcerror_error_t *error = NULL;
+	size64_t data_size       = 0;
+	ssize_t read_count       = 0;
+	int read_index           = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libfsntfs_data_stream_get_size(
+	          data_stream,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_set(
+	          read_results,
+	          0,
+	          sizeof( fsntfs_test_data_stream_async_result_t ) * FSNTFS_TEST_DATA_STREAM_NUMBER_OF_ASYNC_READS ) != NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 * The reads are submitted at the end, in the middle, at the start and beyond the end of the data
+	 */
+	read_offsets[ 0 ] = (off64_t) data_size - 8;
+	read_offsets[ 1 ] = (off64_t) data_size / 2;
+	read_offsets[ 2 ] = 0;
+	read_offsets[ 3 ] = (off64_t) data_size + 8;
+
+	for( read_index = 0;
+	     read_index < FSNTFS_TEST_DATA_STREAM_NUMBER_OF_ASYNC_READS;
+	     read_index++ )
+	{
+		result = libfsntfs_data_stream_read_buffer_at_offset_async(
+		          data_stream,
+		          async_buffers[ read_index ],
+		          512,
+		          read_offsets[ read_index ],
+		          &fsntfs_test_data_stream_read_buffer_at_offset_async_callback_function,
+		          (void *) &( read_results[ read_index ] ),
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Stopping the asynchronous reader completes the outstanding reads
+	 */
+	result = libfsntfs_async_reader_stop(
+	          ( (libfsntfs_internal_data_stream_t *) data_stream )->async_reader,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data read asynchronously should match the data read synchronously
+	 */
+	for( read_index = 0;
+	     read_index < FSNTFS_TEST_DATA_STREAM_NUMBER_OF_ASYNC_READS;
+	     read_index++ )
+	{
+		read_count = libfsntfs_data_stream_read_buffer_at_offset(
+		              data_stream,
+		              buffer,
+		              512,
+		              read_offsets[ read_index ],
+		              &error );
+
+		FSNTFS_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "read_results[ read_index ].number_of_calls",
+		 read_results[ read_index ].number_of_calls,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "read_results[ read_index ].has_error",
+		 read_results[ read_index ].has_error,
+		 0 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT64(
+		 "read_results[ read_index ].offset",
+		 (int64_t) read_results[ read_index ].offset,
+		 (int64_t) read_offsets[ read_index ] );
+
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_results[ read_index ].read_count",
+		 read_results[ read_index ].read_count,
+		 read_count );
+
+		result = memory_compare(
+		          async_buffers[ read_index ],
+		          buffer,
+		          (size_t) read_count );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_results[ 0 ].read_count",
+	 read_results[ 0 ].read_count,
+	 (ssize_t) 8 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_results[ 3 ].read_count",
+	 read_results[ 3 ].read_count,
+	 (ssize_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_data_stream_read_buffer_at_offset_async(
+	          NULL,
+	          async_buffers[ 0 ],
+	          512,
+	          0,
+	          &fsntfs_test_data_stream_read_buffer_at_offset_async_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_stream_read_buffer_at_offset_async(
+	          data_stream,
+	          NULL,
+	          512,
+	          0,
+	          &fsntfs_test_data_stream_read_buffer_at_offset_async_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_stream_read_buffer_at_offset_async(
+	          data_stream,
+	          async_buffers[ 0 ],
+	          512,
+	          -1,
+	          &fsntfs_test_data_stream_read_buffer_at_offset_async_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_stream_read_buffer_at_offset_async(
+	          data_stream,
+	          async_buffers[ 0 ],
+	          512,
+	          0,
+	          NULL,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_data_stream_read_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_data_stream_read_ranges(
+     libfsntfs_data_stream_t *data_stream )
+{
+	uint8_t range_data[ FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES ][ 512 ];
+	uint8_t buffer[ 512 ];
+
+	off64_t range_offsets[ FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES ];
+	size_t range_sizes[ FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES ];
+	uint8_t *range_buffers[ FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES ];
+	ssize_t range_read_counts[ FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES ];
+
+	libcerror_error_t *error = NULL;
+	size64_t data_size       = 0;
+	ssize_t read_count       = 0;
+	int range_index          = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libfsntfs_data_stream_get_size(
+	          data_stream,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The ranges are not sorted, overlap and extend beyond the end of the data
+	 */
+	range_offsets[ 0 ] = (off64_t) data_size / 2;
+	range_sizes[ 0 ]   = 256;
+	range_offsets[ 1 ] = 0;
+	range_sizes[ 1 ]   = 512;
+	range_offsets[ 2 ] = 128;
+	range_sizes[ 2 ]   = 512;
+	range_offsets[ 3 ] = (off64_t) data_size - 8;
+	range_sizes[ 3 ]   = 64;
+	range_offsets[ 4 ] = (off64_t) data_size + 16;
+	range_sizes[ 4 ]   = 64;
+	range_offsets[ 5 ] = ( (off64_t) data_size / 2 ) + 64;
+	range_sizes[ 5 ]   = 128;
+
+	for( range_index = 0;
+	     range_index < FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES;
+	     range_index++ )
+	{
+		range_buffers[ range_index ]     = range_data[ range_index ];
+		range_read_counts[ range_index ] = -1;
+	}
+	result = libfsntfs_data_stream_read_ranges(
+	          data_stream,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data of every range should match the data read separately
+	 */
+	for( range_index = 0;
+	     range_index < FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES;
+	     range_index++ )
+	{
+		read_count = libfsntfs_data_stream_read_buffer_at_offset(
+		              data_stream,
+		              buffer,
+		              range_sizes[ range_index ],
+		              range_offsets[ range_index ],
+		              &error );
+
+		FSNTFS_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "range_read_counts[ range_index ]",
+		 range_read_counts[ range_index ],
+		 read_count );
+
+		result = memory_compare(
+		          range_data[ range_index ],
+		          buffer,
+		          (size_t) read_count );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "range_read_counts[ 3 ]",
+	 range_read_counts[ 3 ],
+	 (ssize_t) 8 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "range_read_counts[ 4 ]",
+	 range_read_counts[ 4 ],
+	 (ssize_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_data_stream_read_ranges(
+	          NULL,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_stream_read_ranges(
+	          data_stream,
+	          NULL,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_data_stream_read_ranges(
+	          data_stream,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          -1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	range_offsets[ 0 ] = -1;
+
+	result = libfsntfs_data_stream_read_ranges(
+	          data_stream,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          FSNTFS_TEST_DATA_STREAM_NUMBER_OF_READ_RANGES,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libfsntfs_data_stream_seek_offset function
  * Returns 1 if successful or 0 if not
  */
@@ -3570,6 +4089,16 @@ int main(
 	 fsntfs_test_data_stream_read_buffer_at_offset,
 	 data_stream );
 
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_data_stream_read_buffer_at_offset_async",
+	 fsntfs_test_data_stream_read_buffer_at_offset_async,
+	 data_stream );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_data_stream_read_ranges",
+	 fsntfs_test_data_stream_read_ranges,
+	 data_stream );
+
 	FSNTFS_TEST_RUN_WITH_ARGS(
 	 "libfsntfs_data_stream_seek_offset",
 	 fsntfs_test_data_stream_seek_offset,
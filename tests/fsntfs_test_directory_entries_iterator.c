@@ -0,0 +1,500 @@
+/*
+ * Library directory_entries_iterator type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_definitions.h"
+#include "../libfsntfs/libfsntfs_directory_entries_iterator.h"
+#include "../libfsntfs/libfsntfs_directory_entry.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_directory_entries_iterator_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_directory_entries_iterator_initialize(
+     void )
+{
+	libcerror_error_t *error                                           = NULL;
+	libfsntfs_directory_entries_iterator_t *directory_entries_iterator = NULL;
+	int result                                                         = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                                    = 1;
+	int number_of_memset_fail_tests                                    = 1;
+	int test_number                                                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_directory_entries_iterator_initialize(
+	          &directory_entries_iterator,
+	          NULL,
+	          NULL,
+	          NULL,
+	          LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_entries_iterator",
+	 directory_entries_iterator );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_directory_entries_iterator_free(
+	          &directory_entries_iterator,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "directory_entries_iterator",
+	 directory_entries_iterator );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_directory_entries_iterator_initialize(
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	directory_entries_iterator = (libfsntfs_directory_entries_iterator_t *) 0x12345678UL;
+
+	result = libfsntfs_directory_entries_iterator_initialize(
+	          &directory_entries_iterator,
+	          NULL,
+	          NULL,
+	          NULL,
+	          LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY,
+	          &error );
+
+	directory_entries_iterator = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_directory_entries_iterator_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_directory_entries_iterator_initialize(
+		          &directory_entries_iterator,
+		          NULL,
+		          NULL,
+		          NULL,
+		          LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( directory_entries_iterator != NULL )
+			{
+				libfsntfs_directory_entries_iterator_free(
+				 &directory_entries_iterator,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "directory_entries_iterator",
+			 directory_entries_iterator );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_directory_entries_iterator_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_directory_entries_iterator_initialize(
+		          &directory_entries_iterator,
+		          NULL,
+		          NULL,
+		          NULL,
+		          LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( directory_entries_iterator != NULL )
+			{
+				libfsntfs_directory_entries_iterator_free(
+				 &directory_entries_iterator,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "directory_entries_iterator",
+			 directory_entries_iterator );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_entries_iterator != NULL )
+	{
+		libfsntfs_directory_entries_iterator_free(
+		 &directory_entries_iterator,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_directory_entries_iterator_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_directory_entries_iterator_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_directory_entries_iterator_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_directory_entries_iterator_get_next_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_directory_entries_iterator_get_next_entry(
+     void )
+{
+	libcerror_error_t *error                                           = NULL;
+	libfsntfs_directory_entries_iterator_t *directory_entries_iterator = NULL;
+	libfsntfs_directory_entry_t *directory_entry                       = NULL;
+	int result                                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_directory_entries_iterator_initialize(
+	          &directory_entries_iterator,
+	          NULL,
+	          NULL,
+	          NULL,
+	          LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_entries_iterator",
+	 directory_entries_iterator );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_directory_entries_iterator_get_next_entry(
+	          directory_entries_iterator,
+	          NULL,
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "directory_entry",
+	 directory_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_directory_entries_iterator_get_next_entry(
+	          NULL,
+	          NULL,
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_directory_entries_iterator_get_next_entry(
+	          directory_entries_iterator,
+	          NULL,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	directory_entry = (libfsntfs_directory_entry_t *) 0x12345678UL;
+
+	result = libfsntfs_directory_entries_iterator_get_next_entry(
+	          directory_entries_iterator,
+	          NULL,
+	          &directory_entry,
+	          &error );
+
+	directory_entry = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_directory_entries_iterator_pop_frame(
+	          directory_entries_iterator,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_directory_entries_iterator_free(
+	          &directory_entries_iterator,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "directory_entries_iterator",
+	 directory_entries_iterator );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_entries_iterator != NULL )
+	{
+		libfsntfs_directory_entries_iterator_free(
+		 &directory_entries_iterator,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_directory_entries_iterator_initialize",
+	 fsntfs_test_directory_entries_iterator_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_directory_entries_iterator_free",
+	 fsntfs_test_directory_entries_iterator_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_directory_entries_iterator_get_next_entry",
+	 fsntfs_test_directory_entries_iterator_get_next_entry );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
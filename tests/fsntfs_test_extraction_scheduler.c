@@ -0,0 +1,1222 @@
+/*
+ * Library extraction_scheduler type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_functions.h"
+#include "fsntfs_test_libbfio.h"
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_data_segment_table.h"
+#include "../libfsntfs/libfsntfs_extraction_scheduler.h"
+#include "../libfsntfs/libfsntfs_libfdata.h"
+#include "../libfsntfs/libfsntfs_read_queue.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_extraction_scheduler_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_extraction_scheduler_initialize(
+     void )
+{
+	libcerror_error_t *error                               = NULL;
+	libfsntfs_extraction_scheduler_t *extraction_scheduler = NULL;
+	int result                                             = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                        = 2;
+	int number_of_memset_fail_tests                        = 1;
+	int test_number                                        = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_extraction_scheduler_initialize(
+	          &extraction_scheduler,
+	          4096,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "extraction_scheduler",
+	 extraction_scheduler );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_extraction_scheduler_free(
+	          &extraction_scheduler,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "extraction_scheduler",
+	 extraction_scheduler );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_extraction_scheduler_initialize(
+	          NULL,
+	          4096,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	extraction_scheduler = (libfsntfs_extraction_scheduler_t *) 0x12345678UL;
+
+	result = libfsntfs_extraction_scheduler_initialize(
+	          &extraction_scheduler,
+	          4096,
+	          &error );
+
+	extraction_scheduler = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_extraction_scheduler_initialize(
+	          &extraction_scheduler,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_extraction_scheduler_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_extraction_scheduler_initialize(
+		          &extraction_scheduler,
+		          4096,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( extraction_scheduler != NULL )
+			{
+				libfsntfs_extraction_scheduler_free(
+				 &extraction_scheduler,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "extraction_scheduler",
+			 extraction_scheduler );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_extraction_scheduler_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_extraction_scheduler_initialize(
+		          &extraction_scheduler,
+		          4096,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( extraction_scheduler != NULL )
+			{
+				libfsntfs_extraction_scheduler_free(
+				 &extraction_scheduler,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "extraction_scheduler",
+			 extraction_scheduler );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extraction_scheduler != NULL )
+	{
+		libfsntfs_extraction_scheduler_free(
+		 &extraction_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+
+/* Tests the libfsntfs_extraction_scheduler_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_extraction_scheduler_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_extraction_scheduler_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_extraction_scheduler_append_item function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_extraction_scheduler_append_item(
+     void )
+{
+	uint8_t resident_data[ 4 ] = { 'a', 'b', 'c', 'd' };
+
+	libcerror_error_t *error                               = NULL;
+	libfsntfs_extraction_scheduler_t *extraction_scheduler = NULL;
+	int result                                             = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_extraction_scheduler_initialize(
+	          &extraction_scheduler,
+	          4096,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "extraction_scheduler",
+	 extraction_scheduler );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_extraction_scheduler_append_item(
+	          extraction_scheduler,
+	          5,
+	          0,
+	          8192,
+	          4096,
+	          0,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_extraction_scheduler_append_item(
+	          extraction_scheduler,
+	          6,
+	          0,
+	          0,
+	          4,
+	          0,
+	          resident_data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "extraction_scheduler->number_of_items",
+	 extraction_scheduler->number_of_items,
+	 2 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "extraction_scheduler->items[ 1 ].resident_data",
+	 extraction_scheduler->items[ 1 ].resident_data );
+
+	result = memory_compare(
+	          extraction_scheduler->items[ 1 ].resident_data,
+	          resident_data,
+	          4 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_extraction_scheduler_append_item(
+	          NULL,
+	          5,
+	          0,
+	          8192,
+	          4096,
+	          0,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_extraction_scheduler_append_item(
+	          extraction_scheduler,
+	          5,
+	          -1,
+	          8192,
+	          4096,
+	          0,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_extraction_scheduler_append_item(
+	          extraction_scheduler,
+	          5,
+	          0,
+	          8192,
+	          0,
+	          0,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_extraction_scheduler_free(
+	          &extraction_scheduler,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "extraction_scheduler",
+	 extraction_scheduler );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extraction_scheduler != NULL )
+	{
+		libfsntfs_extraction_scheduler_free(
+		 &extraction_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The extraction test data
+ */
+typedef struct fsntfs_test_extraction_data fsntfs_test_extraction_data_t;
+
+struct fsntfs_test_extraction_data
+{
+	/* The extracted data per MFT entry
+	 */
+	uint8_t data[ 4 ][ 128 ];
+
+	/* The number of calls
+	 */
+	int number_of_calls;
+
+	/* The number of calls after which to stop
+	 */
+	int maximum_number_of_calls;
+};
+
+/* Callback function to test extraction
+ * Returns 1 to continue, 0 to stop or -1 on error
+ */
+int fsntfs_test_extraction_callback(
+     uint64_t mft_entry_index,
+     off64_t data_offset,
+     const uint8_t *data,
+     size_t data_size,
+     void *user_data )
+{
+	fsntfs_test_extraction_data_t *extraction_data = NULL;
+
+	extraction_data = (fsntfs_test_extraction_data_t *) user_data;
+
+	if( ( extraction_data == NULL )
+	 || ( mft_entry_index >= 4 )
+	 || ( data_offset < 0 )
+	 || ( data_offset > 128 )
+	 || ( data_size > (size_t) ( 128 - data_offset ) ) )
+	{
+		return( -1 );
+	}
+	if( extraction_data->number_of_calls >= extraction_data->maximum_number_of_calls )
+	{
+		return( 0 );
+	}
+	extraction_data->number_of_calls += 1;
+
+	memory_copy(
+	 &( extraction_data->data[ mft_entry_index ][ data_offset ] ),
+	 data,
+	 data_size );
+
+	return( 1 );
+}
+
+/* Tests the libfsntfs_extraction_scheduler_run function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_extraction_scheduler_run(
+     void )
+{
+	uint8_t data[ 256 ];
+	uint8_t resident_data[ 4 ] = { 'a', 'b', 'c', 'd' };
+
+	fsntfs_test_extraction_data_t extraction_data;
+
+	libbfio_handle_t *file_io_handle                       = NULL;
+	libcerror_error_t *error                               = NULL;
+	libfsntfs_data_segment_table_t *data_segment_table     = NULL;
+	libfsntfs_extraction_scheduler_t *extraction_scheduler = NULL;
+	libfsntfs_read_queue_t *read_queue                     = NULL;
+	int data_index                                         = 0;
+	int result                                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 256;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) data_index;
+	}
+	memory_set(
+	 &extraction_data,
+	 0xff,
+	 sizeof( fsntfs_test_extraction_data_t ) );
+
+	extraction_data.number_of_calls         = 0;
+	extraction_data.maximum_number_of_calls = 64;
+
+	result = fsntfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          256,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_extraction_scheduler_initialize(
+	          &extraction_scheduler,
+	          64,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "extraction_scheduler",
+	 extraction_scheduler );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* MFT entry 0 contains data offset 0 - 31 stored at volume offset 128 - 159,
+	 * data offset 32 - 47 is sparse and data offset 48 - 79 is stored at
+	 * volume offset 0 - 31
+	 */
+	result = libfsntfs_data_segment_table_initialize(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          128,
+	          32,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          16,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_data_segment_table_append_segment(
+	          data_segment_table,
+	          0,
+	          64,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_segment_table->data_size = 80;
+
+	result = libfsntfs_extraction_scheduler_append_data_segment_table(
+	          extraction_scheduler,
+	          0,
+	          data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The last segment is truncated to the data size
+	 */
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "extraction_scheduler->number_of_items",
+	 extraction_scheduler->number_of_items,
+	 3 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "extraction_scheduler->items[ 2 ].size",
+	 (uint64_t) extraction_scheduler->items[ 2 ].size,
+	 (uint64_t) 32 );
+
+	result = libfsntfs_data_segment_table_free(
+	          &data_segment_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* MFT entry 1 contains resident data
+	 */
+	result = libfsntfs_extraction_scheduler_append_item(
+	          extraction_scheduler,
+	          1,
+	          0,
+	          0,
+	          4,
+	          0,
+	          resident_data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* MFT entry 2 is stored directly after the first segment of MFT entry 0
+	 */
+	result = libfsntfs_extraction_scheduler_append_item(
+	          extraction_scheduler,
+	          2,
+	          0,
+	          160,
+	          32,
+	          0,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* MFT entry 3 is larger than the buffer
+	 */
+	result = libfsntfs_extraction_scheduler_append_item(
+	          extraction_scheduler,
+	          3,
+	          0,
+	          32,
+	          100,
+	          0,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_extraction_scheduler_run(
+	          extraction_scheduler,
+	          file_io_handle,
+	          NULL,
+	          &fsntfs_test_extraction_callback,
+	          &extraction_data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The sparse and resident data is passed first, followed by the data
+	 * at volume offset 0, 32 (in 2 parts) and 128 + 160 (in 1 read)
+	 */
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "extraction_data.number_of_calls",
+	 extraction_data.number_of_calls,
+	 7 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "extraction_scheduler->items[ 0 ].mft_entry_index",
+	 (int) extraction_scheduler->items[ 0 ].mft_entry_index,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "extraction_scheduler->items[ 2 ].start_offset",
+	 (int) extraction_scheduler->items[ 2 ].start_offset,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "extraction_scheduler->items[ 5 ].start_offset",
+	 (int) extraction_scheduler->items[ 5 ].start_offset,
+	 160 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 0 ][ 0 ]",
+	 extraction_data.data[ 0 ][ 0 ],
+	 128 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 0 ][ 31 ]",
+	 extraction_data.data[ 0 ][ 31 ],
+	 159 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 0 ][ 32 ]",
+	 extraction_data.data[ 0 ][ 32 ],
+	 0 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 0 ][ 47 ]",
+	 extraction_data.data[ 0 ][ 47 ],
+	 0 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 0 ][ 48 ]",
+	 extraction_data.data[ 0 ][ 48 ],
+	 0 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 0 ][ 79 ]",
+	 extraction_data.data[ 0 ][ 79 ],
+	 31 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 0 ][ 80 ]",
+	 extraction_data.data[ 0 ][ 80 ],
+	 0xff );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 1 ][ 3 ]",
+	 extraction_data.data[ 1 ][ 3 ],
+	 'd' );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 2 ][ 0 ]",
+	 extraction_data.data[ 2 ][ 0 ],
+	 160 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 2 ][ 31 ]",
+	 extraction_data.data[ 2 ][ 31 ],
+	 191 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 3 ][ 0 ]",
+	 extraction_data.data[ 3 ][ 0 ],
+	 32 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+	 "extraction_data.data[ 3 ][ 99 ]",
+	 extraction_data.data[ 3 ][ 99 ],
+	 131 );
+
+	/* Test stopping the extraction
+	 */
+	extraction_data.number_of_calls         = 0;
+	extraction_data.maximum_number_of_calls = 3;
+
+	result = libfsntfs_extraction_scheduler_run(
+	          extraction_scheduler,
+	          file_io_handle,
+	          NULL,
+	          &fsntfs_test_extraction_callback,
+	          &extraction_data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "extraction_data.number_of_calls",
+	 extraction_data.number_of_calls,
+	 3 );
+
+	/* Test with a read queue, the buffer is divided into 4 group buffers
+	 * of 16 bytes, hence the data at volume offset 0 is passed in 2 parts,
+	 * at 32 in 7 parts, at 128 in 2 parts and at 160 in 2 parts
+	 */
+	result = libfsntfs_read_queue_initialize(
+	          &read_queue,
+	          file_io_handle,
+	          4,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "read_queue",
+	 read_queue );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &extraction_data,
+	 0xff,
+	 sizeof( fsntfs_test_extraction_data_t ) );
+
+	extraction_data.number_of_calls         = 0;
+	extraction_data.maximum_number_of_calls = 64;
+
+	result = libfsntfs_extraction_scheduler_run(
+	          extraction_scheduler,
+	          file_io_handle,
+	          read_queue,
+	          &fsntfs_test_extraction_callback,
+	          &extraction_data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "extraction_data.number_of_calls",
+	 extraction_data.number_of_calls,
+	 15 );
+
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+		 "extraction_data.data[ 0 ][ data_index ]",
+		 extraction_data.data[ 0 ][ data_index ],
+		 (uint8_t) ( 128 + data_index ) );
+
+		FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+		 "extraction_data.data[ 0 ][ 48 + data_index ]",
+		 extraction_data.data[ 0 ][ 48 + data_index ],
+		 (uint8_t) data_index );
+
+		FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+		 "extraction_data.data[ 2 ][ data_index ]",
+		 extraction_data.data[ 2 ][ data_index ],
+		 (uint8_t) ( 160 + data_index ) );
+	}
+	for( data_index = 0;
+	     data_index < 100;
+	     data_index++ )
+	{
+		FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+		 "extraction_data.data[ 3 ][ data_index ]",
+		 extraction_data.data[ 3 ][ data_index ],
+		 (uint8_t) ( 32 + data_index ) );
+	}
+	/* Test stopping the extraction while reads are in flight
+	 */
+	extraction_data.number_of_calls         = 0;
+	extraction_data.maximum_number_of_calls = 4;
+
+	result = libfsntfs_extraction_scheduler_run(
+	          extraction_scheduler,
+	          file_io_handle,
+	          read_queue,
+	          &fsntfs_test_extraction_callback,
+	          &extraction_data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "extraction_data.number_of_calls",
+	 extraction_data.number_of_calls,
+	 4 );
+
+	result = libfsntfs_read_queue_free(
+	          &read_queue,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "read_queue",
+	 read_queue );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_extraction_scheduler_run(
+	          NULL,
+	          file_io_handle,
+	          NULL,
+	          &fsntfs_test_extraction_callback,
+	          &extraction_data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_extraction_scheduler_run(
+	          extraction_scheduler,
+	          file_io_handle,
+	          NULL,
+	          NULL,
+	          &extraction_data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_extraction_scheduler_run(
+	          extraction_scheduler,
+	          file_io_handle,
+	          NULL,
+	          &fsntfs_test_extraction_callback,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_extraction_scheduler_free(
+	          &extraction_scheduler,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "extraction_scheduler",
+	 extraction_scheduler );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsntfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_queue != NULL )
+	{
+		libfsntfs_read_queue_free(
+		 &read_queue,
+		 NULL );
+	}
+	if( data_segment_table != NULL )
+	{
+		libfsntfs_data_segment_table_free(
+		 &data_segment_table,
+		 NULL );
+	}
+	if( extraction_scheduler != NULL )
+	{
+		libfsntfs_extraction_scheduler_free(
+		 &extraction_scheduler,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_extraction_scheduler_initialize",
+	 fsntfs_test_extraction_scheduler_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_extraction_scheduler_free",
+	 fsntfs_test_extraction_scheduler_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_extraction_scheduler_append_item",
+	 fsntfs_test_extraction_scheduler_append_item );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_extraction_scheduler_run",
+	 fsntfs_test_extraction_scheduler_run );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+on_error:
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -44,6 +45,7 @@
 #include "fsntfs_test_rwlock.h"
 #include "fsntfs_test_unused.h"
 
+#include "../libfsntfs/libfsntfs_async_reader.h"
 #include "../libfsntfs/libfsntfs_attribute.h"
 #include "../libfsntfs/libfsntfs_definitions.h"
 #include "../libfsntfs/libfsntfs_directory_entry.h"
@@ -57,6 +59,29 @@
  */
 
 #define FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE		4096
+#define FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_ASYNC_READS	4
+#define FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES	6
+
+typedef struct fsntfs_test_file_entry_async_result fsntfs_test_file_entry_async_result_t;
+
+struct fsntfs_test_file_entry_async_result
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The number of bytes read
+	 */
+	ssize_t read_count;
+
+	/* Value to indicate an error was passed
+	 */
+	int has_error;
+
+	/* The number of times the callback function was called
+	 */
+	int number_of_calls;
+};
 
 uint8_t fsntfs_test_file_entry_data1[ 16384 ] = {
 	0x46, 0x49, 0x4c, 0x45, 0x30, 0x00, 0x03, 0x00, 0xb7, 0x4e, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -6658,6 +6683,63 @@ on_error:
 
 /* TODO: add tests for libfsntfs_file_entry_get_alternate_data_stream_by_utf16_name */
 
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_internal_file_entry_read_directory_entries_tree function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_internal_file_entry_read_directory_entries_tree(
+     libfsntfs_file_entry_t *file_entry )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_internal_file_entry_read_directory_entries_tree(
+	          (libfsntfs_internal_file_entry_t *) file_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_internal_file_entry_read_directory_entries_tree(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
 /* Tests the libfsntfs_file_entry_get_number_of_sub_file_entries function
  * Returns 1 if successful or 0 if not
  */
@@ -6727,18 +6809,18 @@ int fsntfs_test_file_entry_get_number_of_sub_file_entries(
 
 #if defined( HAVE_FSNTFS_TEST_RWLOCK )
 
-	/* Test libfsntfs_file_entry_get_number_of_sub_file_entries with pthread_rwlock_rdlock failing in libcthreads_read_write_lock_grab_for_read
+	/* Test libfsntfs_file_entry_get_number_of_sub_file_entries with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
 	 */
-	fsntfs_test_pthread_rwlock_rdlock_attempts_before_fail = 0;
+	fsntfs_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
 
 	result = libfsntfs_file_entry_get_number_of_sub_file_entries(
 	          file_entry,
 	          &number_of_file_entries,
 	          &error );
 
-	if( fsntfs_test_pthread_rwlock_rdlock_attempts_before_fail != -1 )
+	if( fsntfs_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
 	{
-		fsntfs_test_pthread_rwlock_rdlock_attempts_before_fail = -1;
+		fsntfs_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
 	}
 	else
 	{
@@ -6754,7 +6836,7 @@ int fsntfs_test_file_entry_get_number_of_sub_file_entries(
 		libcerror_error_free(
 		 &error );
 	}
-	/* Test libfsntfs_file_entry_get_number_of_sub_file_entries with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_read
+	/* Test libfsntfs_file_entry_get_number_of_sub_file_entries with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
 	 */
 	fsntfs_test_pthread_rwlock_unlock_attempts_before_fail = 0;
 
@@ -6794,6 +6876,103 @@ on_error:
 	return( 0 );
 }
 
+/* Callback function for the libfsntfs_file_entry_iterate_sub_file_entries test
+ * Returns 1 to continue
+ */
+int fsntfs_test_file_entry_iterate_sub_file_entries_callback(
+     libfsntfs_file_entry_t *sub_file_entry FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     void *user_data )
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( sub_file_entry )
+
+	if( user_data != NULL )
+	{
+		*( (int *) user_data ) += 1;
+	}
+	return( 1 );
+}
+
+/* Tests the libfsntfs_file_entry_iterate_sub_file_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_file_entry_iterate_sub_file_entries(
+     libfsntfs_file_entry_t *file_entry )
+{
+	libcerror_error_t *error       = NULL;
+	int number_of_sub_file_entries = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_file_entry_iterate_sub_file_entries(
+	          file_entry,
+	          &fsntfs_test_file_entry_iterate_sub_file_entries_callback,
+	          &number_of_sub_file_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_file_entries",
+	 number_of_sub_file_entries,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_file_entry_iterate_sub_file_entries(
+	          NULL,
+	          &fsntfs_test_file_entry_iterate_sub_file_entries_callback,
+	          &number_of_sub_file_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_file_entry_iterate_sub_file_entries(
+	          file_entry,
+	          NULL,
+	          &number_of_sub_file_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* TODO: add tests for libfsntfs_file_entry_get_sub_file_entry_by_index */
 
 /* TODO: add tests for libfsntfs_file_entry_get_sub_file_entry_by_utf8_name */
@@ -7510,96 +7689,875 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfsntfs_file_entry_seek_offset function
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Stores the result of an asynchronous read
+ */
+void fsntfs_test_file_entry_read_buffer_at_offset_async_callback_function(
+      libfsntfs_file_entry_t *file_entry FSNTFS_TEST_ATTRIBUTE_UNUSED,
+      void *buffer FSNTFS_TEST_ATTRIBUTE_UNUSED,
+      ssize_t read_count,
+      off64_t offset,
+      libcerror_error_t *error,
+      void *user_data )
+{
+	fsntfs_test_file_entry_async_result_t *read_result = NULL;
+
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( file_entry )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	read_result = (fsntfs_test_file_entry_async_result_t *) user_data;
+
+	read_result->offset           = offset;
+	read_result->read_count       = read_count;
+	read_result->has_error        = ( error != NULL );
+	read_result->number_of_calls += 1;
+}
+
+/* Tests the libfsntfs_file_entry_read_buffer_at_offset_async function
  * Returns 1 if successful or 0 if not
  */
-int fsntfs_test_file_entry_seek_offset(
+int fsntfs_test_file_entry_read_buffer_at_offset_async(
      libfsntfs_file_entry_t *file_entry )
 {
+	uint8_t async_buffers[ FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_ASYNC_READS ][ 512 ];
+	uint8_t buffer[ 512 ];
+
+	fsntfs_test_file_entry_async_result_t read_results[ FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_ASYNC_READS ];
+	off64_t read_offsets[ FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_ASYNC_READS ];
+
 	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	size64_t data_size       = 0;
+	ssize_t read_count       = 0;
+	int read_index           = 0;
+	int result               = 0;
 
-	/* Test regular cases
+	/* Determine size
 	 */
-	offset = libfsntfs_file_entry_seek_offset(
+	result = libfsntfs_file_entry_get_size(
 	          file_entry,
-	          0,
-	          SEEK_END,
+	          &data_size,
 	          &error );
 
-	FSNTFS_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	FSNTFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
-
-	offset = libfsntfs_file_entry_seek_offset(
-	          file_entry,
-	          1024,
-	          SEEK_SET,
-	          &error );
-
-	FSNTFS_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+	result = memory_set(
+	          read_results,
+	          0,
+	          sizeof( fsntfs_test_file_entry_async_result_t ) * FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_ASYNC_READS ) != NULL;
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	offset = libfsntfs_file_entry_seek_offset(
-	          file_entry,
-	          -512,
-	          SEEK_CUR,
-	          &error );
+	/* Test regular cases
+	 * The reads are submitted at the end, in the middle, at the start and beyond the end of the data
+	 */
+	read_offsets[ 0 ] = (off64_t) data_size - 8;
+	read_offsets[ 1 ] = (off64_t) data_size / 2;
+	read_offsets[ 2 ] = 0;
+	read_offsets[ 3 ] = (off64_t) data_size + 8;
 
-	FSNTFS_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+	for( read_index = 0;
+	     read_index < FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_ASYNC_READS;
+	     read_index++ )
+	{
+		result = libfsntfs_file_entry_read_buffer_at_offset_async(
+		          file_entry,
+		          async_buffers[ read_index ],
+		          512,
+		          read_offsets[ read_index ],
+		          &fsntfs_test_file_entry_read_buffer_at_offset_async_callback_function,
+		          (void *) &( read_results[ read_index ] ),
+		          &error );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
-	offset = libfsntfs_file_entry_seek_offset(
-	          file_entry,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Stopping the asynchronous reader completes the outstanding reads
+	 */
+	result = libfsntfs_async_reader_stop(
+	          ( (libfsntfs_internal_file_entry_t *) file_entry )->io_handle->async_reader,
 	          &error );
 
-	FSNTFS_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	FSNTFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
+	/* The data read asynchronously should match the data read synchronously
 	 */
-	offset = libfsntfs_file_entry_seek_offset(
-	          file_entry,
-	          0,
-	          SEEK_SET,
-	          &error );
-
-	FSNTFS_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	for( read_index = 0;
+	     read_index < FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_ASYNC_READS;
+	     read_index++ )
+	{
+		read_count = libfsntfs_file_entry_read_buffer_at_offset(
+		              file_entry,
+		              buffer,
+		              512,
+		              read_offsets[ read_index ],
+		              &error );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		FSNTFS_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "read_results[ read_index ].number_of_calls",
+		 read_results[ read_index ].number_of_calls,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "read_results[ read_index ].has_error",
+		 read_results[ read_index ].has_error,
+		 0 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT64(
+		 "read_results[ read_index ].offset",
+		 (int64_t) read_results[ read_index ].offset,
+		 (int64_t) read_offsets[ read_index ] );
+
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_results[ read_index ].read_count",
+		 read_results[ read_index ].read_count,
+		 read_count );
+
+		result = memory_compare(
+		          async_buffers[ read_index ],
+		          buffer,
+		          (size_t) read_count );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_results[ 0 ].read_count",
+	 read_results[ 0 ].read_count,
+	 (ssize_t) 8 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_results[ 3 ].read_count",
+	 read_results[ 3 ].read_count,
+	 (ssize_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_file_entry_read_buffer_at_offset_async(
+	          NULL,
+	          async_buffers[ 0 ],
+	          512,
+	          0,
+	          &fsntfs_test_file_entry_read_buffer_at_offset_async_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_file_entry_read_buffer_at_offset_async(
+	          file_entry,
+	          NULL,
+	          512,
+	          0,
+	          &fsntfs_test_file_entry_read_buffer_at_offset_async_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_file_entry_read_buffer_at_offset_async(
+	          file_entry,
+	          async_buffers[ 0 ],
+	          512,
+	          -1,
+	          &fsntfs_test_file_entry_read_buffer_at_offset_async_callback_function,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_file_entry_read_buffer_at_offset_async(
+	          file_entry,
+	          async_buffers[ 0 ],
+	          512,
+	          0,
+	          NULL,
+	          (void *) &( read_results[ 0 ] ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* Tests the libfsntfs_file_entry_read_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_file_entry_read_ranges(
+     libfsntfs_file_entry_t *file_entry )
+{
+	uint8_t range_data[ FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES ][ 512 ];
+	uint8_t buffer[ 512 ];
+
+	off64_t range_offsets[ FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES ];
+	size_t range_sizes[ FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES ];
+	uint8_t *range_buffers[ FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES ];
+	ssize_t range_read_counts[ FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES ];
+
+	libcerror_error_t *error = NULL;
+	size64_t data_size       = 0;
+	ssize_t read_count       = 0;
+	int range_index          = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libfsntfs_file_entry_get_size(
+	          file_entry,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The ranges are not sorted, overlap and extend beyond the end of the data
+	 */
+	range_offsets[ 0 ] = (off64_t) data_size / 2;
+	range_sizes[ 0 ]   = 256;
+	range_offsets[ 1 ] = 0;
+	range_sizes[ 1 ]   = 512;
+	range_offsets[ 2 ] = 128;
+	range_sizes[ 2 ]   = 512;
+	range_offsets[ 3 ] = (off64_t) data_size - 8;
+	range_sizes[ 3 ]   = 64;
+	range_offsets[ 4 ] = (off64_t) data_size + 16;
+	range_sizes[ 4 ]   = 64;
+	range_offsets[ 5 ] = ( (off64_t) data_size / 2 ) + 64;
+	range_sizes[ 5 ]   = 128;
+
+	for( range_index = 0;
+	     range_index < FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES;
+	     range_index++ )
+	{
+		range_buffers[ range_index ]     = range_data[ range_index ];
+		range_read_counts[ range_index ] = -1;
+	}
+	result = libfsntfs_file_entry_read_ranges(
+	          file_entry,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data of every range should match the data read separately
+	 */
+	for( range_index = 0;
+	     range_index < FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES;
+	     range_index++ )
+	{
+		read_count = libfsntfs_file_entry_pread_buffer(
+		              file_entry,
+		              buffer,
+		              range_sizes[ range_index ],
+		              range_offsets[ range_index ],
+		              &error );
+
+		FSNTFS_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "range_read_counts[ range_index ]",
+		 range_read_counts[ range_index ],
+		 read_count );
+
+		result = memory_compare(
+		          range_data[ range_index ],
+		          buffer,
+		          (size_t) read_count );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "range_read_counts[ 3 ]",
+	 range_read_counts[ 3 ],
+	 (ssize_t) 8 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "range_read_counts[ 4 ]",
+	 range_read_counts[ 4 ],
+	 (ssize_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_file_entry_read_ranges(
+	          NULL,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_file_entry_read_ranges(
+	          file_entry,
+	          NULL,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_file_entry_read_ranges(
+	          file_entry,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          -1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	range_offsets[ 0 ] = -1;
+
+	result = libfsntfs_file_entry_read_ranges(
+	          file_entry,
+	          range_offsets,
+	          range_sizes,
+	          range_buffers,
+	          range_read_counts,
+	          FSNTFS_TEST_FILE_ENTRY_NUMBER_OF_READ_RANGES,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_file_entry_pread_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_file_entry_pread_buffer(
+     libfsntfs_file_entry_t *file_entry )
+{
+	uint8_t buffer[ FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE ];
+	uint8_t expected_buffer[ FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error     = NULL;
+	time_t timestamp             = 0;
+	size64_t data_size           = 0;
+	size64_t remaining_data_size = 0;
+	size_t read_size             = 0;
+	ssize_t read_count           = 0;
+	off64_t current_offset       = 0;
+	off64_t offset               = 0;
+	off64_t read_offset          = 0;
+	int number_of_tests          = 1024;
+	int random_number            = 0;
+	int result                   = 0;
+	int test_number              = 0;
+
+	/* Determine size
+	 */
+	result = libfsntfs_file_entry_get_size(
+	          file_entry,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Determine current offset
+	 */
+	result = libfsntfs_file_entry_get_offset(
+	          file_entry,
+	          &current_offset,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_size = FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE;
+
+	if( data_size < FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE )
+	{
+		read_size = (size_t) data_size;
+	}
+	read_count = libfsntfs_file_entry_pread_buffer(
+	              file_entry,
+	              buffer,
+	              FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( data_size > 8 )
+	{
+		/* Read buffer on data_size boundary
+		 */
+		read_count = libfsntfs_file_entry_pread_buffer(
+		              file_entry,
+		              buffer,
+		              FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE,
+		              data_size - 8,
+		              &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond data_size boundary
+		 */
+		read_count = libfsntfs_file_entry_pread_buffer(
+		              file_entry,
+		              buffer,
+		              FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE,
+		              data_size + 8,
+		              &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The current offset should not have changed
+	 */
+	result = libfsntfs_file_entry_get_offset(
+	          file_entry,
+	          &offset,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 current_offset );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Stress test read buffer, the data should match that of read buffer at offset
+	 */
+	timestamp = time(
+	             NULL );
+
+	srand(
+	 (unsigned int) timestamp );
+
+	for( test_number = 0;
+	     test_number < number_of_tests;
+	     test_number++ )
+	{
+		random_number = rand();
+
+		FSNTFS_TEST_ASSERT_GREATER_THAN_INT(
+		 "random_number",
+		 random_number,
+		 -1 );
+
+		if( data_size > 0 )
+		{
+			read_offset = (off64_t) random_number % data_size;
+		}
+		read_size = (size_t) random_number % FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE;
+
+		read_count = libfsntfs_file_entry_pread_buffer(
+		              file_entry,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		remaining_data_size = data_size - read_offset;
+
+		if( read_size > remaining_data_size )
+		{
+			read_size = (size_t) remaining_data_size;
+		}
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libfsntfs_file_entry_read_buffer_at_offset(
+		              file_entry,
+		              expected_buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          expected_buffer,
+		          read_size );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	read_count = libfsntfs_file_entry_pread_buffer(
+	              NULL,
+	              buffer,
+	              FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfsntfs_file_entry_pread_buffer(
+	              file_entry,
+	              NULL,
+	              FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfsntfs_file_entry_pread_buffer(
+	              file_entry,
+	              buffer,
+	              FSNTFS_TEST_FILE_ENTRY_READ_BUFFER_SIZE,
+	              -1,
+	              &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_file_entry_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_file_entry_seek_offset(
+     libfsntfs_file_entry_t *file_entry )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libfsntfs_file_entry_seek_offset(
+	          file_entry,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libfsntfs_file_entry_seek_offset(
+	          file_entry,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libfsntfs_file_entry_seek_offset(
+	          file_entry,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libfsntfs_file_entry_seek_offset(
+	          file_entry,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libfsntfs_file_entry_seek_offset(
+	          file_entry,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
@@ -8725,11 +9683,21 @@ int main(
 
 	/* TODO: add tests for libfsntfs_file_entry_get_alternate_data_stream_by_utf16_name */
 
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_internal_file_entry_read_directory_entries_tree",
+	 fsntfs_test_internal_file_entry_read_directory_entries_tree,
+	 file_entry );
+
 	FSNTFS_TEST_RUN_WITH_ARGS(
 	 "libfsntfs_file_entry_get_number_of_sub_file_entries",
 	 fsntfs_test_file_entry_get_number_of_sub_file_entries,
 	 file_entry );
 
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_file_entry_iterate_sub_file_entries",
+	 fsntfs_test_file_entry_iterate_sub_file_entries,
+	 file_entry );
+
 	/* TODO: add tests for libfsntfs_file_entry_get_sub_file_entry_by_index */
 
 	/* TODO: add tests for libfsntfs_file_entry_get_sub_file_entry_by_utf8_name */
@@ -8746,6 +9714,21 @@ int main(
 	 fsntfs_test_file_entry_read_buffer_at_offset,
 	 file_entry );
 
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_file_entry_read_buffer_at_offset_async",
+	 fsntfs_test_file_entry_read_buffer_at_offset_async,
+	 file_entry );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_file_entry_read_ranges",
+	 fsntfs_test_file_entry_read_ranges,
+	 file_entry );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_file_entry_pread_buffer",
+	 fsntfs_test_file_entry_pread_buffer,
+	 file_entry );
+
 	FSNTFS_TEST_RUN_WITH_ARGS(
 	 "libfsntfs_file_entry_seek_offset",
 	 fsntfs_test_file_entry_seek_offset,
@@ -33,6 +33,7 @@
 #include "fsntfs_test_memory.h"
 #include "fsntfs_test_unused.h"
 
+#include "../libfsntfs/libfsntfs_definitions.h"
 #include "../libfsntfs/libfsntfs_io_handle.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
@@ -398,6 +399,200 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsntfs_io_handle_get_maximum_number_of_cache_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_io_handle_get_maximum_number_of_cache_entries(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libfsntfs_io_handle_t *io_handle    = NULL;
+	int maximum_number_of_cache_entries = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+	          io_handle,
+	          LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	          1024,
+	          &maximum_number_of_cache_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_cache_entries",
+	 maximum_number_of_cache_entries,
+	 LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_MFT_ENTRIES );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->maximum_mft_entry_cache_size = 1024 * 1024;
+
+	result = libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+	          io_handle,
+	          LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	          1024,
+	          &maximum_number_of_cache_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_cache_entries",
+	 maximum_number_of_cache_entries,
+	 1024 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->maximum_index_node_cache_size = 1;
+
+	result = libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+	          io_handle,
+	          LIBFSNTFS_CACHE_TYPE_INDEX_NODES,
+	          4096,
+	          &maximum_number_of_cache_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_cache_entries",
+	 maximum_number_of_cache_entries,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+	          NULL,
+	          LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	          1024,
+	          &maximum_number_of_cache_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+	          io_handle,
+	          -1,
+	          1024,
+	          &maximum_number_of_cache_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_io_handle_get_maximum_number_of_cache_entries(
+	          io_handle,
+	          LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	          1024,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libfsntfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
 
 /* The main program
@@ -429,6 +624,10 @@ int main(
 	 "libfsntfs_io_handle_clear",
 	 fsntfs_test_io_handle_clear );
 
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_io_handle_get_maximum_number_of_cache_entries",
+	 fsntfs_test_io_handle_get_maximum_number_of_cache_entries );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,1924 @@
+/*
+ * Library metadata_cache type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_metadata_cache.h"
+
+uint8_t fsntfs_test_metadata_cache_data1[ 216 ] = {
+	0x66, 0x73, 0x6e, 0x74, 0x66, 0x73, 0x6d, 0x63, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+	0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,
+	0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+	0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0x00, 0x01, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x01, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x05, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+	0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+	0x5c, 0x61, 0x5c, 0x62, 0x00, 0x5c, 0x61, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_metadata_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libfsntfs_metadata_cache_t *metadata_cache = NULL;
+	int result                                 = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests            = 1;
+	int number_of_memset_fail_tests            = 1;
+	int test_number                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_metadata_cache_initialize(
+	          &metadata_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_cache",
+	 metadata_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_free(
+	          &metadata_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "metadata_cache",
+	 metadata_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_initialize(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	metadata_cache = (libfsntfs_metadata_cache_t *) 0x12345678UL;
+
+	result = libfsntfs_metadata_cache_initialize(
+	          &metadata_cache,
+	          &error );
+
+	metadata_cache = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_metadata_cache_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_metadata_cache_initialize(
+		          &metadata_cache,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( metadata_cache != NULL )
+			{
+				libfsntfs_metadata_cache_free(
+				 &metadata_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "metadata_cache",
+			 metadata_cache );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_metadata_cache_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_metadata_cache_initialize(
+		          &metadata_cache,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( metadata_cache != NULL )
+			{
+				libfsntfs_metadata_cache_free(
+				 &metadata_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "metadata_cache",
+			 metadata_cache );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_cache != NULL )
+	{
+		libfsntfs_metadata_cache_free(
+		 &metadata_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_metadata_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_metadata_cache_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_read_data(
+     void )
+{
+	uint8_t data[ 216 ];
+
+	libcerror_error_t *error                   = NULL;
+	libfsntfs_metadata_cache_t *metadata_cache = NULL;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_metadata_cache_initialize(
+	          &metadata_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_cache",
+	 metadata_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          fsntfs_test_metadata_cache_data1,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_cache->volume_serial_number",
+	 metadata_cache->volume_serial_number,
+	 (uint64_t) 0x1122334455667788ULL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_cache->mft_journal_sequence_number",
+	 metadata_cache->mft_journal_sequence_number,
+	 (uint64_t) 0x1000 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_cache->attribute_list_mappings.data_size",
+	 metadata_cache->attribute_list_mappings.data_size,
+	 (size_t) 48 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_cache->security_descriptor_mappings.data_size",
+	 metadata_cache->security_descriptor_mappings.data_size,
+	 (size_t) 32 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_cache->path_data.data_size",
+	 metadata_cache->path_data.data_size,
+	 (size_t) 8 );
+
+	/* Test that data without a metadata cache signature is not supported
+	 */
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          &( fsntfs_test_metadata_cache_data1[ 8 ] ),
+	          208,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_read_data(
+	          NULL,
+	          fsntfs_test_metadata_cache_data1,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          NULL,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          fsntfs_test_metadata_cache_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the attribute list mappings exceed the data
+	 */
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          fsntfs_test_metadata_cache_data1,
+	          128,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the path data exceeds the data
+	 */
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          fsntfs_test_metadata_cache_data1,
+	          212,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the attribute list mappings are not sorted
+	 */
+	result = memory_copy(
+	          data,
+	          fsntfs_test_metadata_cache_data1,
+	          216 ) == NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	data[ 96 ] = 0x09;
+
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          data,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where a path exceeds the path data
+	 */
+	data[ 96 ] = 0x05;
+	data[ 188 ] = 0x04;
+
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          data,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where a path is missing the end-of-string character
+	 */
+	data[ 188 ] = 0x03;
+	data[ 215 ] = 0x62;
+
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          data,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_metadata_cache_free(
+	          &metadata_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "metadata_cache",
+	 metadata_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_cache != NULL )
+	{
+		libfsntfs_metadata_cache_free(
+		 &metadata_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_metadata_cache_write_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_write_data(
+     void )
+{
+	uint8_t data[ 216 ];
+
+	libcerror_error_t *error                   = NULL;
+	libfsntfs_metadata_cache_t *metadata_cache = NULL;
+	size_t data_size                           = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_metadata_cache_initialize(
+	          &metadata_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_cache",
+	 metadata_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_set_volume_values(
+	          metadata_cache,
+	          0x1122334455667788ULL,
+	          0x1000,
+	          0x40000,
+	          4096,
+	          1024,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_append_mft_range(
+	          metadata_cache,
+	          0x00004000L,
+	          0x00020000UL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_append_mft_range(
+	          metadata_cache,
+	          0x00100000L,
+	          0x00020000UL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The records are appended out of order to test sorting
+	 */
+	result = libfsntfs_metadata_cache_append_attribute_list_mapping(
+	          metadata_cache,
+	          0x0002000000000007ULL,
+	          0x0002000000000030ULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_append_attribute_list_mapping(
+	          metadata_cache,
+	          0x0001000000000005ULL,
+	          0x0001000000000021ULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_append_attribute_list_mapping(
+	          metadata_cache,
+	          0x0001000000000005ULL,
+	          0x0001000000000020ULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_append_security_descriptor_mapping(
+	          metadata_cache,
+	          0x00000101UL,
+	          0x00000080UL,
+	          0x00000080UL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_append_security_descriptor_mapping(
+	          metadata_cache,
+	          0x00000100UL,
+	          0,
+	          0x00000078UL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_append_path_hint(
+	          metadata_cache,
+	          0x0002000000000007ULL,
+	          (uint8_t *) "\\a\\b",
+	          5,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_append_path_hint(
+	          metadata_cache,
+	          0x0001000000000005ULL,
+	          (uint8_t *) "\\a",
+	          3,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_metadata_cache_get_data_size(
+	          metadata_cache,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 216 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_write_data(
+	          metadata_cache,
+	          data,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          fsntfs_test_metadata_cache_data1,
+	          216 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_write_data(
+	          NULL,
+	          data,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_write_data(
+	          metadata_cache,
+	          NULL,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_write_data(
+	          metadata_cache,
+	          data,
+	          64,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_append_path_hint(
+	          metadata_cache,
+	          0x0003000000000009ULL,
+	          (uint8_t *) "\\c",
+	          2,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_metadata_cache_free(
+	          &metadata_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "metadata_cache",
+	 metadata_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_cache != NULL )
+	{
+		libfsntfs_metadata_cache_free(
+		 &metadata_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_metadata_cache_matches_mft function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_matches_mft(
+     libfsntfs_metadata_cache_t *metadata_cache )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_metadata_cache_matches_mft(
+	          metadata_cache,
+	          0x1000,
+	          0x40000,
+	          4096,
+	          1024,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_matches_mft(
+	          metadata_cache,
+	          0x2000,
+	          0x40000,
+	          4096,
+	          1024,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_matches_mft(
+	          metadata_cache,
+	          0x1000,
+	          0x80000,
+	          4096,
+	          1024,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_matches_mft(
+	          NULL,
+	          0x1000,
+	          0x40000,
+	          4096,
+	          1024,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_metadata_cache_get_mft_range_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_get_mft_range_by_index(
+     libfsntfs_metadata_cache_t *metadata_cache )
+{
+	libcerror_error_t *error = NULL;
+	size64_t range_size      = 0;
+	off64_t range_offset     = 0;
+	int number_of_ranges     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_metadata_cache_get_number_of_mft_ranges(
+	          metadata_cache,
+	          &number_of_ranges,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 2 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_get_mft_range_by_index(
+	          metadata_cache,
+	          1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 0x00100000L );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 0x00020000UL );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_get_mft_range_by_index(
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_mft_range_by_index(
+	          metadata_cache,
+	          2,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_mft_range_by_index(
+	          metadata_cache,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_mft_range_by_index(
+	          metadata_cache,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference(
+     libfsntfs_metadata_cache_t *metadata_cache )
+{
+	libcerror_error_t *error            = NULL;
+	uint64_t base_record_file_reference = 0;
+	uint64_t file_reference             = 0;
+	int mapping_index                   = 0;
+	int number_of_mappings              = 0;
+	int result                          = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference(
+	          metadata_cache,
+	          0x0001000000000005ULL,
+	          &mapping_index,
+	          &number_of_mappings,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "mapping_index",
+	 mapping_index,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_mappings",
+	 number_of_mappings,
+	 2 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_get_attribute_list_mapping_by_index(
+	          metadata_cache,
+	          1,
+	          &base_record_file_reference,
+	          &file_reference,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "base_record_file_reference",
+	 base_record_file_reference,
+	 (uint64_t) 0x0001000000000005ULL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "file_reference",
+	 file_reference,
+	 (uint64_t) 0x0001000000000021ULL );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference(
+	          metadata_cache,
+	          0x0002000000000007ULL,
+	          &mapping_index,
+	          &number_of_mappings,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "mapping_index",
+	 mapping_index,
+	 2 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_mappings",
+	 number_of_mappings,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A different sequence number is not a match
+	 */
+	result = libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference(
+	          metadata_cache,
+	          0x0002000000000005ULL,
+	          &mapping_index,
+	          &number_of_mappings,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference(
+	          NULL,
+	          0x0001000000000005ULL,
+	          &mapping_index,
+	          &number_of_mappings,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference(
+	          metadata_cache,
+	          0x0001000000000005ULL,
+	          NULL,
+	          &number_of_mappings,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_attribute_list_mapping_by_index(
+	          metadata_cache,
+	          3,
+	          &base_record_file_reference,
+	          &file_reference,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_get_security_descriptor_mapping_by_identifier(
+     libfsntfs_metadata_cache_t *metadata_cache )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t data_offset     = 0;
+	uint32_t data_size       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier(
+	          metadata_cache,
+	          0x00000101UL,
+	          &data_offset,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "data_offset",
+	 data_offset,
+	 (uint64_t) 0x00000080UL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "data_size",
+	 data_size,
+	 (uint32_t) 0x00000080UL );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier(
+	          metadata_cache,
+	          0x00000100UL,
+	          &data_offset,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "data_offset",
+	 data_offset,
+	 (uint64_t) 0 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "data_size",
+	 data_size,
+	 (uint32_t) 0x00000078UL );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier(
+	          metadata_cache,
+	          0x00000200UL,
+	          &data_offset,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier(
+	          NULL,
+	          0x00000101UL,
+	          &data_offset,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier(
+	          metadata_cache,
+	          0x00000101UL,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_metadata_cache_get_path_hint_by_file_reference function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_get_path_hint_by_file_reference(
+     libfsntfs_metadata_cache_t *metadata_cache )
+{
+	libcerror_error_t *error = NULL;
+	const uint8_t *path      = NULL;
+	size_t path_size         = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_metadata_cache_get_path_hint_by_file_reference(
+	          metadata_cache,
+	          0x0002000000000007ULL,
+	          &path,
+	          &path_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "path_size",
+	 path_size,
+	 (size_t) 5 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path",
+	 path );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          path,
+	          "\\a\\b",
+	          5 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfsntfs_metadata_cache_get_path_hint_by_file_reference(
+	          metadata_cache,
+	          0x0001000000000007ULL,
+	          &path,
+	          &path_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_get_path_hint_by_file_reference(
+	          NULL,
+	          0x0002000000000007ULL,
+	          &path,
+	          &path_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_path_hint_by_file_reference(
+	          metadata_cache,
+	          0x0002000000000007ULL,
+	          NULL,
+	          &path_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_path_hint_by_file_reference(
+	          metadata_cache,
+	          0x0002000000000007ULL,
+	          &path,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_metadata_cache_get_path_hint_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_metadata_cache_get_path_hint_by_index(
+     libfsntfs_metadata_cache_t *metadata_cache )
+{
+	libcerror_error_t *error = NULL;
+	const uint8_t *path      = NULL;
+	uint64_t file_reference  = 0;
+	size_t path_size         = 0;
+	int number_of_path_hints = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_metadata_cache_get_number_of_path_hints(
+	          metadata_cache,
+	          &number_of_path_hints,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_path_hints",
+	 number_of_path_hints,
+	 2 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_get_path_hint_by_index(
+	          metadata_cache,
+	          0,
+	          &file_reference,
+	          &path,
+	          &path_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "file_reference",
+	 file_reference,
+	 (uint64_t) 0x0001000000000005ULL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "path_size",
+	 path_size,
+	 (size_t) 3 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path",
+	 path );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          path,
+	          "\\a",
+	          3 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_metadata_cache_get_path_hint_by_index(
+	          NULL,
+	          0,
+	          &file_reference,
+	          &path,
+	          &path_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_path_hint_by_index(
+	          metadata_cache,
+	          2,
+	          &file_reference,
+	          &path,
+	          &path_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_metadata_cache_get_path_hint_by_index(
+	          metadata_cache,
+	          0,
+	          NULL,
+	          &path,
+	          &path_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+	libcerror_error_t *error                   = NULL;
+	libfsntfs_metadata_cache_t *metadata_cache = NULL;
+	int result                                 = 0;
+#endif
+
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_metadata_cache_initialize",
+	 fsntfs_test_metadata_cache_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_metadata_cache_free",
+	 fsntfs_test_metadata_cache_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_metadata_cache_read_data",
+	 fsntfs_test_metadata_cache_read_data );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_metadata_cache_write_data",
+	 fsntfs_test_metadata_cache_write_data );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize metadata_cache for tests
+	 */
+	result = libfsntfs_metadata_cache_initialize(
+	          &metadata_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_cache",
+	 metadata_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_metadata_cache_read_data(
+	          metadata_cache,
+	          fsntfs_test_metadata_cache_data1,
+	          216,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_metadata_cache_matches_mft",
+	 fsntfs_test_metadata_cache_matches_mft,
+	 metadata_cache );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_metadata_cache_get_mft_range_by_index",
+	 fsntfs_test_metadata_cache_get_mft_range_by_index,
+	 metadata_cache );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference",
+	 fsntfs_test_metadata_cache_get_attribute_list_mappings_by_base_record_file_reference,
+	 metadata_cache );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_metadata_cache_get_security_descriptor_mapping_by_identifier",
+	 fsntfs_test_metadata_cache_get_security_descriptor_mapping_by_identifier,
+	 metadata_cache );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_metadata_cache_get_path_hint_by_file_reference",
+	 fsntfs_test_metadata_cache_get_path_hint_by_file_reference,
+	 metadata_cache );
+
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_metadata_cache_get_path_hint_by_index",
+	 fsntfs_test_metadata_cache_get_path_hint_by_index,
+	 metadata_cache );
+
+	/* Clean up
+	 */
+	result = libfsntfs_metadata_cache_free(
+	          &metadata_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "metadata_cache",
+	 metadata_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_cache != NULL )
+	{
+		libfsntfs_metadata_cache_free(
+		 &metadata_cache,
+		 NULL );
+	}
+#endif
+	return( EXIT_FAILURE );
+}
+
@@ -27,6 +27,8 @@
 #include <stdlib.h>
 #endif
 
+#include "fsntfs_test_functions.h"
+#include "fsntfs_test_libbfio.h"
 #include "fsntfs_test_libcerror.h"
 #include "fsntfs_test_libfsntfs.h"
 #include "fsntfs_test_macros.h"
@@ -432,6 +434,223 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsntfs_mft_get_readahead_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_mft_get_readahead_data(
+     libfsntfs_mft_t *mft )
+{
+	uint8_t mft_data[ 4096 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	const uint8_t *data              = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = fsntfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          mft_data,
+	          4096,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_mft_get_readahead_data(
+	          mft,
+	          file_io_handle,
+	          0,
+	          1024,
+	          &data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test data contained in the read-ahead data
+	 */
+	result = libfsntfs_mft_get_readahead_data(
+	          mft,
+	          NULL,
+	          512,
+	          512,
+	          &data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "data",
+	 (intptr_t) data,
+	 (intptr_t) &( mft->readahead_data[ 512 ] ) );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_mft_get_readahead_data(
+	          NULL,
+	          file_io_handle,
+	          0,
+	          1024,
+	          &data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_mft_get_readahead_data(
+	          mft,
+	          file_io_handle,
+	          -1,
+	          1024,
+	          &data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_mft_get_readahead_data(
+	          mft,
+	          file_io_handle,
+	          0,
+	          0,
+	          &data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_mft_get_readahead_data(
+	          mft,
+	          file_io_handle,
+	          0,
+	          1024,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test data beyond the end of the file IO handle
+	 */
+	result = libfsntfs_mft_get_readahead_data(
+	          mft,
+	          file_io_handle,
+	          3584,
+	          1024,
+	          &data,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up file IO handle
+	 */
+	result = fsntfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
 
 /* The main program
@@ -516,6 +735,11 @@ int main(
 	 fsntfs_test_mft_get_number_of_entries,
 	 mft );
 
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_mft_get_readahead_data",
+	 fsntfs_test_mft_get_readahead_data,
+	 mft );
+
 	/* TODO: add tests for libfsntfs_mft_get_mft_entry_by_index */
 
 	/* TODO: add tests for libfsntfs_mft_get_mft_entry_by_index_no_cache */
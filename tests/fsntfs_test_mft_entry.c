@@ -1742,6 +1742,59 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsntfs_mft_entry_has_attribute_list_attribute function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_mft_entry_has_attribute_list_attribute(
+     libfsntfs_mft_entry_t *mft_entry )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_mft_entry_has_attribute_list_attribute(
+	          mft_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_mft_entry_has_attribute_list_attribute(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* TODO: add tests for libfsntfs_mft_entry_read_attributes */
 
 /* TODO: add tests for libfsntfs_mft_entry_read_attributes_from_attribute_list */
@@ -2574,6 +2627,11 @@ int main(
 
 	/* Run tests
 	 */
+	FSNTFS_TEST_RUN_WITH_ARGS(
+	 "libfsntfs_mft_entry_has_attribute_list_attribute",
+	 fsntfs_test_mft_entry_has_attribute_list_attribute,
+	 mft_entry );
+
 	FSNTFS_TEST_RUN_WITH_ARGS(
 	 "libfsntfs_mft_entry_is_empty",
 	 fsntfs_test_mft_entry_is_empty,
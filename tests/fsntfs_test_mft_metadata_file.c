@@ -1361,6 +1361,74 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsntfs_mft_metadata_file_read_attribute_list_map function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_mft_metadata_file_read_attribute_list_map(
+     libfsntfs_mft_metadata_file_t *mft_metadata_file )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_mft_metadata_file_read_attribute_list_map(
+	          mft_metadata_file,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading the attribute list map a second time
+	 */
+	result = libfsntfs_mft_metadata_file_read_attribute_list_map(
+	          mft_metadata_file,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_mft_metadata_file_read_attribute_list_map(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -1612,6 +1680,11 @@ int main(
 
 		/* TODO: add tests for libfsntfs_mft_metadata_file_get_file_entry_by_index */
 
+		FSNTFS_TEST_RUN_WITH_ARGS(
+		 "libfsntfs_mft_metadata_file_read_attribute_list_map",
+		 fsntfs_test_mft_metadata_file_read_attribute_list_map,
+		 mft_metadata_file );
+
 		/* Clean up
 		 */
 		result = fsntfs_test_mft_metadata_file_close_source(
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -34,9 +35,143 @@
 #include "fsntfs_test_unused.h"
 
 #include "../libfsntfs/libfsntfs_name.h"
+#include "../libfsntfs/libfsntfs_upcase_table.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
 
+/* Tests the libfsntfs_name_get_upper_case_character function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_name_get_upper_case_character(
+     void )
+{
+        uint8_t utf16_stream_e_acute[ 4 ]        = { 0xe9, 0, 0, 0 };
+        uint16_t utf16_string_e_acute_upper[ 1 ] = { 0x00c9 };
+	libcerror_error_t *error                 = NULL;
+	libfsntfs_upcase_table_t *upcase_table   = NULL;
+	libuna_unicode_character_t character     = 0;
+	int result                               = 0;
+
+	/* Test regular cases
+	 */
+	character = libfsntfs_name_get_upper_case_character(
+	             (libuna_unicode_character_t) 'a',
+	             NULL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "character",
+	 (uint32_t) character,
+	 (uint32_t) 'A' );
+
+	character = libfsntfs_name_get_upper_case_character(
+	             (libuna_unicode_character_t) '1',
+	             NULL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "character",
+	 (uint32_t) character,
+	 (uint32_t) '1' );
+
+	result = libfsntfs_upcase_table_initialize(
+	          &upcase_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "upcase_table",
+	 upcase_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	upcase_table->values[ 0x00e9 ] = 0x00c9;
+
+	character = libfsntfs_name_get_upper_case_character(
+	             (libuna_unicode_character_t) 'z',
+	             upcase_table );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "character",
+	 (uint32_t) character,
+	 (uint32_t) 'Z' );
+
+	character = libfsntfs_name_get_upper_case_character(
+	             0x000000e9UL,
+	             upcase_table );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "character",
+	 (uint32_t) character,
+	 (uint32_t) 0x000000c9UL );
+
+	character = libfsntfs_name_get_upper_case_character(
+	             0x00010428UL,
+	             upcase_table );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "character",
+	 (uint32_t) character,
+	 (uint32_t) 0x00010428UL );
+
+		result = libfsntfs_name_compare_with_utf16_string(
+	          utf16_stream_e_acute,
+	          4,
+	          utf16_string_e_acute_upper,
+	          1,
+	          1,
+	          upcase_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBUNA_COMPARE_EQUAL );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_upcase_table_free(
+	          &upcase_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "upcase_table",
+	 upcase_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( upcase_table != NULL )
+	{
+		libfsntfs_upcase_table_free(
+		 &upcase_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libfsntfs_name_compare function
  * Returns 1 if successful or 0 if not
  */
@@ -61,6 +196,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_equal,
 	          12,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -78,6 +214,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_equal,
 	          12,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -95,6 +232,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_equal_upper,
 	          12,
 	          1,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -112,6 +250,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_greater,
 	          16,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -129,6 +268,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_more,
 	          10,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -146,6 +286,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_less,
 	          10,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -163,6 +304,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_less,
 	          10,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -182,6 +324,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_equal,
 	          12,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -202,6 +345,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_equal,
 	          12,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -222,6 +366,7 @@ int fsntfs_test_name_compare(
 	          NULL,
 	          12,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -242,6 +387,7 @@ int fsntfs_test_name_compare(
 	          utf16_stream_equal,
 	          (size_t) SSIZE_MAX + 1,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -650,6 +796,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_equal,
 	          5,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -667,6 +814,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_equal,
 	          6,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -684,6 +832,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_equal_upper,
 	          5,
 	          1,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -701,6 +850,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_greater,
 	          7,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -718,6 +868,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_more,
 	          4,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -735,6 +886,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_less,
 	          4,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -752,6 +904,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_less,
 	          4,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -771,6 +924,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_equal,
 	          5,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -791,6 +945,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_equal,
 	          5,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -811,6 +966,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          NULL,
 	          5,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -831,6 +987,7 @@ int fsntfs_test_name_compare_with_utf8_string(
 	          utf8_string_equal,
 	          (size_t) SSIZE_MAX + 1,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -883,6 +1040,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_equal,
 	          5,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -900,6 +1058,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_equal,
 	          6,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -917,6 +1076,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_equal_upper,
 	          5,
 	          1,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -934,6 +1094,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_greater,
 	          7,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -951,6 +1112,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_more,
 	          4,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -968,6 +1130,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_less,
 	          4,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -985,6 +1148,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_less,
 	          4,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -1004,6 +1168,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_equal,
 	          5,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -1024,6 +1189,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_equal,
 	          5,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -1044,6 +1210,7 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          NULL,
 	          5,
 	          0,
+	          NULL,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -1064,6 +1231,485 @@ int fsntfs_test_name_compare_with_utf16_string(
 	          utf16_string_equal,
 	          (size_t) SSIZE_MAX + 1,
 	          0,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_name_get_hash function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_name_get_hash(
+     void )
+{
+        uint8_t utf16_stream_equal[ 12 ]       = { 'e', 0, 'q', 0, 'u', 0, 'a', 0, 'l', 0, 0 };
+        uint8_t utf16_stream_equal_upper[ 12 ] = { 'E', 0, 'Q', 0, 'U', 0, 'A', 0, 'L', 0, 0 };
+        uint8_t utf8_string_equal_upper[ 5 ]   = { 'E', 'Q', 'U', 'A', 'L' };
+        uint16_t utf16_string_equal_upper[ 6 ] = { 'E', 'Q', 'U', 'A', 'L', 0 };
+	libcerror_error_t *error               = NULL;
+	uint32_t hash                          = 0;
+	uint32_t other_hash                    = 0;
+	int result                             = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_name_get_hash(
+	          utf16_stream_equal,
+	          12,
+	          1,
+	          NULL,
+	          &hash,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_name_get_hash(
+	          utf16_stream_equal_upper,
+	          10,
+	          1,
+	          NULL,
+	          &other_hash,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "other_hash",
+	 other_hash,
+	 hash );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_name_get_hash_from_utf8_string(
+	          utf8_string_equal_upper,
+	          5,
+	          1,
+	          NULL,
+	          &other_hash,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "other_hash",
+	 other_hash,
+	 hash );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_name_get_hash_from_utf16_string(
+	          utf16_string_equal_upper,
+	          6,
+	          1,
+	          NULL,
+	          &other_hash,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT32(
+	 "other_hash",
+	 other_hash,
+	 hash );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_name_get_hash(
+	          NULL,
+	          12,
+	          1,
+	          NULL,
+	          &hash,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_name_get_hash(
+	          utf16_stream_equal,
+	          12,
+	          1,
+	          NULL,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_name_get_hash_from_utf8_string(
+	          NULL,
+	          5,
+	          1,
+	          NULL,
+	          &hash,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_name_get_hash_from_utf16_string(
+	          NULL,
+	          6,
+	          1,
+	          NULL,
+	          &hash,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_name_get_number_of_ascii_characters function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_name_get_number_of_ascii_characters(
+     void )
+{
+        uint8_t utf16_stream_ascii[ 26 ]     = { 't', 0, 'e', 0, 's', 0, 't', 0, 'f', 0, 'i', 0, 'l', 0, 'e', 0, '.', 0, 't', 0, 'x', 0, 't', 0, 0, 0 };
+        uint8_t utf16_stream_non_ascii[ 12 ] = { 'e', 0, 'q', 0, 'u', 0, 'a', 0, 'l', 0, 0xe9, 0 };
+	libcerror_error_t *error             = NULL;
+	size_t number_of_characters          = 0;
+	int result                           = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_name_get_number_of_ascii_characters(
+	          utf16_stream_ascii,
+	          26,
+	          &number_of_characters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_characters",
+	 number_of_characters,
+	 (size_t) 12 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_name_get_number_of_ascii_characters(
+	          utf16_stream_ascii,
+	          10,
+	          &number_of_characters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_characters",
+	 number_of_characters,
+	 (size_t) 5 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_name_get_number_of_ascii_characters(
+	          utf16_stream_non_ascii,
+	          12,
+	          &number_of_characters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_name_get_number_of_ascii_characters(
+	          NULL,
+	          26,
+	          &number_of_characters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_name_get_number_of_ascii_characters(
+	          utf16_stream_ascii,
+	          (size_t) SSIZE_MAX + 1,
+	          &number_of_characters,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_name_get_number_of_ascii_characters(
+	          utf16_stream_ascii,
+	          26,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_name_copy_to_utf8_string function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_name_copy_to_utf8_string(
+     void )
+{
+        uint8_t utf16_stream_ascii[ 26 ] = { 't', 0, 'e', 0, 's', 0, 't', 0, 'f', 0, 'i', 0, 'l', 0, 'e', 0, '.', 0, 't', 0, 'x', 0, 't', 0, 0, 0 };
+	uint8_t utf8_string[ 16 ];
+
+	libcerror_error_t *error         = NULL;
+	size_t utf8_string_size          = 0;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_name_get_utf8_string_size(
+	          utf16_stream_ascii,
+	          26,
+	          &utf8_string_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "utf8_string_size",
+	 utf8_string_size,
+	 (size_t) 13 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_name_copy_to_utf8_string(
+	          utf16_stream_ascii,
+	          26,
+	          utf8_string,
+	          16,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          utf8_string,
+	          "testfile.txt",
+	          13 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_name_get_utf8_string_size(
+	          utf16_stream_ascii,
+	          26,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_name_copy_to_utf8_string(
+	          utf16_stream_ascii,
+	          26,
+	          NULL,
+	          16,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_name_copy_to_utf8_string(
+	          utf16_stream_ascii,
+	          26,
+	          utf8_string,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_name_copy_to_utf8_string(
+	          utf16_stream_ascii,
+	          26,
+	          utf8_string,
+	          12,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -1108,6 +1754,10 @@ int main(
 
 #if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
 
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_name_get_upper_case_character",
+	 fsntfs_test_name_get_upper_case_character );
+
 	FSNTFS_TEST_RUN(
 	 "libfsntfs_name_compare",
 	 fsntfs_test_name_compare );
@@ -1124,6 +1774,18 @@ int main(
 	 "libfsntfs_name_compare_with_utf16_string",
 	 fsntfs_test_name_compare_with_utf16_string );
 
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_name_get_hash",
+	 fsntfs_test_name_get_hash );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_name_get_number_of_ascii_characters",
+	 fsntfs_test_name_get_number_of_ascii_characters );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_name_copy_to_utf8_string",
+	 fsntfs_test_name_copy_to_utf8_string );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
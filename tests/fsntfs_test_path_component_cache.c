@@ -0,0 +1,960 @@
+/*
+ * Library path_component_cache type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_directory_entry.h"
+#include "../libfsntfs/libfsntfs_file_name_values.h"
+#include "../libfsntfs/libfsntfs_path_component_cache.h"
+
+uint8_t fsntfs_test_path_component_cache_data1[ 74 ] = {
+	0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x73, 0xbc, 0x83, 0x5d, 0xeb, 0xa4, 0xd4, 0x01,
+	0x73, 0xbc, 0x83, 0x5d, 0xeb, 0xa4, 0xd4, 0x01, 0x73, 0xbc, 0x83, 0x5d, 0xeb, 0xa4, 0xd4, 0x01,
+	0x73, 0xbc, 0x83, 0x5d, 0xeb, 0xa4, 0xd4, 0x01, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x04, 0x03, 0x24, 0x00, 0x4d, 0x00, 0x46, 0x00, 0x54, 0x00 };
+
+uint8_t fsntfs_test_path_component_cache_data2[ 76 ] = {
+	0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x73, 0xbc, 0x83, 0x5d, 0xeb, 0xa4, 0xd4, 0x01,
+	0x73, 0xbc, 0x83, 0x5d, 0xeb, 0xa4, 0xd4, 0x01, 0x73, 0xbc, 0x83, 0x5d, 0xeb, 0xa4, 0xd4, 0x01,
+	0x73, 0xbc, 0x83, 0x5d, 0xeb, 0xa4, 0xd4, 0x01, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x05, 0x02, 0x4d, 0x00, 0x46, 0x00, 0x54, 0x00, 0x7e, 0x00, 0x31, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_path_component_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_component_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                               = NULL;
+	libfsntfs_path_component_cache_t *path_component_cache = NULL;
+	int result                                             = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                         = 2;
+	int number_of_memset_fail_tests                         = 2;
+	int test_number                                         = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_path_component_cache_initialize(
+	          &path_component_cache,
+	          100,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_component_cache",
+	 path_component_cache );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "path_component_cache->number_of_entries",
+	 path_component_cache->number_of_entries,
+	 100 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_free(
+	          &path_component_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_component_cache",
+	 path_component_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_path_component_cache_initialize(
+	          NULL,
+	          100,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	path_component_cache = (libfsntfs_path_component_cache_t *) 0x12345678UL;
+
+	result = libfsntfs_path_component_cache_initialize(
+	          &path_component_cache,
+	          100,
+	          NULL,
+	          &error );
+
+	path_component_cache = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_component_cache_initialize(
+	          &path_component_cache,
+	          0,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_path_component_cache_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_path_component_cache_initialize(
+		          &path_component_cache,
+		          100,
+		          NULL,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( path_component_cache != NULL )
+			{
+				libfsntfs_path_component_cache_free(
+				 &path_component_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "path_component_cache",
+			 path_component_cache );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_path_component_cache_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_path_component_cache_initialize(
+		          &path_component_cache,
+		          100,
+		          NULL,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( path_component_cache != NULL )
+			{
+				libfsntfs_path_component_cache_free(
+				 &path_component_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "path_component_cache",
+			 path_component_cache );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_component_cache != NULL )
+	{
+		libfsntfs_path_component_cache_free(
+		 &path_component_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_path_component_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_component_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_path_component_cache_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_path_component_cache_set_directory_entry and libfsntfs_path_component_cache_get_directory_entry_by_utf8_name functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_component_cache_get_directory_entry_by_utf8_name(
+     void )
+{
+	uint8_t utf8_string_mft[ 4 ]                           = { '$', 'm', 'f', 't' };
+	uint8_t utf8_string_other[ 4 ]                         = { '$', 'b', 'o', 'o' };
+	uint16_t utf16_string_mft[ 4 ]                         = { '$', 'M', 'F', 'T' };
+	libcerror_error_t *error                               = NULL;
+	libfsntfs_directory_entry_t *cached_directory_entry    = NULL;
+	libfsntfs_directory_entry_t *directory_entry           = NULL;
+	libfsntfs_path_component_cache_t *path_component_cache = NULL;
+	int result                                             = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_path_component_cache_initialize(
+	          &path_component_cache,
+	          16,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_component_cache",
+	 path_component_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_directory_entry_initialize(
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_name_values_initialize(
+	          &( directory_entry->file_name_values ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_name_values_read_data(
+	          directory_entry->file_name_values,
+	          fsntfs_test_path_component_cache_data1,
+	          74,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	directory_entry->file_reference = 0x0001000000000000UL;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          utf8_string_mft,
+	          4,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_set_directory_entry(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          1,
+	          directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          utf8_string_mft,
+	          4,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cached_directory_entry",
+	 cached_directory_entry );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "cached_directory_entry->file_reference",
+	 cached_directory_entry->file_reference,
+	 (uint64_t) 0x0001000000000000UL );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf16_name(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          utf16_string_mft,
+	          4,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+	          path_component_cache,
+	          0x0005000000000006UL,
+	          utf8_string_mft,
+	          4,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          utf8_string_other,
+	          4,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+	          NULL,
+	          0x0005000000000005UL,
+	          utf8_string_mft,
+	          4,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          utf8_string_mft,
+	          4,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_component_cache_set_directory_entry(
+	          NULL,
+	          0x0005000000000005UL,
+	          1,
+	          directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_component_cache_set_directory_entry(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          1,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_directory_entry_free(
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_free(
+	          &path_component_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_component_cache",
+	 path_component_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &directory_entry,
+		 NULL );
+	}
+	if( path_component_cache != NULL )
+	{
+		libfsntfs_path_component_cache_free(
+		 &path_component_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_path_component_cache_set_directory_entry function with a short name
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_component_cache_set_directory_entry_short_name(
+     void )
+{
+	uint8_t utf8_string_mft[ 4 ]                           = { '$', 'm', 'f', 't' };
+	uint8_t utf8_string_short_name[ 5 ]                    = { 'm', 'f', 't', '~', '1' };
+	uint16_t utf16_string_short_name[ 5 ]                  = { 'M', 'F', 'T', '~', '1' };
+	libcerror_error_t *error                               = NULL;
+	libfsntfs_directory_entry_t *cached_directory_entry    = NULL;
+	libfsntfs_directory_entry_t *directory_entry           = NULL;
+	libfsntfs_path_component_cache_t *path_component_cache = NULL;
+	int result                                             = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_path_component_cache_initialize(
+	          &path_component_cache,
+	          16,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_component_cache",
+	 path_component_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_directory_entry_initialize(
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_name_values_initialize(
+	          &( directory_entry->file_name_values ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_name_values_read_data(
+	          directory_entry->file_name_values,
+	          fsntfs_test_path_component_cache_data1,
+	          74,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_name_values_initialize(
+	          &( directory_entry->short_file_name_values ),
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_name_values_read_data(
+	          directory_entry->short_file_name_values,
+	          fsntfs_test_path_component_cache_data2,
+	          76,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	directory_entry->file_reference = 0x0001000000000000UL;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          utf8_string_short_name,
+	          5,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_set_directory_entry(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          1,
+	          directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A path component that matched the short name is found in the cache
+	 */
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          utf8_string_short_name,
+	          5,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cached_directory_entry",
+	 cached_directory_entry );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "cached_directory_entry->file_reference",
+	 cached_directory_entry->file_reference,
+	 (uint64_t) 0x0001000000000000UL );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf16_name(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          utf16_string_short_name,
+	          5,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A path component that matched the name is still found in the cache
+	 */
+	result = libfsntfs_path_component_cache_get_directory_entry_by_utf8_name(
+	          path_component_cache,
+	          0x0005000000000005UL,
+	          utf8_string_mft,
+	          4,
+	          &cached_directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cached_directory_entry",
+	 cached_directory_entry );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "cached_directory_entry->file_reference",
+	 cached_directory_entry->file_reference,
+	 (uint64_t) 0x0001000000000000UL );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_directory_entry_free(
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_component_cache_free(
+	          &path_component_cache,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_component_cache",
+	 path_component_cache );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &directory_entry,
+		 NULL );
+	}
+	if( path_component_cache != NULL )
+	{
+		libfsntfs_path_component_cache_free(
+		 &path_component_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_component_cache_initialize",
+	 fsntfs_test_path_component_cache_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_component_cache_free",
+	 fsntfs_test_path_component_cache_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_component_cache_get_directory_entry_by_utf8_name",
+	 fsntfs_test_path_component_cache_get_directory_entry_by_utf8_name );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_component_cache_set_directory_entry_short_name",
+	 fsntfs_test_path_component_cache_set_directory_entry_short_name );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -270,6 +271,227 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsntfs_path_hint_clone function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_hint_clone(
+     void )
+{
+	uint8_t path[ 6 ]                            = { '\\', 'a', '\\', 'b', 'c', 0 };
+	libcerror_error_t *error                     = NULL;
+	libfsntfs_path_hint_t *destination_path_hint = NULL;
+	libfsntfs_path_hint_t *source_path_hint      = NULL;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_path_hint_initialize(
+	          &source_path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "source_path_hint",
+	 source_path_hint );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	source_path_hint->file_reference = 0x0001000000000040UL;
+	source_path_hint->path           = path;
+	source_path_hint->path_size      = 6;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_path_hint_clone(
+	          &destination_path_hint,
+	          source_path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_path_hint",
+	 destination_path_hint );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "destination_path_hint->file_reference",
+	 destination_path_hint->file_reference,
+	 (uint64_t) 0x0001000000000040UL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "destination_path_hint->path_size",
+	 destination_path_hint->path_size,
+	 (size_t) 6 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_path_hint->path",
+	 destination_path_hint->path );
+
+	result = memory_compare(
+	          destination_path_hint->path,
+	          path,
+	          6 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfsntfs_path_hint_free(
+	          &destination_path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "destination_path_hint",
+	 destination_path_hint );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_hint_clone(
+	          &destination_path_hint,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "destination_path_hint",
+	 destination_path_hint );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_path_hint_clone(
+	          NULL,
+	          source_path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	destination_path_hint = (libfsntfs_path_hint_t *) 0x12345678UL;
+
+	result = libfsntfs_path_hint_clone(
+	          &destination_path_hint,
+	          source_path_hint,
+	          &error );
+
+	destination_path_hint = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	source_path_hint->path_size = 0;
+
+	result = libfsntfs_path_hint_clone(
+	          &destination_path_hint,
+	          source_path_hint,
+	          &error );
+
+	source_path_hint->path_size = 6;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	source_path_hint->path = NULL;
+
+	result = libfsntfs_path_hint_free(
+	          &source_path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "source_path_hint",
+	 source_path_hint );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( destination_path_hint != NULL )
+	{
+		libfsntfs_path_hint_free(
+		 &destination_path_hint,
+		 NULL );
+	}
+	if( source_path_hint != NULL )
+	{
+		source_path_hint->path = NULL;
+
+		libfsntfs_path_hint_free(
+		 &source_path_hint,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
 
 /* The main program
@@ -297,6 +519,10 @@ int main(
 	 "libfsntfs_path_hint_free",
 	 fsntfs_test_path_hint_free );
 
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_hint_clone",
+	 fsntfs_test_path_hint_clone );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,689 @@
+/*
+ * Library path_hint_table type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_path_hint.h"
+#include "../libfsntfs/libfsntfs_path_hint_table.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_path_hint_table_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_hint_table_initialize(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libfsntfs_path_hint_table_t *path_hint_table = NULL;
+	int result                                   = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests              = 1;
+	int number_of_memset_fail_tests              = 1;
+	int test_number                              = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_path_hint_table_initialize(
+	          &path_hint_table,
+	          100,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_hint_table",
+	 path_hint_table );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "path_hint_table->number_of_entries",
+	 path_hint_table->number_of_entries,
+	 100 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_hint_table_free(
+	          &path_hint_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_hint_table",
+	 path_hint_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_path_hint_table_initialize(
+	          NULL,
+	          100,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	path_hint_table = (libfsntfs_path_hint_table_t *) 0x12345678UL;
+
+	result = libfsntfs_path_hint_table_initialize(
+	          &path_hint_table,
+	          100,
+	          0,
+	          &error );
+
+	path_hint_table = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_hint_table_initialize(
+	          &path_hint_table,
+	          -1,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_hint_table_initialize(
+	          &path_hint_table,
+	          100,
+	          -1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_path_hint_table_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_path_hint_table_initialize(
+		          &path_hint_table,
+		          100,
+		          0,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( path_hint_table != NULL )
+			{
+				libfsntfs_path_hint_table_free(
+				 &path_hint_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "path_hint_table",
+			 path_hint_table );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_path_hint_table_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_path_hint_table_initialize(
+		          &path_hint_table,
+		          100,
+		          0,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( path_hint_table != NULL )
+			{
+				libfsntfs_path_hint_table_free(
+				 &path_hint_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "path_hint_table",
+			 path_hint_table );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_hint_table != NULL )
+	{
+		libfsntfs_path_hint_table_free(
+		 &path_hint_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_path_hint_table_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_hint_table_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_path_hint_table_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_path_hint_table_set_path_hint and libfsntfs_path_hint_table_get_path_hint_by_file_reference functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_hint_table_get_path_hint_by_file_reference(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libfsntfs_path_hint_t *path_hint             = NULL;
+	libfsntfs_path_hint_t *safe_path_hint        = NULL;
+	libfsntfs_path_hint_table_t *path_hint_table = NULL;
+	uint64_t file_reference                      = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_path_hint_table_initialize(
+	          &path_hint_table,
+	          16,
+	          2,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_hint_table",
+	 path_hint_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+	          path_hint_table,
+	          0x0001000000000003UL,
+	          &path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( file_reference = 0x0001000000000003UL;
+	     file_reference <= 0x0001000000000005UL;
+	     file_reference++ )
+	{
+		result = libfsntfs_path_hint_initialize(
+		          &safe_path_hint,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		safe_path_hint->file_reference = file_reference;
+
+		result = libfsntfs_path_hint_table_set_path_hint(
+		          path_hint_table,
+		          safe_path_hint,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		safe_path_hint = NULL;
+	}
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "path_hint_table->number_of_path_hints",
+	 path_hint_table->number_of_path_hints,
+	 2 );
+
+	/* The least recently used path hint was freed
+	 */
+	result = libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+	          path_hint_table,
+	          0x0001000000000003UL,
+	          &path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+	          path_hint_table,
+	          0x0001000000000004UL,
+	          &path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_hint",
+	 path_hint );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "path_hint->file_reference",
+	 path_hint->file_reference,
+	 (uint64_t) 0x0001000000000004UL );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The sequence number of the file reference must match
+	 */
+	result = libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+	          path_hint_table,
+	          0x0002000000000004UL,
+	          &path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_hint_table_set_maximum_number_of_path_hints(
+	          path_hint_table,
+	          1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The most recently used path hint was retained
+	 */
+	result = libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+	          path_hint_table,
+	          0x0001000000000004UL,
+	          &path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+	          path_hint_table,
+	          0x0001000000000005UL,
+	          &path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+	          NULL,
+	          0x0001000000000004UL,
+	          &path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_hint_table_get_path_hint_by_file_reference(
+	          path_hint_table,
+	          0x0001000000000004UL,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_hint_table_set_path_hint(
+	          NULL,
+	          path_hint,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_hint_table_set_path_hint(
+	          path_hint_table,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_path_hint_table_set_maximum_number_of_path_hints(
+	          path_hint_table,
+	          -1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_path_hint_table_free(
+	          &path_hint_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_hint_table",
+	 path_hint_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( safe_path_hint != NULL )
+	{
+		libfsntfs_path_hint_free(
+		 &safe_path_hint,
+		 NULL );
+	}
+	if( path_hint_table != NULL )
+	{
+		libfsntfs_path_hint_table_free(
+		 &path_hint_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_hint_table_initialize",
+	 fsntfs_test_path_hint_table_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_hint_table_free",
+	 fsntfs_test_path_hint_table_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_hint_table_get_path_hint_by_file_reference",
+	 fsntfs_test_path_hint_table_get_path_hint_by_file_reference );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,872 @@
+/*
+ * Library path_table type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_definitions.h"
+#include "../libfsntfs/libfsntfs_path_table.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_path_table_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_table_initialize(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libfsntfs_path_table_t *path_table = NULL;
+	int result                         = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests    = 1;
+	int number_of_memset_fail_tests    = 1;
+	int test_number                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_path_table_initialize(
+	          &path_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_table",
+	 path_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_table_free(
+	          &path_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_table",
+	 path_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_path_table_initialize(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	path_table = (libfsntfs_path_table_t *) 0x12345678UL;
+
+	result = libfsntfs_path_table_initialize(
+	          &path_table,
+	          &error );
+
+	path_table = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_path_table_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_path_table_initialize(
+		          &path_table,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( path_table != NULL )
+			{
+				libfsntfs_path_table_free(
+				 &path_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "path_table",
+			 path_table );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_path_table_initialize with memset failing
+		 */
+		fsntfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsntfs_path_table_initialize(
+		          &path_table,
+		          &error );
+
+		if( fsntfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsntfs_test_memset_attempts_before_fail = -1;
+
+			if( path_table != NULL )
+			{
+				libfsntfs_path_table_free(
+				 &path_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "path_table",
+			 path_table );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_table != NULL )
+	{
+		libfsntfs_path_table_free(
+		 &path_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* Tests the libfsntfs_path_table_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_path_table_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_path_table_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Compares the UTF-8 encoded path of a specific MFT entry in a path table
+ * Returns 1 if the path matches or 0 if not
+ */
+int fsntfs_test_path_table_compare_utf8_path(
+     libfsntfs_path_table_t *path_table,
+     uint64_t mft_entry_index,
+     const char *expected_path )
+{
+	uint8_t utf8_string[ 64 ];
+
+	size_t utf8_string_size = 0;
+	int result              = 0;
+
+	result = libfsntfs_path_table_get_utf8_path_size(
+	          path_table,
+	          mft_entry_index,
+	          &utf8_string_size,
+	          NULL );
+
+	if( expected_path == NULL )
+	{
+		return( result == 0 );
+	}
+	if( ( result != 1 )
+	 || ( utf8_string_size != ( narrow_string_length( expected_path ) + 1 ) ) )
+	{
+		return( 0 );
+	}
+	result = libfsntfs_path_table_get_utf8_path(
+	          path_table,
+	          mft_entry_index,
+	          utf8_string,
+	          64,
+	          NULL );
+
+	if( result != 1 )
+	{
+		return( 0 );
+	}
+	if( narrow_string_compare(
+	     (char *) utf8_string,
+	     expected_path,
+	     utf8_string_size ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the libfsntfs_internal_path_table_resolve_paths function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_internal_path_table_resolve_paths(
+     void )
+{
+	libfsntfs_path_table_entry_t entries[ 8 ];
+
+	const uint8_t *name_pool                             = (const uint8_t *) ".\0Windows\0notepad.exe\0orphan\0a\0b";
+	libcerror_error_t *error                             = NULL;
+	libfsntfs_internal_path_table_t *internal_path_table = NULL;
+	libfsntfs_path_table_t *path_table                   = NULL;
+	size_t name_pool_size                                = 33;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_path_table_initialize(
+	          &path_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_table",
+	 path_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_path_table = (libfsntfs_internal_path_table_t *) path_table;
+
+	internal_path_table->path_offsets = (size_t *) memory_allocate(
+	                                                sizeof( size_t ) * 8 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "internal_path_table->path_offsets",
+	 internal_path_table->path_offsets );
+
+	memory_set(
+	 internal_path_table->path_offsets,
+	 0,
+	 sizeof( size_t ) * 8 );
+
+	internal_path_table->number_of_entries = 8;
+
+	memory_set(
+	 entries,
+	 0,
+	 sizeof( libfsntfs_path_table_entry_t ) * 8 );
+
+	/* MFT entries 1 and 2 are each others parent
+	 */
+	entries[ 1 ].file_reference        = 0x0001000000000001UL;
+	entries[ 1 ].parent_file_reference = 0x0001000000000002UL;
+	entries[ 1 ].name_offset           = 30;
+	entries[ 1 ].state                 = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME;
+	entries[ 1 ].is_allocated          = 1;
+
+	entries[ 2 ].file_reference        = 0x0001000000000002UL;
+	entries[ 2 ].parent_file_reference = 0x0001000000000001UL;
+	entries[ 2 ].name_offset           = 32;
+	entries[ 2 ].state                 = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME;
+	entries[ 2 ].is_allocated          = 1;
+
+	/* MFT entry 3 refers to a parent that has been reallocated
+	 */
+	entries[ 3 ].file_reference        = 0x0001000000000003UL;
+	entries[ 3 ].parent_file_reference = 0x0001000000000006UL;
+	entries[ 3 ].name_offset           = 23;
+	entries[ 3 ].state                 = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME;
+	entries[ 3 ].is_allocated          = 1;
+
+	entries[ 5 ].file_reference        = 0x0005000000000005UL;
+	entries[ 5 ].parent_file_reference = 0x0005000000000005UL;
+	entries[ 5 ].name_offset           = 1;
+	entries[ 5 ].state                 = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME;
+	entries[ 5 ].is_allocated          = 1;
+
+	entries[ 6 ].file_reference        = 0x0002000000000006UL;
+	entries[ 6 ].parent_file_reference = 0x0005000000000005UL;
+	entries[ 6 ].name_offset           = 3;
+	entries[ 6 ].state                 = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME;
+	entries[ 6 ].is_allocated          = 1;
+
+	/* MFT entry 7 is resolved before its parent
+	 */
+	entries[ 7 ].file_reference        = 0x0001000000000007UL;
+	entries[ 7 ].parent_file_reference = 0x0002000000000006UL;
+	entries[ 7 ].name_offset           = 11;
+	entries[ 7 ].state                 = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME;
+	entries[ 7 ].is_allocated          = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_internal_path_table_resolve_paths(
+	          internal_path_table,
+	          entries,
+	          name_pool,
+	          name_pool_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          0,
+	          NULL );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          1,
+	          "$Orphan\\b\\a" );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          2,
+	          "$Orphan\\b" );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          3,
+	          "$Orphan\\orphan" );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          5,
+	          "\\" );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          6,
+	          "\\Windows" );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          7,
+	          "\\Windows\\notepad.exe" );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_internal_path_table_resolve_paths(
+	          NULL,
+	          entries,
+	          name_pool,
+	          name_pool_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_internal_path_table_resolve_paths(
+	          internal_path_table,
+	          NULL,
+	          name_pool,
+	          name_pool_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_path_table_free(
+	          &path_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_table",
+	 path_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_table != NULL )
+	{
+		libfsntfs_path_table_free(
+		 &path_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_internal_path_table_resolve_paths function with a chain of parents
+ * that exceeds the maximum recursion depth
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_internal_path_table_resolve_paths_maximum_depth(
+     void )
+{
+	uint8_t utf8_string[ 2 * LIBFSNTFS_MAXIMUM_RECURSION_DEPTH + 16 ];
+
+	const uint8_t *name_pool                             = (const uint8_t *) ".\0a";
+	libcerror_error_t *error                             = NULL;
+	libfsntfs_internal_path_table_t *internal_path_table = NULL;
+	libfsntfs_path_table_entry_t *entries                = NULL;
+	libfsntfs_path_table_t *path_table                   = NULL;
+	size_t name_pool_size                                = 4;
+	size_t utf8_string_size                              = 0;
+	uint64_t mft_entry_index                             = 0;
+	uint64_t number_of_entries                           = LIBFSNTFS_MAXIMUM_RECURSION_DEPTH + 9;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_path_table_initialize(
+	          &path_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_table",
+	 path_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_path_table = (libfsntfs_internal_path_table_t *) path_table;
+
+	internal_path_table->path_offsets = (size_t *) memory_allocate(
+	                                                sizeof( size_t ) * number_of_entries );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "internal_path_table->path_offsets",
+	 internal_path_table->path_offsets );
+
+	memory_set(
+	 internal_path_table->path_offsets,
+	 0,
+	 sizeof( size_t ) * number_of_entries );
+
+	internal_path_table->number_of_entries = number_of_entries;
+
+	entries = (libfsntfs_path_table_entry_t *) memory_allocate(
+	                                            sizeof( libfsntfs_path_table_entry_t ) * number_of_entries );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "entries",
+	 entries );
+
+	memory_set(
+	 entries,
+	 0,
+	 sizeof( libfsntfs_path_table_entry_t ) * number_of_entries );
+
+	entries[ 5 ].file_reference        = 0x0005000000000005UL;
+	entries[ 5 ].parent_file_reference = 0x0005000000000005UL;
+	entries[ 5 ].name_offset           = 1;
+	entries[ 5 ].state                 = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME;
+	entries[ 5 ].is_allocated          = 1;
+
+	/* MFT entry 6 is the deepest entry of a chain in which every MFT entry
+	 * is the parent of the MFT entry before it and the last MFT entry is
+	 * stored in the root directory
+	 */
+	for( mft_entry_index = 6;
+	     mft_entry_index < number_of_entries;
+	     mft_entry_index++ )
+	{
+		entries[ mft_entry_index ].file_reference        = 0x0001000000000000UL | mft_entry_index;
+		entries[ mft_entry_index ].parent_file_reference = 0x0001000000000000UL | ( mft_entry_index + 1 );
+		entries[ mft_entry_index ].name_offset           = 3;
+		entries[ mft_entry_index ].state                 = LIBFSNTFS_PATH_TABLE_ENTRY_STATE_HAS_NAME;
+		entries[ mft_entry_index ].is_allocated          = 1;
+	}
+	entries[ number_of_entries - 1 ].parent_file_reference = 0x0005000000000005UL;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_internal_path_table_resolve_paths(
+	          internal_path_table,
+	          entries,
+	          name_pool,
+	          name_pool_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The MFT entry at the maximum recursion depth is stored as an orphan
+	 */
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          6 + LIBFSNTFS_MAXIMUM_RECURSION_DEPTH,
+	          "$Orphan\\a" );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The paths of the parents of the orphan are still resolved
+	 */
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          7 + LIBFSNTFS_MAXIMUM_RECURSION_DEPTH,
+	          "\\a\\a" );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fsntfs_test_path_table_compare_utf8_path(
+	          path_table,
+	          8 + LIBFSNTFS_MAXIMUM_RECURSION_DEPTH,
+	          "\\a" );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The deepest MFT entry is stored relative to the orphan
+	 */
+	result = libfsntfs_path_table_get_utf8_path_size(
+	          path_table,
+	          6,
+	          &utf8_string_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_SIZE(
+	 "utf8_string_size",
+	 utf8_string_size,
+	 (size_t) ( 8 + ( 2 * ( LIBFSNTFS_MAXIMUM_RECURSION_DEPTH + 1 ) ) ) );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_table_get_utf8_path(
+	          path_table,
+	          6,
+	          utf8_string,
+	          2 * LIBFSNTFS_MAXIMUM_RECURSION_DEPTH + 16,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = narrow_string_compare(
+	          (char *) utf8_string,
+	          "$Orphan\\a\\a",
+	          11 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	memory_free(
+	 entries );
+
+	entries = NULL;
+
+	result = libfsntfs_path_table_free(
+	          &path_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_table",
+	 path_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( entries != NULL )
+	{
+		memory_free(
+		 entries );
+	}
+	if( path_table != NULL )
+	{
+		libfsntfs_path_table_free(
+		 &path_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_table_initialize",
+	 fsntfs_test_path_table_initialize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_path_table_free",
+	 fsntfs_test_path_table_free );
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_internal_path_table_resolve_paths",
+	 fsntfs_test_internal_path_table_resolve_paths );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_internal_path_table_resolve_paths_maximum_depth",
+	 fsntfs_test_internal_path_table_resolve_paths_maximum_depth );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,473 @@
+/*
+ * Library upcase_table type test program
+ *
+ * Copyright (C) 2010-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_macros.h"
+#include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_upcase_table.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_upcase_table_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_upcase_table_initialize(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libfsntfs_upcase_table_t *upcase_table = NULL;
+	int result                             = 0;
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests        = 1;
+	int test_number                        = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_upcase_table_initialize(
+	          &upcase_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "upcase_table",
+	 upcase_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT16(
+	 "upcase_table->values[ 'a' ]",
+	 upcase_table->values[ 'a' ],
+	 (uint16_t) 'A' );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT16(
+	 "upcase_table->values[ 0x00e9 ]",
+	 upcase_table->values[ 0x00e9 ],
+	 (uint16_t) 0x00e9 );
+
+	result = libfsntfs_upcase_table_free(
+	          &upcase_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "upcase_table",
+	 upcase_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_upcase_table_initialize(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	upcase_table = (libfsntfs_upcase_table_t *) 0x12345678UL;
+
+	result = libfsntfs_upcase_table_initialize(
+	          &upcase_table,
+	          &error );
+
+	upcase_table = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSNTFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsntfs_upcase_table_initialize with malloc failing
+		 */
+		fsntfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsntfs_upcase_table_initialize(
+		          &upcase_table,
+		          &error );
+
+		if( fsntfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsntfs_test_malloc_attempts_before_fail = -1;
+
+			if( upcase_table != NULL )
+			{
+				libfsntfs_upcase_table_free(
+				 &upcase_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "upcase_table",
+			 upcase_table );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSNTFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( upcase_table != NULL )
+	{
+		libfsntfs_upcase_table_free(
+		 &upcase_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_upcase_table_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_upcase_table_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsntfs_upcase_table_free(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_upcase_table_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_upcase_table_read_data(
+     void )
+{
+	uint8_t upcase_data[ 4 ]               = { 0xc9, 0x00, 0xca, 0x00 };
+	libcerror_error_t *error               = NULL;
+	libfsntfs_upcase_table_t *upcase_table = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_upcase_table_initialize(
+	          &upcase_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "upcase_table",
+	 upcase_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_upcase_table_read_data(
+	          upcase_table,
+	          upcase_data,
+	          4,
+	          0x00e9 * 2,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT16(
+	 "upcase_table->values[ 0x00e9 ]",
+	 upcase_table->values[ 0x00e9 ],
+	 (uint16_t) 0x00c9 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT16(
+	 "upcase_table->values[ 0x00ea ]",
+	 upcase_table->values[ 0x00ea ],
+	 (uint16_t) 0x00ca );
+
+	/* Data beyond the end of the table is ignored
+	 */
+	result = libfsntfs_upcase_table_read_data(
+	          upcase_table,
+	          upcase_data,
+	          4,
+	          ( LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_VALUES * 2 ) - 2,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT16(
+	 "upcase_table->values[ 0xffff ]",
+	 upcase_table->values[ 0xffff ],
+	 (uint16_t) 0x00c9 );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_upcase_table_read_data(
+	          NULL,
+	          upcase_data,
+	          4,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_upcase_table_read_data(
+	          upcase_table,
+	          NULL,
+	          4,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_upcase_table_read_data(
+	          upcase_table,
+	          upcase_data,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_upcase_table_read_data(
+	          upcase_table,
+	          upcase_data,
+	          4,
+	          1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_upcase_table_free(
+	          &upcase_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "upcase_table",
+	 upcase_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( upcase_table != NULL )
+	{
+		libfsntfs_upcase_table_free(
+		 &upcase_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_upcase_table_initialize",
+	 fsntfs_test_upcase_table_initialize );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_upcase_table_free",
+	 fsntfs_test_upcase_table_free );
+
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_upcase_table_read_data",
+	 fsntfs_test_upcase_table_read_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -37,8 +38,11 @@
 #include "fsntfs_test_libfsntfs.h"
 #include "fsntfs_test_macros.h"
 #include "fsntfs_test_memory.h"
+#include "fsntfs_test_unused.h"
 
+#include "../libfsntfs/libfsntfs_definitions.h"
 #include "../libfsntfs/libfsntfs_directory_entry.h"
+#include "../libfsntfs/libfsntfs_io_handle.h"
 #include "../libfsntfs/libfsntfs_mft_entry.h"
 #include "../libfsntfs/libfsntfs_volume.h"
 
@@ -50,6 +54,52 @@
 #define FSNTFS_TEST_VOLUME_VERBOSE
  */
 
+#define FSNTFS_TEST_VOLUME_EXTRACT_DATA_MAXIMUM_SIZE		( 16 * 1024 * 1024 )
+#define FSNTFS_TEST_VOLUME_EXTRACT_DATA_NUMBER_OF_ENTRIES	16
+
+typedef struct fsntfs_test_volume_extract_data_context fsntfs_test_volume_extract_data_context_t;
+
+struct fsntfs_test_volume_extract_data_context
+{
+	/* The MFT entry indexes
+	 */
+	uint64_t mft_entry_indexes[ FSNTFS_TEST_VOLUME_EXTRACT_DATA_NUMBER_OF_ENTRIES ];
+
+	/* The data sizes
+	 */
+	size64_t data_sizes[ FSNTFS_TEST_VOLUME_EXTRACT_DATA_NUMBER_OF_ENTRIES ];
+
+	/* The extracted data
+	 */
+	uint8_t *data[ FSNTFS_TEST_VOLUME_EXTRACT_DATA_NUMBER_OF_ENTRIES ];
+
+	/* The number of bytes passed to the callback function
+	 */
+	size64_t number_of_bytes[ FSNTFS_TEST_VOLUME_EXTRACT_DATA_NUMBER_OF_ENTRIES ];
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* Value to indicate the callback function should stop the extraction
+	 */
+	int stop_extraction;
+};
+
+typedef struct fsntfs_test_volume_scan_mft_entries_context fsntfs_test_volume_scan_mft_entries_context_t;
+
+struct fsntfs_test_volume_scan_mft_entries_context
+{
+	/* The allocation state per MFT entry
+	 * 0 if not scanned, 1 if not allocated or 2 if allocated
+	 */
+	uint8_t *allocation_states;
+
+	/* The number of entries
+	 */
+	uint64_t number_of_entries;
+};
+
 #if !defined( LIBFSNTFS_HAVE_BFIO )
 
 LIBFSNTFS_EXTERN \
@@ -430,6 +480,129 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsntfs_volume_set_cache_limits function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_volume_set_cache_limits(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libfsntfs_volume_t *volume = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsntfs_volume_initialize(
+	          &volume,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_volume_set_cache_limits(
+	          volume,
+	          1024 * 1024,
+	          2 * 1024 * 1024,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_mft_entry_cache_size",
+	 (uint64_t) ( (libfsntfs_internal_volume_t *) volume )->io_handle->maximum_mft_entry_cache_size,
+	 (uint64_t) 1024 * 1024 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_index_node_cache_size",
+	 (uint64_t) ( (libfsntfs_internal_volume_t *) volume )->io_handle->maximum_index_node_cache_size,
+	 (uint64_t) 2 * 1024 * 1024 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_compressed_block_cache_size",
+	 (uint64_t) ( (libfsntfs_internal_volume_t *) volume )->io_handle->maximum_compressed_block_cache_size,
+	 (uint64_t) 0 );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+	/* Test error cases
+	 */
+	result = libfsntfs_volume_set_cache_limits(
+	          NULL,
+	          1024 * 1024,
+	          2 * 1024 * 1024,
+	          0,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_volume_free(
+	          &volume,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfsntfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libfsntfs_volume_open function
  * Returns 1 if successful or 0 if not
  */
@@ -605,15 +778,13 @@ on_error:
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Tests the libfsntfs_volume_open_wide function
+/* Tests the libfsntfs_volume_open_mapped function
  * Returns 1 if successful or 0 if not
  */
-int fsntfs_test_volume_open_wide(
+int fsntfs_test_volume_open_mapped(
      const system_character_t *source )
 {
-	wchar_t wide_source[ 256 ];
+	char narrow_source[ 256 ];
 
 	libcerror_error_t *error   = NULL;
 	libfsntfs_volume_t *volume = NULL;
@@ -621,9 +792,9 @@ int fsntfs_test_volume_open_wide(
 
 	/* Initialize test
 	 */
-	result = fsntfs_test_get_wide_source(
+	result = fsntfs_test_get_narrow_source(
 	          source,
-	          wide_source,
+	          narrow_source,
 	          256,
 	          &error );
 
@@ -655,9 +826,9 @@ int fsntfs_test_volume_open_wide(
 
 	/* Test open
 	 */
-	result = libfsntfs_volume_open_wide(
+	result = libfsntfs_volume_open_mapped(
 	          volume,
-	          wide_source,
+	          narrow_source,
 	          LIBFSNTFS_OPEN_READ,
 	          &error );
 
@@ -672,9 +843,9 @@ int fsntfs_test_volume_open_wide(
 
 	/* Test error cases
 	 */
-	result = libfsntfs_volume_open_wide(
+	result = libfsntfs_volume_open_mapped(
 	          NULL,
-	          wide_source,
+	          narrow_source,
 	          LIBFSNTFS_OPEN_READ,
 	          &error );
 
@@ -690,7 +861,7 @@ int fsntfs_test_volume_open_wide(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_volume_open_wide(
+	result = libfsntfs_volume_open_mapped(
 	          volume,
 	          NULL,
 	          LIBFSNTFS_OPEN_READ,
@@ -708,9 +879,9 @@ int fsntfs_test_volume_open_wide(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_volume_open_wide(
+	result = libfsntfs_volume_open_mapped(
 	          volume,
-	          wide_source,
+	          narrow_source,
 	          -1,
 	          &error );
 
@@ -728,9 +899,9 @@ int fsntfs_test_volume_open_wide(
 
 	/* Test open when already opened
 	 */
-	result = libfsntfs_volume_open_wide(
+	result = libfsntfs_volume_open_mapped(
 	          volume,
-	          wide_source,
+	          narrow_source,
 	          LIBFSNTFS_OPEN_READ,
 	          &error );
 
@@ -782,63 +953,36 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Tests the libfsntfs_volume_open_file_io_handle function
+/* Tests the libfsntfs_volume_open_wide function
  * Returns 1 if successful or 0 if not
  */
-int fsntfs_test_volume_open_file_io_handle(
+int fsntfs_test_volume_open_wide(
      const system_character_t *source )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	libcerror_error_t *error         = NULL;
-	libfsntfs_volume_t *volume       = NULL;
-	size_t string_length             = 0;
-	int result                       = 0;
+	wchar_t wide_source[ 256 ];
+
+	libcerror_error_t *error   = NULL;
+	libfsntfs_volume_t *volume = NULL;
+	int result                 = 0;
 
 	/* Initialize test
 	 */
-	result = libbfio_file_initialize(
-	          &file_io_handle,
-	          &error );
-
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-        FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-         "file_io_handle",
-         file_io_handle );
-
-        FSNTFS_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
-
-	string_length = system_string_length(
-	                 source );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libbfio_file_set_name_wide(
-	          file_io_handle,
-	          source,
-	          string_length,
-	          &error );
-#else
-	result = libbfio_file_set_name(
-	          file_io_handle,
+	result = fsntfs_test_get_wide_source(
 	          source,
-	          string_length,
+	          wide_source,
+	          256,
 	          &error );
-#endif
+
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
-        FSNTFS_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libfsntfs_volume_initialize(
 	          &volume,
@@ -859,9 +1003,9 @@ int fsntfs_test_volume_open_file_io_handle(
 
 	/* Test open
 	 */
-	result = libfsntfs_volume_open_file_io_handle(
+	result = libfsntfs_volume_open_wide(
 	          volume,
-	          file_io_handle,
+	          wide_source,
 	          LIBFSNTFS_OPEN_READ,
 	          &error );
 
@@ -876,9 +1020,9 @@ int fsntfs_test_volume_open_file_io_handle(
 
 	/* Test error cases
 	 */
-	result = libfsntfs_volume_open_file_io_handle(
+	result = libfsntfs_volume_open_wide(
 	          NULL,
-	          file_io_handle,
+	          wide_source,
 	          LIBFSNTFS_OPEN_READ,
 	          &error );
 
@@ -894,7 +1038,7 @@ int fsntfs_test_volume_open_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_volume_open_file_io_handle(
+	result = libfsntfs_volume_open_wide(
 	          volume,
 	          NULL,
 	          LIBFSNTFS_OPEN_READ,
@@ -912,9 +1056,9 @@ int fsntfs_test_volume_open_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_volume_open_file_io_handle(
+	result = libfsntfs_volume_open_wide(
 	          volume,
-	          file_io_handle,
+	          wide_source,
 	          -1,
 	          &error );
 
@@ -932,9 +1076,9 @@ int fsntfs_test_volume_open_file_io_handle(
 
 	/* Test open when already opened
 	 */
-	result = libfsntfs_volume_open_file_io_handle(
+	result = libfsntfs_volume_open_wide(
 	          volume,
-	          file_io_handle,
+	          wide_source,
 	          LIBFSNTFS_OPEN_READ,
 	          &error );
 
@@ -969,23 +1113,6 @@ int fsntfs_test_volume_open_file_io_handle(
 	 "error",
 	 error );
 
-	result = libbfio_handle_free(
-	          &file_io_handle,
-	          &error );
-
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	FSNTFS_TEST_ASSERT_IS_NULL(
-         "file_io_handle",
-         file_io_handle );
-
-        FSNTFS_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
-
 	return( 1 );
 
 on_error:
@@ -1000,24 +1127,245 @@ on_error:
 		 &volume,
 		 NULL );
 	}
-	if( file_io_handle != NULL )
-	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libfsntfs_volume_close function
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libfsntfs_volume_open_file_io_handle function
  * Returns 1 if successful or 0 if not
  */
-int fsntfs_test_volume_close(
-     void )
+int fsntfs_test_volume_open_file_io_handle(
+     const system_character_t *source )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
-
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libfsntfs_volume_t *volume       = NULL;
+	size_t string_length             = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libbfio_file_initialize(
+	          &file_io_handle,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+         "file_io_handle",
+         file_io_handle );
+
+        FSNTFS_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	string_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#endif
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        FSNTFS_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libfsntfs_volume_initialize(
+	          &volume,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libfsntfs_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          LIBFSNTFS_OPEN_READ,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_volume_open_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          LIBFSNTFS_OPEN_READ,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_open_file_io_handle(
+	          volume,
+	          NULL,
+	          LIBFSNTFS_OPEN_READ,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          -1,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open when already opened
+	 */
+	result = libfsntfs_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          LIBFSNTFS_OPEN_READ,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsntfs_volume_free(
+	          &volume,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+         "file_io_handle",
+         file_io_handle );
+
+        FSNTFS_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfsntfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_volume_close function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_volume_close(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
 	/* Test error cases
 	 */
 	result = libfsntfs_volume_close(
@@ -2206,38 +2554,1544 @@ on_error:
 	return( 0 );
 }
 
-#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
-
-/* Tests the libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path function
- * Returns 1 if successful or 0 if not
+/* Callback function for testing the libfsntfs_volume_scan_mft_entries function
+ * Returns 1 to continue or 0 to stop
  */
-int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf8_path(
-     libfsntfs_volume_t *volume )
+int fsntfs_test_volume_scan_mft_entries_callback(
+     libfsntfs_file_entry_t *file_entry,
+     uint64_t mft_entry_index FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     void *user_data )
 {
-	uint8_t utf8_path[ 6 ]                       = { '\\', '$', 'M', 'F', 'T', 0 };
-	libcerror_error_t *error                     = NULL;
-	libfsntfs_directory_entry_t *directory_entry = NULL;
-	libfsntfs_mft_entry_t *mft_entry             = NULL;
-	int result                                   = 0;
-
-	/* Test regular cases
-	 */
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
-	          (libfsntfs_internal_volume_t *) volume,
-	          utf8_path,
-	          5,
-	          &mft_entry,
-	          &directory_entry,
-	          &error );
+	uint64_t *number_of_scanned_entries = (uint64_t *) user_data;
 
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( mft_entry_index )
 
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "mft_entry",
-	 mft_entry );
+	if( ( file_entry == NULL )
+	 || ( number_of_scanned_entries == NULL ) )
+	{
+		return( -1 );
+	}
+	if( *number_of_scanned_entries == (uint64_t) UINT64_MAX )
+	{
+		return( 0 );
+	}
+	*number_of_scanned_entries += 1;
+
+	return( 1 );
+}
+
+/* Callback function for testing the libfsntfs_volume_scan_mft_entries function
+ * The callback function only uses the file entry it is called with and not the volume
+ * Returns 1 to continue or -1 on error
+ */
+int fsntfs_test_volume_scan_mft_entries_file_entry_callback(
+     libfsntfs_file_entry_t *file_entry,
+     uint64_t mft_entry_index,
+     void *user_data )
+{
+	fsntfs_test_volume_scan_mft_entries_context_t *context = NULL;
+	uint64_t file_reference                                = 0;
+	int result                                             = 0;
+
+	context = (fsntfs_test_volume_scan_mft_entries_context_t *) user_data;
+
+	if( ( file_entry == NULL )
+	 || ( context == NULL )
+	 || ( mft_entry_index >= context->number_of_entries ) )
+	{
+		return( -1 );
+	}
+	if( libfsntfs_file_entry_get_file_reference(
+	     file_entry,
+	     &file_reference,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( ( file_reference != 0 )
+	 && ( ( file_reference & 0xffffffffffffUL ) != mft_entry_index ) )
+	{
+		return( -1 );
+	}
+	result = libfsntfs_file_entry_is_allocated(
+	          file_entry,
+	          NULL );
+
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	/* The callback function is called concurrently but only once per MFT entry
+	 */
+	context->allocation_states[ mft_entry_index ] = (uint8_t) ( 1 + result );
+
+	return( 1 );
+}
+
+/* Tests the libfsntfs_volume_scan_mft_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_volume_scan_mft_entries(
+     libfsntfs_volume_t *volume )
+{
+	fsntfs_test_volume_scan_mft_entries_context_t context;
+
+	libcerror_error_t *error           = NULL;
+	libfsntfs_file_entry_t *file_entry = NULL;
+	uint64_t mft_entry_index           = 0;
+	uint64_t number_of_file_entries    = 0;
+	uint64_t number_of_scanned_entries = 0;
+	int result                         = 0;
+
+	context.allocation_states = NULL;
+
+	result = libfsntfs_volume_get_number_of_file_entries(
+	          volume,
+	          &number_of_file_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_volume_scan_mft_entries(
+	          volume,
+	          1,
+	          &fsntfs_test_volume_scan_mft_entries_callback,
+	          (void *) &number_of_scanned_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_scanned_entries",
+	 number_of_scanned_entries,
+	 number_of_file_entries );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test scan stopped by the callback function
+	 */
+	if( number_of_file_entries > 0 )
+	{
+		number_of_scanned_entries = (uint64_t) UINT64_MAX;
+
+		result = libfsntfs_volume_scan_mft_entries(
+		          volume,
+		          2,
+		          &fsntfs_test_volume_scan_mft_entries_callback,
+		          (void *) &number_of_scanned_entries,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test the callback function using only the file entry it is called with
+	 */
+	if( ( number_of_file_entries > 0 )
+	 && ( number_of_file_entries <= (uint64_t) ( 16 * 1024 * 1024 ) ) )
+	{
+		context.allocation_states = (uint8_t *) memory_allocate(
+		                                         sizeof( uint8_t ) * (size_t) number_of_file_entries );
+
+		FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+		 "context.allocation_states",
+		 context.allocation_states );
+
+		result = memory_set(
+		          context.allocation_states,
+		          0,
+		          sizeof( uint8_t ) * (size_t) number_of_file_entries ) != NULL;
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		context.number_of_entries = number_of_file_entries;
+
+		result = libfsntfs_volume_scan_mft_entries(
+		          volume,
+		          4,
+		          &fsntfs_test_volume_scan_mft_entries_file_entry_callback,
+		          (void *) &context,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The volume can be used again after the scan has completed
+		 */
+		for( mft_entry_index = 0;
+		     mft_entry_index < number_of_file_entries;
+		     mft_entry_index++ )
+		{
+			result = libfsntfs_volume_get_file_entry_by_index(
+			          volume,
+			          mft_entry_index,
+			          &file_entry,
+			          &error );
+
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "file_entry",
+			 file_entry );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = libfsntfs_file_entry_is_allocated(
+			          file_entry,
+			          &error );
+
+			FSNTFS_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			FSNTFS_TEST_ASSERT_EQUAL_UINT8(
+			 "context.allocation_states[ mft_entry_index ]",
+			 context.allocation_states[ mft_entry_index ],
+			 (uint8_t) ( 1 + result ) );
+
+			result = libfsntfs_file_entry_free(
+			          &file_entry,
+			          &error );
+
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		memory_free(
+		 context.allocation_states );
+
+		context.allocation_states = NULL;
+	}
+	/* Test error cases
+	 */
+	result = libfsntfs_volume_scan_mft_entries(
+	          NULL,
+	          1,
+	          &fsntfs_test_volume_scan_mft_entries_callback,
+	          (void *) &number_of_scanned_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_scan_mft_entries(
+	          volume,
+	          0,
+	          &fsntfs_test_volume_scan_mft_entries_callback,
+	          (void *) &number_of_scanned_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_scan_mft_entries(
+	          volume,
+	          1,
+	          NULL,
+	          (void *) &number_of_scanned_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( context.allocation_states != NULL )
+	{
+		memory_free(
+		 context.allocation_states );
+	}
+	return( 0 );
+}
+
+/* Callback function for testing the libfsntfs_volume_extract_data function
+ * Returns 1 to continue, 0 to stop or -1 on error
+ */
+int fsntfs_test_volume_extract_data_callback(
+     uint64_t mft_entry_index,
+     off64_t data_offset,
+     const uint8_t *data,
+     size_t data_size,
+     void *user_data )
+{
+	fsntfs_test_volume_extract_data_context_t *context = NULL;
+	int entry_index                                    = 0;
+
+	context = (fsntfs_test_volume_extract_data_context_t *) user_data;
+
+	if( ( context == NULL )
+	 || ( data == NULL ) )
+	{
+		return( -1 );
+	}
+	if( context->stop_extraction != 0 )
+	{
+		return( 0 );
+	}
+	for( entry_index = 0;
+	     entry_index < context->number_of_entries;
+	     entry_index++ )
+	{
+		if( context->mft_entry_indexes[ entry_index ] == mft_entry_index )
+		{
+			break;
+		}
+	}
+	if( entry_index >= context->number_of_entries )
+	{
+		return( -1 );
+	}
+	if( ( data_offset < 0 )
+	 || ( (size64_t) data_offset > context->data_sizes[ entry_index ] )
+	 || ( (size64_t) data_size > ( context->data_sizes[ entry_index ] - data_offset ) ) )
+	{
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( context->data[ entry_index ][ data_offset ] ),
+	     data,
+	     data_size ) == NULL )
+	{
+		return( -1 );
+	}
+	context->number_of_bytes[ entry_index ] += data_size;
+
+	return( 1 );
+}
+
+/* Tests the libfsntfs_volume_extract_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_volume_extract_data(
+     libfsntfs_volume_t *volume )
+{
+	fsntfs_test_volume_extract_data_context_t context;
+
+	libcerror_error_t *error           = NULL;
+	libfsntfs_file_entry_t *file_entry = NULL;
+	uint8_t *read_data                 = NULL;
+	size64_t data_size                 = 0;
+	uint64_t mft_entry_index           = 0;
+	uint64_t number_of_file_entries    = 0;
+	ssize_t read_count                 = 0;
+	int entry_index                    = 0;
+	int result                         = 0;
+
+	result = memory_set(
+	          &context,
+	          0,
+	          sizeof( fsntfs_test_volume_extract_data_context_t ) ) != NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfsntfs_volume_get_number_of_file_entries(
+	          volume,
+	          &number_of_file_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Determine the data sizes of the first MFT entries
+	 */
+	for( mft_entry_index = 0;
+	     ( mft_entry_index < number_of_file_entries )
+	  && ( context.number_of_entries < FSNTFS_TEST_VOLUME_EXTRACT_DATA_NUMBER_OF_ENTRIES );
+	     mft_entry_index++ )
+	{
+		result = libfsntfs_volume_get_file_entry_by_index(
+		          volume,
+		          mft_entry_index,
+		          &file_entry,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_free(
+			 &error );
+
+			continue;
+		}
+		data_size = 0;
+
+		result = libfsntfs_file_entry_has_default_data_stream(
+		          file_entry,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			result = libfsntfs_file_entry_get_size(
+			          file_entry,
+			          &data_size,
+			          &error );
+
+			FSNTFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSNTFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libfsntfs_file_entry_free(
+		          &file_entry,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( data_size > FSNTFS_TEST_VOLUME_EXTRACT_DATA_MAXIMUM_SIZE )
+		{
+			continue;
+		}
+		entry_index = context.number_of_entries;
+
+		if( data_size > 0 )
+		{
+			context.data[ entry_index ] = (uint8_t *) memory_allocate(
+			                                           sizeof( uint8_t ) * (size_t) data_size );
+
+			FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+			 "context.data[ entry_index ]",
+			 context.data[ entry_index ] );
+		}
+		context.mft_entry_indexes[ entry_index ] = mft_entry_index;
+		context.data_sizes[ entry_index ]        = data_size;
+
+		context.number_of_entries += 1;
+	}
+	/* Test regular cases
+	 */
+	result = libfsntfs_volume_extract_data(
+	          volume,
+	          context.mft_entry_indexes,
+	          context.number_of_entries,
+	          &fsntfs_test_volume_extract_data_callback,
+	          (void *) &context,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Every byte of the data should have been passed to the callback function
+	 * and match the data read from the file entry
+	 */
+	for( entry_index = 0;
+	     entry_index < context.number_of_entries;
+	     entry_index++ )
+	{
+		FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+		 "context.number_of_bytes[ entry_index ]",
+		 (uint64_t) context.number_of_bytes[ entry_index ],
+		 (uint64_t) context.data_sizes[ entry_index ] );
+
+		if( context.data_sizes[ entry_index ] == 0 )
+		{
+			continue;
+		}
+		read_data = (uint8_t *) memory_allocate(
+		                         sizeof( uint8_t ) * (size_t) context.data_sizes[ entry_index ] );
+
+		FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+		 "read_data",
+		 read_data );
+
+		result = libfsntfs_volume_get_file_entry_by_index(
+		          volume,
+		          context.mft_entry_indexes[ entry_index ],
+		          &file_entry,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libfsntfs_file_entry_read_buffer_at_offset(
+		              file_entry,
+		              read_data,
+		              (size_t) context.data_sizes[ entry_index ],
+		              0,
+		              &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) context.data_sizes[ entry_index ] );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libfsntfs_file_entry_free(
+		          &file_entry,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          context.data[ entry_index ],
+		          read_data,
+		          (size_t) context.data_sizes[ entry_index ] );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		memory_free(
+		 read_data );
+
+		read_data = NULL;
+	}
+	/* Test extraction stopped by the callback function
+	 */
+	context.stop_extraction = 1;
+
+	for( entry_index = 0;
+	     entry_index < context.number_of_entries;
+	     entry_index++ )
+	{
+		if( context.data_sizes[ entry_index ] > 0 )
+		{
+			break;
+		}
+	}
+	if( entry_index < context.number_of_entries )
+	{
+		result = libfsntfs_volume_extract_data(
+		          volume,
+		          context.mft_entry_indexes,
+		          context.number_of_entries,
+		          &fsntfs_test_volume_extract_data_callback,
+		          (void *) &context,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libfsntfs_volume_extract_data(
+	          NULL,
+	          context.mft_entry_indexes,
+	          context.number_of_entries,
+	          &fsntfs_test_volume_extract_data_callback,
+	          (void *) &context,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_extract_data(
+	          volume,
+	          NULL,
+	          context.number_of_entries,
+	          &fsntfs_test_volume_extract_data_callback,
+	          (void *) &context,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_extract_data(
+	          volume,
+	          context.mft_entry_indexes,
+	          -1,
+	          &fsntfs_test_volume_extract_data_callback,
+	          (void *) &context,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_extract_data(
+	          volume,
+	          context.mft_entry_indexes,
+	          context.number_of_entries,
+	          NULL,
+	          (void *) &context,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	for( entry_index = 0;
+	     entry_index < context.number_of_entries;
+	     entry_index++ )
+	{
+		if( context.data[ entry_index ] != NULL )
+		{
+			memory_free(
+			 context.data[ entry_index ] );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( read_data != NULL )
+	{
+		memory_free(
+		 read_data );
+	}
+	for( entry_index = 0;
+	     entry_index < FSNTFS_TEST_VOLUME_EXTRACT_DATA_NUMBER_OF_ENTRIES;
+	     entry_index++ )
+	{
+		if( context.data[ entry_index ] != NULL )
+		{
+			memory_free(
+			 context.data[ entry_index ] );
+		}
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_volume_build_path_table function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_volume_build_path_table(
+     libfsntfs_volume_t *volume )
+{
+	uint8_t utf8_string[ 64 ];
+
+	libcerror_error_t *error           = NULL;
+	libfsntfs_path_table_t *path_table = NULL;
+	uint64_t number_of_entries         = 0;
+	uint64_t number_of_file_entries    = 0;
+	int result                         = 0;
+
+	result = libfsntfs_volume_get_number_of_file_entries(
+	          volume,
+	          &number_of_file_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_volume_build_path_table(
+	          volume,
+	          &path_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_table",
+	 path_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_path_table_get_number_of_entries(
+	          path_table,
+	          &number_of_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_entries",
+	 number_of_entries,
+	 number_of_file_entries );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( number_of_entries > LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY )
+	{
+		/* The path of the $MFT metadata file
+		 */
+		result = libfsntfs_path_table_get_utf8_path(
+		          path_table,
+		          LIBFSNTFS_MFT_ENTRY_INDEX_MFT,
+		          utf8_string,
+		          64,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = narrow_string_compare(
+		          (char *) utf8_string,
+		          "\\$MFT",
+		          6 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* The path of the root directory
+		 */
+		result = libfsntfs_path_table_get_utf8_path(
+		          path_table,
+		          LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY,
+		          utf8_string,
+		          64,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = narrow_string_compare(
+		          (char *) utf8_string,
+		          "\\",
+		          2 );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	result = libfsntfs_path_table_free(
+	          &path_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_table",
+	 path_table );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_volume_build_path_table(
+	          NULL,
+	          &path_table,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "path_table",
+	 path_table );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_build_path_table(
+	          volume,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_table != NULL )
+	{
+		libfsntfs_path_table_free(
+		 &path_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsntfs_volume_read_children_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_volume_read_children_index(
+     libfsntfs_volume_t *volume )
+{
+	libcerror_error_t *error                 = NULL;
+	libfsntfs_file_entry_t *child_file_entry = NULL;
+	libfsntfs_file_entry_t *root_directory   = NULL;
+	int number_of_child_file_entries         = 0;
+	int result                               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_volume_read_children_index(
+	          volume,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading the children index when it was already read
+	 */
+	result = libfsntfs_volume_read_children_index(
+	          volume,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The metadata files are children of the root directory
+	 */
+	result = libfsntfs_volume_get_root_directory(
+	          volume,
+	          &root_directory,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "root_directory",
+	 root_directory );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_entry_get_number_of_child_file_entries(
+	          root_directory,
+	          &number_of_child_file_entries,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_child_file_entries",
+	 number_of_child_file_entries,
+	 0 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_entry_get_child_file_entry_by_index(
+	          root_directory,
+	          0,
+	          &child_file_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "child_file_entry",
+	 child_file_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_entry_free(
+	          &child_file_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_entry_free(
+	          &root_directory,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_volume_read_children_index(
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( child_file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &child_file_entry,
+		 NULL );
+	}
+	if( root_directory != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &root_directory,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+     libfsntfs_volume_t *volume )
+{
+	uint8_t utf8_path[ 6 ]                       = { '\\', '$', 'M', 'F', 'T', 0 };
+	libcerror_error_t *error                     = NULL;
+	libfsntfs_directory_entry_t *directory_entry = NULL;
+	libfsntfs_mft_entry_t *mft_entry             = NULL;
+	int result                                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	          (libfsntfs_internal_volume_t *) volume,
+	          utf8_path,
+	          5,
+	          &mft_entry,
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "mft_entry",
+	 mft_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_entry",
+	 directory_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_directory_entry_free(
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "directory_entry",
+	 directory_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	          NULL,
+	          utf8_path,
+	          5,
+	          &mft_entry,
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	          (libfsntfs_internal_volume_t *) volume,
+	          NULL,
+	          5,
+	          &mft_entry,
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	          (libfsntfs_internal_volume_t *) volume,
+	          utf8_path,
+	          (size_t) SSIZE_MAX + 1,
+	          &mft_entry,
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	          (libfsntfs_internal_volume_t *) volume,
+	          utf8_path,
+	          5,
+	          NULL,
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	          (libfsntfs_internal_volume_t *) volume,
+	          utf8_path,
+	          5,
+	          &mft_entry,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	directory_entry = (libfsntfs_directory_entry_t *) 0x12345678UL;
+
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	          (libfsntfs_internal_volume_t *) volume,
+	          utf8_path,
+	          5,
+	          &mft_entry,
+	          NULL,
+	          &error );
+
+	directory_entry = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &directory_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
+
+/* Tests the libfsntfs_volume_get_file_entry_by_utf8_path function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_volume_get_file_entry_by_utf8_path(
+     libfsntfs_volume_t *volume )
+{
+	uint8_t utf8_path[ 6 ]             = { '\\', '$', 'M', 'F', 'T', 0 };
+	libcerror_error_t *error           = NULL;
+	libfsntfs_file_entry_t *file_entry = NULL;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	          volume,
+	          utf8_path,
+	          5,
+	          &file_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsntfs_file_entry_free(
+	          &file_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	          NULL,
+	          utf8_path,
+	          5,
+	          &file_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	          volume,
+	          NULL,
+	          5,
+	          &file_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	          volume,
+	          utf8_path,
+	          5,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_entry = (libfsntfs_file_entry_t *) 0x12345678UL;
+
+	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	          volume,
+	          utf8_path,
+	          5,
+	          &file_entry,
+	          &error );
+
+	file_entry = NULL;
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+
+/* Tests the libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf16_path(
+     libfsntfs_volume_t *volume )
+{
+	uint16_t utf16_path[ 6 ]                     = { '\\', '$', 'M', 'F', 'T', 0 };
+	libcerror_error_t *error                     = NULL;
+	libfsntfs_directory_entry_t *directory_entry = NULL;
+	libfsntfs_mft_entry_t *mft_entry             = NULL;
+	int result                                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
+	          (libfsntfs_internal_volume_t *) volume,
+	          utf16_path,
+	          5,
+	          &mft_entry,
+	          &directory_entry,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "mft_entry",
+	 mft_entry );
 
 	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
 	 "directory_entry",
@@ -2266,9 +4120,9 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf8_path(
 
 	/* Test error cases
 	 */
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	          NULL,
-	          utf8_path,
+	          utf16_path,
 	          5,
 	          &mft_entry,
 	          &directory_entry,
@@ -2286,7 +4140,7 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf8_path(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	          (libfsntfs_internal_volume_t *) volume,
 	          NULL,
 	          5,
@@ -2306,9 +4160,9 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf8_path(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	          (libfsntfs_internal_volume_t *) volume,
-	          utf8_path,
+	          utf16_path,
 	          (size_t) SSIZE_MAX + 1,
 	          &mft_entry,
 	          &directory_entry,
@@ -2326,9 +4180,9 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf8_path(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	          (libfsntfs_internal_volume_t *) volume,
-	          utf8_path,
+	          utf16_path,
 	          5,
 	          NULL,
 	          &directory_entry,
@@ -2346,9 +4200,9 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf8_path(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	          (libfsntfs_internal_volume_t *) volume,
-	          utf8_path,
+	          utf16_path,
 	          5,
 	          &mft_entry,
 	          NULL,
@@ -2368,9 +4222,9 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf8_path(
 
 	directory_entry = (libfsntfs_directory_entry_t *) 0x12345678UL;
 
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf8_path(
+	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	          (libfsntfs_internal_volume_t *) volume,
-	          utf8_path,
+	          utf16_path,
 	          5,
 	          &mft_entry,
 	          NULL,
@@ -2409,22 +4263,22 @@ on_error:
 
 #endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
 
-/* Tests the libfsntfs_volume_get_file_entry_by_utf8_path function
+/* Tests the libfsntfs_volume_get_file_entry_by_utf16_path function
  * Returns 1 if successful or 0 if not
  */
-int fsntfs_test_volume_get_file_entry_by_utf8_path(
+int fsntfs_test_volume_get_file_entry_by_utf16_path(
      libfsntfs_volume_t *volume )
 {
-	uint8_t utf8_path[ 6 ]             = { '\\', '$', 'M', 'F', 'T', 0 };
+	uint16_t utf16_path[ 6 ]           = { '\\', '$', 'M', 'F', 'T', 0 };
 	libcerror_error_t *error           = NULL;
 	libfsntfs_file_entry_t *file_entry = NULL;
 	int result                         = 0;
 
 	/* Test regular cases
 	 */
-	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	result = libfsntfs_volume_get_file_entry_by_utf16_path(
 	          volume,
-	          utf8_path,
+	          utf16_path,
 	          5,
 	          &file_entry,
 	          &error );
@@ -2461,9 +4315,9 @@ int fsntfs_test_volume_get_file_entry_by_utf8_path(
 
 	/* Test error cases
 	 */
-	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	result = libfsntfs_volume_get_file_entry_by_utf16_path(
 	          NULL,
-	          utf8_path,
+	          utf16_path,
 	          5,
 	          &file_entry,
 	          &error );
@@ -2484,7 +4338,7 @@ int fsntfs_test_volume_get_file_entry_by_utf8_path(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	result = libfsntfs_volume_get_file_entry_by_utf16_path(
 	          volume,
 	          NULL,
 	          5,
@@ -2507,9 +4361,9 @@ int fsntfs_test_volume_get_file_entry_by_utf8_path(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	result = libfsntfs_volume_get_file_entry_by_utf16_path(
 	          volume,
-	          utf8_path,
+	          utf16_path,
 	          5,
 	          NULL,
 	          &error );
@@ -2532,9 +4386,9 @@ int fsntfs_test_volume_get_file_entry_by_utf8_path(
 
 	file_entry = (libfsntfs_file_entry_t *) 0x12345678UL;
 
-	result = libfsntfs_volume_get_file_entry_by_utf8_path(
+	result = libfsntfs_volume_get_file_entry_by_utf16_path(
 	          volume,
-	          utf8_path,
+	          utf16_path,
 	          5,
 	          &file_entry,
 	          &error );
@@ -2546,10 +4400,6 @@ int fsntfs_test_volume_get_file_entry_by_utf8_path(
 	 result,
 	 -1 );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "file_entry",
-	 file_entry );
-
 	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2574,28 +4424,21 @@ on_error:
 	return( 0 );
 }
 
-#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
-
-/* Tests the libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path function
+/* Tests the libfsntfs_volume_get_root_directory function
  * Returns 1 if successful or 0 if not
  */
-int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf16_path(
+int fsntfs_test_volume_get_root_directory(
      libfsntfs_volume_t *volume )
 {
-	uint16_t utf16_path[ 6 ]                     = { '\\', '$', 'M', 'F', 'T', 0 };
-	libcerror_error_t *error                     = NULL;
-	libfsntfs_directory_entry_t *directory_entry = NULL;
-	libfsntfs_mft_entry_t *mft_entry             = NULL;
-	int result                                   = 0;
+	libcerror_error_t *error               = NULL;
+	libfsntfs_file_entry_t *root_directory = 0;
+	int result                             = 0;
 
 	/* Test regular cases
 	 */
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
-	          (libfsntfs_internal_volume_t *) volume,
-	          utf16_path,
-	          5,
-	          &mft_entry,
-	          &directory_entry,
+	result = libfsntfs_volume_get_root_directory(
+	          volume,
+	          &root_directory,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -2604,19 +4447,15 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	 1 );
 
 	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "mft_entry",
-	 mft_entry );
-
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "directory_entry",
-	 directory_entry );
+	 "root_directory",
+	 root_directory );
 
 	FSNTFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libfsntfs_directory_entry_free(
-	          &directory_entry,
+	result = libfsntfs_file_entry_free(
+	          &root_directory,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -2625,8 +4464,8 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	 1 );
 
 	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "directory_entry",
-	 directory_entry );
+	 "root_directory",
+	 root_directory );
 
 	FSNTFS_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -2634,52 +4473,9 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 
 	/* Test error cases
 	 */
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
-	          NULL,
-	          utf16_path,
-	          5,
-	          &mft_entry,
-	          &directory_entry,
-	          &error );
-
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
-	          (libfsntfs_internal_volume_t *) volume,
+	result = libfsntfs_volume_get_root_directory(
 	          NULL,
-	          5,
-	          &mft_entry,
-	          &directory_entry,
-	          &error );
-
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
-	          (libfsntfs_internal_volume_t *) volume,
-	          utf16_path,
-	          (size_t) SSIZE_MAX + 1,
-	          &mft_entry,
-	          &directory_entry,
+	          &root_directory,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -2687,25 +4483,9 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	 result,
 	 -1 );
 
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
-	          (libfsntfs_internal_volume_t *) volume,
-	          utf16_path,
-	          5,
-	          NULL,
-	          &directory_entry,
-	          &error );
-
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "root_directory",
+	 root_directory );
 
 	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2714,11 +4494,8 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
-	          (libfsntfs_internal_volume_t *) volume,
-	          utf16_path,
-	          5,
-	          &mft_entry,
+	result = libfsntfs_volume_get_root_directory(
+	          volume,
 	          NULL,
 	          &error );
 
@@ -2727,29 +4504,9 @@ int fsntfs_test_internal_volume_get_mft_and_directory_entry_by_utf16_path(
 	 result,
 	 -1 );
 
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	directory_entry = (libfsntfs_directory_entry_t *) 0x12345678UL;
-
-	result = libfsntfs_internal_volume_get_mft_and_directory_entry_by_utf16_path(
-	          (libfsntfs_internal_volume_t *) volume,
-	          utf16_path,
-	          5,
-	          &mft_entry,
-	          NULL,
-	          &error );
-
-	directory_entry = NULL;
-
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "root_directory",
+	 root_directory );
 
 	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2766,74 +4523,68 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( directory_entry != NULL )
+	if( root_directory != NULL )
 	{
-		libfsntfs_directory_entry_free(
-		 &directory_entry,
+		libfsntfs_file_entry_free(
+		 &root_directory,
 		 NULL );
 	}
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT ) */
-
-/* Tests the libfsntfs_volume_get_file_entry_by_utf16_path function
+/* Tests the libfsntfs_volume_get_usn_change_journal function
  * Returns 1 if successful or 0 if not
  */
-int fsntfs_test_volume_get_file_entry_by_utf16_path(
+int fsntfs_test_volume_get_usn_change_journal(
      libfsntfs_volume_t *volume )
 {
-	uint16_t utf16_path[ 6 ]           = { '\\', '$', 'M', 'F', 'T', 0 };
-	libcerror_error_t *error           = NULL;
-	libfsntfs_file_entry_t *file_entry = NULL;
-	int result                         = 0;
+	libcerror_error_t *error                           = NULL;
+	libfsntfs_usn_change_journal_t *usn_change_journal = 0;
+	int result                                         = 0;
+	int usn_change_journal_is_set                      = 0;
 
 	/* Test regular cases
 	 */
-	result = libfsntfs_volume_get_file_entry_by_utf16_path(
+	result = libfsntfs_volume_get_usn_change_journal(
 	          volume,
-	          utf16_path,
-	          5,
-	          &file_entry,
+	          &usn_change_journal,
 	          &error );
 
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	FSNTFS_TEST_ASSERT_NOT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "file_entry",
-	 file_entry );
+	 -1 );
 
 	FSNTFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libfsntfs_file_entry_free(
-	          &file_entry,
-	          &error );
+	usn_change_journal_is_set = result;
 
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+	if( usn_change_journal_is_set != 0 )
+	{
+		FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+		 "usn_change_journal",
+		 usn_change_journal );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "file_entry",
-	 file_entry );
+		result = libfsntfs_usn_change_journal_free(
+		          &usn_change_journal,
+		          &error );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
 	/* Test error cases
 	 */
-	result = libfsntfs_volume_get_file_entry_by_utf16_path(
+	result = libfsntfs_volume_get_usn_change_journal(
 	          NULL,
-	          utf16_path,
-	          5,
-	          &file_entry,
+	          &usn_change_journal,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -2841,45 +4592,87 @@ int fsntfs_test_volume_get_file_entry_by_utf16_path(
 	 result,
 	 -1 );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "file_entry",
-	 file_entry );
+	FSNTFS_TEST_ASSERT_IS_NULL(
+	 "usn_change_journal",
+	 usn_change_journal );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( usn_change_journal_is_set != 0 )
+	{
+		result = libfsntfs_volume_get_usn_change_journal(
+		          volume,
+		          NULL,
+		          &error );
+
+		FSNTFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FSNTFS_TEST_ASSERT_IS_NULL(
+		 "usn_change_journal",
+		 usn_change_journal );
+
+		FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
 
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
 
-	libcerror_error_free(
-	 &error );
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( usn_change_journal != NULL )
+	{
+		libfsntfs_usn_change_journal_free(
+		 &usn_change_journal,
+		 NULL );
+	}
+	return( 0 );
+}
 
-	result = libfsntfs_volume_get_file_entry_by_utf16_path(
+/* Tests the libfsntfs_volume_is_cluster_allocated function
+ * Returns 1 if successful or 0 if not
+ */
+int fsntfs_test_volume_is_cluster_allocated(
+     libfsntfs_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsntfs_volume_is_cluster_allocated(
 	          volume,
-	          NULL,
-	          5,
-	          &file_entry,
+	          0,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "file_entry",
-	 file_entry );
-
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libfsntfs_volume_get_file_entry_by_utf16_path(
-	          volume,
-	          utf16_path,
-	          5,
+	/* Test error cases
+	 */
+	result = libfsntfs_volume_is_cluster_allocated(
 	          NULL,
+	          0,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -2887,10 +4680,6 @@ int fsntfs_test_volume_get_file_entry_by_utf16_path(
 	 result,
 	 -1 );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "file_entry",
-	 file_entry );
-
 	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2898,17 +4687,11 @@ int fsntfs_test_volume_get_file_entry_by_utf16_path(
 	libcerror_error_free(
 	 &error );
 
-	file_entry = (libfsntfs_file_entry_t *) 0x12345678UL;
-
-	result = libfsntfs_volume_get_file_entry_by_utf16_path(
+	result = libfsntfs_volume_is_cluster_allocated(
 	          volume,
-	          utf16_path,
-	          5,
-	          &file_entry,
+	          0xffffffffffffffffULL,
 	          &error );
 
-	file_entry = NULL;
-
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -2929,47 +4712,24 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( file_entry != NULL )
-	{
-		libfsntfs_file_entry_free(
-		 &file_entry,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libfsntfs_volume_get_root_directory function
+/* Tests the libfsntfs_volume_get_number_of_unallocated_ranges function
  * Returns 1 if successful or 0 if not
  */
-int fsntfs_test_volume_get_root_directory(
+int fsntfs_test_volume_get_number_of_unallocated_ranges(
      libfsntfs_volume_t *volume )
 {
-	libcerror_error_t *error               = NULL;
-	libfsntfs_file_entry_t *root_directory = 0;
-	int result                             = 0;
+	libcerror_error_t *error = NULL;
+	int number_of_ranges     = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libfsntfs_volume_get_root_directory(
+	result = libfsntfs_volume_get_number_of_unallocated_ranges(
 	          volume,
-	          &root_directory,
-	          &error );
-
-	FSNTFS_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-	 "root_directory",
-	 root_directory );
-
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
-	result = libfsntfs_file_entry_free(
-	          &root_directory,
+	          &number_of_ranges,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -2977,19 +4737,15 @@ int fsntfs_test_volume_get_root_directory(
 	 result,
 	 1 );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "root_directory",
-	 root_directory );
-
 	FSNTFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
 	/* Test error cases
 	 */
-	result = libfsntfs_volume_get_root_directory(
+	result = libfsntfs_volume_get_number_of_unallocated_ranges(
 	          NULL,
-	          &root_directory,
+	          &number_of_ranges,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -2997,10 +4753,6 @@ int fsntfs_test_volume_get_root_directory(
 	 result,
 	 -1 );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "root_directory",
-	 root_directory );
-
 	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -3008,7 +4760,7 @@ int fsntfs_test_volume_get_root_directory(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsntfs_volume_get_root_directory(
+	result = libfsntfs_volume_get_number_of_unallocated_ranges(
 	          volume,
 	          NULL,
 	          &error );
@@ -3018,10 +4770,6 @@ int fsntfs_test_volume_get_root_directory(
 	 result,
 	 -1 );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "root_directory",
-	 root_directory );
-
 	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -3037,52 +4785,44 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( root_directory != NULL )
-	{
-		libfsntfs_file_entry_free(
-		 &root_directory,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libfsntfs_volume_get_usn_change_journal function
+/* Tests the libfsntfs_volume_get_unallocated_range_by_index function
  * Returns 1 if successful or 0 if not
  */
-int fsntfs_test_volume_get_usn_change_journal(
+int fsntfs_test_volume_get_unallocated_range_by_index(
      libfsntfs_volume_t *volume )
 {
-	libcerror_error_t *error                           = NULL;
-	libfsntfs_usn_change_journal_t *usn_change_journal = 0;
-	int result                                         = 0;
-	int usn_change_journal_is_set                      = 0;
+	libcerror_error_t *error = NULL;
+	size64_t range_size      = 0;
+	off64_t range_offset     = 0;
+	int number_of_ranges     = 0;
+	int result               = 0;
 
-	/* Test regular cases
-	 */
-	result = libfsntfs_volume_get_usn_change_journal(
+	result = libfsntfs_volume_get_number_of_unallocated_ranges(
 	          volume,
-	          &usn_change_journal,
+	          &number_of_ranges,
 	          &error );
 
-	FSNTFS_TEST_ASSERT_NOT_EQUAL_INT(
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	FSNTFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	usn_change_journal_is_set = result;
-
-	if( usn_change_journal_is_set != 0 )
+	/* Test regular cases
+	 */
+	if( number_of_ranges > 0 )
 	{
-		FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-		 "usn_change_journal",
-		 usn_change_journal );
-
-		result = libfsntfs_usn_change_journal_free(
-		          &usn_change_journal,
+		result = libfsntfs_volume_get_unallocated_range_by_index(
+		          volume,
+		          0,
+		          &range_offset,
+		          &range_size,
 		          &error );
 
 		FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -3096,9 +4836,11 @@ int fsntfs_test_volume_get_usn_change_journal(
 	}
 	/* Test error cases
 	 */
-	result = libfsntfs_volume_get_usn_change_journal(
+	result = libfsntfs_volume_get_unallocated_range_by_index(
 	          NULL,
-	          &usn_change_journal,
+	          0,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	FSNTFS_TEST_ASSERT_EQUAL_INT(
@@ -3106,9 +4848,24 @@ int fsntfs_test_volume_get_usn_change_journal(
 	 result,
 	 -1 );
 
-	FSNTFS_TEST_ASSERT_IS_NULL(
-	 "usn_change_journal",
-	 usn_change_journal );
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_get_unallocated_range_by_index(
+	          volume,
+	          -1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -3117,29 +4874,44 @@ int fsntfs_test_volume_get_usn_change_journal(
 	libcerror_error_free(
 	 &error );
 
-	if( usn_change_journal_is_set != 0 )
-	{
-		result = libfsntfs_volume_get_usn_change_journal(
-		          volume,
-		          NULL,
-		          &error );
+	result = libfsntfs_volume_get_unallocated_range_by_index(
+	          volume,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
 
-		FSNTFS_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		FSNTFS_TEST_ASSERT_IS_NULL(
-		 "usn_change_journal",
-		 usn_change_journal );
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		FSNTFS_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	libcerror_error_free(
+	 &error );
+
+	result = libfsntfs_volume_get_unallocated_range_by_index(
+	          volume,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	FSNTFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSNTFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3148,12 +4920,6 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( usn_change_journal != NULL )
-	{
-		libfsntfs_usn_change_journal_free(
-		 &usn_change_journal,
-		 NULL );
-	}
 	return( 0 );
 }
 
@@ -3241,6 +5007,10 @@ int main(
 	 "libfsntfs_volume_free",
 	 fsntfs_test_volume_free );
 
+	FSNTFS_TEST_RUN(
+	 "libfsntfs_volume_set_cache_limits",
+	 fsntfs_test_volume_set_cache_limits );
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -3322,6 +5092,11 @@ int main(
 		 fsntfs_test_volume_open,
 		 source );
 
+		FSNTFS_TEST_RUN_WITH_ARGS(
+		 "libfsntfs_volume_open_mapped",
+		 fsntfs_test_volume_open_mapped,
+		 source );
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
 		FSNTFS_TEST_RUN_WITH_ARGS(
@@ -3439,6 +5214,26 @@ int main(
 		 fsntfs_test_volume_get_file_entry_by_index,
 		 volume );
 
+		FSNTFS_TEST_RUN_WITH_ARGS(
+		 "libfsntfs_volume_scan_mft_entries",
+		 fsntfs_test_volume_scan_mft_entries,
+		 volume );
+
+		FSNTFS_TEST_RUN_WITH_ARGS(
+		 "libfsntfs_volume_extract_data",
+		 fsntfs_test_volume_extract_data,
+		 volume );
+
+		FSNTFS_TEST_RUN_WITH_ARGS(
+		 "libfsntfs_volume_build_path_table",
+		 fsntfs_test_volume_build_path_table,
+		 volume );
+
+		FSNTFS_TEST_RUN_WITH_ARGS(
+		 "libfsntfs_volume_read_children_index",
+		 fsntfs_test_volume_read_children_index,
+		 volume );
+
 #if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
 
 		FSNTFS_TEST_RUN_WITH_ARGS(
@@ -3477,6 +5272,21 @@ int main(
 		 fsntfs_test_volume_get_usn_change_journal,
 		 volume );
 
+		FSNTFS_TEST_RUN_WITH_ARGS(
+		 "libfsntfs_volume_is_cluster_allocated",
+		 fsntfs_test_volume_is_cluster_allocated,
+		 volume );
+
+		FSNTFS_TEST_RUN_WITH_ARGS(
+		 "libfsntfs_volume_get_number_of_unallocated_ranges",
+		 fsntfs_test_volume_get_number_of_unallocated_ranges,
+		 volume );
+
+		FSNTFS_TEST_RUN_WITH_ARGS(
+		 "libfsntfs_volume_get_unallocated_range_by_index",
+		 fsntfs_test_volume_get_unallocated_range_by_index,
+		 volume );
+
 		/* Clean up
 		 */
 		result = fsntfs_test_volume_close_source(